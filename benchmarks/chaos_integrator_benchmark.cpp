@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+    chaos_integrator_benchmark.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Cost and accuracy of every chaos integrator method and oversampling
+    factor, measured against RK4 at the highest factor
+  ==============================================================================
+*/
+
+#include "oscillators/chaos_integrator.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace vital::audio_engine::oscillators;
+using System = ChaosIntegrator::System;
+using Method = ChaosIntegrator::Method;
+
+namespace {
+
+struct Result
+{
+    Method method = Method::Euler;
+    int oversampling = 1;
+    double nanosecondsPerVoiceSample = 0.0;
+    double spectralErrorDb = 0.0;       // Mean absolute log-spectrum distance from the reference
+    bool stable = true;                 // False if the trajectory diverged
+};
+
+/**
+ * Render seconds of audio with every method at 1x, 2x, 4x and 8x, and
+ * compare each averaged spectrum against RK4 at 8x.
+ */
+std::vector<Result> measure(System system, double sampleRate, float speed, int numVoices, double seconds)
+{
+    constexpr int kFftOrder = 12;
+    constexpr int kFftSize = 1 << kFftOrder;
+    constexpr int kBlockSize = 512;
+
+    const int totalSamples = std::max(kFftSize, static_cast<int>(seconds * sampleRate));
+    const int warmupSamples = static_cast<int>(0.1 * sampleRate);
+
+    struct Run
+    {
+        std::vector<double> spectrum;
+        double nanoseconds = 0.0;
+        bool stable = true;
+    };
+
+    // Hann-windowed power spectrum of voice 0, averaged over half-overlapping frames
+    const auto render = [&](Method method, int factor) {
+        ChaosIntegrator integrator;
+        integrator.prepare({ system, method, factor, numVoices, kBlockSize, sampleRate });
+        for (int voice = 0; voice < numVoices; ++voice)
+            integrator.setSpeed(voice, speed);
+
+        for (int done = 0; done < warmupSamples; done += kBlockSize)
+            integrator.process(numVoices, std::min(kBlockSize, warmupSamples - done));
+
+        std::vector<float> signal(static_cast<size_t>(totalSamples));
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int done = 0; done < totalSamples; done += kBlockSize) {
+            const int count = std::min(kBlockSize, totalSamples - done);
+            integrator.process(numVoices, count);
+            std::copy(integrator.getOutput(0), integrator.getOutput(0) + count, signal.begin() + done);
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        Run run;
+        run.nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count()
+                        / (static_cast<double>(totalSamples) * numVoices);
+        run.stable = integrator.getNumDivergences() == 0;
+        run.spectrum.assign(kFftSize / 2, 0.0);
+
+        juce::dsp::FFT fft(kFftOrder);
+        std::vector<float> frame(2 * kFftSize);
+        int numFrames = 0;
+
+        for (int offset = 0; offset + kFftSize <= totalSamples; offset += kFftSize / 2) {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            for (int i = 0; i < kFftSize; ++i) {
+                const float window = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * i / kFftSize);
+                frame[static_cast<size_t>(i)] = signal[static_cast<size_t>(offset + i)] * window;
+            }
+
+            fft.performRealOnlyForwardTransform(frame.data());
+            for (int bin = 0; bin < kFftSize / 2; ++bin) {
+                const double re = frame[2 * static_cast<size_t>(bin)];
+                const double im = frame[2 * static_cast<size_t>(bin) + 1];
+                run.spectrum[static_cast<size_t>(bin)] += re * re + im * im;
+            }
+            ++numFrames;
+        }
+
+        for (auto& power : run.spectrum)
+            power /= std::max(1, numFrames);
+
+        return run;
+    };
+
+    const Run reference = render(Method::RK4, ChaosIntegrator::kMaxOversampling);
+    std::vector<Result> results;
+
+    for (Method method : { Method::Euler, Method::RK2, Method::RK4 }) {
+        for (int factor = 1; factor <= ChaosIntegrator::kMaxOversampling; factor *= 2) {
+            const Run run = render(method, factor);
+
+            // Bins below 90% of Nyquist; the floor keeps empty bins from dominating
+            const int numBins = static_cast<int>(0.9 * kFftSize / 2);
+            double distance = 0.0;
+            for (int bin = 1; bin < numBins; ++bin) {
+                const double a = 10.0 * std::log10(run.spectrum[static_cast<size_t>(bin)] + 1.0e-12);
+                const double b = 10.0 * std::log10(reference.spectrum[static_cast<size_t>(bin)] + 1.0e-12);
+                distance += std::abs(a - b);
+            }
+
+            Result result;
+            result.method = method;
+            result.oversampling = factor;
+            result.nanosecondsPerVoiceSample = run.nanoseconds;
+            result.spectralErrorDb = distance / (numBins - 1);
+            result.stable = run.stable;
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+
+const char* methodName(Method method)
+{
+    switch (method) {
+        case Method::Euler: return "Euler";
+        case Method::RK2:   return "RK2";
+        case Method::RK4:   return "RK4";
+    }
+    return "";
+}
+
+} // namespace
+
+int main()
+{
+    constexpr double kSeconds = 2.0;
+    constexpr int kVoices = ChaosIntegrator::kLaneWidth;
+
+    for (const auto system : { System::Lorenz, System::Rossler }) {
+        for (const double sampleRate : { 44100.0, 96000.0 }) {
+            std::printf("%s at %.0f Hz, %d voices\n", system == System::Lorenz ? "Lorenz" : "Rossler",
+                        sampleRate, kVoices);
+            std::printf("  method  factor  ns/voice-sample  spectral error dB  stable\n");
+
+            for (const auto& result : measure(system, sampleRate, 441.0f, kVoices, kSeconds)) {
+                std::printf("  %-6s  %6d  %15.2f  %17.2f  %s\n", methodName(result.method), result.oversampling,
+                            result.nanosecondsPerVoiceSample, result.spectralErrorDb, result.stable ? "yes" : "no");
+            }
+            std::printf("\n");
+        }
+    }
+
+    return 0;
+}
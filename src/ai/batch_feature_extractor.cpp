@@ -0,0 +1,554 @@
+#include "batch_feature_extractor.h"
+#include "feature_store.h"
+#include "real_fft.h"
+#include "../performance/multithreading.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace vital {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr float kEpsilon = 1e-10f;
+constexpr size_t kFrameGrain = 8;
+
+/** Per-thread work buffers, reused across frames and files */
+struct FrameScratch {
+    std::vector<float> windowed;
+    std::vector<std::complex<float>> spectrum;
+    std::vector<float> magnitude;
+    std::vector<float> mel;
+
+    void reserve(size_t frame_size, size_t num_bins, size_t num_bands) {
+        if (windowed.size() != frame_size) windowed.resize(frame_size);
+        if (spectrum.size() != num_bins) spectrum.resize(num_bins);
+        if (magnitude.size() != num_bins) magnitude.resize(num_bins);
+        if (mel.size() != num_bands) mel.resize(num_bands);
+    }
+};
+
+FrameScratch& threadScratch() {
+    thread_local FrameScratch scratch;
+    return scratch;
+}
+
+/**
+ * Minimal streaming RIFF/WAVE decoder: PCM 8/16/24/32-bit and IEEE float
+ * 32/64-bit, including WAVE_FORMAT_EXTENSIBLE. Channels are averaged.
+ */
+class WavChunkReader {
+public:
+    bool open(const std::string& path, std::string& error) {
+        file_.open(path, std::ios::binary);
+        if (!file_.is_open()) {
+            error = "Cannot open file";
+            return false;
+        }
+
+        char riff[12];
+        if (!file_.read(riff, 12) || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+            error = "Not a RIFF/WAVE file";
+            return false;
+        }
+
+        bool have_format = false;
+        char header[8];
+
+        while (file_.read(header, 8)) {
+            uint32_t chunk_size = 0;
+            std::memcpy(&chunk_size, header + 4, 4);
+
+            if (std::memcmp(header, "fmt ", 4) == 0) {
+                std::vector<char> fmt(chunk_size);
+                if (chunk_size < 16 || !file_.read(fmt.data(), chunk_size)) break;
+
+                std::memcpy(&format_, fmt.data(), 2);
+                std::memcpy(&channels_, fmt.data() + 2, 2);
+                std::memcpy(&sample_rate_, fmt.data() + 4, 4);
+                std::memcpy(&bits_, fmt.data() + 14, 2);
+
+                // WAVE_FORMAT_EXTENSIBLE: the real format leads the sub-format GUID
+                if (format_ == 0xFFFE && chunk_size >= 26) {
+                    std::memcpy(&format_, fmt.data() + 24, 2);
+                }
+
+                have_format = true;
+                if (chunk_size & 1) file_.ignore(1);
+            } else if (std::memcmp(header, "data", 4) == 0) {
+                if (!have_format) break;
+                data_remaining_ = chunk_size;
+                break;
+            } else {
+                file_.ignore(static_cast<std::streamsize>(chunk_size) + (chunk_size & 1));
+            }
+        }
+
+        const bool pcm = format_ == 1 && (bits_ == 8 || bits_ == 16 || bits_ == 24 || bits_ == 32);
+        const bool ieee = format_ == 3 && (bits_ == 32 || bits_ == 64);
+
+        if (!have_format || data_remaining_ == 0 || channels_ == 0 || sample_rate_ == 0) {
+            error = "Missing or empty fmt/data chunk";
+            return false;
+        }
+        if (!pcm && !ieee) {
+            error = "Unsupported sample format";
+            return false;
+        }
+
+        return true;
+    }
+
+    double sampleRate() const { return static_cast<double>(sample_rate_); }
+
+    /** Read up to max_frames mono frames, returning how many were read */
+    size_t read(float* output, size_t max_frames) {
+        const size_t frame_bytes = size_t(channels_) * (bits_ / 8);
+        const size_t frames = std::min<uint64_t>(max_frames, data_remaining_ / frame_bytes);
+        if (frames == 0) return 0;
+
+        raw_.resize(frames * frame_bytes);
+        file_.read(raw_.data(), static_cast<std::streamsize>(raw_.size()));
+        const size_t frames_read = static_cast<size_t>(file_.gcount()) / frame_bytes;
+        data_remaining_ = frames_read == frames ? data_remaining_ - frames * frame_bytes : 0;
+
+        const float channel_scale = 1.0f / channels_;
+        const char* data = raw_.data();
+
+        for (size_t frame = 0; frame < frames_read; ++frame) {
+            float sum = 0.0f;
+            for (uint16_t channel = 0; channel < channels_; ++channel) {
+                sum += decodeSample(data);
+                data += bits_ / 8;
+            }
+            output[frame] = sum * channel_scale;
+        }
+
+        return frames_read;
+    }
+
+private:
+    float decodeSample(const char* data) const {
+        if (format_ == 3) {
+            if (bits_ == 32) {
+                float value;
+                std::memcpy(&value, data, 4);
+                return value;
+            }
+            double value;
+            std::memcpy(&value, data, 8);
+            return static_cast<float>(value);
+        }
+
+        switch (bits_) {
+            case 8:
+                return (static_cast<uint8_t>(data[0]) - 128) / 128.0f;
+            case 16: {
+                int16_t value;
+                std::memcpy(&value, data, 2);
+                return value / 32768.0f;
+            }
+            case 24: {
+                const int32_t value = (static_cast<uint8_t>(data[0]) << 8) |
+                                      (static_cast<uint8_t>(data[1]) << 16) |
+                                      (static_cast<uint8_t>(data[2]) << 24);
+                return (value >> 8) / 8388608.0f;
+            }
+            default: {
+                int32_t value;
+                std::memcpy(&value, data, 4);
+                return value / 2147483648.0f;
+            }
+        }
+    }
+
+    std::ifstream file_;
+    uint16_t format_ = 0;
+    uint16_t channels_ = 0;
+    uint16_t bits_ = 0;
+    uint32_t sample_rate_ = 0;
+    uint64_t data_remaining_ = 0;
+    std::vector<char> raw_;
+};
+
+} // namespace
+
+// ============================================================================
+// Per sample rate tables
+// ============================================================================
+
+struct BatchFeatureExtractor::Tables {
+    struct MelBand {
+        size_t first_bin;
+        std::vector<float> weights;
+    };
+
+    std::shared_ptr<const RealFFT> fft;
+    std::vector<float> window;
+    std::vector<float> bin_frequency;
+    std::vector<MelBand> mel_bands;
+    std::vector<float> dct;             // MFCC_BINS x num_mel_bands
+    std::vector<int> chroma_class;      // -1 for bins outside the musical range
+
+    Tables(const Config& config, double sample_rate) {
+        const size_t n = config.frame_size;
+        const size_t num_bins = n / 2 + 1;
+
+        fft = RealFFT::plan(n);
+
+        // Same windows as IntelligentAudioAnalyzer::generateWindow
+        window.resize(n);
+        const double denominator = n > 1 ? static_cast<double>(n - 1) : 1.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double phase = 2.0 * kPi * static_cast<double>(i) / denominator;
+            switch (config.window_type) {
+                case 0: window[i] = 1.0f; break;
+                case 2: window[i] = static_cast<float>(0.54 - 0.46 * std::cos(phase)); break;
+                case 3: window[i] = static_cast<float>(0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase)); break;
+                default: window[i] = static_cast<float>(0.5 * (1.0 - std::cos(phase))); break;
+            }
+        }
+
+        bin_frequency.resize(num_bins);
+        for (size_t k = 0; k < num_bins; ++k) {
+            bin_frequency[k] = static_cast<float>(k * sample_rate / n);
+        }
+
+        // Triangular mel filters evaluated at each bin's exact frequency
+        const size_t num_bands = config.num_mel_bands;
+        auto toMel = [](double hz) { return 2595.0 * std::log10(1.0 + hz / 700.0); };
+        auto toHz = [](double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); };
+
+        const double mel_max = toMel(sample_rate / 2.0);
+        std::vector<double> edges(num_bands + 2);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            edges[i] = toHz(mel_max * static_cast<double>(i) / static_cast<double>(num_bands + 1));
+        }
+
+        mel_bands.resize(num_bands);
+        for (size_t band = 0; band < num_bands; ++band) {
+            const double left = edges[band], center = edges[band + 1], right = edges[band + 2];
+            MelBand& mel = mel_bands[band];
+            mel.first_bin = num_bins;
+
+            for (size_t k = 0; k < num_bins; ++k) {
+                const double f = bin_frequency[k];
+                if (f <= left || f >= right) continue;
+
+                if (mel.first_bin == num_bins) mel.first_bin = k;
+                const double weight = f < center ? (f - left) / (center - left) : (right - f) / (right - center);
+                mel.weights.resize(k - mel.first_bin + 1, 0.0f);
+                mel.weights.back() = static_cast<float>(weight);
+            }
+        }
+
+        dct.resize(MFCC_BINS * num_bands);
+        for (size_t i = 0; i < MFCC_BINS; ++i) {
+            for (size_t j = 0; j < num_bands; ++j) {
+                dct[i * num_bands + j] = static_cast<float>(std::cos(kPi * i * (j + 0.5) / num_bands));
+            }
+        }
+
+        chroma_class.assign(num_bins, -1);
+        for (size_t k = 1; k < num_bins; ++k) {
+            const double f = bin_frequency[k];
+            if (f < 27.5 || f > 5000.0) continue;
+
+            // A4 = 57 semitones above C0, so class 0 is C
+            const long semitone = std::lround(12.0 * std::log2(f / 440.0) + 57.0);
+            chroma_class[k] = static_cast<int>(((semitone % 12) + 12) % 12);
+        }
+    }
+};
+
+// ============================================================================
+// BatchFeatureExtractor
+// ============================================================================
+
+BatchFeatureExtractor::BatchFeatureExtractor() : BatchFeatureExtractor(Config()) {}
+
+BatchFeatureExtractor::BatchFeatureExtractor(const Config& config) : config_(config) {
+    config_.frame_size = std::max<size_t>(2, config_.frame_size);
+    config_.hop_size = std::max<size_t>(1, config_.hop_size);
+    config_.num_mel_bands = std::max<size_t>(1, config_.num_mel_bands);
+    config_.chunk_frames = std::max<size_t>(1, config_.chunk_frames);
+    config_.files_per_batch = std::max<size_t>(1, config_.files_per_batch);
+
+    size_t threads = config_.num_threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    scheduler_ = std::make_unique<performance::threading::WorkStealingScheduler>(threads - 1);
+}
+
+BatchFeatureExtractor::~BatchFeatureExtractor() = default;
+
+const std::vector<std::string>& BatchFeatureExtractor::columnNames() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> result = {
+            "rms", "energy", "zero_crossing_rate", "spectral_centroid",
+            "spectral_rolloff", "spectral_flatness", "spectral_bandwidth"
+        };
+        for (size_t i = 0; i < MFCC_BINS; ++i) result.push_back("mfcc_" + std::to_string(i));
+        for (size_t i = 0; i < CHROMA_BINS; ++i) result.push_back("chroma_" + std::to_string(i));
+        return result;
+    }();
+    return names;
+}
+
+std::shared_ptr<const BatchFeatureExtractor::Tables> BatchFeatureExtractor::getTables(double sample_rate) {
+    std::lock_guard<std::mutex> lock(tables_mutex_);
+
+    auto& tables = tables_[sample_rate];
+    if (!tables) {
+        tables = std::make_shared<const Tables>(config_, sample_rate);
+    }
+    return tables;
+}
+
+void BatchFeatureExtractor::extract(const float* samples, size_t num_samples, double sample_rate,
+                                    FeatureMatrix& features) {
+    features.clear();
+    if (num_samples == 0) return;
+
+    auto tables = getTables(sample_rate);
+
+    if (num_samples < config_.frame_size) {
+        features.values.resize(NUM_COLUMNS);
+        features.num_rows = 1;
+        computeFrame(samples, num_samples, *tables, features.values.data());
+        return;
+    }
+
+    const size_t num_frames = (num_samples - config_.frame_size) / config_.hop_size + 1;
+    appendFrames(samples, num_frames, *tables, features);
+}
+
+void BatchFeatureExtractor::extractBlocks(const std::vector<std::vector<float>>& blocks, double sample_rate,
+                                          FeatureMatrix& features) {
+    auto tables = getTables(sample_rate);
+
+    features.values.resize(blocks.size() * NUM_COLUMNS);
+    features.num_rows = blocks.size();
+
+    scheduler_->parallel_for(0, blocks.size(), kFrameGrain, [&](size_t index) {
+        computeFrame(blocks[index].data(), blocks[index].size(), *tables, features.values.data() + index * NUM_COLUMNS);
+    });
+}
+
+BatchFeatureExtractor::FileResult BatchFeatureExtractor::extractFile(const std::string& path, FeatureMatrix& features) {
+    FileResult result;
+    result.path = path;
+    features.clear();
+
+    WavChunkReader reader;
+    if (!reader.open(path, result.error)) {
+        return result;
+    }
+
+    result.sample_rate = reader.sampleRate();
+    auto tables = getTables(result.sample_rate);
+
+    const size_t frame_size = config_.frame_size;
+    const size_t hop_size = config_.hop_size;
+    const size_t chunk_samples = config_.chunk_frames * hop_size;
+
+    // Holds the unconsumed tail of the previous chunk plus the new one
+    std::vector<float> pending(frame_size + chunk_samples);
+    size_t pending_samples = 0;
+    size_t total_samples = 0;
+
+    while (true) {
+        const size_t read = reader.read(pending.data() + pending_samples, pending.size() - pending_samples);
+        pending_samples += read;
+        total_samples += read;
+
+        if (pending_samples >= frame_size) {
+            const size_t num_frames = (pending_samples - frame_size) / hop_size + 1;
+            appendFrames(pending.data(), num_frames, *tables, features);
+
+            const size_t consumed = std::min(num_frames * hop_size, pending_samples);
+            std::copy(pending.begin() + consumed, pending.begin() + pending_samples, pending.begin());
+            pending_samples -= consumed;
+        }
+
+        if (read == 0) break;
+    }
+
+    if (features.num_rows == 0 && total_samples > 0) {
+        features.values.resize(NUM_COLUMNS);
+        features.num_rows = 1;
+        computeFrame(pending.data(), pending_samples, *tables, features.values.data());
+    }
+
+    result.success = true;
+    result.num_frames = features.num_rows;
+    return result;
+}
+
+std::vector<BatchFeatureExtractor::FileResult> BatchFeatureExtractor::indexFiles(const std::vector<std::string>& paths,
+                                                                                 const std::string& store_path) {
+    std::vector<FileResult> results(paths.size());
+
+    FeatureStoreWriter writer;
+    if (!writer.open(store_path, columnNames())) {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            results[i].path = paths[i];
+            results[i].error = "Cannot create feature store";
+        }
+        return results;
+    }
+
+    std::vector<FeatureMatrix> matrices(config_.files_per_batch);
+
+    for (size_t batch_begin = 0; batch_begin < paths.size(); batch_begin += config_.files_per_batch) {
+        const size_t batch_end = std::min(paths.size(), batch_begin + config_.files_per_batch);
+
+        // Files run concurrently; long files also split their frames further
+        scheduler_->parallel_for(batch_begin, batch_end, 1, [&](size_t index) {
+            results[index] = extractFile(paths[index], matrices[index - batch_begin]);
+        });
+
+        // Written in input order, so the store layout does not depend on timing
+        for (size_t index = batch_begin; index < batch_end; ++index) {
+            const FeatureMatrix& matrix = matrices[index - batch_begin];
+            if (results[index].success && !writer.append(paths[index], matrix.values.data(), matrix.num_rows)) {
+                results[index].success = false;
+                results[index].error = "Feature store write failed";
+            }
+        }
+    }
+
+    writer.close();
+    return results;
+}
+
+// ============================================================================
+// Frame features
+// ============================================================================
+
+void BatchFeatureExtractor::appendFrames(const float* samples, size_t num_frames, const Tables& tables,
+                                         FeatureMatrix& features) {
+    const size_t first_row = features.num_rows;
+    features.num_rows += num_frames;
+    features.values.resize(features.num_rows * NUM_COLUMNS);
+
+    float* rows = features.values.data() + first_row * NUM_COLUMNS;
+
+    scheduler_->parallel_for(0, num_frames, kFrameGrain, [&](size_t frame) {
+        computeFrame(samples + frame * config_.hop_size, config_.frame_size, tables, rows + frame * NUM_COLUMNS);
+    });
+}
+
+void BatchFeatureExtractor::computeFrame(const float* samples, size_t num_samples, const Tables& tables,
+                                         float* row) const {
+    const size_t n = config_.frame_size;
+    const size_t num_bins = n / 2 + 1;
+    const size_t num_bands = tables.mel_bands.size();
+
+    FrameScratch& scratch = threadScratch();
+    scratch.reserve(n, num_bins, num_bands);
+
+    const size_t available = std::min(n, num_samples);
+    for (size_t i = 0; i < available; ++i) {
+        scratch.windowed[i] = samples[i] * tables.window[i];
+    }
+    std::fill(scratch.windowed.begin() + available, scratch.windowed.end(), 0.0f);
+
+    // Temporal features of the windowed frame, as in the real-time analyzer
+    const float* windowed = scratch.windowed.data();
+    size_t zero_crossings = 0;
+    float sum_squares = 0.0f;
+
+    for (size_t i = 0; i < n; ++i) {
+        sum_squares += windowed[i] * windowed[i];
+        if (i > 0 && (windowed[i - 1] >= 0.0f) != (windowed[i] >= 0.0f)) {
+            ++zero_crossings;
+        }
+    }
+
+    row[RMS] = std::sqrt(sum_squares / n);
+    row[ENERGY] = sum_squares;
+    row[ZERO_CROSSING_RATE] = static_cast<float>(zero_crossings) / n;
+
+    // Spectral features
+    tables.fft->forward(windowed, scratch.spectrum.data());
+
+    float* magnitude = scratch.magnitude.data();
+    float magnitude_sum = 0.0f;
+    float weighted_sum = 0.0f;
+    float log_sum = 0.0f;
+
+    for (size_t k = 0; k < num_bins; ++k) {
+        magnitude[k] = std::abs(scratch.spectrum[k]);
+        magnitude_sum += magnitude[k];
+        weighted_sum += tables.bin_frequency[k] * magnitude[k];
+        log_sum += std::log(magnitude[k] + kEpsilon);
+    }
+
+    const float centroid = magnitude_sum > 0.0f ? weighted_sum / magnitude_sum : 0.0f;
+    row[SPECTRAL_CENTROID] = centroid;
+
+    row[SPECTRAL_ROLLOFF] = 0.0f;
+    const float rolloff_threshold = 0.85f * magnitude_sum;
+    float running_sum = 0.0f;
+    for (size_t k = 0; k < num_bins; ++k) {
+        running_sum += magnitude[k];
+        if (running_sum >= rolloff_threshold) {
+            row[SPECTRAL_ROLLOFF] = tables.bin_frequency[k];
+            break;
+        }
+    }
+
+    const float arithmetic_mean = magnitude_sum / num_bins;
+    row[SPECTRAL_FLATNESS] = arithmetic_mean > 0.0f ? std::exp(log_sum / num_bins) / arithmetic_mean : 0.0f;
+
+    float bandwidth_sum = 0.0f;
+    for (size_t k = 0; k < num_bins; ++k) {
+        bandwidth_sum += std::abs(tables.bin_frequency[k] - centroid) * magnitude[k];
+    }
+    row[SPECTRAL_BANDWIDTH] = magnitude_sum > 0.0f ? bandwidth_sum / magnitude_sum : 0.0f;
+
+    // MFCC: log mel power followed by a DCT-II
+    for (size_t band = 0; band < num_bands; ++band) {
+        const auto& mel = tables.mel_bands[band];
+        float energy = 0.0f;
+        for (size_t i = 0; i < mel.weights.size(); ++i) {
+            const float m = magnitude[mel.first_bin + i];
+            energy += mel.weights[i] * m * m;
+        }
+        scratch.mel[band] = std::log(std::max(energy, kEpsilon));
+    }
+
+    for (size_t i = 0; i < MFCC_BINS; ++i) {
+        const float* basis = tables.dct.data() + i * num_bands;
+        float coefficient = 0.0f;
+        for (size_t band = 0; band < num_bands; ++band) {
+            coefficient += basis[band] * scratch.mel[band];
+        }
+        row[MFCC_0 + i] = coefficient;
+    }
+
+    // Chroma
+    float* chroma = row + CHROMA_0;
+    std::fill(chroma, chroma + CHROMA_BINS, 0.0f);
+    float chroma_sum = 0.0f;
+    for (size_t k = 1; k < num_bins; ++k) {
+        const int pitch_class = tables.chroma_class[k];
+        if (pitch_class >= 0) {
+            chroma[pitch_class] += magnitude[k];
+            chroma_sum += magnitude[k];
+        }
+    }
+    if (chroma_sum > 0.0f) {
+        for (size_t i = 0; i < CHROMA_BINS; ++i) {
+            chroma[i] /= chroma_sum;
+        }
+    }
+}
+
+} // namespace vital
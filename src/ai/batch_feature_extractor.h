@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <cstddef>
+
+namespace vital {
+
+namespace performance {
+namespace threading {
+class WorkStealingScheduler;
+} // namespace threading
+} // namespace performance
+
+/**
+ * @class BatchFeatureExtractor
+ * @brief Streaming, multithreaded frame feature extraction for sample libraries
+ *
+ * Files are decoded in chunks of chunk_frames hops, and the frames of each
+ * chunk are spread over a work-stealing pool. indexFiles() also keeps up to
+ * files_per_batch files in flight, so libraries of short samples keep every
+ * core busy. Each worker thread reuses its own scratch buffers and every
+ * sample-rate dependent table (window, mel bank, DCT, chroma map, FFT plan)
+ * is built once, so steady-state extraction does not allocate.
+ *
+ * Each frame yields one row of NUM_COLUMNS floats; see columnNames(). Rows
+ * depend only on the frame, not on scheduling, so output is deterministic.
+ */
+class BatchFeatureExtractor {
+public:
+    struct Config {
+        size_t frame_size = 1024;
+        size_t hop_size = 512;
+        size_t window_type = 1;         // 0: rectangular, 1: hann, 2: hamming, 3: blackman
+        size_t num_mel_bands = 26;
+        size_t num_threads = 0;         // Including the calling thread; 0 uses every core
+        size_t chunk_frames = 256;      // Hops decoded per chunk
+        size_t files_per_batch = 64;    // Files extracted concurrently by indexFiles()
+    };
+
+    static constexpr size_t MFCC_BINS = 13;
+    static constexpr size_t CHROMA_BINS = 12;
+
+    enum Column : size_t {
+        RMS,
+        ENERGY,
+        ZERO_CROSSING_RATE,
+        SPECTRAL_CENTROID,              // Hz
+        SPECTRAL_ROLLOFF,               // Hz, 85% of the magnitude sum
+        SPECTRAL_FLATNESS,
+        SPECTRAL_BANDWIDTH,             // Hz
+        MFCC_0,
+        CHROMA_0 = MFCC_0 + MFCC_BINS,  // Normalised to sum to one
+        NUM_COLUMNS = CHROMA_0 + CHROMA_BINS
+    };
+
+    /** Row-major matrix of num_rows x NUM_COLUMNS features */
+    struct FeatureMatrix {
+        std::vector<float> values;
+        size_t num_rows = 0;
+
+        const float* row(size_t index) const { return values.data() + index * NUM_COLUMNS; }
+        void clear() { values.clear(); num_rows = 0; }
+    };
+
+    struct FileResult {
+        std::string path;
+        bool success = false;
+        std::string error;
+        size_t num_frames = 0;
+        double sample_rate = 0.0;
+    };
+
+    BatchFeatureExtractor();
+    explicit BatchFeatureExtractor(const Config& config);
+    ~BatchFeatureExtractor();
+
+    const Config& getConfig() const { return config_; }
+
+    static const std::vector<std::string>& columnNames();
+
+    /** Every full frame of a mono signal; a shorter signal gives one zero-padded frame */
+    void extract(const float* samples, size_t num_samples, double sample_rate, FeatureMatrix& features);
+
+    /** One row per block, each block zero-padded or truncated to frame_size */
+    void extractBlocks(const std::vector<std::vector<float>>& blocks, double sample_rate, FeatureMatrix& features);
+
+    /** Decode a WAV file chunk by chunk, mixed to mono */
+    FileResult extractFile(const std::string& path, FeatureMatrix& features);
+
+    /** Extract every file and write one store source per file, in input order */
+    std::vector<FileResult> indexFiles(const std::vector<std::string>& paths, const std::string& store_path);
+
+private:
+    struct Tables;
+
+    std::shared_ptr<const Tables> getTables(double sample_rate);
+
+    /** Append num_frames rows for frames starting every hop_size samples */
+    void appendFrames(const float* samples, size_t num_frames, const Tables& tables, FeatureMatrix& features);
+
+    void computeFrame(const float* samples, size_t num_samples, const Tables& tables, float* row) const;
+
+    Config config_;
+    std::unique_ptr<performance::threading::WorkStealingScheduler> scheduler_;
+
+    std::mutex tables_mutex_;
+    std::map<double, std::shared_ptr<const Tables>> tables_;
+};
+
+} // namespace vital
@@ -0,0 +1,272 @@
+#include "feature_store.h"
+#include <algorithm>
+
+namespace vital {
+
+namespace {
+
+template<typename T>
+void writeValue(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readString(std::ifstream& file, std::string& value, size_t length) {
+    value.resize(length);
+    return length == 0 || static_cast<bool>(file.read(value.data(), static_cast<std::streamsize>(length)));
+}
+
+} // namespace
+
+// ============================================================================
+// FeatureStoreWriter
+// ============================================================================
+
+FeatureStoreWriter::~FeatureStoreWriter() {
+    if (file_.is_open()) {
+        close();
+    }
+}
+
+bool FeatureStoreWriter::open(const std::string& file_path, const std::vector<std::string>& column_names,
+                              size_t rows_per_group) {
+    if (file_.is_open()) {
+        close();
+    }
+
+    file_.open(file_path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    column_names_ = column_names;
+    rows_per_group_ = std::max<size_t>(1, rows_per_group);
+    pending_columns_.assign(column_names_.size(), std::vector<float>());
+    for (auto& column : pending_columns_) {
+        column.reserve(rows_per_group_);
+    }
+    pending_rows_ = 0;
+    total_rows_ = 0;
+    groups_.clear();
+    sources_.clear();
+
+    writeValue(file_, MAGIC);
+    writeValue(file_, VERSION);
+    writeValue(file_, static_cast<uint32_t>(column_names_.size()));
+    for (const auto& name : column_names_) {
+        writeValue(file_, static_cast<uint16_t>(name.size()));
+        file_.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+
+    return static_cast<bool>(file_);
+}
+
+bool FeatureStoreWriter::append(const std::string& source, const float* rows, size_t num_rows) {
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    sources_.push_back({source, total_rows_, static_cast<uint32_t>(num_rows)});
+
+    const size_t num_columns = column_names_.size();
+    for (size_t row = 0; row < num_rows; ++row) {
+        const float* values = rows + row * num_columns;
+        for (size_t column = 0; column < num_columns; ++column) {
+            pending_columns_[column].push_back(values[column]);
+        }
+
+        ++total_rows_;
+        if (++pending_rows_ == rows_per_group_ && !flushGroup()) {
+            return false;
+        }
+    }
+
+    return static_cast<bool>(file_);
+}
+
+bool FeatureStoreWriter::flushGroup() {
+    if (pending_rows_ == 0) {
+        return true;
+    }
+
+    groups_.push_back({static_cast<uint64_t>(file_.tellp()), static_cast<uint32_t>(pending_rows_)});
+
+    for (auto& column : pending_columns_) {
+        file_.write(reinterpret_cast<const char*>(column.data()),
+                    static_cast<std::streamsize>(column.size() * sizeof(float)));
+        column.clear();
+    }
+
+    pending_rows_ = 0;
+    return static_cast<bool>(file_);
+}
+
+bool FeatureStoreWriter::close() {
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    bool ok = flushGroup();
+
+    const uint64_t footer_offset = static_cast<uint64_t>(file_.tellp());
+
+    writeValue(file_, static_cast<uint32_t>(groups_.size()));
+    for (const auto& group : groups_) {
+        writeValue(file_, group.offset);
+        writeValue(file_, group.num_rows);
+    }
+
+    writeValue(file_, static_cast<uint32_t>(sources_.size()));
+    for (const auto& source : sources_) {
+        writeValue(file_, static_cast<uint32_t>(source.name.size()));
+        file_.write(source.name.data(), static_cast<std::streamsize>(source.name.size()));
+        writeValue(file_, source.first_row);
+        writeValue(file_, source.num_rows);
+    }
+
+    writeValue(file_, footer_offset);
+    writeValue(file_, MAGIC);
+
+    ok = ok && static_cast<bool>(file_);
+    file_.close();
+    return ok;
+}
+
+// ============================================================================
+// FeatureStoreReader
+// ============================================================================
+
+bool FeatureStoreReader::open(const std::string& file_path) {
+    file_.close();
+    file_.clear();
+    column_names_.clear();
+    groups_.clear();
+    sources_.clear();
+    total_rows_ = 0;
+
+    file_.open(file_path, std::ios::binary);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0, num_columns = 0;
+    if (!readValue(file_, magic) || magic != FeatureStoreWriter::MAGIC ||
+        !readValue(file_, version) || version != FeatureStoreWriter::VERSION ||
+        !readValue(file_, num_columns)) {
+        return false;
+    }
+
+    column_names_.resize(num_columns);
+    for (auto& name : column_names_) {
+        uint16_t length = 0;
+        if (!readValue(file_, length) || !readString(file_, name, length)) {
+            return false;
+        }
+    }
+
+    // Trailer: footer offset followed by the magic
+    uint64_t footer_offset = 0;
+    file_.seekg(-static_cast<std::streamoff>(sizeof(uint64_t) + sizeof(uint32_t)), std::ios::end);
+    if (!readValue(file_, footer_offset) || !readValue(file_, magic) || magic != FeatureStoreWriter::MAGIC) {
+        return false;
+    }
+
+    file_.seekg(static_cast<std::streamoff>(footer_offset));
+
+    uint32_t num_groups = 0;
+    if (!readValue(file_, num_groups)) {
+        return false;
+    }
+
+    groups_.resize(num_groups);
+    for (auto& group : groups_) {
+        if (!readValue(file_, group.offset) || !readValue(file_, group.num_rows)) {
+            return false;
+        }
+        group.first_row = total_rows_;
+        total_rows_ += group.num_rows;
+    }
+
+    uint32_t num_sources = 0;
+    if (!readValue(file_, num_sources)) {
+        return false;
+    }
+
+    sources_.resize(num_sources);
+    for (auto& source : sources_) {
+        uint32_t length = 0;
+        if (!readValue(file_, length) || !readString(file_, source.name, length) ||
+            !readValue(file_, source.first_row) || !readValue(file_, source.num_rows)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int FeatureStoreReader::findColumn(const std::string& name) const {
+    auto it = std::find(column_names_.begin(), column_names_.end(), name);
+    return it != column_names_.end() ? static_cast<int>(it - column_names_.begin()) : -1;
+}
+
+bool FeatureStoreReader::readColumn(size_t column, std::vector<float>& values) {
+    if (!file_.is_open() || column >= column_names_.size()) {
+        return false;
+    }
+
+    values.resize(total_rows_);
+
+    for (const auto& group : groups_) {
+        const uint64_t offset = group.offset + uint64_t(column) * group.num_rows * sizeof(float);
+        file_.seekg(static_cast<std::streamoff>(offset));
+        if (!file_.read(reinterpret_cast<char*>(values.data() + group.first_row),
+                        static_cast<std::streamsize>(group.num_rows * sizeof(float)))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FeatureStoreReader::readRows(uint64_t first_row, size_t num_rows, std::vector<float>& rows) {
+    const size_t num_columns = column_names_.size();
+    if (!file_.is_open() || first_row + num_rows > total_rows_) {
+        return false;
+    }
+
+    rows.resize(num_rows * num_columns);
+    std::vector<float> segment;
+
+    for (const auto& group : groups_) {
+        const uint64_t group_end = group.first_row + group.num_rows;
+        const uint64_t begin = std::max(first_row, group.first_row);
+        const uint64_t end = std::min<uint64_t>(first_row + num_rows, group_end);
+        if (begin >= end) {
+            continue;
+        }
+
+        const size_t count = static_cast<size_t>(end - begin);
+        segment.resize(count);
+
+        for (size_t column = 0; column < num_columns; ++column) {
+            const uint64_t offset = group.offset +
+                (uint64_t(column) * group.num_rows + (begin - group.first_row)) * sizeof(float);
+            file_.seekg(static_cast<std::streamoff>(offset));
+            if (!file_.read(reinterpret_cast<char*>(segment.data()), static_cast<std::streamsize>(count * sizeof(float)))) {
+                return false;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                rows[(begin - first_row + i) * num_columns + column] = segment[i];
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace vital
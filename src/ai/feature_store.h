@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+
+namespace vital {
+
+/**
+ * @class FeatureStoreWriter
+ * @brief Streams per-frame feature rows into a compact columnar file
+ *
+ * Rows are buffered and written in row groups. Inside a group every column
+ * is a contiguous float32 array, so one feature can be read for the whole
+ * library without touching the others. A footer lists the row groups and,
+ * for each source (usually one audio file), its first row and row count.
+ *
+ * Layout (little-endian):
+ *   header   "VFST", version, num_columns, column names
+ *   groups   float32[rows] per column, repeated
+ *   footer   group offsets and row counts, sources
+ *   trailer  footer offset, "VFST"
+ */
+class FeatureStoreWriter {
+public:
+    static constexpr uint32_t MAGIC = 0x54534656; // "VFST"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_ROWS_PER_GROUP = 4096;
+
+    FeatureStoreWriter() = default;
+    ~FeatureStoreWriter();
+
+    bool open(const std::string& file_path, const std::vector<std::string>& column_names,
+              size_t rows_per_group = DEFAULT_ROWS_PER_GROUP);
+
+    /** Append num_rows row-major rows of numColumns() values for one source */
+    bool append(const std::string& source, const float* rows, size_t num_rows);
+
+    /** Flush the last group and write the footer */
+    bool close();
+
+    bool isOpen() const { return file_.is_open(); }
+    size_t numColumns() const { return column_names_.size(); }
+    uint64_t numRows() const { return total_rows_; }
+
+private:
+    struct RowGroup {
+        uint64_t offset;
+        uint32_t num_rows;
+    };
+
+    struct Source {
+        std::string name;
+        uint64_t first_row;
+        uint32_t num_rows;
+    };
+
+    bool flushGroup();
+
+    std::ofstream file_;
+    std::vector<std::string> column_names_;
+    size_t rows_per_group_ = DEFAULT_ROWS_PER_GROUP;
+
+    std::vector<std::vector<float>> pending_columns_;
+    size_t pending_rows_ = 0;
+    uint64_t total_rows_ = 0;
+
+    std::vector<RowGroup> groups_;
+    std::vector<Source> sources_;
+};
+
+/**
+ * @class FeatureStoreReader
+ * @brief Random access to a file written by FeatureStoreWriter
+ */
+class FeatureStoreReader {
+public:
+    struct Source {
+        std::string name;
+        uint64_t first_row;
+        uint32_t num_rows;
+    };
+
+    bool open(const std::string& file_path);
+
+    const std::vector<std::string>& columnNames() const { return column_names_; }
+    const std::vector<Source>& sources() const { return sources_; }
+    uint64_t numRows() const { return total_rows_; }
+
+    /** Index of a column by name, or -1 */
+    int findColumn(const std::string& name) const;
+
+    /** One column over all rows */
+    bool readColumn(size_t column, std::vector<float>& values);
+
+    /** Rows [first_row, first_row + num_rows) as a row-major matrix */
+    bool readRows(uint64_t first_row, size_t num_rows, std::vector<float>& rows);
+
+private:
+    struct RowGroup {
+        uint64_t offset;
+        uint32_t num_rows;
+        uint64_t first_row;
+    };
+
+    std::ifstream file_;
+    std::vector<std::string> column_names_;
+    std::vector<RowGroup> groups_;
+    std::vector<Source> sources_;
+    uint64_t total_rows_ = 0;
+};
+
+} // namespace vital
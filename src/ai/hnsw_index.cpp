@@ -0,0 +1,492 @@
+#include "hnsw_index.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <queue>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define VITAL_HNSW_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VITAL_HNSW_NEON 1
+#endif
+
+namespace vital {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x534E4856; // "VHNS"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kVectorPadding = 8;
+
+/** Squared L2 distance; size is a multiple of kVectorPadding */
+float squaredDistance(const float* a, const float* b, size_t size) {
+    size_t i = 0;
+    float total = 0.0f;
+
+#if defined(__AVX__)
+    __m256 sum8 = _mm256_setzero_ps();
+    for (; i + 8 <= size; i += 8) {
+        const __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(diff, diff));
+    }
+    const __m128 folded = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+    alignas(16) float lanes8[4];
+    _mm_store_ps(lanes8, folded);
+    total = (lanes8[0] + lanes8[1]) + (lanes8[2] + lanes8[3]);
+#endif
+
+#if VITAL_HNSW_SSE
+    __m128 sum4 = _mm_setzero_ps();
+    for (; i + 4 <= size; i += 4) {
+        const __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        sum4 = _mm_add_ps(sum4, _mm_mul_ps(diff, diff));
+    }
+    alignas(16) float lanes4[4];
+    _mm_store_ps(lanes4, sum4);
+    total += (lanes4[0] + lanes4[1]) + (lanes4[2] + lanes4[3]);
+#elif VITAL_HNSW_NEON
+    float32x4_t sum4 = vdupq_n_f32(0.0f);
+    for (; i + 4 <= size; i += 4) {
+        const float32x4_t diff = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        sum4 = vmlaq_f32(sum4, diff, diff);
+    }
+    float32x2_t pair = vadd_f32(vget_low_f32(sum4), vget_high_f32(sum4));
+    total += vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+
+    for (; i < size; ++i) {
+        const float diff = a[i] - b[i];
+        total += diff * diff;
+    }
+
+    return total;
+}
+
+/** Per-thread visited marks; a generation counter avoids clearing per query */
+struct VisitedList {
+    std::vector<uint32_t> marks;
+    uint32_t generation = 0;
+
+    void prepare(size_t size) {
+        if (marks.size() < size) {
+            marks.resize(size, 0);
+        }
+        if (++generation == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool visit(uint32_t id) {
+        if (marks[id] == generation) return false;
+        marks[id] = generation;
+        return true;
+    }
+};
+
+VisitedList& threadVisitedList() {
+    thread_local VisitedList visited;
+    return visited;
+}
+
+template<typename T>
+void writeValue(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+HNSWIndex::HNSWIndex() : HNSWIndex(Config()) {}
+
+HNSWIndex::HNSWIndex(const Config& config) {
+    reset(config);
+}
+
+void HNSWIndex::reset(const Config& config) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    config_ = config;
+    config_.max_neighbors = std::max<size_t>(2, config_.max_neighbors);
+    config_.ef_construction = std::max(config_.ef_construction, config_.max_neighbors);
+    config_.ef_search = std::max<size_t>(1, config_.ef_search);
+
+    padded_dimension_ = (config_.dimension + kVectorPadding - 1) / kVectorPadding * kVectorPadding;
+    level_multiplier_ = 1.0 / std::log(static_cast<double>(config_.max_neighbors));
+
+    vectors_.clear();
+    links_.clear();
+    removed_.clear();
+    num_removed_ = 0;
+    entry_point_ = 0;
+    max_level_ = -1;
+    rng_.seed(config_.seed);
+}
+
+float HNSWIndex::distance(const float* a, const float* b) const {
+    return squaredDistance(a, b, padded_dimension_);
+}
+
+int HNSWIndex::randomLevel() {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double u = std::max(uniform(rng_), 1e-12);
+    return static_cast<int>(-std::log(u) * level_multiplier_);
+}
+
+// ============================================================================
+// Insertion
+// ============================================================================
+
+size_t HNSWIndex::add(const float* vector) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    const uint32_t id = static_cast<uint32_t>(links_.size());
+    const int level = randomLevel();
+
+    vectors_.resize(vectors_.size() + padded_dimension_, 0.0f);
+    std::copy(vector, vector + config_.dimension, vectors_.end() - padded_dimension_);
+    links_.emplace_back(static_cast<size_t>(level) + 1);
+    removed_.push_back(0);
+
+    if (max_level_ < 0) {
+        entry_point_ = id;
+        max_level_ = level;
+        return id;
+    }
+
+    const float* query = vectorAt(id);
+    std::vector<Candidate> entry_points = {{distance(query, vectorAt(entry_point_)), entry_point_}};
+    std::vector<Candidate> candidates;
+
+    // Greedy descent through the layers above the new node's top layer
+    for (int layer = max_level_; layer > level; --layer) {
+        searchLayer(query, entry_points, 1, layer, candidates);
+        entry_points.assign(1, candidates.front());
+    }
+
+    for (int layer = std::min(level, max_level_); layer >= 0; --layer) {
+        searchLayer(query, entry_points, config_.ef_construction, layer, candidates);
+        entry_points = candidates;
+
+        selectNeighbors(candidates, config_.max_neighbors);
+        linkNode(id, layer, candidates);
+    }
+
+    if (level > max_level_) {
+        max_level_ = level;
+        entry_point_ = id;
+    }
+
+    return id;
+}
+
+void HNSWIndex::linkNode(uint32_t id, int level, const std::vector<Candidate>& neighbors) {
+    auto& own_links = links_[id][static_cast<size_t>(level)];
+    own_links.clear();
+    for (const auto& neighbor : neighbors) {
+        own_links.push_back(neighbor.id);
+    }
+
+    const size_t max_links = maxLinks(level);
+    std::vector<Candidate> pruned;
+
+    for (const auto& neighbor : neighbors) {
+        auto& links = links_[neighbor.id][static_cast<size_t>(level)];
+        links.push_back(id);
+
+        if (links.size() <= max_links) continue;
+
+        // Over capacity: re-select the neighbour's links with the same heuristic
+        const float* base = vectorAt(neighbor.id);
+        pruned.clear();
+        for (uint32_t link : links) {
+            pruned.push_back({distance(base, vectorAt(link)), link});
+        }
+        std::sort(pruned.begin(), pruned.end());
+        selectNeighbors(pruned, max_links);
+
+        links.clear();
+        for (const auto& kept : pruned) {
+            links.push_back(kept.id);
+        }
+    }
+}
+
+void HNSWIndex::selectNeighbors(std::vector<Candidate>& candidates, size_t m) const {
+    if (candidates.size() <= m) return;
+
+    std::vector<Candidate> selected;
+    selected.reserve(m);
+
+    for (const auto& candidate : candidates) {
+        if (selected.size() >= m) break;
+
+        const float* vector = vectorAt(candidate.id);
+        bool diverse = true;
+        for (const auto& kept : selected) {
+            if (distance(vector, vectorAt(kept.id)) < candidate.distance) {
+                diverse = false;
+                break;
+            }
+        }
+
+        if (diverse) {
+            selected.push_back(candidate);
+        }
+    }
+
+    candidates.swap(selected);
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+void HNSWIndex::searchLayer(const float* query, const std::vector<Candidate>& entry_points, size_t ef, int level,
+                            std::vector<Candidate>& result) const {
+    VisitedList& visited = threadVisitedList();
+    visited.prepare(links_.size());
+
+    // Closest unexpanded candidate first; furthest kept result on top
+    auto closer = [](const Candidate& a, const Candidate& b) { return a.distance > b.distance; };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(closer)> frontier(closer);
+    std::priority_queue<Candidate> nearest;
+
+    for (const auto& entry : entry_points) {
+        if (visited.visit(entry.id)) {
+            frontier.push(entry);
+            nearest.push(entry);
+            if (nearest.size() > ef) nearest.pop();
+        }
+    }
+
+    while (!frontier.empty()) {
+        const Candidate current = frontier.top();
+        if (nearest.size() >= ef && current.distance > nearest.top().distance) break;
+        frontier.pop();
+
+        const auto& layer_links = links_[current.id];
+        if (static_cast<size_t>(level) >= layer_links.size()) continue;
+
+        for (uint32_t neighbor : layer_links[static_cast<size_t>(level)]) {
+            if (!visited.visit(neighbor)) continue;
+
+            const float d = distance(query, vectorAt(neighbor));
+            if (nearest.size() < ef || d < nearest.top().distance) {
+                frontier.push({d, neighbor});
+                nearest.push({d, neighbor});
+                if (nearest.size() > ef) nearest.pop();
+            }
+        }
+    }
+
+    result.resize(nearest.size());
+    for (size_t i = result.size(); i-- > 0;) {
+        result[i] = nearest.top();
+        nearest.pop();
+    }
+}
+
+std::vector<HNSWIndex::Result> HNSWIndex::search(const float* query, size_t k, size_t ef) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::vector<Result> results;
+    if (max_level_ < 0 || k == 0) return results;
+
+    std::vector<float> padded(padded_dimension_, 0.0f);
+    std::copy(query, query + config_.dimension, padded.begin());
+
+    // Removed vectors still route the search, so widen it to keep k live results
+    const size_t width = std::max(ef > 0 ? ef : config_.ef_search, k + std::min(num_removed_, k));
+
+    std::vector<Candidate> entry_points = {{distance(padded.data(), vectorAt(entry_point_)), entry_point_}};
+    std::vector<Candidate> candidates;
+
+    for (int layer = max_level_; layer > 0; --layer) {
+        searchLayer(padded.data(), entry_points, 1, layer, candidates);
+        entry_points.assign(1, candidates.front());
+    }
+
+    searchLayer(padded.data(), entry_points, width, 0, candidates);
+
+    for (const auto& candidate : candidates) {
+        if (removed_[candidate.id]) continue;
+        results.push_back({candidate.id, candidate.distance});
+        if (results.size() == k) break;
+    }
+
+    return results;
+}
+
+// ============================================================================
+// Maintenance
+// ============================================================================
+
+void HNSWIndex::remove(size_t id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (id < removed_.size() && !removed_[id]) {
+        removed_[id] = 1;
+        ++num_removed_;
+    }
+}
+
+bool HNSWIndex::isRemoved(size_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id >= removed_.size() || removed_[id] != 0;
+}
+
+void HNSWIndex::setEfSearch(size_t ef) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    config_.ef_search = std::max<size_t>(1, ef);
+}
+
+size_t HNSWIndex::getEfSearch() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return config_.ef_search;
+}
+
+size_t HNSWIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return links_.size();
+}
+
+size_t HNSWIndex::numRemoved() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return num_removed_;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+bool HNSWIndex::save(const std::string& file_path) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    writeValue(file, kMagic);
+    writeValue(file, kVersion);
+    writeValue(file, static_cast<uint64_t>(config_.dimension));
+    writeValue(file, static_cast<uint64_t>(config_.max_neighbors));
+    writeValue(file, static_cast<uint64_t>(config_.ef_construction));
+    writeValue(file, static_cast<uint64_t>(config_.ef_search));
+    writeValue(file, config_.seed);
+    writeValue(file, static_cast<uint64_t>(links_.size()));
+    writeValue(file, entry_point_);
+    writeValue(file, static_cast<int32_t>(max_level_));
+
+    for (uint32_t id = 0; id < links_.size(); ++id) {
+        file.write(reinterpret_cast<const char*>(vectorAt(id)),
+                   static_cast<std::streamsize>(config_.dimension * sizeof(float)));
+        writeValue(file, removed_[id]);
+        writeValue(file, static_cast<uint32_t>(links_[id].size()));
+
+        for (const auto& level_links : links_[id]) {
+            writeValue(file, static_cast<uint32_t>(level_links.size()));
+            file.write(reinterpret_cast<const char*>(level_links.data()),
+                       static_cast<std::streamsize>(level_links.size() * sizeof(uint32_t)));
+        }
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool HNSWIndex::load(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t magic = 0, version = 0, entry_point = 0;
+    uint64_t dimension = 0, max_neighbors = 0, ef_construction = 0, ef_search = 0, count = 0;
+    int32_t max_level = -1;
+    Config config;
+
+    if (!readValue(file, magic) || magic != kMagic || !readValue(file, version) || version != kVersion ||
+        !readValue(file, dimension) || !readValue(file, max_neighbors) || !readValue(file, ef_construction) ||
+        !readValue(file, ef_search) || !readValue(file, config.seed) || !readValue(file, count) ||
+        !readValue(file, entry_point) || !readValue(file, max_level)) {
+        return false;
+    }
+
+    config.dimension = static_cast<size_t>(dimension);
+    config.max_neighbors = static_cast<size_t>(max_neighbors);
+    config.ef_construction = static_cast<size_t>(ef_construction);
+    config.ef_search = static_cast<size_t>(ef_search);
+
+    // Load into a fresh index so a truncated file leaves this one untouched
+    HNSWIndex loaded(config);
+    loaded.vectors_.assign(static_cast<size_t>(count) * loaded.padded_dimension_, 0.0f);
+    loaded.links_.resize(static_cast<size_t>(count));
+    loaded.removed_.resize(static_cast<size_t>(count));
+
+    for (size_t id = 0; id < count; ++id) {
+        float* vector = loaded.vectors_.data() + id * loaded.padded_dimension_;
+        uint32_t num_levels = 0;
+
+        if (!file.read(reinterpret_cast<char*>(vector), static_cast<std::streamsize>(config.dimension * sizeof(float))) ||
+            !readValue(file, loaded.removed_[id]) || !readValue(file, num_levels)) {
+            return false;
+        }
+
+        loaded.num_removed_ += loaded.removed_[id] ? 1 : 0;
+        loaded.links_[id].resize(num_levels);
+
+        for (auto& level_links : loaded.links_[id]) {
+            uint32_t num_links = 0;
+            if (!readValue(file, num_links)) return false;
+
+            level_links.resize(num_links);
+            if (!file.read(reinterpret_cast<char*>(level_links.data()),
+                           static_cast<std::streamsize>(num_links * sizeof(uint32_t)))) {
+                return false;
+            }
+
+            for (uint32_t link : level_links) {
+                if (link >= count) return false;
+            }
+        }
+    }
+
+    if (count > 0) {
+        // Search descends from max_level at the entry point, so that level has to exist there
+        if (entry_point >= count || max_level < 0 ||
+            static_cast<size_t>(max_level) >= loaded.links_[entry_point].size()) {
+            return false;
+        }
+
+        // A level-L link is followed at level L, so its target must have a level L too
+        for (const auto& node_links : loaded.links_) {
+            for (size_t level = 0; level < node_links.size(); ++level) {
+                for (uint32_t link : node_links[level]) {
+                    if (loaded.links_[link].size() <= level) return false;
+                }
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    config_ = loaded.config_;
+    padded_dimension_ = loaded.padded_dimension_;
+    level_multiplier_ = loaded.level_multiplier_;
+    vectors_ = std::move(loaded.vectors_);
+    links_ = std::move(loaded.links_);
+    removed_ = std::move(loaded.removed_);
+    num_removed_ = loaded.num_removed_;
+    entry_point_ = entry_point;
+    max_level_ = count > 0 ? max_level : -1;
+    rng_.seed(config_.seed + static_cast<uint32_t>(count));
+    return true;
+}
+
+} // namespace vital
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <random>
+#include <shared_mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace vital {
+
+/**
+ * @class HNSWIndex
+ * @brief Approximate nearest-neighbour index over fixed-size float vectors
+ *
+ * Hierarchical navigable small world graph (Malkov & Yashunin). Each vector
+ * gets a random top layer; a query descends greedily through the sparse
+ * upper layers and then runs a best-first search of width ef on layer 0,
+ * so lookups cost roughly O(log n) distance evaluations.
+ *
+ * Recall and latency are traded with ef_search (per query or as default),
+ * build quality with max_neighbors and ef_construction. Distances are
+ * squared L2 over vectors padded to a multiple of eight floats, evaluated
+ * with SIMD kernels.
+ *
+ * Inserts are incremental. remove() only marks a vector as deleted: it is
+ * still used to route searches but never returned. Searches may run
+ * concurrently with each other; inserts and removals are exclusive.
+ */
+class HNSWIndex {
+public:
+    struct Config {
+        size_t dimension = 0;
+        size_t max_neighbors = 16;      // M; layer 0 keeps 2 * M
+        size_t ef_construction = 200;   // Candidate list width while inserting
+        size_t ef_search = 64;          // Default candidate list width for queries
+        uint32_t seed = 42;
+    };
+
+    struct Result {
+        size_t id;
+        float distance;                 // Squared L2
+    };
+
+    HNSWIndex();
+    explicit HNSWIndex(const Config& config);
+
+    /** Drop every vector and start over with a new configuration */
+    void reset(const Config& config);
+
+    /** Insert a vector of dimension() floats and return its id (ids are sequential) */
+    size_t add(const float* vector);
+
+    /** Soft-delete an id */
+    void remove(size_t id);
+
+    /** Up to k nearest live vectors, closest first. ef = 0 uses ef_search. */
+    std::vector<Result> search(const float* query, size_t k, size_t ef = 0) const;
+
+    void setEfSearch(size_t ef);
+    size_t getEfSearch() const;
+
+    size_t size() const;
+    size_t numRemoved() const;
+    size_t dimension() const { return config_.dimension; }
+    bool isRemoved(size_t id) const;
+
+    bool save(const std::string& file_path) const;
+    bool load(const std::string& file_path);
+
+private:
+    struct Candidate {
+        float distance;
+        uint32_t id;
+
+        bool operator<(const Candidate& other) const { return distance < other.distance; }
+    };
+
+    const float* vectorAt(uint32_t id) const { return vectors_.data() + size_t(id) * padded_dimension_; }
+    float distance(const float* a, const float* b) const;
+
+    int randomLevel();
+    size_t maxLinks(int level) const { return level == 0 ? 2 * config_.max_neighbors : config_.max_neighbors; }
+
+    /** Best-first search of one layer; returns up to ef candidates, closest first */
+    void searchLayer(const float* query, const std::vector<Candidate>& entry_points, size_t ef, int level,
+                     std::vector<Candidate>& result) const;
+
+    /** Keep up to m candidates that are closer to the base than to any kept neighbour */
+    void selectNeighbors(std::vector<Candidate>& candidates, size_t m) const;
+
+    void linkNode(uint32_t id, int level, const std::vector<Candidate>& neighbors);
+
+    Config config_;
+    size_t padded_dimension_ = 0;
+    double level_multiplier_ = 0.0;
+
+    std::vector<float> vectors_;
+    std::vector<std::vector<std::vector<uint32_t>>> links_;    // Node, level, neighbours
+    std::vector<uint8_t> removed_;
+    size_t num_removed_ = 0;
+
+    uint32_t entry_point_ = 0;
+    int max_level_ = -1;
+    std::mt19937 rng_;
+
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace vital
@@ -1,4 +1,5 @@
 #include "intelligent_audio_analyzer.h"
+#include "real_fft.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -10,7 +11,8 @@
 namespace vital {
 
 IntelligentAudioAnalyzer::IntelligentAudioAnalyzer(AIManager* ai_manager) 
-    : ai_manager_(ai_manager), real_time_monitoring_active_(false) {
+    : ai_manager_(ai_manager), training_index_(similarityIndexConfig()),
+      similarity_index_(similarityIndexConfig()), real_time_monitoring_active_(false) {
     
     // Default configuration
     config_.sample_rate = 44100;
@@ -52,6 +54,11 @@ void IntelligentAudioAnalyzer::setAnalysisConfig(const AnalysisConfig& config) {
     // Update dependent components
     window_ = generateWindow(config_.frame_size, config_.window_type);
     
+    {
+        std::lock_guard<std::mutex> lock(processing_mutex_);
+        batch_extractor_.reset();
+    }
+    
     if (ai_manager_) {
         ai_manager_->recordEvent(AIManager::FeatureType::AudioAnalysis, "Analysis config updated");
     }
@@ -153,6 +160,111 @@ IntelligentAudioAnalyzer::AudioFeatures IntelligentAudioAnalyzer::analyzeAudioIn
     return features;
 }
 
+// Batch processing
+std::vector<IntelligentAudioAnalyzer::AudioFeatures> IntelligentAudioAnalyzer::analyzeBatch(
+    const std::vector<std::vector<float>>& audio_blocks) {
+    std::vector<AudioFeatures> results;
+    results.reserve(audio_blocks.size());
+    
+    BatchFeatureExtractor::FeatureMatrix matrix;
+    {
+        std::lock_guard<std::mutex> lock(processing_mutex_);
+        getBatchExtractor().extractBlocks(audio_blocks, static_cast<double>(config_.sample_rate), matrix);
+    }
+    
+    for (size_t i = 0; i < matrix.num_rows; ++i) {
+        results.push_back(featuresFromRow(matrix.row(i)));
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.total_audio_blocks_processed += audio_blocks.size();
+        stats_.total_features_extracted += audio_blocks.size();
+    }
+    
+    return results;
+}
+
+IntelligentAudioAnalyzer::AudioFeatures IntelligentAudioAnalyzer::analyzeAudioFile(const std::string& file_path) {
+    BatchFeatureExtractor::FeatureMatrix matrix;
+    BatchFeatureExtractor::FileResult result;
+    {
+        std::lock_guard<std::mutex> lock(processing_mutex_);
+        result = getBatchExtractor().extractFile(file_path, matrix);
+    }
+    
+    if (!result.success || matrix.num_rows == 0) {
+        if (ai_manager_) {
+            ai_manager_->recordEvent(AIManager::FeatureType::AudioAnalysis,
+                "File analysis failed: " + file_path + " (" + result.error + ")");
+        }
+        AudioFeatures empty;
+        empty.clear();
+        return empty;
+    }
+    
+    // Whole-file features are the mean over all frames
+    std::vector<float> mean(BatchFeatureExtractor::NUM_COLUMNS, 0.0f);
+    for (size_t i = 0; i < matrix.num_rows; ++i) {
+        const float* row = matrix.row(i);
+        for (size_t column = 0; column < mean.size(); ++column) {
+            mean[column] += row[column];
+        }
+    }
+    for (float& value : mean) {
+        value /= static_cast<float>(matrix.num_rows);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.total_audio_blocks_processed += matrix.num_rows;
+        stats_.total_features_extracted += 1;
+    }
+    
+    return featuresFromRow(mean.data());
+}
+
+BatchFeatureExtractor& IntelligentAudioAnalyzer::getBatchExtractor() {
+    if (!batch_extractor_) {
+        BatchFeatureExtractor::Config extractor_config;
+        extractor_config.frame_size = config_.frame_size;
+        extractor_config.hop_size = config_.hop_size;
+        extractor_config.window_type = config_.window_type;
+        batch_extractor_ = std::make_unique<BatchFeatureExtractor>(extractor_config);
+    }
+    return *batch_extractor_;
+}
+
+IntelligentAudioAnalyzer::AudioFeatures IntelligentAudioAnalyzer::featuresFromRow(const float* row) const {
+    using Column = BatchFeatureExtractor::Column;
+    
+    AudioFeatures features;
+    features.clear();
+    
+    features.rms = row[Column::RMS];
+    features.energy = row[Column::ENERGY];
+    features.zero_crossing_rate = row[Column::ZERO_CROSSING_RATE];
+    features.spectral_centroid = row[Column::SPECTRAL_CENTROID];
+    features.spectral_rolloff = row[Column::SPECTRAL_ROLLOFF];
+    features.spectral_flatness = row[Column::SPECTRAL_FLATNESS];
+    features.spectral_bandwidth = row[Column::SPECTRAL_BANDWIDTH];
+    
+    if (config_.enable_mfcc) {
+        features.mfcc.assign(row + Column::MFCC_0, row + Column::MFCC_0 + BatchFeatureExtractor::MFCC_BINS);
+    }
+    if (config_.enable_chroma) {
+        features.chroma.assign(row + Column::CHROMA_0, row + Column::CHROMA_0 + BatchFeatureExtractor::CHROMA_BINS);
+    }
+    
+    // Same perceptual mapping as extractPerceptualFeatures
+    features.brightness = features.spectral_centroid / (config_.sample_rate / 2.0f);
+    features.warmth = 1.0f - features.brightness;
+    features.clarity = 1.0f - features.spectral_flatness;
+    features.roughness = features.spectral_centroid > 0.0f ? features.spectral_bandwidth / features.spectral_centroid : 0.0f;
+    
+    return features;
+}
+
 // Classification
 IntelligentAudioAnalyzer::ClassificationResult IntelligentAudioAnalyzer::classifyAudio(const AudioFeatures& features) {
     ClassificationResult result;
@@ -496,25 +608,17 @@ void IntelligentAudioAnalyzer::extractPerceptualFeatures(const AudioFeatures& fe
 
 // Classification algorithms
 IntelligentAudioAnalyzer::AudioClass IntelligentAudioAnalyzer::classifyKNN(const AudioFeatures& features, size_t k) {
+    std::lock_guard<std::mutex> lock(history_mutex_);
     if (training_data_.size() < k) return AudioClass::Unknown;
     
-    // Calculate distances to all training samples
-    std::vector<std::pair<float, AudioClass>> distances;
-    distances.reserve(training_data_.size());
-    
-    for (const auto& [train_features, label] : training_data_) {
-        float distance = compareFeatures(features, train_features);
-        distances.emplace_back(distance, label);
-    }
-    
-    // Sort by distance
-    std::partial_sort(distances.begin(), distances.begin() + k, distances.end(),
-                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    // Approximate k nearest training samples from the HNSW index
+    const auto query = similarityVector(features);
+    const auto neighbors = training_index_.search(query.data(), k);
     
     // Vote on k nearest neighbors
     std::map<AudioClass, int> votes;
-    for (size_t i = 0; i < k; ++i) {
-        votes[distances[i].second]++;
+    for (const auto& neighbor : neighbors) {
+        votes[training_data_[neighbor.id - training_index_base_].second]++;
     }
     
     // Find majority class
@@ -580,6 +684,72 @@ float IntelligentAudioAnalyzer::compareFeatures(const AudioFeatures& a, const Au
     return std::sqrt(distance);
 }
 
+std::vector<size_t> IntelligentAudioAnalyzer::findSimilarAudio(const AudioFeatures& query, size_t num_results) {
+    const auto vector = similarityVector(query);
+    const auto neighbors = similarity_index_.search(vector.data(), num_results);
+    
+    std::vector<size_t> ids;
+    ids.reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+        ids.push_back(neighbor.id);
+    }
+    
+    return ids;
+}
+
+// Nearest-neighbour indexing
+std::array<float, IntelligentAudioAnalyzer::SIMILARITY_DIMENSIONS>
+IntelligentAudioAnalyzer::similarityVector(const AudioFeatures& features) {
+    // Squared L2 between these equals compareFeatures squared
+    return {features.spectral_centroid, features.spectral_rolloff, features.spectral_flatness,
+            features.energy, features.rms};
+}
+
+HNSWIndex::Config IntelligentAudioAnalyzer::similarityIndexConfig() {
+    HNSWIndex::Config config;
+    config.dimension = SIMILARITY_DIMENSIONS;
+    config.max_neighbors = 12;
+    config.ef_construction = 100;
+    config.ef_search = 48;
+    return config;
+}
+
+size_t IntelligentAudioAnalyzer::addToSimilarityIndex(const AudioFeatures& features) {
+    const auto vector = similarityVector(features);
+    return similarity_index_.add(vector.data());
+}
+
+bool IntelligentAudioAnalyzer::saveSimilarityIndex(const std::string& file_path) const {
+    return similarity_index_.save(file_path);
+}
+
+bool IntelligentAudioAnalyzer::loadSimilarityIndex(const std::string& file_path) {
+    if (!similarity_index_.load(file_path)) {
+        return false;
+    }
+    
+    if (similarity_index_.dimension() != SIMILARITY_DIMENSIONS) {
+        similarity_index_.reset(similarityIndexConfig());
+        return false;
+    }
+    return true;
+}
+
+void IntelligentAudioAnalyzer::setSimilaritySearchWidth(size_t ef) {
+    similarity_index_.setEfSearch(ef);
+    training_index_.setEfSearch(ef);
+}
+
+void IntelligentAudioAnalyzer::rebuildTrainingIndex() {
+    training_index_.reset(similarityIndexConfig());
+    training_index_base_ = 0;
+    
+    for (const auto& [features, label] : training_data_) {
+        const auto vector = similarityVector(features);
+        training_index_.add(vector.data());
+    }
+}
+
 // Learning
 void IntelligentAudioAnalyzer::learnFromUserFeedback(const AudioFeatures& features, AudioClass correct_class) {
     if (!config_.enable_learning) return;
@@ -587,10 +757,18 @@ void IntelligentAudioAnalyzer::learnFromUserFeedback(const AudioFeatures& featur
     {
         std::lock_guard<std::mutex> lock(history_mutex_);
         training_data_.push_back({features, correct_class});
+        const auto vector = similarityVector(features);
+        training_index_.add(vector.data());
         
         // Keep only recent training data
         if (training_data_.size() > 1000) {
             training_data_.erase(training_data_.begin());
+            training_index_.remove(training_index_base_++);
+            
+            // Evicted nodes still cost search time; compact once they outnumber live ones
+            if (training_index_.numRemoved() > training_data_.size()) {
+                rebuildTrainingIndex();
+            }
         }
     }
     
@@ -629,9 +807,16 @@ void IntelligentAudioAnalyzer::resetStats() {
         std::lock_guard<std::mutex> lock2(history_mutex_);
         feature_history_.clear();
         training_data_.clear();
+        rebuildTrainingIndex();
     }
 }
 
+void IntelligentAudioAnalyzer::resetClassificationModel() {
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    training_data_.clear();
+    rebuildTrainingIndex();
+}
+
 // Utility functions
 std::vector<float> IntelligentAudioAnalyzer::applyWindow(const std::vector<float>& audio_block, size_t window_type) {
     std::vector<float> windowed = audio_block;
@@ -787,21 +972,13 @@ void IntelligentAudioAnalyzer::optimizeForAccuracy() {
     config_.feature_smoothing = 0.05f; // Less aggressive smoothing
 }
 
-// FFT implementation (simplified)
+// FFT via the shared planned real FFT; input is zero-padded to a power of two
 void IntelligentAudioAnalyzer::performFFT(const std::vector<float>& input, std::vector<std::complex<float>>& output) {
-    size_t n = getNextPowerOfTwo(input.size());
-    output.resize(n);
-    
-    // Simplified FFT implementation
-    for (size_t k = 0; k < n; ++k) {
-        std::complex<float> sum(0.0f, 0.0f);
-        for (size_t j = 0; j < n; ++j) {
-            float angle = -2.0f * M_PI * k * j / n;
-            std::complex<float> w(std::cos(angle), std::sin(angle));
-            sum += input[j] * w;
-        }
-        output[k] = sum;
-    }
+    RealFFT::plan(getNextPowerOfTwo(input.size()))->forwardFull(input, output);
+}
+
+void IntelligentAudioAnalyzer::performIFFT(const std::vector<std::complex<float>>& input, std::vector<float>& output) {
+    RealFFT::plan(input.size())->inverseFull(input, output);
 }
 
 size_t IntelligentAudioAnalyzer::getNextPowerOfTwo(size_t n) {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ai_manager.h"
+#include "batch_feature_extractor.h"
+#include "hnsw_index.h"
 #include <vector>
 #include <array>
 #include <complex>
@@ -8,6 +10,7 @@
 #include <queue>
 #include <atomic>
 #include <functional>
+#include <memory>
 
 namespace vital {
 
@@ -154,7 +157,7 @@ public:
     AudioFeatures analyzeAudio(const std::vector<float>& audio_block);
     AudioFeatures analyzeAudioInRealTime(const std::vector<float>& audio_block);
     
-    // Batch processing
+    // Batch processing (multithreaded, see BatchFeatureExtractor)
     std::vector<AudioFeatures> analyzeBatch(const std::vector<std::vector<float>>& audio_blocks);
     AudioFeatures analyzeAudioFile(const std::string& file_path);
     
@@ -190,6 +193,13 @@ public:
     std::vector<float> calculateFeatureDistance(const AudioFeatures& a, const AudioFeatures& b);
     std::vector<size_t> findSimilarAudio(const AudioFeatures& query, size_t num_results);
     
+    // Similarity index (HNSW over the compareFeatures terms)
+    static constexpr size_t SIMILARITY_DIMENSIONS = 5;
+    size_t addToSimilarityIndex(const AudioFeatures& features);     // Returns the id findSimilarAudio reports
+    bool saveSimilarityIndex(const std::string& file_path) const;
+    bool loadSimilarityIndex(const std::string& file_path);
+    void setSimilaritySearchWidth(size_t ef);                       // Higher is more accurate, slower
+    
     // Musical intelligence
     float estimateTempo(const std::vector<float>& audio_block);
     std::vector<float> estimateKey(const AudioFeatures& features);
@@ -252,7 +262,7 @@ public:
     std::vector<float> generateMelFilterBank(size_t num_filters, size_t fft_size, float sample_rate);
     
 private:
-    // FFT implementation (simplified Cooley-Tukey)
+    // FFT (shared planned real FFT, see real_fft.h)
     void performFFT(const std::vector<float>& input, std::vector<std::complex<float>>& output);
     void performIFFT(const std::vector<std::complex<float>>& input, std::vector<float>& output);
     
@@ -260,6 +270,10 @@ private:
     std::vector<float> generateWindow(size_t size, size_t window_type);
     float calculateWindowCorrection(size_t size, size_t window_type);
     
+    // Batch extraction
+    BatchFeatureExtractor& getBatchExtractor();
+    AudioFeatures featuresFromRow(const float* row) const;
+    
     // Feature smoothing
     void smoothFeatures(AudioFeatures& current_features, const AudioFeatures& previous_features);
     
@@ -272,6 +286,11 @@ private:
     AudioClass classifyBayes(const AudioFeatures& features);
     AudioClass classifyNeural(const AudioFeatures& features);
     
+    // Nearest-neighbour indexing
+    static std::array<float, SIMILARITY_DIMENSIONS> similarityVector(const AudioFeatures& features);
+    static HNSWIndex::Config similarityIndexConfig();
+    void rebuildTrainingIndex();
+    
     // Feature normalization
     void normalizeFeatures(AudioFeatures& features);
     void updateFeatureStatistics(const AudioFeatures& features);
@@ -293,6 +312,11 @@ private:
     std::vector<AudioFeatures> feature_history_;
     std::vector<std::pair<AudioFeatures, AudioClass>> training_data_;
     std::mutex history_mutex_;
+    
+    // training_data_[i] is training_index_ id training_index_base_ + i; evicted ids are removed
+    HNSWIndex training_index_;
+    size_t training_index_base_ = 0;
+    HNSWIndex similarity_index_;
     mutable std::mutex processing_mutex_;
     
     // Real-time monitoring
@@ -317,6 +341,9 @@ private:
     // Window function cache
     std::vector<std::vector<float>> window_cache_;
     
+    // Batch extractor, rebuilt when the analysis config changes
+    std::unique_ptr<BatchFeatureExtractor> batch_extractor_;
+    
     // Helper methods
     size_t getNextPowerOfTwo(size_t n);
     float interpolateValue(const std::vector<float>& data, float position);
@@ -0,0 +1,528 @@
+#include "real_fft.h"
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define VITAL_FFT_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VITAL_FFT_NEON 1
+#endif
+
+namespace vital {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+bool isPowerOfTwo(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+// Lane types give the butterflies one source for scalar and SIMD code
+struct ScalarLanes {
+    static constexpr size_t width = 1;
+    float v;
+
+    static ScalarLanes load(const float* p) { return {*p}; }
+    static ScalarLanes broadcast(float x) { return {x}; }
+    void store(float* p) const { *p = v; }
+
+    friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return {a.v + b.v}; }
+    friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return {a.v - b.v}; }
+    friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return {a.v * b.v}; }
+};
+
+#if VITAL_FFT_SSE
+struct SimdLanes {
+    static constexpr size_t width = 4;
+    __m128 v;
+
+    static SimdLanes load(const float* p) { return {_mm_loadu_ps(p)}; }
+    static SimdLanes broadcast(float x) { return {_mm_set1_ps(x)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    friend SimdLanes operator+(SimdLanes a, SimdLanes b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend SimdLanes operator-(SimdLanes a, SimdLanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend SimdLanes operator*(SimdLanes a, SimdLanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+};
+#elif VITAL_FFT_NEON
+struct SimdLanes {
+    static constexpr size_t width = 4;
+    float32x4_t v;
+
+    static SimdLanes load(const float* p) { return {vld1q_f32(p)}; }
+    static SimdLanes broadcast(float x) { return {vdupq_n_f32(x)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+
+    friend SimdLanes operator+(SimdLanes a, SimdLanes b) { return {vaddq_f32(a.v, b.v)}; }
+    friend SimdLanes operator-(SimdLanes a, SimdLanes b) { return {vsubq_f32(a.v, b.v)}; }
+    friend SimdLanes operator*(SimdLanes a, SimdLanes b) { return {vmulq_f32(a.v, b.v)}; }
+};
+#else
+using SimdLanes = ScalarLanes;
+#endif
+
+/** Per-thread work buffers, so shared plans stay immutable */
+struct Scratch {
+    std::vector<float> data_re, data_im;
+    std::vector<float> work_re, work_im;
+    std::vector<std::complex<float>> spectrum;
+
+    void reserve(size_t n) {
+        if (data_re.size() < n) {
+            data_re.resize(n);
+            data_im.resize(n);
+            work_re.resize(n);
+            work_im.resize(n);
+        }
+    }
+};
+
+Scratch& threadScratch() {
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+// ============================================================================
+// Complex power-of-two FFT (Stockham autosort, radix-4 with a radix-2 tail)
+// ============================================================================
+
+struct RealFFT::ComplexPlan {
+    struct Stage {
+        size_t radix;
+        size_t length;      // Sub-transform length at this stage
+        size_t stride;
+        size_t twiddle_offset;
+    };
+
+    size_t size;
+    std::vector<Stage> stages;
+    std::vector<float> twiddle_re;  // Radix-4: w^p, w^2p, w^3p for each p
+    std::vector<float> twiddle_im;
+
+    explicit ComplexPlan(size_t n) : size(n) {
+        size_t length = n;
+        size_t stride = 1;
+
+        while (length > 1) {
+            const size_t radix = (length % 4 == 0) ? 4 : 2;
+            stages.push_back({radix, length, stride, twiddle_re.size()});
+
+            if (radix == 4) {
+                for (size_t p = 0; p < length / 4; ++p) {
+                    for (size_t k = 1; k <= 3; ++k) {
+                        const double angle = -2.0 * kPi * static_cast<double>(k * p) / static_cast<double>(length);
+                        twiddle_re.push_back(static_cast<float>(std::cos(angle)));
+                        twiddle_im.push_back(static_cast<float>(std::sin(angle)));
+                    }
+                }
+            }
+
+            length /= radix;
+            stride *= radix;
+        }
+    }
+
+    /** Forward transform of re/im in place; work must hold size floats each */
+    void transform(float* re, float* im, float* work_re, float* work_im) const {
+        float* x_re = re;
+        float* x_im = im;
+        float* y_re = work_re;
+        float* y_im = work_im;
+
+        for (const Stage& stage : stages) {
+            if (stage.radix == 4) {
+                if (stage.stride >= SimdLanes::width) {
+                    radix4<SimdLanes>(stage, x_re, x_im, y_re, y_im);
+                } else {
+                    radix4<ScalarLanes>(stage, x_re, x_im, y_re, y_im);
+                }
+            } else {
+                // Only ever the last stage, where the stride is size / 2
+                if (stage.stride >= SimdLanes::width) {
+                    radix2<SimdLanes>(stage, x_re, x_im, y_re, y_im);
+                } else {
+                    radix2<ScalarLanes>(stage, x_re, x_im, y_re, y_im);
+                }
+            }
+
+            std::swap(x_re, y_re);
+            std::swap(x_im, y_im);
+        }
+
+        if (x_re != re) {
+            std::copy(x_re, x_re + size, re);
+            std::copy(x_im, x_im + size, im);
+        }
+    }
+
+    template <typename V>
+    void radix4(const Stage& stage, const float* x_re, const float* x_im, float* y_re, float* y_im) const {
+        const size_t s = stage.stride;
+        const size_t quarter = stage.length / 4;
+        const float* w_re = twiddle_re.data() + stage.twiddle_offset;
+        const float* w_im = twiddle_im.data() + stage.twiddle_offset;
+
+        for (size_t p = 0; p < quarter; ++p) {
+            const V w1r = V::broadcast(w_re[3 * p]), w1i = V::broadcast(w_im[3 * p]);
+            const V w2r = V::broadcast(w_re[3 * p + 1]), w2i = V::broadcast(w_im[3 * p + 1]);
+            const V w3r = V::broadcast(w_re[3 * p + 2]), w3i = V::broadcast(w_im[3 * p + 2]);
+
+            const size_t in0 = s * p;
+            const size_t in1 = s * (p + quarter);
+            const size_t in2 = s * (p + 2 * quarter);
+            const size_t in3 = s * (p + 3 * quarter);
+            const size_t out = s * 4 * p;
+
+            for (size_t q = 0; q < s; q += V::width) {
+                const V ar = V::load(x_re + in0 + q), ai = V::load(x_im + in0 + q);
+                const V br = V::load(x_re + in1 + q), bi = V::load(x_im + in1 + q);
+                const V cr = V::load(x_re + in2 + q), ci = V::load(x_im + in2 + q);
+                const V dr = V::load(x_re + in3 + q), di = V::load(x_im + in3 + q);
+
+                const V apc_r = ar + cr, apc_i = ai + ci;
+                const V amc_r = ar - cr, amc_i = ai - ci;
+                const V bpd_r = br + dr, bpd_i = bi + di;
+                // j * (b - d)
+                const V jbmd_r = di - bi, jbmd_i = br - dr;
+
+                (apc_r + bpd_r).store(y_re + out + q);
+                (apc_i + bpd_i).store(y_im + out + q);
+
+                const V t1r = amc_r - jbmd_r, t1i = amc_i - jbmd_i;
+                (w1r * t1r - w1i * t1i).store(y_re + out + s + q);
+                (w1r * t1i + w1i * t1r).store(y_im + out + s + q);
+
+                const V t2r = apc_r - bpd_r, t2i = apc_i - bpd_i;
+                (w2r * t2r - w2i * t2i).store(y_re + out + 2 * s + q);
+                (w2r * t2i + w2i * t2r).store(y_im + out + 2 * s + q);
+
+                const V t3r = amc_r + jbmd_r, t3i = amc_i + jbmd_i;
+                (w3r * t3r - w3i * t3i).store(y_re + out + 3 * s + q);
+                (w3r * t3i + w3i * t3r).store(y_im + out + 3 * s + q);
+            }
+        }
+    }
+
+    template <typename V>
+    void radix2(const Stage& stage, const float* x_re, const float* x_im, float* y_re, float* y_im) const {
+        const size_t s = stage.stride;
+
+        for (size_t q = 0; q < s; q += V::width) {
+            const V ar = V::load(x_re + q), ai = V::load(x_im + q);
+            const V br = V::load(x_re + s + q), bi = V::load(x_im + s + q);
+
+            (ar + br).store(y_re + q);
+            (ai + bi).store(y_im + q);
+            (ar - br).store(y_re + s + q);
+            (ai - bi).store(y_im + s + q);
+        }
+    }
+};
+
+// ============================================================================
+// Bluestein chirp-z transform for sizes that are not a power of two
+// ============================================================================
+
+struct RealFFT::BluesteinPlan {
+    size_t size;
+    ComplexPlan convolution;
+    std::vector<float> chirp_re;    // exp(-i pi k^2 / size)
+    std::vector<float> chirp_im;
+    std::vector<float> kernel_re;   // FFT of the conjugate chirp, scaled by 1 / M
+    std::vector<float> kernel_im;
+
+    explicit BluesteinPlan(size_t n)
+        : size(n), convolution(nextPowerOfTwo(2 * n - 1)) {
+        const size_t m = convolution.size;
+        chirp_re.resize(n);
+        chirp_im.resize(n);
+
+        for (size_t k = 0; k < n; ++k) {
+            // k^2 mod 2n keeps the angle exact for large k
+            const double phase = static_cast<double>((k * k) % (2 * n));
+            const double angle = -kPi * phase / static_cast<double>(n);
+            chirp_re[k] = static_cast<float>(std::cos(angle));
+            chirp_im[k] = static_cast<float>(std::sin(angle));
+        }
+
+        kernel_re.assign(m, 0.0f);
+        kernel_im.assign(m, 0.0f);
+        for (size_t k = 0; k < n; ++k) {
+            kernel_re[k] = chirp_re[k];
+            kernel_im[k] = -chirp_im[k];
+            if (k > 0) {
+                kernel_re[m - k] = chirp_re[k];
+                kernel_im[m - k] = -chirp_im[k];
+            }
+        }
+
+        std::vector<float> work_re(m), work_im(m);
+        convolution.transform(kernel_re.data(), kernel_im.data(), work_re.data(), work_im.data());
+
+        const float scale = 1.0f / static_cast<float>(m);
+        for (size_t k = 0; k < m; ++k) {
+            kernel_re[k] *= scale;
+            kernel_im[k] *= scale;
+        }
+    }
+
+    /** Forward DFT of size complex values in re/im, in place. Buffers hold M floats. */
+    void transform(float* re, float* im, float* work_re, float* work_im) const {
+        const size_t m = convolution.size;
+
+        for (size_t k = 0; k < size; ++k) {
+            const float r = re[k] * chirp_re[k] - im[k] * chirp_im[k];
+            const float i = re[k] * chirp_im[k] + im[k] * chirp_re[k];
+            re[k] = r;
+            im[k] = i;
+        }
+        std::fill(re + size, re + m, 0.0f);
+        std::fill(im + size, im + m, 0.0f);
+
+        convolution.transform(re, im, work_re, work_im);
+
+        // Multiply by the kernel and conjugate, so the forward plan computes the inverse
+        for (size_t k = 0; k < m; ++k) {
+            const float r = re[k] * kernel_re[k] - im[k] * kernel_im[k];
+            const float i = re[k] * kernel_im[k] + im[k] * kernel_re[k];
+            re[k] = r;
+            im[k] = -i;
+        }
+
+        convolution.transform(re, im, work_re, work_im);
+
+        for (size_t k = 0; k < size; ++k) {
+            const float r = re[k];
+            const float i = -im[k];
+            re[k] = r * chirp_re[k] - i * chirp_im[k];
+            im[k] = r * chirp_im[k] + i * chirp_re[k];
+        }
+    }
+};
+
+// ============================================================================
+// RealFFT
+// ============================================================================
+
+RealFFT::RealFFT(size_t size) : size_(size) {
+    if (size_ < 2) return;
+
+    if (isPowerOfTwo(size_)) {
+        const size_t half = size_ / 2;
+        half_plan_ = std::make_unique<ComplexPlan>(half);
+
+        packing_re_.resize(half + 1);
+        packing_im_.resize(half + 1);
+        for (size_t k = 0; k <= half; ++k) {
+            const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(size_);
+            packing_re_[k] = static_cast<float>(std::cos(angle));
+            packing_im_[k] = static_cast<float>(std::sin(angle));
+        }
+    } else {
+        bluestein_ = std::make_unique<BluesteinPlan>(size_);
+    }
+}
+
+RealFFT::~RealFFT() = default;
+
+std::shared_ptr<const RealFFT> RealFFT::plan(size_t size) {
+    // Most callers ask for the same size frame after frame, often through a temporary,
+    // so each thread keeps its most recent plan alive
+    thread_local std::shared_ptr<const RealFFT> last_plan;
+    if (last_plan && last_plan->size() == size) {
+        return last_plan;
+    }
+
+    // Shared entries are weak: a plan is freed with its last user, so arbitrary sizes don't pile up
+    static std::mutex cache_mutex;
+    static std::unordered_map<size_t, std::weak_ptr<const RealFFT>> cache;
+
+    std::shared_ptr<const RealFFT> result;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (auto it = cache.find(size); it != cache.end()) {
+            result = it->second.lock();
+        }
+    }
+
+    if (!result) {
+        // Built outside the lock; if another thread got there first, its plan wins
+        auto created = std::make_shared<const RealFFT>(size);
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto& entry = cache[size];
+        result = entry.lock();
+        if (!result) {
+            entry = created;
+            result = std::move(created);
+
+            for (auto it = cache.begin(); it != cache.end();) {
+                it = it->second.expired() ? cache.erase(it) : std::next(it);
+            }
+        }
+    }
+
+    last_plan = result;
+    return result;
+}
+
+void RealFFT::forward(const float* input, std::complex<float>* spectrum) const {
+    if (size_ == 0) return;
+    if (size_ == 1) {
+        spectrum[0] = {input[0], 0.0f};
+        return;
+    }
+
+    Scratch& scratch = threadScratch();
+
+    if (bluestein_) {
+        scratch.reserve(bluestein_->convolution.size);
+        std::copy(input, input + size_, scratch.data_re.begin());
+        std::fill(scratch.data_im.begin(), scratch.data_im.begin() + size_, 0.0f);
+
+        bluestein_->transform(scratch.data_re.data(), scratch.data_im.data(),
+                              scratch.work_re.data(), scratch.work_im.data());
+
+        for (size_t k = 0; k < numBins(); ++k) {
+            spectrum[k] = {scratch.data_re[k], scratch.data_im[k]};
+        }
+        return;
+    }
+
+    // Even samples become the real part, odd samples the imaginary part
+    const size_t half = size_ / 2;
+    scratch.reserve(half);
+    float* z_re = scratch.data_re.data();
+    float* z_im = scratch.data_im.data();
+
+    for (size_t k = 0; k < half; ++k) {
+        z_re[k] = input[2 * k];
+        z_im[k] = input[2 * k + 1];
+    }
+
+    half_plan_->transform(z_re, z_im, scratch.work_re.data(), scratch.work_im.data());
+
+    // Split into the spectra of the even and odd samples and recombine
+    for (size_t k = 0; k <= half; ++k) {
+        const size_t a = k % half;
+        const size_t b = (half - k) % half;
+
+        const float even_re = 0.5f * (z_re[a] + z_re[b]);
+        const float even_im = 0.5f * (z_im[a] - z_im[b]);
+        const float odd_re = 0.5f * (z_im[a] + z_im[b]);
+        const float odd_im = -0.5f * (z_re[a] - z_re[b]);
+
+        spectrum[k] = {even_re + packing_re_[k] * odd_re - packing_im_[k] * odd_im,
+                       even_im + packing_re_[k] * odd_im + packing_im_[k] * odd_re};
+    }
+}
+
+void RealFFT::inverse(const std::complex<float>* spectrum, float* output) const {
+    if (size_ == 0) return;
+    if (size_ == 1) {
+        output[0] = spectrum[0].real();
+        return;
+    }
+
+    Scratch& scratch = threadScratch();
+    const float scale = 1.0f / static_cast<float>(size_);
+
+    if (bluestein_) {
+        // x = swap(DFT(swap(X))) / n on the conjugate-symmetric extension
+        scratch.reserve(bluestein_->convolution.size);
+        for (size_t k = 0; k < size_; ++k) {
+            const std::complex<float> bin = (k < numBins()) ? spectrum[k] : std::conj(spectrum[size_ - k]);
+            scratch.data_re[k] = bin.imag();
+            scratch.data_im[k] = bin.real();
+        }
+
+        bluestein_->transform(scratch.data_re.data(), scratch.data_im.data(),
+                              scratch.work_re.data(), scratch.work_im.data());
+
+        for (size_t k = 0; k < size_; ++k) {
+            output[k] = scratch.data_im[k] * scale;
+        }
+        return;
+    }
+
+    const size_t half = size_ / 2;
+    scratch.reserve(half);
+    float* z_re = scratch.data_re.data();
+    float* z_im = scratch.data_im.data();
+
+    // Rebuild Z = E + iO, stored swapped so the forward plan computes the inverse
+    for (size_t k = 0; k < half; ++k) {
+        const std::complex<float> a = spectrum[k];
+        const std::complex<float> b = std::conj(spectrum[half - k]);
+
+        const std::complex<float> even = 0.5f * (a + b);
+        const std::complex<float> odd = 0.5f * (a - b) * std::complex<float>(packing_re_[k], -packing_im_[k]);
+        const std::complex<float> z = even + std::complex<float>(-odd.imag(), odd.real());
+
+        z_re[k] = z.imag();
+        z_im[k] = z.real();
+    }
+
+    half_plan_->transform(z_re, z_im, scratch.work_re.data(), scratch.work_im.data());
+
+    for (size_t k = 0; k < half; ++k) {
+        output[2 * k] = z_im[k] * 2.0f * scale;
+        output[2 * k + 1] = z_re[k] * 2.0f * scale;
+    }
+}
+
+void RealFFT::forwardFull(const std::vector<float>& input, std::vector<std::complex<float>>& spectrum) const {
+    spectrum.resize(size_);
+    if (size_ == 0) return;
+
+    const float* samples = input.data();
+    std::vector<float> padded;
+    if (input.size() < size_) {
+        padded.assign(size_, 0.0f);
+        std::copy(input.begin(), input.end(), padded.begin());
+        samples = padded.data();
+    }
+
+    forward(samples, spectrum.data());
+
+    for (size_t k = numBins(); k < size_; ++k) {
+        spectrum[k] = std::conj(spectrum[size_ - k]);
+    }
+}
+
+void RealFFT::inverseFull(const std::vector<std::complex<float>>& spectrum, std::vector<float>& output) const {
+    output.resize(size_);
+    if (size_ == 0) return;
+
+    // The real part of the inverse only sees the conjugate-symmetric part
+    std::vector<std::complex<float>>& bins = threadScratch().spectrum;
+    bins.resize(numBins());
+
+    auto binAt = [&](size_t k) {
+        return k < spectrum.size() ? spectrum[k] : std::complex<float>();
+    };
+
+    for (size_t k = 0; k < numBins(); ++k) {
+        bins[k] = 0.5f * (binAt(k) + std::conj(binAt((size_ - k) % size_)));
+    }
+
+    inverse(bins.data(), output.data());
+}
+
+} // namespace vital
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cstddef>
+
+namespace vital {
+
+/**
+ * @class RealFFT
+ * @brief Planned real-input FFT shared by the analysis engines
+ *
+ * A plan holds every twiddle factor for one transform size, so no
+ * trigonometry is evaluated per frame. Power-of-two sizes pack the real
+ * input into a complex transform of half the length, computed with a
+ * Stockham radix-4 FFT (plus one radix-2 pass for odd powers) over split
+ * real/imaginary arrays with SIMD butterflies. Other sizes use Bluestein's
+ * algorithm on top of a power-of-two plan.
+ *
+ * Plans are immutable and can be shared between threads; scratch memory is
+ * per thread. Use plan() to obtain a cached instance for a given size.
+ */
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+    ~RealFFT();
+
+    /**
+     * Shared plan for size, created on first use and freed with its last
+     * holder; each thread also holds the plan it asked for most recently.
+     * Thread-safe.
+     */
+    static std::shared_ptr<const RealFFT> plan(size_t size);
+
+    size_t size() const { return size_; }
+    size_t numBins() const { return size_ / 2 + 1; }
+
+    /** size() real samples to numBins() complex bins, unscaled */
+    void forward(const float* input, std::complex<float>* spectrum) const;
+
+    /** numBins() complex bins to size() real samples, scaled by 1 / size() */
+    void inverse(const std::complex<float>* spectrum, float* output) const;
+
+    /**
+     * Full complex spectrum of input, zero-padded or truncated to size().
+     * The negative frequencies are filled in by conjugate symmetry.
+     */
+    void forwardFull(const std::vector<float>& input, std::vector<std::complex<float>>& spectrum) const;
+
+    /**
+     * Real part of the inverse of a full complex spectrum of size() bins,
+     * which need not be conjugate-symmetric. Scaled by 1 / size().
+     */
+    void inverseFull(const std::vector<std::complex<float>>& spectrum, std::vector<float>& output) const;
+
+private:
+    struct ComplexPlan;
+    struct BluesteinPlan;
+
+    size_t size_;
+    std::unique_ptr<ComplexPlan> half_plan_;       // size_ / 2 points, power-of-two sizes
+    std::vector<float> packing_re_;                // exp(-2 pi i k / size_) for real packing
+    std::vector<float> packing_im_;
+    std::unique_ptr<BluesteinPlan> bluestein_;     // Everything else
+
+    RealFFT(const RealFFT&) = delete;
+    RealFFT& operator=(const RealFFT&) = delete;
+};
+
+} // namespace vital
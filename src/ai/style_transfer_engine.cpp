@@ -1,4 +1,5 @@
 #include "style_transfer_engine.h"
+#include "real_fft.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -529,37 +530,13 @@ void StyleTransferEngine::optimizeForQuality() {
     config_.quality_threshold = 0.8f;
 }
 
-// FFT implementation (simplified)
+// FFT via the shared planned real FFT
 void StyleTransferEngine::performFFT(const std::vector<float>& input, std::vector<std::complex<float>>& output) {
-    size_t n = input.size();
-    output.resize(n);
-    
-    // Simplified FFT implementation
-    for (size_t k = 0; k < n; ++k) {
-        std::complex<float> sum(0.0f, 0.0f);
-        for (size_t j = 0; j < n; ++j) {
-            float angle = -2.0f * M_PI * k * j / n;
-            std::complex<float> w(std::cos(angle), std::sin(angle));
-            sum += input[j] * w;
-        }
-        output[k] = sum;
-    }
+    RealFFT::plan(input.size())->forwardFull(input, output);
 }
 
 void StyleTransferEngine::performIFFT(const std::vector<std::complex<float>>& input, std::vector<float>& output) {
-    size_t n = input.size();
-    output.resize(n);
-    
-    // Simplified IFFT implementation
-    for (size_t k = 0; k < n; ++k) {
-        float sum = 0.0f;
-        for (size_t j = 0; j < n; ++j) {
-            float angle = 2.0f * M_PI * k * j / n;
-            std::complex<float> w(std::cos(angle), std::sin(angle));
-            sum += std::real(input[j] * w);
-        }
-        output[k] = sum / n;
-    }
+    RealFFT::plan(input.size())->inverseFull(input, output);
 }
 
 // Feature extraction
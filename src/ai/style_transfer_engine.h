@@ -136,7 +136,7 @@ public:
     void optimizeForQuality();
     
 private:
-    // FFT implementation (simplified)
+    // FFT (shared planned real FFT, see real_fft.h)
     void performFFT(const std::vector<float>& input, std::vector<std::complex<float>>& output);
     void performIFFT(const std::vector<std::complex<float>>& input, std::vector<float>& output);
     
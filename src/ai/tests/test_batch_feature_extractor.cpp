@@ -0,0 +1,203 @@
+#include "batch_feature_extractor.h"
+#include "feature_store.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace vital {
+namespace {
+
+constexpr double kSampleRate = 44100.0;
+
+std::filesystem::path testDirectory() {
+    auto directory = std::filesystem::temp_directory_path() / "vital_batch_feature_extractor_test";
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::vector<float> sine(float frequency, size_t num_samples) {
+    std::vector<float> samples(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        samples[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * frequency * static_cast<double>(i) / kSampleRate));
+    }
+    return samples;
+}
+
+template<typename T>
+void writeValue(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** 16-bit PCM with the same signal on every channel; returns the samples as the decoder sees them */
+std::vector<float> writeWav(const std::string& path, const std::vector<float>& samples, uint16_t channels) {
+    std::vector<float> decoded;
+    std::vector<int16_t> pcm;
+    for (float sample : samples) {
+        const int16_t value = static_cast<int16_t>(std::lround(sample * 32767.0f));
+        decoded.push_back(value / 32768.0f);
+        for (uint16_t channel = 0; channel < channels; ++channel) pcm.push_back(value);
+    }
+
+    const uint32_t data_size = static_cast<uint32_t>(pcm.size() * sizeof(int16_t));
+    std::ofstream file(path, std::ios::binary);
+    file.write("RIFF", 4);
+    writeValue<uint32_t>(file, 36 + data_size);
+    file.write("WAVE", 4);
+    file.write("fmt ", 4);
+    writeValue<uint32_t>(file, 16);
+    writeValue<uint16_t>(file, 1);
+    writeValue<uint16_t>(file, channels);
+    writeValue<uint32_t>(file, static_cast<uint32_t>(kSampleRate));
+    writeValue<uint32_t>(file, static_cast<uint32_t>(kSampleRate) * channels * 2);
+    writeValue<uint16_t>(file, static_cast<uint16_t>(channels * 2));
+    writeValue<uint16_t>(file, 16);
+    file.write("data", 4);
+    writeValue<uint32_t>(file, data_size);
+    file.write(reinterpret_cast<const char*>(pcm.data()), data_size);
+    return decoded;
+}
+
+BatchFeatureExtractor::Config makeConfig(size_t num_threads) {
+    BatchFeatureExtractor::Config config;
+    config.num_threads = num_threads;
+    config.chunk_frames = 4;
+    config.files_per_batch = 2;
+    return config;
+}
+
+TEST(BatchFeatureExtractorTest, SineFramesHaveExpectedFeatures) {
+    BatchFeatureExtractor extractor(makeConfig(2));
+    const auto signal = sine(1000.0f, 10000);
+
+    BatchFeatureExtractor::FeatureMatrix features;
+    extractor.extract(signal.data(), signal.size(), kSampleRate, features);
+
+    const auto& config = extractor.getConfig();
+    ASSERT_EQ(features.num_rows, (signal.size() - config.frame_size) / config.hop_size + 1);
+    ASSERT_EQ(features.values.size(), features.num_rows * BatchFeatureExtractor::NUM_COLUMNS);
+    ASSERT_EQ(BatchFeatureExtractor::columnNames().size(), size_t(BatchFeatureExtractor::NUM_COLUMNS));
+
+    for (size_t i = 0; i < features.num_rows; ++i) {
+        const float* row = features.row(i);
+        EXPECT_NEAR(row[BatchFeatureExtractor::SPECTRAL_CENTROID], 1000.0f, 100.0f) << "frame " << i;
+        EXPECT_GT(row[BatchFeatureExtractor::RMS], 0.0f);
+
+        float chroma_sum = 0.0f;
+        for (size_t c = 0; c < BatchFeatureExtractor::CHROMA_BINS; ++c) {
+            chroma_sum += row[BatchFeatureExtractor::CHROMA_0 + c];
+        }
+        EXPECT_NEAR(chroma_sum, 1.0f, 1e-4f);
+    }
+}
+
+TEST(BatchFeatureExtractorTest, ShortSignalGivesOnePaddedFrame) {
+    BatchFeatureExtractor extractor(makeConfig(1));
+    const auto signal = sine(440.0f, 300);
+
+    BatchFeatureExtractor::FeatureMatrix features;
+    extractor.extract(signal.data(), signal.size(), kSampleRate, features);
+    EXPECT_EQ(features.num_rows, 1u);
+
+    extractor.extract(signal.data(), 0, kSampleRate, features);
+    EXPECT_EQ(features.num_rows, 0u);
+}
+
+TEST(BatchFeatureExtractorTest, RowsDoNotDependOnThreadCount) {
+    std::vector<float> signal = sine(220.0f, 40000);
+    const auto overtone = sine(3300.0f, signal.size());
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] += overtone[i] * static_cast<float>(i % 7) / 7.0f;
+
+    BatchFeatureExtractor::FeatureMatrix single;
+    BatchFeatureExtractor::FeatureMatrix parallel;
+    BatchFeatureExtractor(makeConfig(1)).extract(signal.data(), signal.size(), kSampleRate, single);
+    BatchFeatureExtractor(makeConfig(4)).extract(signal.data(), signal.size(), kSampleRate, parallel);
+
+    ASSERT_EQ(single.num_rows, parallel.num_rows);
+    EXPECT_EQ(single.values, parallel.values);
+}
+
+TEST(BatchFeatureExtractorTest, StreamedFileMatchesInMemoryExtraction) {
+    const std::string path = (testDirectory() / "stereo.wav").string();
+    // Not a whole number of chunks, so the last one is partial
+    const auto decoded = writeWav(path, sine(660.0f, 9001), 2);
+
+    BatchFeatureExtractor extractor(makeConfig(3));
+    BatchFeatureExtractor::FeatureMatrix from_file;
+    BatchFeatureExtractor::FeatureMatrix from_memory;
+
+    const auto result = extractor.extractFile(path, from_file);
+    extractor.extract(decoded.data(), decoded.size(), kSampleRate, from_memory);
+
+    ASSERT_TRUE(result.success) << result.error;
+    EXPECT_EQ(result.sample_rate, kSampleRate);
+    EXPECT_EQ(result.num_frames, from_memory.num_rows);
+    EXPECT_EQ(from_file.values, from_memory.values);
+}
+
+TEST(BatchFeatureExtractorTest, RejectsFilesThatAreNotWav) {
+    const std::string path = (testDirectory() / "not_audio.wav").string();
+    std::ofstream(path) << "plain text";
+
+    BatchFeatureExtractor extractor(makeConfig(1));
+    BatchFeatureExtractor::FeatureMatrix features;
+
+    const auto result = extractor.extractFile(path, features);
+    EXPECT_FALSE(result.success);
+    EXPECT_FALSE(result.error.empty());
+
+    const auto missing = extractor.extractFile((testDirectory() / "missing.wav").string(), features);
+    EXPECT_FALSE(missing.success);
+}
+
+TEST(BatchFeatureExtractorTest, IndexWritesSourcesInInputOrder) {
+    const auto directory = testDirectory();
+    const std::vector<std::string> paths = {
+        (directory / "index_a.wav").string(),
+        (directory / "index_missing.wav").string(),
+        (directory / "index_b.wav").string(),
+        (directory / "index_c.wav").string(),
+    };
+    writeWav(paths[0], sine(200.0f, 5000), 1);
+    writeWav(paths[2], sine(2000.0f, 700), 1);
+    writeWav(paths[3], sine(800.0f, 12000), 2);
+
+    BatchFeatureExtractor extractor(makeConfig(4));
+    const std::string store_path = (directory / "index.vfst").string();
+    const auto results = extractor.indexFiles(paths, store_path);
+
+    ASSERT_EQ(results.size(), paths.size());
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_TRUE(results[2].success);
+    EXPECT_TRUE(results[3].success);
+
+    FeatureStoreReader reader;
+    ASSERT_TRUE(reader.open(store_path));
+    EXPECT_EQ(reader.columnNames(), BatchFeatureExtractor::columnNames());
+
+    // The failed file has no source; the rest keep their order
+    const auto& sources = reader.sources();
+    ASSERT_EQ(sources.size(), 3u);
+    const size_t expected[] = {0, 2, 3};
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const auto& result = results[expected[i]];
+        EXPECT_EQ(sources[i].name, paths[expected[i]]);
+        EXPECT_EQ(sources[i].num_rows, result.num_frames);
+
+        BatchFeatureExtractor::FeatureMatrix features;
+        extractor.extractFile(paths[expected[i]], features);
+
+        std::vector<float> rows;
+        ASSERT_TRUE(reader.readRows(sources[i].first_row, sources[i].num_rows, rows));
+        EXPECT_EQ(rows, features.values);
+    }
+}
+
+} // namespace
+} // namespace vital
@@ -0,0 +1,101 @@
+#include "feature_store.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vital {
+namespace {
+
+std::string storePath(const std::string& name) {
+    auto directory = std::filesystem::temp_directory_path() / "vital_feature_store_test";
+    std::filesystem::create_directories(directory);
+    return (directory / name).string();
+}
+
+/** Row-major rows whose value encodes (row, column) */
+std::vector<float> makeRows(size_t first_row, size_t num_rows, size_t num_columns) {
+    std::vector<float> rows(num_rows * num_columns);
+    for (size_t row = 0; row < num_rows; ++row) {
+        for (size_t column = 0; column < num_columns; ++column) {
+            rows[row * num_columns + column] = static_cast<float>((first_row + row) * 100 + column);
+        }
+    }
+    return rows;
+}
+
+TEST(FeatureStoreTest, RoundTripsAcrossRowGroups) {
+    const std::vector<std::string> columns = {"rms", "centroid", "flatness"};
+    const std::string path = storePath("round_trip.vfst");
+
+    {
+        FeatureStoreWriter writer;
+        // Groups of 4 rows, so sources straddle group boundaries
+        ASSERT_TRUE(writer.open(path, columns, 4));
+        EXPECT_TRUE(writer.append("a", makeRows(0, 6, 3).data(), 6));
+        EXPECT_TRUE(writer.append("b", makeRows(6, 0, 3).data(), 0));
+        EXPECT_TRUE(writer.append("c", makeRows(6, 5, 3).data(), 5));
+        EXPECT_EQ(writer.numRows(), 11u);
+        EXPECT_TRUE(writer.close());
+        EXPECT_FALSE(writer.isOpen());
+    }
+
+    FeatureStoreReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.columnNames(), columns);
+    EXPECT_EQ(reader.numRows(), 11u);
+
+    ASSERT_EQ(reader.sources().size(), 3u);
+    EXPECT_EQ(reader.sources()[0].name, "a");
+    EXPECT_EQ(reader.sources()[1].num_rows, 0u);
+    EXPECT_EQ(reader.sources()[2].first_row, 6u);
+    EXPECT_EQ(reader.sources()[2].num_rows, 5u);
+
+    EXPECT_EQ(reader.findColumn("centroid"), 1);
+    EXPECT_EQ(reader.findColumn("missing"), -1);
+
+    std::vector<float> column;
+    ASSERT_TRUE(reader.readColumn(2, column));
+    ASSERT_EQ(column.size(), 11u);
+    for (size_t row = 0; row < column.size(); ++row) {
+        EXPECT_EQ(column[row], static_cast<float>(row * 100 + 2));
+    }
+
+    std::vector<float> rows;
+    ASSERT_TRUE(reader.readRows(3, 7, rows));
+    EXPECT_EQ(rows, makeRows(3, 7, 3));
+
+    EXPECT_FALSE(reader.readRows(10, 2, rows));
+    EXPECT_FALSE(reader.readColumn(3, column));
+}
+
+TEST(FeatureStoreTest, DestructorFinishesTheFile) {
+    const std::string path = storePath("unclosed.vfst");
+    {
+        FeatureStoreWriter writer;
+        ASSERT_TRUE(writer.open(path, {"x"}));
+        writer.append("only", makeRows(0, 3, 1).data(), 3);
+    }
+
+    FeatureStoreReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.numRows(), 3u);
+}
+
+TEST(FeatureStoreTest, RejectsOtherFiles) {
+    const std::string path = storePath("garbage.vfst");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "this is not a feature store at all";
+    }
+
+    FeatureStoreReader reader;
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.open(storePath("missing.vfst")));
+
+    FeatureStoreWriter writer;
+    EXPECT_FALSE(writer.append("closed", nullptr, 0));
+}
+
+} // namespace
+} // namespace vital
@@ -0,0 +1,252 @@
+#include "hnsw_index.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vital {
+namespace {
+
+/** Dimension 13 is not a multiple of the eight-float padding */
+constexpr size_t kDimension = 13;
+
+std::vector<float> randomVectors(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> values(count * kDimension);
+    for (auto& value : values) value = dist(rng);
+    return values;
+}
+
+float squaredDistance(const float* a, const float* b) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < kDimension; ++i) sum += (a[i] - b[i]) * (a[i] - b[i]);
+    return sum;
+}
+
+std::vector<size_t> bruteForce(const std::vector<float>& data, const float* query, size_t k,
+                               const HNSWIndex& index) {
+    std::vector<std::pair<float, size_t>> all;
+    for (size_t id = 0; id < data.size() / kDimension; ++id) {
+        if (!index.isRemoved(id)) all.emplace_back(squaredDistance(data.data() + id * kDimension, query), id);
+    }
+    std::sort(all.begin(), all.end());
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < std::min(k, all.size()); ++i) ids.push_back(all[i].second);
+    return ids;
+}
+
+HNSWIndex::Config makeConfig() {
+    HNSWIndex::Config config;
+    config.dimension = kDimension;
+    return config;
+}
+
+void addAll(HNSWIndex& index, const std::vector<float>& data) {
+    for (size_t i = 0; i < data.size() / kDimension; ++i) {
+        EXPECT_EQ(index.add(data.data() + i * kDimension), i);
+    }
+}
+
+/** Per node, its links at each level */
+using NodeLinks = std::vector<std::vector<uint32_t>>;
+
+/** Writes an index file by hand in HNSWIndex's save format, one vector of ones per node */
+void writeIndexFile(const std::string& path, uint32_t entry_point, int32_t max_level,
+                    const std::vector<NodeLinks>& nodes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const auto write = [&file](const auto& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    const HNSWIndex::Config config = makeConfig();
+    write(uint32_t{0x534E4856});
+    write(uint32_t{1});
+    write(static_cast<uint64_t>(config.dimension));
+    write(static_cast<uint64_t>(config.max_neighbors));
+    write(static_cast<uint64_t>(config.ef_construction));
+    write(static_cast<uint64_t>(config.ef_search));
+    write(config.seed);
+    write(static_cast<uint64_t>(nodes.size()));
+    write(entry_point);
+    write(max_level);
+
+    const std::vector<float> vector(kDimension, 1.0f);
+    for (const auto& levels : nodes) {
+        file.write(reinterpret_cast<const char*>(vector.data()),
+                   static_cast<std::streamsize>(vector.size() * sizeof(float)));
+        write(false);
+        write(static_cast<uint32_t>(levels.size()));
+        for (const auto& links : levels) {
+            write(static_cast<uint32_t>(links.size()));
+            for (uint32_t link : links) write(link);
+        }
+    }
+}
+
+double recallAtTen(const HNSWIndex& index, const std::vector<float>& data, const std::vector<float>& queries,
+                   size_t ef) {
+    size_t found = 0, total = 0;
+    for (size_t q = 0; q < queries.size() / kDimension; ++q) {
+        const float* query = queries.data() + q * kDimension;
+        const auto expected = bruteForce(data, query, 10, index);
+        const std::set<size_t> truth(expected.begin(), expected.end());
+        for (const auto& result : index.search(query, 10, ef)) found += truth.count(result.id);
+        total += expected.size();
+    }
+    return static_cast<double>(found) / static_cast<double>(total);
+}
+
+TEST(HNSWIndexTest, EmptyIndexReturnsNothing) {
+    HNSWIndex index(makeConfig());
+    const auto query = randomVectors(1, 1);
+    EXPECT_TRUE(index.search(query.data(), 5).empty());
+    EXPECT_EQ(index.size(), 0u);
+}
+
+TEST(HNSWIndexTest, ResultsAreSortedExactDistances) {
+    const auto data = randomVectors(500, 2);
+    HNSWIndex index(makeConfig());
+    addAll(index, data);
+    ASSERT_EQ(index.size(), 500u);
+
+    const auto query = randomVectors(1, 3);
+    const auto results = index.search(query.data(), 20);
+    ASSERT_EQ(results.size(), 20u);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_NEAR(results[i].distance, squaredDistance(data.data() + results[i].id * kDimension, query.data()),
+                    1e-3f);
+        if (i > 0) {
+            EXPECT_LE(results[i - 1].distance, results[i].distance);
+        }
+    }
+
+    // A stored vector is its own nearest neighbour
+    const auto self = index.search(data.data() + 123 * kDimension, 1);
+    ASSERT_EQ(self.size(), 1u);
+    EXPECT_EQ(self[0].id, 123u);
+    EXPECT_NEAR(self[0].distance, 0.0f, 1e-5f);
+}
+
+TEST(HNSWIndexTest, RecallMatchesBruteForce) {
+    const auto data = randomVectors(2000, 4);
+    const auto queries = randomVectors(50, 5);
+    HNSWIndex index(makeConfig());
+    addAll(index, data);
+
+    EXPECT_GE(recallAtTen(index, data, queries, 128), 0.95);
+
+    // A wider candidate list trades latency for recall
+    EXPECT_GE(recallAtTen(index, data, queries, 400), recallAtTen(index, data, queries, 16));
+
+    index.setEfSearch(5);
+    EXPECT_EQ(index.getEfSearch(), 5u);
+}
+
+TEST(HNSWIndexTest, RemovedVectorsAreNeverReturned) {
+    const auto data = randomVectors(300, 6);
+    HNSWIndex index(makeConfig());
+    addAll(index, data);
+
+    for (size_t id = 0; id < 300; id += 3) index.remove(id);
+    index.remove(0);
+    index.remove(100000);
+    EXPECT_EQ(index.numRemoved(), 100u);
+    EXPECT_EQ(index.size(), 300u);
+
+    const auto queries = randomVectors(20, 7);
+    for (size_t q = 0; q < 20; ++q) {
+        for (const auto& result : index.search(queries.data() + q * kDimension, 10, 100)) {
+            EXPECT_FALSE(index.isRemoved(result.id));
+            EXPECT_NE(result.id % 3, 0u);
+        }
+    }
+    EXPECT_GE(recallAtTen(index, data, queries, 200), 0.9);
+}
+
+TEST(HNSWIndexTest, SaveAndLoadKeepSearchResults) {
+    const auto data = randomVectors(400, 8);
+    HNSWIndex index(makeConfig());
+    addAll(index, data);
+    index.remove(7);
+
+    const auto path = (std::filesystem::temp_directory_path() / "vital_hnsw_index_test.bin").string();
+    ASSERT_TRUE(index.save(path));
+
+    HNSWIndex loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.size(), index.size());
+    EXPECT_EQ(loaded.dimension(), kDimension);
+    EXPECT_TRUE(loaded.isRemoved(7));
+
+    const auto queries = randomVectors(10, 9);
+    for (size_t q = 0; q < 10; ++q) {
+        const float* query = queries.data() + q * kDimension;
+        const auto expected = index.search(query, 10);
+        const auto actual = loaded.search(query, 10);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) EXPECT_EQ(actual[i].id, expected[i].id);
+    }
+
+    EXPECT_FALSE(loaded.load(path + ".missing"));
+}
+
+TEST(HNSWIndexTest, LoadRejectsInconsistentLevels) {
+    const auto path = (std::filesystem::temp_directory_path() / "vital_hnsw_levels_test.bin").string();
+
+    // Node 0 has levels 0 and 1, node 1 only level 0
+    writeIndexFile(path, 0, 1, {{{1}, {}}, {{0}}});
+    HNSWIndex index;
+    ASSERT_TRUE(index.load(path));
+    ASSERT_EQ(index.size(), 2u);
+
+    // max_level above the entry point's top level
+    writeIndexFile(path, 0, 2, {{{1}, {}}, {{0}}});
+    EXPECT_FALSE(index.load(path));
+
+    // Entry point with no levels at all
+    writeIndexFile(path, 1, 0, {{{}}, {}});
+    EXPECT_FALSE(index.load(path));
+
+    // A level-1 link to a node that only has level 0
+    writeIndexFile(path, 0, 1, {{{1}, {1}}, {{0}}});
+    EXPECT_FALSE(index.load(path));
+
+    // Rejected files leave the loaded index as it was
+    EXPECT_EQ(index.size(), 2u);
+    const std::vector<float> query(kDimension, 1.0f);
+    EXPECT_EQ(index.search(query.data(), 2).size(), 2u);
+}
+
+TEST(HNSWIndexTest, ConcurrentSearchesAgreeWithSerialOnes) {
+    const auto data = randomVectors(1000, 10);
+    HNSWIndex index(makeConfig());
+    addAll(index, data);
+    const auto queries = randomVectors(64, 11);
+
+    std::vector<std::vector<HNSWIndex::Result>> serial(64);
+    for (size_t q = 0; q < 64; ++q) serial[q] = index.search(queries.data() + q * kDimension, 5);
+
+    std::vector<std::vector<HNSWIndex::Result>> parallel(64);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t q = t; q < 64; q += 4) parallel[q] = index.search(queries.data() + q * kDimension, 5);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (size_t q = 0; q < 64; ++q) {
+        ASSERT_EQ(parallel[q].size(), serial[q].size());
+        for (size_t i = 0; i < serial[q].size(); ++i) EXPECT_EQ(parallel[q][i].id, serial[q][i].id);
+    }
+}
+
+} // namespace
+} // namespace vital
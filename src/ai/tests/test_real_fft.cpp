@@ -0,0 +1,135 @@
+#include "real_fft.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+namespace vital {
+namespace {
+
+std::vector<float> randomSignal(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> signal(size);
+    for (auto& value : signal) value = dist(rng);
+    return signal;
+}
+
+std::vector<std::complex<double>> naiveDft(const std::vector<float>& input) {
+    const size_t n = input.size();
+    std::vector<std::complex<double>> spectrum(n);
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> sum = 0.0;
+        for (size_t t = 0; t < n; ++t) {
+            sum += static_cast<double>(input[t]) *
+                   std::polar(1.0, -2.0 * M_PI * static_cast<double>(k * t % n) / static_cast<double>(n));
+        }
+        spectrum[k] = sum;
+    }
+    return spectrum;
+}
+
+class RealFFTSizeTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(RealFFTSizeTest, ForwardMatchesDirectTransform) {
+    const size_t size = GetParam();
+    const RealFFT fft(size);
+    ASSERT_EQ(fft.numBins(), size / 2 + 1);
+
+    const auto input = randomSignal(size, 17);
+    std::vector<std::complex<float>> spectrum(fft.numBins());
+    fft.forward(input.data(), spectrum.data());
+
+    const auto expected = naiveDft(input);
+    const double tolerance = 1e-4 * std::sqrt(static_cast<double>(size)) * std::log2(static_cast<double>(size) + 1.0);
+    for (size_t k = 0; k < fft.numBins(); ++k) {
+        EXPECT_NEAR(spectrum[k].real(), expected[k].real(), tolerance) << "bin " << k;
+        EXPECT_NEAR(spectrum[k].imag(), expected[k].imag(), tolerance) << "bin " << k;
+    }
+}
+
+TEST_P(RealFFTSizeTest, InverseRestoresInput) {
+    const size_t size = GetParam();
+    const RealFFT fft(size);
+
+    const auto input = randomSignal(size, 29);
+    std::vector<std::complex<float>> spectrum(fft.numBins());
+    std::vector<float> output(size);
+    fft.forward(input.data(), spectrum.data());
+    fft.inverse(spectrum.data(), output.data());
+
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(output[i], input[i], 1e-4f) << "sample " << i;
+    }
+}
+
+// Powers of two (both radix-4 parities) and Bluestein sizes
+INSTANTIATE_TEST_SUITE_P(Sizes, RealFFTSizeTest,
+                         ::testing::Values(size_t(2), size_t(8), size_t(16), size_t(64), size_t(512),
+                                           size_t(2048), size_t(6), size_t(100), size_t(441)));
+
+TEST(RealFFTTest, FullSpectrumIsConjugateSymmetric) {
+    const RealFFT fft(64);
+    const auto input = randomSignal(40, 5);
+
+    std::vector<std::complex<float>> spectrum;
+    fft.forwardFull(input, spectrum);
+    ASSERT_EQ(spectrum.size(), 64u);
+
+    // Shorter input is zero-padded
+    auto padded = input;
+    padded.resize(64, 0.0f);
+    const auto expected = naiveDft(padded);
+
+    for (size_t k = 1; k < 64; ++k) {
+        EXPECT_NEAR(spectrum[k].real(), spectrum[64 - k].real(), 1e-5f);
+        EXPECT_NEAR(spectrum[k].imag(), -spectrum[64 - k].imag(), 1e-5f);
+        EXPECT_NEAR(spectrum[k].real(), expected[k].real(), 1e-3);
+        EXPECT_NEAR(spectrum[k].imag(), expected[k].imag(), 1e-3);
+    }
+}
+
+TEST(RealFFTTest, InverseFullTakesAsymmetricSpectra) {
+    const size_t size = 32;
+    const RealFFT fft(size);
+
+    // A single positive-frequency bin: the real part of its inverse is a cosine at half amplitude
+    std::vector<std::complex<float>> spectrum(size, 0.0f);
+    spectrum[3] = std::complex<float>(static_cast<float>(size), 0.0f);
+
+    std::vector<float> output;
+    fft.inverseFull(spectrum, output);
+    ASSERT_EQ(output.size(), size);
+
+    for (size_t i = 0; i < size; ++i) {
+        const double expected = std::cos(2.0 * M_PI * 3.0 * static_cast<double>(i) / static_cast<double>(size));
+        EXPECT_NEAR(output[i], expected, 1e-5) << "sample " << i;
+    }
+}
+
+TEST(RealFFTTest, PlansAreSharedPerSize) {
+    const auto first = RealFFT::plan(1024);
+    const auto again = RealFFT::plan(1024);
+    const auto other = RealFFT::plan(2048);
+
+    EXPECT_EQ(first.get(), again.get());
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_EQ(other->size(), 2048u);
+}
+
+TEST(RealFFTTest, UnusedPlansAreReleased) {
+    std::weak_ptr<const RealFFT> released = RealFFT::plan(1000);
+
+    // Asking for another size drops this thread's hold on the old plan
+    const auto current = RealFFT::plan(1001);
+    EXPECT_TRUE(released.expired());
+
+    const auto rebuilt = RealFFT::plan(1000);
+    EXPECT_EQ(rebuilt->size(), 1000u);
+    EXPECT_EQ(RealFFT::plan(1000).get(), rebuilt.get());
+    EXPECT_EQ(RealFFT::plan(1001).get(), current.get());
+}
+
+} // namespace
+} // namespace vital
@@ -23,6 +23,7 @@
 
 // Include all the phase improvements
 #include "audio_engine/vital_audio_engine.h"
+#include "audio_engine/offline_renderer.h"
 #include "audio_quality/audio_quality.h"
 #include "performance/simd_vectorization.h"
 #include "performance/multithreading.h"
@@ -101,6 +102,14 @@ void VitalApplication::initialise(const juce::String& commandLine) {
             DBG("Command Line: " << commandLine);
         }
         
+        // Offline rendering needs no devices or UI; exit as soon as it finishes
+        if (command_line_options_.isOfflineRender()) {
+            setApplicationReturnValue(runOfflineRender());
+            state_.store(ApplicationState::Initialised);
+            juce::JUCEApplication::quit();
+            return;
+        }
+        
         // Initialize core systems
         if (!initializeCoreSystems()) {
             throw std::runtime_error("Failed to initialize core systems");
@@ -751,6 +760,37 @@ VitalApplication::CommandLineOptions VitalApplication::parseCommandLine(const ju
         else if (token == "--verbose" || token == "-v") {
             options.verbose_logging = true;
         }
+        else if (token.startsWith("--render-midi=")) {
+            options.render_midi_file = token.substring(14);
+        }
+        else if (token.startsWith("--render-out=")) {
+            options.render_output_file = token.substring(13);
+        }
+        else if (token.startsWith("--render-batch=")) {
+            options.render_batch_file = token.substring(15);
+        }
+        else if (token.startsWith("--render-split=")) {
+            options.render_split = token.substring(15);
+        }
+        else if (token.startsWith("--render-threads=")) {
+            options.render_threads = token.substring(17).getIntValue();
+        }
+        else if (token.startsWith("--render-block=")) {
+            options.render_block_size = token.substring(15).getIntValue();
+        }
+        else if (token.startsWith("--render-bits=")) {
+            options.render_bit_depth = token.substring(14).getIntValue();
+        }
+        else if (token.startsWith("--render-tail=")) {
+            options.render_tail_seconds = token.substring(14).getFloatValue();
+        }
+    }
+    
+    if (options.isOfflineRender()) {
+        options.headless = true;
+        if (options.render_threads <= 0) {
+            options.render_threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
     }
     
     // Detect mode if not explicitly set
@@ -762,6 +802,100 @@ VitalApplication::CommandLineOptions VitalApplication::parseCommandLine(const ju
     return options;
 }
 
+//==============================================================================
+int VitalApplication::runOfflineRender() {
+    using vital::audio_engine::OfflineRenderer;
+    
+    const auto& options = command_line_options_;
+    
+    OfflineRenderer::Settings base;
+    base.sampleRate = options.sample_rate;
+    base.blockSize = options.render_block_size;
+    base.maxVoices = options.max_voices;
+    base.bitDepth = options.render_bit_depth;
+    base.tailSeconds = options.render_tail_seconds;
+    base.numThreads = options.render_threads;
+    
+    if (options.render_split == "voice") {
+        base.splitMode = OfflineRenderer::SplitMode::ByVoice;
+    } else if (options.render_split == "time") {
+        base.splitMode = OfflineRenderer::SplitMode::ByTimeSegment;
+    } else if (options.render_split != "none") {
+        std::cerr << "Unknown --render-split value: " << options.render_split
+                  << " (expected none, voice or time)" << std::endl;
+        return 1;
+    }
+    
+    const auto toFile = [](const juce::String& path) {
+        return path.isEmpty() ? juce::File() : juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    };
+    
+    std::vector<OfflineRenderer::Settings> jobs;
+    
+    if (options.render_batch_file.isNotEmpty()) {
+        const auto batchFile = toFile(options.render_batch_file);
+        if (!batchFile.existsAsFile()) {
+            std::cerr << "Batch file not found: " << batchFile.getFullPathName() << std::endl;
+            return 1;
+        }
+        
+        juce::StringArray lines;
+        batchFile.readLines(lines);
+        
+        for (const auto& line : lines) {
+            if (line.trim().isEmpty() || line.startsWith("#")) continue;
+            
+            juce::StringArray fields;
+            fields.addTokens(line, "\t", "");
+            
+            if (fields.size() != 3) {
+                std::cerr << "Skipping malformed batch line: " << line << std::endl;
+                continue;
+            }
+            
+            OfflineRenderer::Settings job = base;
+            job.presetFile = toFile(fields[0].trim());
+            job.midiFile = toFile(fields[1].trim());
+            job.outputFile = toFile(fields[2].trim());
+            jobs.push_back(job);
+        }
+        
+        if (jobs.empty()) {
+            std::cerr << "Batch file has no render jobs: " << batchFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    } else {
+        OfflineRenderer::Settings job = base;
+        job.presetFile = toFile(options.preset_file);
+        job.midiFile = toFile(options.render_midi_file);
+        job.outputFile = toFile(options.render_output_file);
+        jobs.push_back(job);
+    }
+    
+    std::vector<OfflineRenderer::Result> results;
+    if (jobs.size() == 1) {
+        results.push_back(OfflineRenderer::render(jobs.front()));
+    } else {
+        results = OfflineRenderer::renderBatch(jobs, options.render_threads);
+    }
+    
+    int failures = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        const auto outputPath = jobs[i].outputFile.getFullPathName();
+        
+        if (result.success) {
+            std::cout << outputPath << ": " << result.numSamples << " samples in "
+                      << result.renderSeconds << "s (" << result.realtimeFactor << "x realtime)" << std::endl;
+        } else {
+            std::cerr << outputPath << ": " << result.errorMessage << std::endl;
+            ++failures;
+        }
+    }
+    
+    return failures == 0 ? 0 : 1;
+}
+
 //==============================================================================
 void VitalApplication::loadConfiguration(const juce::File& configFile) {
     if (!configFile.exists()) {
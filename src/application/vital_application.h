@@ -164,6 +164,18 @@ public:
         float sample_rate = vital::app::SAMPLE_RATE;
         juce::String plugin_format = "auto"; // auto, vst3, au, lv2
         bool verbose_logging = false;
+        
+        // Offline rendering (implies headless)
+        juce::String render_midi_file = "";
+        juce::String render_output_file = "";   // .wav or .flac
+        juce::String render_batch_file = "";    // One "preset<TAB>midi<TAB>output" job per line
+        juce::String render_split = "none";     // none, voice, time
+        int render_threads = 1;
+        int render_block_size = static_cast<int>(vital::app::AUDIO_BUFFER_SIZE);
+        int render_bit_depth = 24;
+        float render_tail_seconds = 2.0f;
+        
+        bool isOfflineRender() const { return render_output_file.isNotEmpty() || render_batch_file.isNotEmpty(); }
     };
     
     CommandLineOptions parseCommandLine(const juce::String& commandLine);
@@ -253,6 +265,9 @@ private:
     } windows_opts_;
 #endif
     
+    // Offline rendering; returns the process exit code
+    int runOfflineRender();
+    
     // Initialization methods
     bool initializeCoreSystems();
     bool initializeAudioEngine();
@@ -19,6 +19,10 @@
 #include <mutex>
 #include <random>
 
+#include "../utility/oversampler.h"
+#include "../utility/polyphase_resampler.h"
+#include "../utility/dither_quantiser.h"
+
 namespace vital {
 namespace audio_engine {
 namespace audio_quality {
@@ -408,45 +412,182 @@ private:
         void correctDC(float* samples, int numSamples);
     };
     
+    /**
+     * Owns one chain of the shared oversampling service. The FIR filter types
+     * select linear phase half-bands, the others minimum phase; kNoAlias runs
+     * at the base rate. Nonlinear stages opt in through process().
+     */
     class AntiAliasingProcessor {
     public:
-        void initialize(const Config& config);
-        void processOversampled(const float* input, float* output, int numSamples);
-        void setFilterType(AntiAliasType type);
-        void setOversampleFactor(int factor);
-        void designFilter();
+        void initialize(const Config& config)
+        {
+            numChannels_ = juce::jlimit(1, utility::Oversampler::kMaxChannels, config.channels);
+            filterType_ = config.filterType;
+            oversampleFactor_ = config.oversampleFactor;
+            designFilter();
+        }
+        
+        /** Band-limit one channel through the chain without a nonlinear stage; input and output may alias */
+        void processOversampled(const float* input, float* output, int numSamples)
+        {
+            if (input != output) std::copy(input, input + numSamples, output);
+            process(&output, 1, numSamples, [](float* const*, int) {});
+        }
+        
+        /** Run callback(float* const* channels, int numOversampledSamples) on the oversampled channels in place */
+        template <typename Callback>
+        void process(float* const* channels, int numChannels, int numSamples, Callback&& callback)
+        {
+            oversampler_.process(channels, numChannels, numSamples, std::forward<Callback>(callback));
+        }
+        
+        /** Not real-time safe */
+        void setFilterType(AntiAliasType type)
+        {
+            filterType_ = type;
+            designFilter();
+        }
+        
+        /** 1, 2, 4 or 8. Not real-time safe. */
+        void setOversampleFactor(int factor)
+        {
+            oversampleFactor_ = factor;
+            designFilter();
+        }
+        
+        /** Fetch the shared design and allocate the chain */
+        void designFilter()
+        {
+            const bool linearPhase = filterType_ == AntiAliasType::kWindowedSinc || filterType_ == AntiAliasType::kFIR;
+            
+            utility::Oversampler::Config config;
+            config.factor = filterType_ == AntiAliasType::kNoAlias ? 1 : oversampleFactor_;
+            config.phase = linearPhase ? utility::Oversampler::Phase::Linear : utility::Oversampler::Phase::Minimum;
+            config.numChannels = numChannels_;
+            config.maxBlockSize = kBlockSize;
+            oversampler_.prepare(config);
+        }
+        
+        int getOversampleFactor() const { return oversampler_.getFactor(); }
+        
+        /** Delay added by the chain, in samples */
+        float getLatency() const { return oversampler_.getLatency(); }
+        
+        void reset() { oversampler_.reset(); }
         
     private:
+        static constexpr int kBlockSize = 512;
+        
         AntiAliasType filterType_ = AntiAliasType::kWindowedSinc;
         int oversampleFactor_ = 4;
-        std::vector<float> filterCoeffs_;
-        std::vector<float> filterState_;
-        int filterLength_ = 0;
-        
-        void applyLinearInterpolation(const float* input, float* output, int numSamples);
-        void applyHermiteInterpolation(const float* input, float* output, int numSamples);
-        void applyCubicInterpolation(const float* input, float* output, int numSamples);
-        void applyWindowedSinc(const float* input, float* output, int numSamples);
+        int numChannels_ = 2;
+        utility::Oversampler oversampler_;
     };
     
+    /**
+     * Final-stage word length reduction through the shared quantiser: dither
+     * and shaping run in one loop so the dither is shaped with the error, and
+     * the result can go straight into the host's PCM buffer.
+     */
     class NoiseShapingProcessor {
     public:
-        void initialize(const Config& config);
-        void process(float* samples, int numSamples);
-        void setShapingType(NoiseShapingType type);
-        void setFeedbackDelay(int delay);
-        void resetFeedback();
+        void initialize(const Config& config)
+        {
+            sampleRate_ = config.sampleRate;
+            numChannels_ = juce::jlimit(1, utility::DitherQuantiser::kMaxChannels, config.channels);
+            shapingType_ = config.shapingType;
+            wordLength_ = config.wordLength;
+            strength_ = config.shapingStrength;
+            errorFeedback_ = config.enableErrorFeedback;
+            ditherType_ = config.ditherType;
+            configure();
+        }
+        
+        /** Quantise channels in place to the word length */
+        void process(float* const* channels, int numChannels, int numSamples)
+        {
+            quantiser_.process(channels, numChannels, numSamples);
+        }
+        
+        /** Quantise one channel in place, using the first channel's state */
+        void process(float* samples, int numSamples)
+        {
+            quantiser_.process(&samples, 1, numSamples);
+        }
+        
+        /** Quantise channels into an interleaved 16- or 24-bit host buffer */
+        void processToPcm(const float* const* channels, int numChannels, int numSamples,
+                          void* destination, utility::DitherQuantiser::Format format)
+        {
+            quantiser_.process(channels, numChannels, numSamples, destination, format);
+        }
+        
+        /** Not real-time safe */
+        void setShapingType(NoiseShapingType type)
+        {
+            shapingType_ = type;
+            configure();
+        }
+        
+        /** Not real-time safe */
+        void setWordLength(int bits)
+        {
+            wordLength_ = bits;
+            configure();
+        }
+        
+        /** Not real-time safe */
+        void setShapingStrength(float strength)
+        {
+            strength_ = strength;
+            configure();
+        }
+        
+        /** Not real-time safe */
+        void setDitherType(DitherType type)
+        {
+            ditherType_ = type;
+            configure();
+        }
+        
+        void resetFeedback() { quantiser_.reset(); }
         
     private:
         NoiseShapingType shapingType_ = NoiseShapingType::kPsychoacoustic;
-        int feedbackDelay_ = 1;
-        std::vector<float> feedbackBuffer_;
-        float previousError_ = 0.0f;
-        int feedbackIndex_ = 0;
-        
-        void applySimpleShaping(float* samples, int numSamples);
-        void applyPsychoacousticShaping(float* samples, int numSamples);
-        float calculateErrorSignal(float sample, float quantized);
+        DitherType ditherType_ = DitherType::kTriangular;
+        double sampleRate_ = 44100.0;
+        int numChannels_ = 2;
+        int wordLength_ = 16;
+        float strength_ = 0.5f;
+        bool errorFeedback_ = true;
+        utility::DitherQuantiser quantiser_;
+        
+        /** Map the engine's settings onto the quantiser */
+        void configure()
+        {
+            using Quantiser = utility::DitherQuantiser;
+            
+            Quantiser::Config config;
+            config.sampleRate = sampleRate_;
+            config.numChannels = numChannels_;
+            config.bitDepth = wordLength_;
+            config.shapingStrength = strength_;
+            
+            switch (ditherType_) {
+                case DitherType::kNoDither:    config.dither = Quantiser::Dither::None; break;
+                case DitherType::kRectangular: config.dither = Quantiser::Dither::Rectangular; break;
+                default:                       config.dither = Quantiser::Dither::Triangular; break;
+            }
+            
+            switch (errorFeedback_ ? shapingType_ : NoiseShapingType::kNoShaping) {
+                case NoiseShapingType::kNoShaping:     config.shaping = Quantiser::Shaping::None; break;
+                case NoiseShapingType::kSimple:        config.shaping = Quantiser::Shaping::FirstOrder; break;
+                case NoiseShapingType::kWeightedNoise: config.shaping = Quantiser::Shaping::EWeighted; break;
+                default:                               config.shaping = Quantiser::Shaping::FWeighted; break;
+            }
+            
+            quantiser_.prepare(config);
+        }
     };
     
     class StereoProcessor {
@@ -470,23 +611,112 @@ private:
         void widenStereo(float* left, float* right, int numSamples);
     };
     
+    /**
+     * Streams audio from the engine rate to the target rate through the shared
+     * polyphase sinc tables. Quality scales the kernel around filterLength and
+     * sets the stopband; phase preservation keeps output time aligned with the
+     * input instead of starting with half a kernel of latency.
+     */
     class ResamplingProcessor {
     public:
-        void initialize(const Config& config);
-        void process(const float* input, float* output, int numInput, int numOutput);
-        void setQuality(ResampleQuality quality);
-        void enablePhasePreservation(bool enable);
+        void initialize(const Config& config)
+        {
+            inputRate_ = config.sampleRate;
+            outputRate_ = config.targetSampleRate;
+            numChannels_ = juce::jlimit(1, utility::PolyphaseResampler::kMaxChannels, config.channels);
+            quality_ = config.quality;
+            preservePhase_ = config.preservePhase;
+            filterLength_ = config.filterLength;
+            cutoff_ = config.resampleCutoff;
+            designPolyphaseFilter();
+        }
+        
+        /** Convert until the input runs out or maxOutput samples are written; see PolyphaseResampler::process() */
+        utility::PolyphaseResampler::Result process(const float* const* input, int numChannels, int numInput,
+                                                    float* const* output, int maxOutput)
+        {
+            return resampler_.process(input, numChannels, numInput, output, maxOutput);
+        }
+        
+        /** Convert one channel; returns the number of outputs written */
+        int process(const float* input, float* output, int numInput, int numOutput)
+        {
+            return resampler_.process(&input, 1, numInput, &output, numOutput).produced;
+        }
+        
+        /** Input samples needed for the next numOutput outputs, for pulling at a fixed output block size */
+        int getRequiredInput(int numOutput) const { return resampler_.getRequiredInput(numOutput); }
+        
+        /** Output room needed to consume numInput samples in one call */
+        int getMaxOutput(int numInput) const { return resampler_.getMaxOutput(numInput); }
+        
+        /** Drain the end of an offline render */
+        int flush(float* const* output, int numChannels, int maxOutput)
+        {
+            return resampler_.flush(output, numChannels, maxOutput);
+        }
+        
+        /** Not real-time safe */
+        void setQuality(ResampleQuality quality)
+        {
+            quality_ = quality;
+            designPolyphaseFilter();
+        }
+        
+        /** Not real-time safe */
+        void enablePhasePreservation(bool enable)
+        {
+            preservePhase_ = enable;
+            designPolyphaseFilter();
+        }
+        
+        /** Not real-time safe */
+        void setSampleRates(double inputRate, double outputRate)
+        {
+            inputRate_ = inputRate;
+            outputRate_ = outputRate;
+            designPolyphaseFilter();
+        }
+        
+        /** Kernel length at kHigh, in samples at the lower rate. Not real-time safe. */
+        void setFilterLength(int length)
+        {
+            filterLength_ = length;
+            designPolyphaseFilter();
+        }
+        
+        /** Output delay in input samples; 0 with phase preservation */
+        float getLatency() const { return resampler_.getLatency(); }
+        
+        void reset() { resampler_.reset(); }
         
     private:
         ResampleQuality quality_ = ResampleQuality::kHigh;
         bool preservePhase_ = true;
-        std::vector<float> resampleFilter_;
-        std::vector<float> phaseTable_;
-        float ratio_ = 1.0f;
+        double inputRate_ = 44100.0;
+        double outputRate_ = 44100.0;
+        int numChannels_ = 2;
+        int filterLength_ = 128;
+        float cutoff_ = 0.95f;
+        utility::PolyphaseResampler resampler_;
         
-        void designPolyphaseFilter();
-        void applyPolyphaseResampling(const float* input, const float* filter,
-                                     float* output, int numInput, int numOutput);
+        /** Fetch the shared phase table for the current rates and quality */
+        void designPolyphaseFilter()
+        {
+            static constexpr float kLengthScale[] = { 0.25f, 0.5f, 1.0f, 1.5f, 2.0f };
+            static constexpr float kAttenuationDb[] = { 60.0f, 80.0f, 100.0f, 120.0f, 140.0f };
+            const auto index = static_cast<size_t>(quality_);
+            
+            utility::PolyphaseResampler::Config config;
+            config.inputRate = inputRate_;
+            config.outputRate = outputRate_;
+            config.numChannels = numChannels_;
+            config.numTaps = static_cast<int>(static_cast<float>(filterLength_) * kLengthScale[index]);
+            config.cutoff = cutoff_;
+            config.attenuationDb = kAttenuationDb[index];
+            config.timeAligned = preservePhase_;
+            resampler_.prepare(config);
+        }
     };
     
     //==============================================================================
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+    event_scheduler.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Sample-accurate event scheduling for the VitalAudioEngine
+    Splits each audio block into sub-blocks at MIDI and automation timestamps
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace vital {
+namespace audio_engine {
+namespace core {
+
+//==============================================================================
+/**
+ * @class EventScheduler
+ * @brief Allocation-free, sample-accurate event pipeline for the audio thread
+ *
+ * Collects MIDI and parameter automation events for one block into a
+ * pre-sized event list, orders them by sample offset and then walks the
+ * block, rendering the audio between consecutive event timestamps and
+ * dispatching each event exactly at its sample position.
+ *
+ * All storage is reserved in prepare(); the add methods and process() never
+ * allocate, lock or format strings. Events that do not fit into the reserved
+ * capacity are dropped and counted.
+ */
+class EventScheduler
+{
+public:
+    //==============================================================================
+    /** A single timestamped event */
+    struct Event
+    {
+        enum class Type : uint8_t {
+            NoteOn,
+            NoteOff,
+            AllNotesOff,
+            Controller,
+            ParameterChange
+        };
+
+        int sampleOffset = 0;
+        Type type = Type::NoteOn;
+        int channel = 0;
+        int number = 0;       // Note number, CC number or parameter id
+        float value = 0.0f;   // Normalised velocity, CC value or parameter value
+    };
+
+    //==============================================================================
+    EventScheduler() = default;
+
+    /** Reserve storage for the busiest expected block. Not real-time safe. */
+    void prepare(int maxEventsPerBlock)
+    {
+        jassert(maxEventsPerBlock > 0);
+        events_.assign(static_cast<size_t>(maxEventsPerBlock), Event{});
+        numEvents_ = 0;
+    }
+
+    /** Discard all pending events */
+    void clear() noexcept { numEvents_ = 0; }
+
+    //==============================================================================
+    /** Append every channel-voice message in buffer, in a single pass */
+    void addMidiBuffer(const juce::MidiBuffer& buffer, int midiChannel = 0) noexcept
+    {
+        for (const auto metadata : buffer) {
+            if (metadata.numBytes < 1) continue;
+
+            const uint8_t status = metadata.data[0];
+            if (status < 0x80 || status >= 0xf0) continue; // Ignore running status and system messages
+
+            const int channel = (status & 0x0f) + 1;
+            if (midiChannel != 0 && channel != midiChannel) continue;
+
+            const int data1 = metadata.numBytes > 1 ? (metadata.data[1] & 0x7f) : 0;
+            const int data2 = metadata.numBytes > 2 ? (metadata.data[2] & 0x7f) : 0;
+
+            Event event;
+            event.sampleOffset = metadata.samplePosition;
+            event.channel = channel;
+            event.number = data1;
+
+            switch (status & 0xf0) {
+                case 0x90:
+                    event.type = data2 > 0 ? Event::Type::NoteOn : Event::Type::NoteOff;
+                    event.value = data2 / 127.0f;
+                    break;
+                case 0x80:
+                    event.type = Event::Type::NoteOff;
+                    event.value = data2 / 127.0f;
+                    break;
+                case 0xb0:
+                    event.type = (data1 == 123) ? Event::Type::AllNotesOff : Event::Type::Controller;
+                    event.value = data2 / 127.0f;
+                    break;
+                default:
+                    continue;
+            }
+
+            push(event);
+        }
+    }
+
+    /** Schedule a parameter change at a sample offset within the next processed block */
+    bool addParameterChange(int sampleOffset, int paramId, float value) noexcept
+    {
+        Event event;
+        event.sampleOffset = sampleOffset;
+        event.type = Event::Type::ParameterChange;
+        event.number = paramId;
+        event.value = value;
+        return push(event);
+    }
+
+    //==============================================================================
+    /**
+     * Walk a block of numSamples in timestamp order and consume its events.
+     *
+     * handleEvent(const Event&) is invoked for every event at its sample
+     * position, before renderSubBlock(int startSample, int numSamples) renders
+     * the samples up to the next event. Sub-blocks never have zero length;
+     * events past the end of the block are delivered on its last sample.
+     */
+    template <typename EventHandler, typename SubBlockRenderer>
+    void process(int numSamples, EventHandler&& handleEvent, SubBlockRenderer&& renderSubBlock)
+    {
+        const int lastSample = std::max(0, numSamples - 1);
+        for (int i = 0; i < numEvents_; ++i) {
+            events_[i].sampleOffset = std::min(events_[i].sampleOffset, lastSample);
+        }
+
+        sortEvents();
+
+        int position = 0;
+        int index = 0;
+
+        while (position < numSamples) {
+            while (index < numEvents_ && events_[index].sampleOffset <= position) {
+                handleEvent(events_[index++]);
+            }
+
+            const int next = index < numEvents_ ? events_[index].sampleOffset : numSamples;
+            renderSubBlock(position, next - position);
+            position = next;
+        }
+
+        // Zero-length blocks still deliver their events
+        while (index < numEvents_) {
+            handleEvent(events_[index++]);
+        }
+
+        numEvents_ = 0;
+    }
+
+    //==============================================================================
+    /** Statistics */
+    int getNumEvents() const noexcept { return numEvents_; }
+    int getCapacity() const noexcept { return static_cast<int>(events_.size()); }
+    uint64_t getNumDroppedEvents() const noexcept { return droppedEvents_; }
+
+private:
+    //==============================================================================
+    std::vector<Event> events_;
+    int numEvents_ = 0;
+    uint64_t droppedEvents_ = 0;
+
+    bool push(Event event) noexcept
+    {
+        if (numEvents_ >= static_cast<int>(events_.size())) {
+            ++droppedEvents_;
+            return false;
+        }
+
+        event.sampleOffset = std::max(0, event.sampleOffset);
+        events_[numEvents_++] = event;
+        return true;
+    }
+
+    /** Stable in-place insertion sort; MIDI arrives ordered so this is O(n) in practice */
+    void sortEvents() noexcept
+    {
+        for (int i = 1; i < numEvents_; ++i) {
+            const Event event = events_[i];
+            int j = i - 1;
+
+            while (j >= 0 && events_[j].sampleOffset > event.sampleOffset) {
+                events_[j + 1] = events_[j];
+                --j;
+            }
+
+            events_[j + 1] = event;
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(EventScheduler)
+};
+
+} // namespace core
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+    parallel_voice_renderer.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the parallel voice group renderer
+  ==============================================================================
+*/
+
+#include "parallel_voice_renderer.h"
+#include "../../performance/multithreading.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace core {
+
+namespace {
+
+inline void cpuRelax() noexcept
+{
+   #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+   #elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+   #else
+    std::this_thread::yield();
+   #endif
+}
+
+} // namespace
+
+//==============================================================================
+// Lifecycle
+//==============================================================================
+
+ParallelVoiceRenderer::~ParallelVoiceRenderer()
+{
+    release();
+}
+
+bool ParallelVoiceRenderer::prepare(const Config& config)
+{
+    release();
+
+    config_ = config;
+    config_.numWorkers = std::max(0, config.numWorkers);
+    config_.maxVoices = std::max(1, config.maxVoices);
+    config_.maxBlockSize = std::max(1, config.maxBlockSize);
+    config_.numChannels = std::max(1, config.numChannels);
+    config_.voicesPerGroup = std::max(1, config.voicesPerGroup);
+
+    voicesPerGroup_ = config_.voicesPerGroup;
+    numGroups_ = (config_.maxVoices + voicesPerGroup_ - 1) / voicesPerGroup_;
+    jassert(numGroups_ <= static_cast<int>(kIndexMask));
+
+    groupBuffers_.clear();
+    groupBuffers_.reserve(static_cast<size_t>(numGroups_));
+    for (int group = 0; group < numGroups_; ++group) {
+        groupBuffers_.emplace_back(config_.numChannels, config_.maxBlockSize);
+    }
+
+    if (config_.numWorkers == 0) {
+        return true;
+    }
+
+    // The first optimal core is where AudioThreadManager pins the audio thread, so workers skip it
+    std::vector<int> cores;
+    if (config_.pinThreads) {
+        cores = performance::threading::ThreadPlatform::get_audio_optimal_cores(config_.numWorkers + 1);
+        if (!cores.empty()) {
+            cores.erase(cores.begin());
+        }
+    }
+
+    try {
+        stopWorkers_.store(false);
+        workers_.reserve(static_cast<size_t>(config_.numWorkers));
+
+        for (int worker = 0; worker < config_.numWorkers; ++worker) {
+            const size_t coreIndex = static_cast<size_t>(worker);
+            const int cpuCore = coreIndex < cores.size() ? cores[coreIndex] : -1;
+            workers_.emplace_back(&ParallelVoiceRenderer::workerLoop, this, cpuCore);
+        }
+    } catch (...) {
+        release();
+        return false;
+    }
+
+    return true;
+}
+
+void ParallelVoiceRenderer::release()
+{
+    if (workers_.empty()) return;
+
+    stopWorkers_.store(true);
+
+    // Bump the generation so parked workers wake and see the stop flag
+    jobWord_.fetch_add(uint64_t(1) << kGenerationShift);
+    jobWord_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+
+    workers_.clear();
+}
+
+//==============================================================================
+// Job Distribution
+//==============================================================================
+
+void ParallelVoiceRenderer::runJobs(int numJobs, JobFunction function, void* context) noexcept
+{
+    if (numJobs <= 0) return;
+
+    if (workers_.empty()) {
+        for (int job = 0; job < numJobs; ++job) {
+            function(context, job);
+        }
+        return;
+    }
+
+    jobFunction_ = function;
+    jobContext_ = context;
+    remainingJobs_.store(numJobs, std::memory_order_relaxed);
+
+    // Only this thread changes the generation, so a relaxed read is enough
+    const uint32_t generation = generationOf(jobWord_.load(std::memory_order_relaxed)) + 1;
+    jobWord_.store((uint64_t(generation) << kGenerationShift) | (uint64_t(numJobs) << kCountShift));
+
+    if (parkedWorkers_.load() > 0) {
+        jobWord_.notify_all();
+    }
+
+    // Take part in the work, then wait only for groups still in flight
+    runClaimedJobs(generation);
+
+    while (remainingJobs_.load(std::memory_order_acquire) > 0) {
+        cpuRelax();
+    }
+}
+
+int ParallelVoiceRenderer::runClaimedJobs(uint32_t generation) noexcept
+{
+    int jobsRun = 0;
+    uint64_t word = jobWord_.load(std::memory_order_acquire);
+
+    while (generationOf(word) == generation && indexOf(word) < countOf(word)) {
+        if (jobWord_.compare_exchange_weak(word, word + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            // The claimed group keeps the job alive, so its function is stable here
+            jobFunction_(jobContext_, indexOf(word));
+            remainingJobs_.fetch_sub(1, std::memory_order_release);
+            ++jobsRun;
+
+            word = jobWord_.load(std::memory_order_acquire);
+        }
+    }
+
+    return jobsRun;
+}
+
+void ParallelVoiceRenderer::workerLoop(int cpuCore)
+{
+    using performance::threading::ThreadPlatform;
+
+    if (cpuCore >= 0) {
+        ThreadPlatform::set_thread_affinity(std::this_thread::get_id(), cpuCore);
+    }
+    ThreadPlatform::set_thread_priority(std::this_thread::get_id(), config_.threadPriority);
+
+    uint32_t seenGeneration = generationOf(jobWord_.load(std::memory_order_acquire));
+
+    while (true) {
+        uint64_t word = jobWord_.load(std::memory_order_acquire);
+        int spins = 0;
+
+        // Spin for a short while, then park until the next job is published
+        while (generationOf(word) == seenGeneration && !stopWorkers_.load(std::memory_order_relaxed)) {
+            if (++spins < kSpinIterations) {
+                cpuRelax();
+            } else {
+                parkedWorkers_.fetch_add(1);
+                word = jobWord_.load();
+                if (generationOf(word) == seenGeneration && !stopWorkers_.load()) {
+                    jobWord_.wait(word);
+                }
+                parkedWorkers_.fetch_sub(1);
+                spins = 0;
+            }
+
+            word = jobWord_.load(std::memory_order_acquire);
+        }
+
+        if (stopWorkers_.load()) return;
+
+        seenGeneration = generationOf(word);
+        const int jobsRun = runClaimedJobs(seenGeneration);
+        offloadedGroups_.fetch_add(static_cast<uint64_t>(jobsRun), std::memory_order_relaxed);
+    }
+}
+
+} // namespace core
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+    voice_allocator.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the fixed-capacity voice allocator
+  ==============================================================================
+*/
+
+#include "voice_allocator.h"
+
+namespace vital {
+namespace audio_engine {
+namespace core {
+
+//==============================================================================
+// StealHeap Implementation
+//==============================================================================
+
+void VoiceAllocator::StealHeap::prepare(int capacity)
+{
+    heap_.assign(static_cast<size_t>(capacity), -1);
+    position_.assign(static_cast<size_t>(capacity), -1);
+    size_ = 0;
+}
+
+void VoiceAllocator::StealHeap::push(int id, const VoiceAllocator& owner) noexcept
+{
+    if (position_[id] != -1) return;
+
+    heap_[size_] = id;
+    position_[id] = size_;
+    siftUp(size_++, owner);
+}
+
+void VoiceAllocator::StealHeap::remove(int id, const VoiceAllocator& owner) noexcept
+{
+    const int index = position_[id];
+    if (index == -1) return;
+
+    const int last = --size_;
+    if (index != last) {
+        swapEntries(index, last);
+        position_[id] = -1;
+        siftDown(index, owner);
+        siftUp(index, owner);
+    } else {
+        position_[id] = -1;
+    }
+}
+
+void VoiceAllocator::StealHeap::update(int id, const VoiceAllocator& owner) noexcept
+{
+    const int index = position_[id];
+    if (index == -1) return;
+
+    siftUp(index, owner);
+    siftDown(position_[id], owner);
+}
+
+void VoiceAllocator::StealHeap::siftUp(int index, const VoiceAllocator& owner) noexcept
+{
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        if (!owner.stealsBefore(heap_[index], heap_[parent])) break;
+
+        swapEntries(index, parent);
+        index = parent;
+    }
+}
+
+void VoiceAllocator::StealHeap::siftDown(int index, const VoiceAllocator& owner) noexcept
+{
+    while (true) {
+        const int left = 2 * index + 1;
+        const int right = left + 1;
+        int smallest = index;
+
+        if (left < size_ && owner.stealsBefore(heap_[left], heap_[smallest])) smallest = left;
+        if (right < size_ && owner.stealsBefore(heap_[right], heap_[smallest])) smallest = right;
+        if (smallest == index) break;
+
+        swapEntries(index, smallest);
+        index = smallest;
+    }
+}
+
+void VoiceAllocator::StealHeap::swapEntries(int a, int b) noexcept
+{
+    std::swap(heap_[a], heap_[b]);
+    position_[heap_[a]] = a;
+    position_[heap_[b]] = b;
+}
+
+//==============================================================================
+// VoiceAllocator Implementation
+//==============================================================================
+
+void VoiceAllocator::prepare(const Config& config)
+{
+    jassert(config.maxVoices > 0);
+
+    config_ = config;
+    config_.mpeMasterChannel = clampChannel(config.mpeMasterChannel);
+
+    slots_.assign(static_cast<size_t>(config_.maxVoices), Slot{});
+    noteHeads_.assign(kNumChannels * kNumNotes, -1);
+    noteTails_.assign(kNumChannels * kNumNotes, -1);
+
+    globalHeap_.prepare(config_.maxVoices);
+    groups_.resize(kNumChannels);
+
+    for (int group = 0; group < kNumChannels; ++group) {
+        groups_[group].heap.prepare(config_.maxVoices);
+        groups_[group].count = 0;
+        groups_[group].limit = config_.maxVoices;
+
+        const bool isMemberChannel = (group + 1) != config_.mpeMasterChannel;
+        if (config_.groupMode == GroupMode::MPE && isMemberChannel) {
+            groups_[group].limit = juce::jlimit(0, config_.maxVoices, config_.mpeVoicesPerMemberChannel);
+        }
+    }
+
+    reset();
+}
+
+void VoiceAllocator::reset() noexcept
+{
+    std::fill(noteHeads_.begin(), noteHeads_.end(), -1);
+    std::fill(noteTails_.begin(), noteTails_.end(), -1);
+
+    globalHeap_.clear();
+    for (auto& group : groups_) {
+        group.heap.clear();
+        group.count = 0;
+    }
+
+    // Rebuild the free list in id order
+    freeHead_ = -1;
+    for (int id = config_.maxVoices - 1; id >= 0; --id) {
+        slots_[id] = Slot{};
+        pushFree(id);
+    }
+
+    numSounding_ = 0;
+    numHeld_ = 0;
+    ageCounter_ = 0;
+}
+
+//==============================================================================
+// Allocation
+//==============================================================================
+
+VoiceAllocator::Allocation VoiceAllocator::noteOn(int note, int channel, float velocity) noexcept
+{
+    Allocation allocation;
+    note = juce::jlimit(0, kNumNotes - 1, note);
+    channel = clampChannel(channel);
+
+    // Same-note retrigger reuses the oldest voice already sounding this note
+    if (config_.stealPolicy == StealPolicy::SameNoteRetrigger) {
+        const int existing = noteHeads_[noteKey(channel, note)];
+        if (existing != -1) {
+            Slot& slot = slots_[existing];
+            if (slot.stage == VoiceStage::Released) numHeld_++;
+
+            slot.stage = VoiceStage::Held;
+            slot.velocity = velocity;
+            slot.level = velocity;
+            slot.age = ++ageCounter_;
+            updateOrder(existing);
+
+            allocation.voiceId = existing;
+            allocation.stolenVoiceId = existing;
+            allocation.retriggered = true;
+            return allocation;
+        }
+    }
+
+    const Group& group = groups_[getGroupForChannel(channel)];
+    int voiceId = -1;
+
+    if (group.count >= group.limit) {
+        // Group is full: steal inside the group so other channels are untouched
+        if (!config_.enableStealing || group.heap.top() == -1) return allocation;
+
+        voiceId = group.heap.top();
+        allocation.stolenVoiceId = voiceId;
+        deactivate(voiceId);
+    } else {
+        voiceId = popFree();
+        if (voiceId == -1) {
+            if (!config_.enableStealing || globalHeap_.top() == -1) return allocation;
+
+            voiceId = globalHeap_.top();
+            allocation.stolenVoiceId = voiceId;
+            deactivate(voiceId);
+        }
+    }
+
+    activate(voiceId, note, channel, velocity);
+    allocation.voiceId = voiceId;
+    return allocation;
+}
+
+int VoiceAllocator::noteOff(int note, int channel) noexcept
+{
+    if (note < 0 || note >= kNumNotes) return -1;
+
+    for (int id = noteHeads_[noteKey(clampChannel(channel), note)]; id != -1; id = slots_[id].next) {
+        if (slots_[id].stage == VoiceStage::Held) {
+            release(id);
+            return id;
+        }
+    }
+
+    return -1;
+}
+
+VoiceAllocator::Allocation VoiceAllocator::assign(int voiceId, int note, int channel, float velocity) noexcept
+{
+    Allocation allocation;
+    if (!isValid(voiceId)) return allocation;
+
+    if (slots_[voiceId].stage == VoiceStage::Free) {
+        unlinkFree(voiceId);
+    } else {
+        allocation.stolenVoiceId = voiceId;
+        deactivate(voiceId);
+    }
+
+    activate(voiceId, juce::jlimit(0, kNumNotes - 1, note), clampChannel(channel), velocity);
+    allocation.voiceId = voiceId;
+    return allocation;
+}
+
+bool VoiceAllocator::release(int voiceId) noexcept
+{
+    if (!isValid(voiceId) || slots_[voiceId].stage != VoiceStage::Held) return false;
+
+    slots_[voiceId].stage = VoiceStage::Released;
+    numHeld_--;
+    updateOrder(voiceId);
+    return true;
+}
+
+bool VoiceAllocator::free(int voiceId) noexcept
+{
+    if (!isValid(voiceId) || slots_[voiceId].stage == VoiceStage::Free) return false;
+
+    deactivate(voiceId);
+    pushFree(voiceId);
+    return true;
+}
+
+//==============================================================================
+// Steal Order
+//==============================================================================
+
+void VoiceAllocator::setVoiceLevel(int voiceId, float level) noexcept
+{
+    if (!isValid(voiceId) || slots_[voiceId].stage == VoiceStage::Free) return;
+
+    slots_[voiceId].level = level;
+    if (config_.stealPolicy == StealPolicy::Quietest) {
+        updateOrder(voiceId);
+    }
+}
+
+void VoiceAllocator::setVoicePriority(int voiceId, int priority) noexcept
+{
+    if (!isValid(voiceId) || slots_[voiceId].stage == VoiceStage::Free) return;
+
+    slots_[voiceId].priority = priority;
+    updateOrder(voiceId);
+}
+
+void VoiceAllocator::setStealPolicy(StealPolicy policy) noexcept
+{
+    if (policy == config_.stealPolicy) return;
+    config_.stealPolicy = policy;
+
+    // Ordering changed: rebuild every heap from the sounding voices
+    globalHeap_.clear();
+    for (auto& group : groups_) group.heap.clear();
+
+    for (int id = 0; id < config_.maxVoices; ++id) {
+        if (slots_[id].stage != VoiceStage::Free) {
+            globalHeap_.push(id, *this);
+            groups_[slots_[id].group].heap.push(id, *this);
+        }
+    }
+}
+
+int VoiceAllocator::peekStealCandidate() const noexcept
+{
+    return globalHeap_.top();
+}
+
+bool VoiceAllocator::stealsBefore(int a, int b) const noexcept
+{
+    const Slot& x = slots_[a];
+    const Slot& y = slots_[b];
+
+    if (x.priority != y.priority) return x.priority < y.priority;
+
+    switch (config_.stealPolicy) {
+        case StealPolicy::ReleaseStageFirst:
+            if (x.stage != y.stage) return x.stage == VoiceStage::Released;
+            break;
+        case StealPolicy::Quietest:
+            if (x.level != y.level) return x.level < y.level;
+            break;
+        case StealPolicy::Oldest:
+        case StealPolicy::SameNoteRetrigger:
+            break;
+    }
+
+    return x.age < y.age;
+}
+
+//==============================================================================
+// Groups
+//==============================================================================
+
+void VoiceAllocator::setGroupVoiceLimit(int group, int limit) noexcept
+{
+    if (group < 0 || group >= static_cast<int>(groups_.size())) return;
+    groups_[group].limit = juce::jlimit(0, config_.maxVoices, limit);
+}
+
+int VoiceAllocator::getGroupVoiceLimit(int group) const noexcept
+{
+    if (group < 0 || group >= static_cast<int>(groups_.size())) return 0;
+    return groups_[group].limit;
+}
+
+int VoiceAllocator::getGroupForChannel(int channel) const noexcept
+{
+    if (config_.groupMode == GroupMode::Global) return 0;
+    return clampChannel(channel) - 1;
+}
+
+//==============================================================================
+// Voice Queries
+//==============================================================================
+
+VoiceAllocator::VoiceStage VoiceAllocator::getStage(int voiceId) const noexcept
+{
+    return isValid(voiceId) ? slots_[voiceId].stage : VoiceStage::Free;
+}
+
+int VoiceAllocator::getNote(int voiceId) const noexcept
+{
+    return isValid(voiceId) ? slots_[voiceId].note : -1;
+}
+
+int VoiceAllocator::getChannel(int voiceId) const noexcept
+{
+    return isValid(voiceId) ? slots_[voiceId].channel : 0;
+}
+
+//==============================================================================
+// Intrusive Lists
+//==============================================================================
+
+int VoiceAllocator::popFree() noexcept
+{
+    const int voiceId = freeHead_;
+    if (voiceId != -1) unlinkFree(voiceId);
+    return voiceId;
+}
+
+void VoiceAllocator::unlinkFree(int voiceId) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    if (slot.prev != -1) slots_[slot.prev].next = slot.next;
+    else freeHead_ = slot.next;
+    if (slot.next != -1) slots_[slot.next].prev = slot.prev;
+
+    slot.prev = slot.next = -1;
+}
+
+void VoiceAllocator::pushFree(int voiceId) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    slot.prev = -1;
+    slot.next = freeHead_;
+    if (freeHead_ != -1) slots_[freeHead_].prev = voiceId;
+    freeHead_ = voiceId;
+}
+
+void VoiceAllocator::linkNote(int voiceId) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    const int key = noteKey(slot.channel, slot.note);
+
+    slot.prev = noteTails_[key];
+    slot.next = -1;
+    if (noteTails_[key] != -1) slots_[noteTails_[key]].next = voiceId;
+    else noteHeads_[key] = voiceId;
+    noteTails_[key] = voiceId;
+}
+
+void VoiceAllocator::unlinkNote(int voiceId) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    const int key = noteKey(slot.channel, slot.note);
+
+    if (slot.prev != -1) slots_[slot.prev].next = slot.next;
+    else noteHeads_[key] = slot.next;
+    if (slot.next != -1) slots_[slot.next].prev = slot.prev;
+    else noteTails_[key] = slot.prev;
+
+    slot.prev = slot.next = -1;
+}
+
+//==============================================================================
+// Voice State Transitions
+//==============================================================================
+
+void VoiceAllocator::activate(int voiceId, int note, int channel, float velocity) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    slot.stage = VoiceStage::Held;
+    slot.note = note;
+    slot.channel = channel;
+    slot.group = getGroupForChannel(channel);
+    slot.velocity = velocity;
+    slot.level = velocity;
+    slot.priority = 0;
+    slot.age = ++ageCounter_;
+
+    linkNote(voiceId);
+    globalHeap_.push(voiceId, *this);
+    groups_[slot.group].heap.push(voiceId, *this);
+    groups_[slot.group].count++;
+
+    numSounding_++;
+    numHeld_++;
+}
+
+void VoiceAllocator::deactivate(int voiceId) noexcept
+{
+    Slot& slot = slots_[voiceId];
+    if (slot.stage == VoiceStage::Held) numHeld_--;
+
+    globalHeap_.remove(voiceId, *this);
+    groups_[slot.group].heap.remove(voiceId, *this);
+    groups_[slot.group].count--;
+    unlinkNote(voiceId);
+
+    slot.stage = VoiceStage::Free;
+    numSounding_--;
+}
+
+void VoiceAllocator::updateOrder(int voiceId) noexcept
+{
+    globalHeap_.update(voiceId, *this);
+    groups_[slots_[voiceId].group].heap.update(voiceId, *this);
+}
+
+} // namespace core
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+    voice_allocator.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Fixed-capacity voice allocator for the VitalAudioEngine
+    Intrusive free list, indexed steal heaps and per-channel/MPE voice groups
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace vital {
+namespace audio_engine {
+namespace core {
+
+//==============================================================================
+/**
+ * @class VoiceAllocator
+ * @brief Fixed-capacity voice allocator with O(1)/O(log n) allocate, release and steal
+ *
+ * All storage is sized in prepare(). After that, every operation is free of
+ * allocation and locks and is intended to be called from the audio thread
+ * only:
+ * - Free voices live on an intrusive doubly-linked free list (O(1))
+ * - Sounding voices are kept in indexed min-heaps ordered by the steal
+ *   policy, one global and one per voice group (O(log n) steal/update)
+ * - Voices are linked per (channel, note) so note-off and same-note
+ *   retrigger lookups do not scan the voice array
+ *
+ * A voice is either Free, Held (key down) or Released (in its release
+ * tail). Releasing or freeing a voice twice is a no-op, so a voice id can
+ * never appear on the free list more than once.
+ */
+class VoiceAllocator
+{
+public:
+    //==============================================================================
+    /** Which sounding voice is taken when no free voice is available */
+    enum class StealPolicy {
+        Oldest,              // Longest-sounding voice
+        Quietest,            // Lowest reported output level
+        SameNoteRetrigger,   // Reuse a voice already playing the note, else oldest
+        ReleaseStageFirst    // Voices in their release tail first, then oldest
+    };
+
+    /** How voices are partitioned into groups */
+    enum class GroupMode {
+        Global,      // One group shared by all channels
+        PerChannel,  // One group per MIDI channel
+        MPE          // Per-channel groups, member channels limited per MPE zone
+    };
+
+    enum class VoiceStage : uint8_t {
+        Free,
+        Held,
+        Released
+    };
+
+    //==============================================================================
+    /** Allocator configuration */
+    struct Config
+    {
+        int maxVoices = 32;
+        StealPolicy stealPolicy = StealPolicy::ReleaseStageFirst;
+        GroupMode groupMode = GroupMode::Global;
+        bool enableStealing = true;
+
+        // MPE lower zone settings
+        int mpeMasterChannel = 1;
+        int mpeVoicesPerMemberChannel = 1;
+    };
+
+    /** Result of a note-on allocation */
+    struct Allocation
+    {
+        int voiceId = -1;         // -1 when no voice could be allocated
+        int stolenVoiceId = -1;   // Voice that was cut off to make room, or -1
+        bool retriggered = false; // voiceId was already playing this note
+    };
+
+    static constexpr int kNumChannels = 16;
+    static constexpr int kNumNotes = 128;
+
+    //==============================================================================
+    VoiceAllocator() = default;
+
+    /** Size all internal storage. Not real-time safe. */
+    void prepare(const Config& config);
+
+    /** Return every voice to the free list */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Allocate (or steal, or retrigger) a voice for a note */
+    Allocation noteOn(int note, int channel, float velocity) noexcept;
+
+    /** Move the oldest held voice for (note, channel) into its release stage */
+    int noteOff(int note, int channel) noexcept;
+
+    /** Claim a specific voice id for a note, stealing it if it is sounding */
+    Allocation assign(int voiceId, int note, int channel, float velocity) noexcept;
+
+    /** Move a held voice into its release stage */
+    bool release(int voiceId) noexcept;
+
+    /** Return a voice to the free list once its output has finished */
+    bool free(int voiceId) noexcept;
+
+    //==============================================================================
+    /** Steal-order inputs */
+    void setVoiceLevel(int voiceId, float level) noexcept;
+    void setVoicePriority(int voiceId, int priority) noexcept;
+
+    /** Group configuration */
+    void setGroupVoiceLimit(int group, int limit) noexcept;
+    int getGroupVoiceLimit(int group) const noexcept;
+    int getGroupForChannel(int channel) const noexcept;
+
+    void setStealPolicy(StealPolicy policy) noexcept;
+    StealPolicy getStealPolicy() const noexcept { return config_.stealPolicy; }
+
+    //==============================================================================
+    /** Voice queries */
+    VoiceStage getStage(int voiceId) const noexcept;
+    int getNote(int voiceId) const noexcept;
+    int getChannel(int voiceId) const noexcept;
+    int getNumSoundingVoices() const noexcept { return numSounding_; }
+    int getNumHeldVoices() const noexcept { return numHeld_; }
+    int getMaxVoices() const noexcept { return config_.maxVoices; }
+
+    /** Voice the current policy would steal next, or -1 */
+    int peekStealCandidate() const noexcept;
+
+    /** Invoke fn(voiceId) for every sounding voice on channel (-1 = all channels) */
+    template <typename Callback>
+    void forEachSoundingVoice(int channel, Callback&& fn) const
+    {
+        for (int id = 0; id < config_.maxVoices; ++id) {
+            const Slot& slot = slots_[id];
+            if (slot.stage != VoiceStage::Free && (channel == -1 || slot.channel == clampChannel(channel))) {
+                fn(id);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        VoiceStage stage = VoiceStage::Free;
+        int note = -1;
+        int channel = 1;
+        int group = 0;
+        float velocity = 0.0f;
+        float level = 0.0f;
+        int priority = 0;
+        uint64_t age = 0;
+
+        // Intrusive links: free list when Free, per-note list otherwise
+        int prev = -1;
+        int next = -1;
+    };
+
+    /** Min-heap of voice ids ordered by VoiceAllocator::stealsBefore */
+    class StealHeap
+    {
+    public:
+        void prepare(int capacity);
+        void clear() noexcept { size_ = 0; std::fill(position_.begin(), position_.end(), -1); }
+
+        void push(int id, const VoiceAllocator& owner) noexcept;
+        void remove(int id, const VoiceAllocator& owner) noexcept;
+        void update(int id, const VoiceAllocator& owner) noexcept;
+
+        int top() const noexcept { return size_ > 0 ? heap_[0] : -1; }
+        int size() const noexcept { return size_; }
+
+    private:
+        std::vector<int> heap_;
+        std::vector<int> position_;
+        int size_ = 0;
+
+        void siftUp(int index, const VoiceAllocator& owner) noexcept;
+        void siftDown(int index, const VoiceAllocator& owner) noexcept;
+        void swapEntries(int a, int b) noexcept;
+    };
+
+    struct Group
+    {
+        StealHeap heap;
+        int limit = 0;
+        int count = 0;
+    };
+
+    //==============================================================================
+    Config config_;
+    std::vector<Slot> slots_;
+    std::vector<int> noteHeads_;   // kNumChannels * kNumNotes list heads
+    std::vector<int> noteTails_;
+    std::vector<Group> groups_;
+    StealHeap globalHeap_;
+
+    int freeHead_ = -1;
+    int numSounding_ = 0;
+    int numHeld_ = 0;
+    uint64_t ageCounter_ = 0;
+
+    //==============================================================================
+    bool stealsBefore(int a, int b) const noexcept;
+
+    bool isValid(int voiceId) const noexcept { return voiceId >= 0 && voiceId < config_.maxVoices; }
+    static int clampChannel(int channel) noexcept { return juce::jlimit(1, kNumChannels, channel); }
+    static int noteKey(int channel, int note) noexcept { return (channel - 1) * kNumNotes + note; }
+
+    int popFree() noexcept;
+    void unlinkFree(int voiceId) noexcept;
+    void pushFree(int voiceId) noexcept;
+
+    void linkNote(int voiceId) noexcept;
+    void unlinkNote(int voiceId) noexcept;
+
+    void activate(int voiceId, int note, int channel, float velocity) noexcept;
+    void deactivate(int voiceId) noexcept;
+    void updateOrder(int voiceId) noexcept;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(VoiceAllocator)
+};
+
+} // namespace core
+} // namespace audio_engine
+} // namespace vital
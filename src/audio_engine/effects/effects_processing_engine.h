@@ -17,6 +17,10 @@
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <array>
+
+#include "partitioned_convolver.h"
+#include "../filtering/biquad_coefficient_cache.h"
 
 namespace vital {
 namespace audio_engine {
@@ -69,9 +73,11 @@ public:
         bool enableMemoryOptimization = true;
         
         // Convolution settings
-        bool partitionedConvolution = true;
-        int partitionSize = 512;
-        int maxImpulseLength = 44100; // 1 second at 44.1kHz
+        bool partitionedConvolution = true;   // Non-uniform partitions; uniform when false
+        int partitionSize = 512;              // Zero-latency head block
+        int maxPartitionSize = 8192;          // Largest tail partition
+        bool backgroundConvolution = true;    // Tail partitions on a background thread
+        int maxImpulseLength = 0;             // Longest IR kept, in samples; 0 keeps the whole IR
         
         // Multi-band settings
         int numBands = 4;
@@ -241,6 +247,31 @@ public:
     void loadImpulseResponse(const juce::File& impulseFile);
     void loadImpulseResponse(const std::vector<float>& impulseResponse);
     void setConvolutionGain(float gain);
+    
+    /** Impulse response slots, convolved in parallel and summed */
+    static constexpr int kNumImpulseSlots = 4;
+    
+    /**
+     * Build the slot's convolver on the calling thread; processing picks it
+     * up at its next block without waiting on this call. Returns the samples
+     * kept: fewer than impulseResponse.size() when Config::maxImpulseLength
+     * truncated the response, 0 when it could not be loaded.
+     */
+    int loadImpulseResponse(int slot, const std::vector<float>& impulseResponse)
+    {
+        return convolution_ ? convolution_->loadImpulse(slot, impulseResponse) : 0;
+    }
+    
+    void clearImpulseResponse(int slot)
+    {
+        if (convolution_) convolution_->clearImpulse(slot);
+    }
+    
+    void setImpulseSlotGain(int slot, float gain)
+    {
+        if (convolution_) convolution_->setSlotGain(slot, gain);
+    }
+
     void setConvolutionMix(float mix);
     void setRoomSize(float size);
     void setDamping(float damping);
@@ -376,37 +407,280 @@ private:
     
     //==============================================================================
     /** Effect components - simplified implementations for demonstration */
+    /**
+     * Impulse response slots, each a PartitionedConvolver, summed into the wet
+     * signal. Loading builds the new convolver on the caller's thread and
+     * publishes it through the slot's pending pointer; process() adopts it at
+     * the start of its next block and hands the old one back through the
+     * retired pointer, so the audio thread never blocks, allocates or joins
+     * a tail thread. Retired convolvers are freed by the next load and by the
+     * destructor.
+     */
     class ConvolutionReverb {
     public:
-        void initialize(const Config& config);
-        void process(float* input, float* output, int numSamples);
-        void loadImpulse(const std::vector<float>& impulse);
+        ConvolutionReverb() = default;
+        
+        ~ConvolutionReverb()
+        {
+            for (int slot = 0; slot < kNumImpulseSlots; ++slot) {
+                delete pending_[slot].exchange(nullptr, std::memory_order_acquire);
+                delete retired_[slot].exchange(nullptr, std::memory_order_acquire);
+            }
+        }
+        
+        void initialize(const Config& config)
+        {
+            convolverConfig_.headBlockSize = config.partitionSize;
+            convolverConfig_.maxTailBlockSize = config.partitionedConvolution ? config.maxPartitionSize
+                                                                              : config.partitionSize;
+            convolverConfig_.backgroundTail = config.backgroundConvolution;
+            maxImpulseLength_ = config.maxImpulseLength;
+            
+            wetBuffer_.assign(static_cast<size_t>(std::max(1, config.bufferSize)), 0.0f);
+            slotBuffer_.assign(wetBuffer_.size(), 0.0f);
+        }
+        
+        /** Mono; input and output may alias. Blocks longer than Config::bufferSize run in pieces. */
+        void process(float* input, float* output, int numSamples)
+        {
+            adoptPendingImpulses();
+            
+            const int chunk = static_cast<int>(wetBuffer_.size());
+            for (int offset = 0; offset < numSamples; offset += chunk) {
+                processChunk(input + offset, output + offset, std::min(chunk, numSamples - offset));
+            }
+        }
+        
+        /**
+         * Build a convolver for an impulse response and queue it for the slot.
+         * Not real-time safe, but never waits for process(). Returns the number
+         * of samples kept, which is less than impulse.size() when
+         * Config::maxImpulseLength truncated it, or 0 if it could not be built.
+         */
+        int loadImpulse(const std::vector<float>& impulse) { return loadImpulse(0, impulse); }
+        
+        int loadImpulse(int slot, const std::vector<float>& impulse)
+        {
+            if (slot < 0 || slot >= kNumImpulseSlots || impulse.empty()) return 0;
+            
+            int length = static_cast<int>(impulse.size());
+            if (maxImpulseLength_ > 0) length = std::min(length, maxImpulseLength_);
+            
+            auto convolver = std::make_unique<PartitionedConvolver>();
+            if (!convolver->loadImpulse(impulse.data(), length, convolverConfig_)) return 0;
+            
+            publish(slot, std::move(convolver));
+            return length;
+        }
+        
+        /** Queue an empty convolver for the slot; not real-time safe */
+        void clearImpulse(int slot)
+        {
+            if (slot >= 0 && slot < kNumImpulseSlots) publish(slot, std::make_unique<PartitionedConvolver>());
+        }
+        
+        /** Clear the input history of the active convolvers; call from the audio thread or while it is stopped */
+        void reset()
+        {
+            for (auto& convolver : active_) {
+                if (convolver) convolver->reset();
+            }
+        }
+        
+        void setSlotGain(int slot, float gain)
+        {
+            if (slot >= 0 && slot < kNumImpulseSlots) slotGains_[slot].store(gain, std::memory_order_relaxed);
+        }
+        
         void setGain(float gain) { gain_ = gain; }
         void setMix(float mix) { mix_ = mix; }
         
+        /** 0 sizes each convolver from its impulse response */
+        void setMaxImpulseLength(int length) { maxImpulseLength_ = std::max(0, length); }
+        
     private:
-        std::vector<float> impulseResponse_;
-        std::vector<float> delayLine_;
+        void processChunk(const float* input, float* output, int numSamples)
+        {
+            std::fill(wetBuffer_.begin(), wetBuffer_.begin() + numSamples, 0.0f);
+            
+            for (int slot = 0; slot < kNumImpulseSlots; ++slot) {
+                auto* convolver = active_[slot].get();
+                if (convolver == nullptr || !convolver->isLoaded()) continue;
+                
+                convolver->process(input, slotBuffer_.data(), numSamples);
+                juce::FloatVectorOperations::addWithMultiply(wetBuffer_.data(), slotBuffer_.data(),
+                                                             slotGains_[slot].load(std::memory_order_relaxed),
+                                                             numSamples);
+            }
+            
+            const float wet = mix_ * gain_;
+            const float dry = 1.0f - mix_;
+            for (int i = 0; i < numSamples; ++i) {
+                output[i] = input[i] * dry + wetBuffer_[i] * wet;
+            }
+        }
+        
+        /** Audio thread: swap in queued convolvers whose slot has no retired one still waiting to be freed */
+        void adoptPendingImpulses() noexcept
+        {
+            for (int slot = 0; slot < kNumImpulseSlots; ++slot) {
+                if (pending_[slot].load(std::memory_order_relaxed) == nullptr) continue;
+                if (retired_[slot].load(std::memory_order_acquire) != nullptr) continue;
+                
+                auto* next = pending_[slot].exchange(nullptr, std::memory_order_acquire);
+                if (next == nullptr) continue;
+                
+                retired_[slot].store(active_[slot].release(), std::memory_order_release);
+                active_[slot].reset(next);
+            }
+        }
+        
+        /** Loader: free what the audio thread retired, then queue the new convolver, dropping an unclaimed one */
+        void publish(int slot, std::unique_ptr<PartitionedConvolver> convolver)
+        {
+            std::lock_guard<std::mutex> lock(loadMutex_);
+            delete retired_[slot].exchange(nullptr, std::memory_order_acquire);
+            delete pending_[slot].exchange(convolver.release(), std::memory_order_acq_rel);
+        }
+        
+        PartitionedConvolver::Config convolverConfig_;
+        
+        /** Owned by the audio thread */
+        std::array<std::unique_ptr<PartitionedConvolver>, kNumImpulseSlots> active_;
+        
+        /** Handoff: loaders fill pending_, the audio thread fills retired_, and each side only empties the other's */
+        std::array<std::atomic<PartitionedConvolver*>, kNumImpulseSlots> pending_{};
+        std::array<std::atomic<PartitionedConvolver*>, kNumImpulseSlots> retired_{};
+        std::mutex loadMutex_;
+        
+        std::array<std::atomic<float>, kNumImpulseSlots> slotGains_{ 1.0f, 1.0f, 1.0f, 1.0f };
+        std::vector<float> wetBuffer_;
+        std::vector<float> slotBuffer_;
         float gain_ = 1.0f;
         float mix_ = 1.0f;
-        int delayLength_ = 0;
-        int writeIndex_ = 0;
+        int maxImpulseLength_ = 0;
     };
     
+    /**
+     * Fourth-order Linkwitz-Riley band split, each crossover a pair of
+     * two-section cached biquads. Crossover moves glide per sample through the
+     * shared prewarp table, so sweeping them never redesigns a filter.
+     * Bands split off in series from the bottom; instead of running every
+     * lower band through each later crossover's allpass, the running sum is
+     * passed through it once, which keeps the bands phase aligned at one
+     * allpass per crossover.
+     */
     class MultiBandProcessor {
     public:
-        void initialize(const Config& config);
-        void process(float* input, float* output, int numSamples);
-        void setNumBands(int numBands);
-        void setCrossoverFrequency(int bandIndex, float frequency);
-        void setBandGain(int bandIndex, float gain);
-        void setBandEnabled(int bandIndex, bool enabled);
+        static constexpr int kMaxBands = 5;
+        
+        void initialize(const Config& config)
+        {
+            using Type = filtering::CachedBiquad::Type;
+            constexpr float kButterworthQ = 0.70710678f;
+            
+            for (int index = 0; index < kMaxBands - 1; ++index) {
+                auto& crossover = crossovers_[index];
+                crossover.lowPass.setResponse(Type::LowPass, kButterworthQ);
+                crossover.highPass.setResponse(Type::HighPass, kButterworthQ);
+                crossover.allPass.setResponse(Type::AllPass, kButterworthQ);
+                crossover.lowPass.setStages(2);
+                crossover.highPass.setStages(2);
+                
+                for (auto* filter : { &crossover.lowPass, &crossover.highPass, &crossover.allPass }) {
+                    filter->prepare(config.sampleRate);
+                    filter->snapFrequency(config.crossoverFrequencies[index]);
+                }
+            }
+            
+            bandGains_.fill(1.0f);
+            bandEnabled_.fill(true);
+            setNumBands(config.numBands);
+        }
+        
+        /** Mono; input and output may alias. Bands are weighted by their gains and summed. */
+        void process(float* input, float* output, int numSamples)
+        {
+            for (int offset = 0; offset < numSamples; offset += kChunk) {
+                const int count = std::min(kChunk, numSamples - offset);
+                float* sum = output + offset;
+                
+                std::copy(input + offset, input + offset + count, rest_.begin());
+                std::fill(sum, sum + count, 0.0f);
+                
+                for (int index = 0; index < numBands_ - 1; ++index) {
+                    auto& crossover = crossovers_[index];
+                    
+                    if (index > 0) crossover.allPass.process(sum, count);
+                    
+                    std::copy(rest_.begin(), rest_.begin() + count, band_.begin());
+                    crossover.lowPass.process(band_.data(), count);
+                    crossover.highPass.process(rest_.data(), count);
+                    juce::FloatVectorOperations::addWithMultiply(sum, band_.data(), getBandWeight(index), count);
+                }
+                
+                juce::FloatVectorOperations::addWithMultiply(sum, rest_.data(), getBandWeight(numBands_ - 1), count);
+            }
+        }
+        
+        void reset()
+        {
+            for (auto& crossover : crossovers_) {
+                crossover.lowPass.reset();
+                crossover.highPass.reset();
+                crossover.allPass.reset();
+            }
+        }
+        
+        void setNumBands(int numBands)
+        {
+            numBands_ = juce::jlimit(1, kMaxBands, numBands);
+        }
+        
+        /** Crossover above band bandIndex; glides there over the next block. Keep crossovers ascending. */
+        void setCrossoverFrequency(int bandIndex, float frequency)
+        {
+            if (bandIndex < 0 || bandIndex >= kMaxBands - 1) return;
+            
+            auto& crossover = crossovers_[bandIndex];
+            crossover.lowPass.setFrequency(frequency);
+            crossover.highPass.setFrequency(frequency);
+            crossover.allPass.setFrequency(frequency);
+        }
+        
+        /** Linear gain */
+        void setBandGain(int bandIndex, float gain)
+        {
+            if (bandIndex >= 0 && bandIndex < kMaxBands) bandGains_[bandIndex] = gain;
+        }
+        
+        /** Disabled bands pass at unity gain */
+        void setBandEnabled(int bandIndex, bool enabled)
+        {
+            if (bandIndex >= 0 && bandIndex < kMaxBands) bandEnabled_[bandIndex] = enabled;
+        }
         
     private:
-        std::vector<juce::LinkwitzRileyFilter<float>> filters_;
-        std::vector<float> bandGains_;
-        std::vector<bool> bandEnabled_;
+        static constexpr int kChunk = 256;
+        
+        struct Crossover
+        {
+            filtering::CachedBiquad lowPass, highPass, allPass;
+        };
+        
+        float getBandWeight(int bandIndex) const
+        {
+            return bandEnabled_[bandIndex] ? bandGains_[bandIndex] : 1.0f;
+        }
+        
+        std::array<Crossover, kMaxBands - 1> crossovers_;
+        std::array<float, kMaxBands> bandGains_{};
+        std::array<bool, kMaxBands> bandEnabled_{};
         int numBands_ = 4;
+        
+        /** Signal above the current crossover, and the band just split off */
+        alignas(32) std::array<float, kChunk> rest_{};
+        alignas(32) std::array<float, kChunk> band_{};
     };
     
     class AdaptiveEffects {
@@ -0,0 +1,409 @@
+/*
+  ==============================================================================
+    partitioned_convolver.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the partitioned FFT convolver
+  ==============================================================================
+*/
+
+#include "partitioned_convolver.h"
+#include "../../performance/multithreading.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_CONVOLVER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_CONVOLVER_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace effects {
+
+namespace {
+
+/** Spectra are padded to this many bins so the kernel needs no scalar tail */
+constexpr int kKernelWidth = 8;
+
+/** acc += a * b over split complex arrays */
+inline void complexMultiplyAdd(float* accRe, float* accIm,
+                               const float* aRe, const float* aIm,
+                               const float* bRe, const float* bIm,
+                               int numBins) noexcept
+{
+    int bin = 0;
+
+   #if defined(__AVX__)
+    for (; bin + 8 <= numBins; bin += 8) {
+        const __m256 ar = _mm256_loadu_ps(aRe + bin);
+        const __m256 ai = _mm256_loadu_ps(aIm + bin);
+        const __m256 br = _mm256_loadu_ps(bRe + bin);
+        const __m256 bi = _mm256_loadu_ps(bIm + bin);
+
+        const __m256 re = _mm256_sub_ps(_mm256_mul_ps(ar, br), _mm256_mul_ps(ai, bi));
+        const __m256 im = _mm256_add_ps(_mm256_mul_ps(ar, bi), _mm256_mul_ps(ai, br));
+        _mm256_storeu_ps(accRe + bin, _mm256_add_ps(_mm256_loadu_ps(accRe + bin), re));
+        _mm256_storeu_ps(accIm + bin, _mm256_add_ps(_mm256_loadu_ps(accIm + bin), im));
+    }
+   #endif
+
+   #if VITAL_CONVOLVER_SSE
+    for (; bin + 4 <= numBins; bin += 4) {
+        const __m128 ar = _mm_loadu_ps(aRe + bin);
+        const __m128 ai = _mm_loadu_ps(aIm + bin);
+        const __m128 br = _mm_loadu_ps(bRe + bin);
+        const __m128 bi = _mm_loadu_ps(bIm + bin);
+
+        const __m128 re = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        const __m128 im = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_storeu_ps(accRe + bin, _mm_add_ps(_mm_loadu_ps(accRe + bin), re));
+        _mm_storeu_ps(accIm + bin, _mm_add_ps(_mm_loadu_ps(accIm + bin), im));
+    }
+   #elif VITAL_CONVOLVER_NEON
+    for (; bin + 4 <= numBins; bin += 4) {
+        const float32x4_t ar = vld1q_f32(aRe + bin);
+        const float32x4_t ai = vld1q_f32(aIm + bin);
+        const float32x4_t br = vld1q_f32(bRe + bin);
+        const float32x4_t bi = vld1q_f32(bIm + bin);
+
+        const float32x4_t re = vsubq_f32(vmulq_f32(ar, br), vmulq_f32(ai, bi));
+        const float32x4_t im = vaddq_f32(vmulq_f32(ar, bi), vmulq_f32(ai, br));
+        vst1q_f32(accRe + bin, vaddq_f32(vld1q_f32(accRe + bin), re));
+        vst1q_f32(accIm + bin, vaddq_f32(vld1q_f32(accIm + bin), im));
+    }
+   #endif
+
+    for (; bin < numBins; ++bin) {
+        accRe[bin] += aRe[bin] * bRe[bin] - aIm[bin] * bIm[bin];
+        accIm[bin] += aRe[bin] * bIm[bin] + aIm[bin] * bRe[bin];
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// UniformConvolutionStage
+//==============================================================================
+
+void UniformConvolutionStage::prepare(const float* impulse, int length, int blockSize)
+{
+    blockSize_ = juce::nextPowerOfTwo(std::max(1, blockSize));
+    numPartitions_ = (impulse != nullptr && length > 0) ? (length + blockSize_ - 1) / blockSize_ : 0;
+
+    if (numPartitions_ == 0) {
+        fft_.reset();
+        impulseSpectra_.clear();
+        inputSpectra_.clear();
+        return;
+    }
+
+    const int fftSize = 2 * blockSize_;
+    fft_ = std::make_unique<juce::dsp::FFT>(juce::findHighestSetBit(static_cast<juce::uint32>(fftSize)));
+
+    numBins_ = blockSize_ + 1;
+    binStride_ = (numBins_ + kKernelWidth - 1) / kKernelWidth * kKernelWidth;
+
+    const size_t spectrumSize = size_t(2 * binStride_);
+    impulseSpectra_.assign(spectrumSize * size_t(numPartitions_), 0.0f);
+    inputSpectra_.assign(spectrumSize * size_t(numPartitions_), 0.0f);
+    accumulated_.assign(spectrumSize, 0.0f);
+    spectrum_.assign(spectrumSize, 0.0f);
+    fftBuffer_.assign(size_t(2 * fftSize), 0.0f);
+    inputBlock_.assign(size_t(blockSize_), 0.0f);
+    overlap_.assign(size_t(blockSize_), 0.0f);
+
+    for (int partition = 0; partition < numPartitions_; ++partition) {
+        const int offset = partition * blockSize_;
+        const int count = std::min(blockSize_, length - offset);
+
+        std::fill(fftBuffer_.begin(), fftBuffer_.begin() + blockSize_, 0.0f);
+        std::copy(impulse + offset, impulse + offset + count, fftBuffer_.begin());
+        forwardTransform(partitionRe(impulseSpectra_, partition), partitionIm(impulseSpectra_, partition));
+    }
+
+    reset();
+}
+
+void UniformConvolutionStage::reset() noexcept
+{
+    std::fill(inputSpectra_.begin(), inputSpectra_.end(), 0.0f);
+    std::fill(inputBlock_.begin(), inputBlock_.end(), 0.0f);
+    std::fill(overlap_.begin(), overlap_.end(), 0.0f);
+    current_ = 0;
+    inputPosition_ = 0;
+}
+
+void UniformConvolutionStage::forwardTransform(float* re, float* im) noexcept
+{
+    std::fill(fftBuffer_.begin() + blockSize_, fftBuffer_.end(), 0.0f);
+    fft_->performRealOnlyForwardTransform(fftBuffer_.data(), true);
+
+    for (int bin = 0; bin < numBins_; ++bin) {
+        re[bin] = fftBuffer_[size_t(2 * bin)];
+        im[bin] = fftBuffer_[size_t(2 * bin + 1)];
+    }
+}
+
+void UniformConvolutionStage::inverseTransform(const float* re, const float* im) noexcept
+{
+    for (int bin = 0; bin < numBins_; ++bin) {
+        fftBuffer_[size_t(2 * bin)] = re[bin];
+        fftBuffer_[size_t(2 * bin + 1)] = im[bin];
+    }
+
+    fft_->performRealOnlyInverseTransform(fftBuffer_.data());
+}
+
+void UniformConvolutionStage::process(const float* input, float* output, int numSamples) noexcept
+{
+    if (numPartitions_ == 0) {
+        juce::FloatVectorOperations::clear(output, numSamples);
+        return;
+    }
+
+    int done = 0;
+    while (done < numSamples) {
+        const int chunk = std::min(numSamples - done, blockSize_ - inputPosition_);
+        std::copy(input + done, input + done + chunk, inputBlock_.begin() + inputPosition_);
+
+        // The newest (partial) block is transformed on every call
+        std::copy(inputBlock_.begin(), inputBlock_.end(), fftBuffer_.begin());
+        forwardTransform(partitionRe(inputSpectra_, current_), partitionIm(inputSpectra_, current_));
+
+        // Older blocks do not change until the next boundary
+        if (inputPosition_ == 0) {
+            std::fill(accumulated_.begin(), accumulated_.end(), 0.0f);
+
+            for (int partition = 1; partition < numPartitions_; ++partition) {
+                const int block = (current_ + partition) % numPartitions_;
+                complexMultiplyAdd(accumulated_.data(), accumulated_.data() + binStride_,
+                                   partitionRe(impulseSpectra_, partition), partitionIm(impulseSpectra_, partition),
+                                   partitionRe(inputSpectra_, block), partitionIm(inputSpectra_, block),
+                                   binStride_);
+            }
+        }
+
+        std::copy(accumulated_.begin(), accumulated_.end(), spectrum_.begin());
+        complexMultiplyAdd(spectrum_.data(), spectrum_.data() + binStride_,
+                           partitionRe(impulseSpectra_, 0), partitionIm(impulseSpectra_, 0),
+                           partitionRe(inputSpectra_, current_), partitionIm(inputSpectra_, current_),
+                           binStride_);
+
+        inverseTransform(spectrum_.data(), spectrum_.data() + binStride_);
+
+        juce::FloatVectorOperations::add(output + done, fftBuffer_.data() + inputPosition_,
+                                         overlap_.data() + inputPosition_, chunk);
+
+        inputPosition_ += chunk;
+        done += chunk;
+
+        if (inputPosition_ == blockSize_) {
+            std::copy(fftBuffer_.begin() + blockSize_, fftBuffer_.begin() + 2 * blockSize_, overlap_.begin());
+            std::fill(inputBlock_.begin(), inputBlock_.end(), 0.0f);
+            inputPosition_ = 0;
+            current_ = current_ > 0 ? current_ - 1 : numPartitions_ - 1;
+        }
+    }
+}
+
+//==============================================================================
+// PartitionedConvolver
+//==============================================================================
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+    release();
+}
+
+bool PartitionedConvolver::loadImpulse(const float* impulse, int length, const Config& config)
+{
+    release();
+
+    if (impulse == nullptr || length <= 0) return false;
+
+    const int headBlock = juce::nextPowerOfTwo(std::max(1, config.headBlockSize));
+    const int maxTailBlock = std::max(headBlock, juce::nextPowerOfTwo(std::max(1, config.maxTailBlockSize)));
+
+    // Each stage ends where the next one, of block size B, can start: at 2 * B
+    auto stageEnd = [&](int block, int nextBlock) {
+        return nextBlock > block ? std::min(length, 2 * nextBlock) : length;
+    };
+
+    try {
+        int block = headBlock;
+        int nextBlock = std::min(block * kStageGrowth, maxTailBlock);
+        int begin = stageEnd(block, nextBlock);
+
+        head_.prepare(impulse, begin, headBlock);
+
+        while (begin < length) {
+            block = nextBlock;
+            nextBlock = std::min(block * kStageGrowth, maxTailBlock);
+            const int end = stageEnd(block, nextBlock);
+
+            auto tail = std::make_unique<TailStage>();
+            tail->stage.prepare(impulse + begin, end - begin, block);
+            tail->input.assign(size_t(block), 0.0f);
+            tail->output.assign(size_t(block), 0.0f);
+            tail->jobInput.assign(size_t(block), 0.0f);
+            tail->jobOutput.assign(size_t(block), 0.0f);
+            tailStages_.push_back(std::move(tail));
+
+            begin = end;
+        }
+
+        impulseLength_ = length;
+
+        if (config.backgroundTail && !tailStages_.empty()) {
+            stopTailThread_.store(false);
+            tailThread_ = std::thread(&PartitionedConvolver::tailThreadLoop, this, config.tailThreadPriority);
+        }
+    } catch (...) {
+        release();
+        return false;
+    }
+
+    return true;
+}
+
+void PartitionedConvolver::release()
+{
+    stopTailThread();
+    tailStages_.clear();
+    head_.prepare(nullptr, 0, 1);
+    impulseLength_ = 0;
+}
+
+void PartitionedConvolver::reset() noexcept
+{
+    head_.reset();
+
+    for (auto& tail : tailStages_) {
+        finishTailJob(*tail);
+        tail->stage.reset();
+        std::fill(tail->input.begin(), tail->input.end(), 0.0f);
+        std::fill(tail->output.begin(), tail->output.end(), 0.0f);
+        std::fill(tail->jobOutput.begin(), tail->jobOutput.end(), 0.0f);
+        tail->position = 0;
+    }
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+void PartitionedConvolver::process(const float* input, float* output, int numSamples) noexcept
+{
+    if (tailStages_.empty()) {
+        head_.process(input, output, numSamples);
+        return;
+    }
+
+    int done = 0;
+    while (done < numSamples) {
+        // Stop at the nearest tail block boundary
+        int chunk = numSamples - done;
+        for (auto& tail : tailStages_) {
+            chunk = std::min(chunk, tail->stage.getBlockSize() - tail->position);
+        }
+
+        // Input is taken before the head writes, since output may alias it
+        for (auto& tail : tailStages_) {
+            std::copy(input + done, input + done + chunk, tail->input.begin() + tail->position);
+        }
+
+        head_.process(input + done, output + done, chunk);
+
+        for (auto& tail : tailStages_) {
+            juce::FloatVectorOperations::add(output + done, tail->output.data() + tail->position, chunk);
+            tail->position += chunk;
+
+            if (tail->position == tail->stage.getBlockSize()) {
+                tail->position = 0;
+                advanceTailStage(*tail);
+            }
+        }
+
+        done += chunk;
+    }
+}
+
+void PartitionedConvolver::advanceTailStage(TailStage& tail) noexcept
+{
+    // The previous job produced exactly the block that starts now
+    finishTailJob(tail);
+
+    std::swap(tail.output, tail.jobOutput);
+    std::swap(tail.input, tail.jobInput);
+
+    tail.state.store(kQueued, std::memory_order_release);
+
+    if (tailThread_.joinable()) {
+        tailRequests_.fetch_add(1, std::memory_order_release);
+        tailRequests_.notify_one();
+    } else {
+        runTailJob(tail);
+    }
+}
+
+void PartitionedConvolver::finishTailJob(TailStage& tail) noexcept
+{
+    // Not picked up in time: computing it here beats waiting for a wake-up
+    if (runTailJob(tail)) {
+        inlineTailJobs_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    while (tail.state.load(std::memory_order_acquire) != kIdle) {
+        performance::threading::cpu_relax();
+    }
+}
+
+bool PartitionedConvolver::runTailJob(TailStage& tail) noexcept
+{
+    int expected = kQueued;
+    if (!tail.state.compare_exchange_strong(expected, kRunning, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    tail.stage.process(tail.jobInput.data(), tail.jobOutput.data(), tail.stage.getBlockSize());
+    tail.state.store(kIdle, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+// Tail Thread
+//==============================================================================
+
+void PartitionedConvolver::tailThreadLoop(int priority)
+{
+    performance::threading::ThreadPlatform::set_thread_priority(std::this_thread::get_id(), priority);
+
+    while (true) {
+        const uint32_t seenRequests = tailRequests_.load(std::memory_order_acquire);
+        if (stopTailThread_.load()) return;
+
+        // Smallest stages first: their deadlines are the nearest
+        for (auto& tail : tailStages_) {
+            runTailJob(*tail);
+        }
+
+        tailRequests_.wait(seenRequests, std::memory_order_acquire);
+    }
+}
+
+void PartitionedConvolver::stopTailThread()
+{
+    if (!tailThread_.joinable()) return;
+
+    stopTailThread_.store(true);
+    tailRequests_.fetch_add(1);
+    tailRequests_.notify_all();
+    tailThread_.join();
+}
+
+} // namespace effects
+} // namespace audio_engine
+} // namespace vital
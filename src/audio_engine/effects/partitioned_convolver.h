@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+    partitioned_convolver.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Zero-latency non-uniformly partitioned FFT convolution with the long
+    tail partitions computed on a background thread
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+namespace vital {
+namespace audio_engine {
+namespace effects {
+
+//==============================================================================
+/**
+ * @class UniformConvolutionStage
+ * @brief Uniformly partitioned overlap-add convolution of one IR range
+ *
+ * The impulse response is cut into partitions of blockSize samples whose
+ * spectra (FFT size 2 * blockSize) are kept in split real/imaginary arrays,
+ * together with a frequency-domain delay line of past input blocks.
+ *
+ * process() has no latency: a partially filled input block is transformed on
+ * every call, while the products of all older partitions are accumulated only
+ * once per block.
+ */
+class UniformConvolutionStage
+{
+public:
+    //==============================================================================
+    UniformConvolutionStage() = default;
+
+    /** Partition impulse[0, length) with a power-of-two block size. Not real-time safe. */
+    void prepare(const float* impulse, int length, int blockSize);
+
+    /** Clear the input history, keeping the impulse response */
+    void reset() noexcept;
+
+    /** Convolve numSamples of input into output, which may alias input */
+    void process(const float* input, float* output, int numSamples) noexcept;
+
+    //==============================================================================
+    int getBlockSize() const noexcept { return blockSize_; }
+    int getNumPartitions() const noexcept { return numPartitions_; }
+    bool isEmpty() const noexcept { return numPartitions_ == 0; }
+
+private:
+    //==============================================================================
+    /** Transform fftBuffer_[0, blockSize) zero-padded to 2 * blockSize into re/im */
+    void forwardTransform(float* re, float* im) noexcept;
+
+    /** Inverse transform re/im into fftBuffer_[0, 2 * blockSize) */
+    void inverseTransform(const float* re, const float* im) noexcept;
+
+    float* partitionRe(std::vector<float>& data, int index) noexcept { return data.data() + size_t(index) * size_t(2 * binStride_); }
+    float* partitionIm(std::vector<float>& data, int index) noexcept { return partitionRe(data, index) + binStride_; }
+
+    //==============================================================================
+    std::unique_ptr<juce::dsp::FFT> fft_;
+    int blockSize_ = 0;
+    int numBins_ = 0;
+    int binStride_ = 0;                 // numBins_ rounded up to the SIMD kernel width
+    int numPartitions_ = 0;
+
+    std::vector<float> impulseSpectra_; // Per partition: re[binStride_], im[binStride_]
+    std::vector<float> inputSpectra_;   // Frequency-domain delay line, same layout
+    std::vector<float> accumulated_;    // Older partitions, summed once per block
+    std::vector<float> spectrum_;
+    std::vector<float> fftBuffer_;      // juce::dsp::FFT real-only work area
+    std::vector<float> inputBlock_;
+    std::vector<float> overlap_;
+
+    int current_ = 0;
+    int inputPosition_ = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(UniformConvolutionStage)
+};
+
+//==============================================================================
+/**
+ * @class PartitionedConvolver
+ * @brief Mono zero-latency convolver for multi-second impulse responses
+ *
+ * The impulse response is split into stages whose block size grows by
+ * kStageGrowth up to maxTailBlockSize:
+ *
+ *   head:  [0, 2 * B1)           block headBlockSize, run on the audio thread
+ *   tail:  [2 * Bn, 2 * Bn+1)    block Bn, one block late on the tail thread
+ *
+ * A tail stage with block size B starts 2 * B samples into the response, so
+ * when an input block completes its output is only needed one block later.
+ * The background thread has that block to compute it; at the next block
+ * boundary the audio thread collects the result, running the job itself if
+ * the thread has not picked it up yet. Latency is therefore always zero and
+ * the output does not depend on whether the tail runs in the background.
+ */
+class PartitionedConvolver
+{
+public:
+    //==============================================================================
+    struct Config
+    {
+        int headBlockSize = 128;        // Rounded up to a power of two
+        int maxTailBlockSize = 8192;    // Largest partition; <= headBlockSize gives one uniform stage
+        bool backgroundTail = true;     // Otherwise tail stages run inline at block boundaries
+        int tailThreadPriority = 60;
+    };
+
+    static constexpr int kStageGrowth = 4;
+
+    //==============================================================================
+    PartitionedConvolver() = default;
+    ~PartitionedConvolver();
+
+    /** Partition and transform an impulse response. Not real-time safe. */
+    bool loadImpulse(const float* impulse, int length, const Config& config);
+
+    /** Drop the impulse response and stop the tail thread */
+    void release();
+
+    /** Clear all input history */
+    void reset() noexcept;
+
+    /** Convolve numSamples of input into output, which may alias input */
+    void process(const float* input, float* output, int numSamples) noexcept;
+
+    //==============================================================================
+    bool isLoaded() const noexcept { return impulseLength_ > 0; }
+    int getImpulseLength() const noexcept { return impulseLength_; }
+    int getLatencySamples() const noexcept { return 0; }
+    int getNumTailStages() const noexcept { return static_cast<int>(tailStages_.size()); }
+
+    /** Tail jobs the audio thread had to run itself at a block boundary */
+    uint64_t getNumInlineTailJobs() const noexcept { return inlineTailJobs_.load(std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    enum JobState : int { kIdle, kQueued, kRunning };
+
+    /** One delayed stage and its double-buffered job data */
+    struct TailStage
+    {
+        UniformConvolutionStage stage;
+        std::vector<float> input;       // Filled by the audio thread
+        std::vector<float> output;      // Read by the audio thread
+        std::vector<float> jobInput;    // Owned by whoever runs the job
+        std::vector<float> jobOutput;
+        int position = 0;
+        alignas(64) std::atomic<int> state{kIdle};
+    };
+
+    //==============================================================================
+    UniformConvolutionStage head_;
+    std::vector<std::unique_ptr<TailStage>> tailStages_;
+    int impulseLength_ = 0;
+
+    std::thread tailThread_;
+    alignas(64) std::atomic<uint32_t> tailRequests_{0};
+    std::atomic<bool> stopTailThread_{false};
+    std::atomic<uint64_t> inlineTailJobs_{0};
+
+    //==============================================================================
+    void advanceTailStage(TailStage& tail) noexcept;
+    void finishTailJob(TailStage& tail) noexcept;
+    static bool runTailJob(TailStage& tail) noexcept;
+    void tailThreadLoop(int priority);
+    void stopTailThread();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(PartitionedConvolver)
+};
+
+} // namespace effects
+} // namespace audio_engine
+} // namespace vital
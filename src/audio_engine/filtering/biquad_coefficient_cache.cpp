@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+    biquad_coefficient_cache.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    The table-driven biquad cascade
+  ==============================================================================
+*/
+
+#include "biquad_coefficient_cache.h"
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace filtering {
+
+namespace {
+
+constexpr float kMinQ = 0.1f;
+constexpr float kMaxQ = 40.0f;
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void CachedBiquad::prepare(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0);
+
+    const float frequency = getFrequency();
+    sampleRate_ = sampleRate;
+    snapFrequency(frequency);
+    reset();
+}
+
+void CachedBiquad::setResponse(Type type, float q) noexcept
+{
+    table_ = FilterPitch::getPrewarpTable();
+    type_ = type;
+    q_ = juce::jlimit(kMinQ, kMaxQ, q);
+
+    // Output mixes of the SVF that give each RBJ response
+    const float k = 1.0f / q_;
+    damping_ = k;
+    mix0_ = mix1_ = mix2_ = 0.0f;
+
+    switch (type_) {
+        case Type::LowPass:  mix2_ = 1.0f; break;
+        case Type::HighPass: mix0_ = 1.0f; mix1_ = -k; mix2_ = -1.0f; break;
+        case Type::BandPass: mix1_ = k; break;
+        case Type::Notch:    mix0_ = 1.0f; mix1_ = -k; break;
+        case Type::AllPass:  mix0_ = 1.0f; mix1_ = -2.0f * k; break;
+    }
+}
+
+void CachedBiquad::setFrequency(float frequency) noexcept
+{
+    targetPitch_ = FilterPitch::fromFrequency(frequency, sampleRate_);
+}
+
+void CachedBiquad::snapFrequency(float frequency) noexcept
+{
+    targetPitch_ = FilterPitch::fromFrequency(frequency, sampleRate_);
+    pitch_ = targetPitch_;
+}
+
+float CachedBiquad::getFrequency() const noexcept
+{
+    return static_cast<float>(sampleRate_ * std::exp2(static_cast<double>(targetPitch_)));
+}
+
+void CachedBiquad::reset() noexcept
+{
+    state1_.fill(0.0f);
+    state2_.fill(0.0f);
+}
+
+void CachedBiquad::flushState() noexcept
+{
+    for (int stage = 0; stage < kMaxStages; ++stage) {
+        state1_[stage] = FilterPitch::flush(state1_[stage]);
+        state2_[stage] = FilterPitch::flush(state2_[stage]);
+    }
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+void CachedBiquad::process(float* samples, int numSamples, const float* modulation) noexcept
+{
+    if (table_ == nullptr || numSamples <= 0) return;
+
+    if (modulation != nullptr || (ramp_ == Ramp::PerSample && pitch_ != targetPitch_))
+        processRamped(samples, numSamples, modulation);
+    else
+        processFixed(samples, numSamples);
+
+    flushState();
+}
+
+void CachedBiquad::processFixed(float* samples, int numSamples) noexcept
+{
+    pitch_ = targetPitch_;
+
+    const float g = FilterPitch::prewarp(table_, pitch_);
+    const float a1 = 1.0f / (1.0f + g * (g + damping_));
+    const float a2 = g * a1;
+    const float a3 = g * a2;
+    const float m0 = mix0_, m1 = mix1_, m2 = mix2_;
+
+    for (int stage = 0; stage < stages_; ++stage) {
+        float ic1 = state1_[stage];
+        float ic2 = state2_[stage];
+
+        for (int i = 0; i < numSamples; ++i) {
+            const float x = samples[i];
+            const float v3 = x - ic2;
+            const float v1 = a1 * ic1 + a2 * v3;
+            const float v2 = ic2 + a2 * ic1 + a3 * v3;
+            ic1 = 2.0f * v1 - ic1;
+            ic2 = 2.0f * v2 - ic2;
+            samples[i] = m0 * x + m1 * v1 + m2 * v2;
+        }
+
+        state1_[stage] = ic1;
+        state2_[stage] = ic2;
+    }
+}
+
+void CachedBiquad::processRamped(float* samples, int numSamples, const float* modulation) noexcept
+{
+    using Layout = FilterPitch::PrewarpLayout;
+    const float* table = table_;
+    const float start = pitch_;
+    const float glide = ramp_ == Ramp::PerSample ? (targetPitch_ - pitch_) / static_cast<float>(numSamples) : 0.0f;
+    const float base = ramp_ == Ramp::PerSample ? start : targetPitch_;
+    const float k = damping_, m0 = mix0_, m1 = mix1_, m2 = mix2_;
+
+    alignas(32) std::array<int, kChunk> positions;
+    alignas(32) std::array<float, kChunk> gains;
+
+    for (int offset = 0; offset < numSamples; offset += kChunk) {
+        const int count = std::min(kChunk, numSamples - offset);
+
+        // Table positions for the chunk; affine in the sample index plus modulation, so this vectorises
+        if (modulation != nullptr) {
+            for (int i = 0; i < count; ++i)
+                positions[i] = Layout::toPosition(base - FilterPitch::kMinPitch + glide * static_cast<float>(offset + i)
+                                                  + modulation[offset + i]);
+        } else {
+            for (int i = 0; i < count; ++i)
+                positions[i] = Layout::toPosition(base - FilterPitch::kMinPitch + glide * static_cast<float>(offset + i));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int index = Layout::index(positions[i]);
+            gains[i] = table[index] + Layout::fraction(positions[i]) * (table[index + 1] - table[index]);
+        }
+
+        // Trapezoidal integrator state keeps its meaning when g moves, so fast sweeps cannot pump energy into the loop
+        for (int i = 0; i < count; ++i) {
+            const float g = gains[i];
+            const float a1 = 1.0f / (1.0f + g * (g + k));
+            const float a2 = g * a1;
+            const float a3 = g * a2;
+
+            float x = samples[offset + i];
+            for (int stage = 0; stage < stages_; ++stage) {
+                const float v3 = x - state2_[stage];
+                const float v1 = a1 * state1_[stage] + a2 * v3;
+                const float v2 = state2_[stage] + a2 * state1_[stage] + a3 * v3;
+                state1_[stage] = 2.0f * v1 - state1_[stage];
+                state2_[stage] = 2.0f * v2 - state2_[stage];
+                x = m0 * x + m1 * v1 + m2 * v2;
+            }
+            samples[offset + i] = x;
+        }
+    }
+
+    pitch_ = targetPitch_;
+}
+
+} // namespace filtering
+} // namespace audio_engine
+} // namespace vital
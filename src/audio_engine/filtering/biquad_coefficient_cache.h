@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+    biquad_coefficient_cache.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    A biquad cascade whose coefficients come from the shared prewarp table,
+    so moving a cutoff costs an interpolation instead of a redesign
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "filter_pitch.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace vital {
+namespace audio_engine {
+namespace filtering {
+
+//==============================================================================
+/**
+ * @class CachedBiquad
+ * @brief Cascade of identical RBJ biquad sections driven by a gain table
+ *
+ * Cutoff changes never call a transcendental function: setFrequency() takes
+ * one log2 and every later coefficient set is one read from FilterPitch's
+ * prewarp table, the same tan(pi f / fs) table ZdfFilterBank uses. With
+ * Ramp::Block the coefficients jump to the new cutoff at the start of the
+ * next block; with Ramp::PerSample the cutoff glides across the next block
+ * in pitch and the coefficients are looked up every sample, which removes
+ * zipper noise from fast sweeps. Per-sample modulation in octaves always
+ * takes the per-sample path.
+ *
+ * Sections are Simper's trapezoidal state variable filter with damping 1 / Q
+ * and a per-type output mix, which has exactly the RBJ cookbook response at
+ * a fixed cutoff; type and Q live only in that mix, so the gain table is
+ * shared by every response. Its state is the integrator charge rather than past
+ * samples, so it stays bounded however fast the cutoff moves, including
+ * audio-rate modulation where direct form sections diverge. Sections share
+ * one lookup, so a fourth-order Linkwitz-Riley filter is two stages at Q 0.7071.
+ */
+class CachedBiquad
+{
+public:
+    //==============================================================================
+    static constexpr int kMaxStages = 4;
+
+    /** The gain-free RBJ responses */
+    enum class Type : uint8_t { LowPass, HighPass, BandPass, Notch, AllPass };
+
+    enum class Ramp : uint8_t { Block, PerSample };
+
+    //==============================================================================
+    CachedBiquad() = default;
+
+    /** Set the sample rate and clear the state */
+    void prepare(double sampleRate) noexcept;
+
+    /** Response to follow, with Q clamped to 0.1 - 40; until it is set audio passes through */
+    void setResponse(Type type, float q) noexcept;
+
+    void setRamp(Ramp ramp) noexcept { ramp_ = ramp; }
+
+    /** Number of cascaded sections, 1 to kMaxStages */
+    void setStages(int stages) noexcept { stages_ = juce::jlimit(1, kMaxStages, stages); }
+
+    /** Target cutoff in Hz, reached at the start (Ramp::Block) or end (Ramp::PerSample) of the next block */
+    void setFrequency(float frequency) noexcept;
+
+    /** Jump to a cutoff without ramping */
+    void snapFrequency(float frequency) noexcept;
+
+    float getFrequency() const noexcept;
+    Type getType() const noexcept { return type_; }
+    float getQ() const noexcept { return q_; }
+    int getStages() const noexcept { return stages_; }
+    Ramp getRamp() const noexcept { return ramp_; }
+
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Filter in place; modulation may be nullptr or hold per-sample cutoff offsets in octaves */
+    void process(float* samples, int numSamples, const float* modulation = nullptr) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int kChunk = 256;
+
+    void processFixed(float* samples, int numSamples) noexcept;
+    void processRamped(float* samples, int numSamples, const float* modulation) noexcept;
+    void flushState() noexcept;
+
+    /** FilterPitch's prewarp table, or nullptr until setResponse() */
+    const float* table_ = nullptr;
+    Type type_ = Type::LowPass;
+    float q_ = 0.70710678f;
+
+    /** Damping and output = mix0 * input + mix1 * band + mix2 * low, set by the type and Q */
+    float damping_ = 1.0f;
+    float mix0_ = 0.0f;
+    float mix1_ = 0.0f;
+    float mix2_ = 1.0f;
+
+    double sampleRate_ = 44100.0;
+    Ramp ramp_ = Ramp::PerSample;
+    int stages_ = 1;
+
+    /** Cutoff as log2(frequency / sampleRate): current and ramp target */
+    float pitch_ = -5.5f;
+    float targetPitch_ = -5.5f;
+
+    /** Integrator state per section */
+    std::array<float, kMaxStages> state1_{};
+    std::array<float, kMaxStages> state2_{};
+
+    JUCE_DECLARE_NON_COPYABLE(CachedBiquad)
+};
+
+} // namespace filtering
+} // namespace audio_engine
+} // namespace vital
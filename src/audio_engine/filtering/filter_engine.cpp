@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+    filter_engine.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    FilterEngine lifecycle and per-filter controls on top of the ZDF filter bank
+  ==============================================================================
+*/
+
+#include "filter_engine.h"
+
+namespace vital {
+namespace audio_engine {
+namespace filtering {
+
+namespace {
+
+struct TypeMapping
+{
+    ZdfFilterBank::Model model;
+    ZdfFilterBank::Mode mode;
+};
+
+TypeMapping mapType(FilterEngine::FilterType type) noexcept
+{
+    using Type = FilterEngine::FilterType;
+    using Model = ZdfFilterBank::Model;
+    using Mode = ZdfFilterBank::Mode;
+
+    switch (type) {
+        case Type::LowPass:        return { Model::Svf, Mode::LowPass };
+        case Type::HighPass:       return { Model::Svf, Mode::HighPass };
+        case Type::BandPass:       return { Model::Svf, Mode::BandPass };
+        case Type::Notch:          return { Model::Svf, Mode::Notch };
+        case Type::Peaking:        return { Model::Svf, Mode::Bell };
+        case Type::LowShelf:       return { Model::Svf, Mode::LowShelf };
+        case Type::HighShelf:      return { Model::Svf, Mode::HighShelf };
+        case Type::AllPass:        return { Model::Svf, Mode::AllPass };
+        case Type::AnalogLowPass:  return { Model::Ladder, Mode::LowPass };
+        case Type::AnalogHighPass: return { Model::Ladder, Mode::HighPass };
+        case Type::AnalogBandPass: return { Model::Ladder, Mode::BandPass };
+        case Type::Custom:         break;
+    }
+
+    return { Model::Svf, Mode::LowPass };
+}
+
+} // namespace
+
+//==============================================================================
+// Lifecycle
+//==============================================================================
+
+FilterEngine::FilterEngine(const Config& config)
+    : config_(config)
+{
+}
+
+FilterEngine::~FilterEngine()
+{
+    shutdown();
+}
+
+bool FilterEngine::initialize(const Config& config)
+{
+    if (config.numFilters <= 0 || config.numFilters > ZdfFilterBank::kMaxVoices || config.sampleRate <= 0.0f)
+        return false;
+
+    config_ = config;
+    filterBank_.prepare(config_.numFilters, config_.sampleRate);
+    prepareOversampling();
+
+    isInitialized_.store(true);
+    return true;
+}
+
+void FilterEngine::shutdown()
+{
+    isInitialized_.store(false);
+}
+
+void FilterEngine::reset()
+{
+    if (isInitialized_.load()) {
+        filterBank_.reset();
+        oversampler_.reset();
+    }
+}
+
+void FilterEngine::prepareOversampling()
+{
+    utility::Oversampler::Config oversampling;
+    oversampling.factor = config_.enableOversampling ? config_.oversamplingFactor : 1;
+    oversampling.phase = config_.linearPhaseOversampling ? utility::Oversampler::Phase::Linear
+                                                         : utility::Oversampler::Phase::Minimum;
+    oversampling.numChannels = config_.numFilters;
+    oversampling.maxBlockSize = kOversamplingBlock;
+    oversampler_.prepare(oversampling);
+
+    const int factor = oversampler_.getFactor();
+    heldModulation_.assign(static_cast<size_t>(config_.numFilters * kOversamplingBlock * factor), 0.0f);
+    filterBank_.setSampleRate(static_cast<double>(config_.sampleRate) * factor);
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+void FilterEngine::processFilters(float* const* buffers, int numFilters, int numSamples,
+                                  const float* const* cutoffModulation) noexcept
+{
+    if (!isInitialized_.load(std::memory_order_relaxed)) return;
+
+    const int factor = oversampler_.getFactor();
+    if (factor == 1) {
+        filterBank_.process(buffers, numFilters, numSamples, cutoffModulation);
+        return;
+    }
+
+    numFilters = juce::jmin(numFilters, oversampler_.getNumChannels());
+    std::array<float*, ZdfFilterBank::kMaxVoices> piece{};
+    std::array<const float*, ZdfFilterBank::kMaxVoices> modulation{};
+
+    for (int offset = 0; offset < numSamples; offset += kOversamplingBlock) {
+        const int count = juce::jmin(kOversamplingBlock, numSamples - offset);
+        const int oversampledCount = count * factor;
+
+        for (int filter = 0; filter < numFilters; ++filter) {
+            piece[static_cast<size_t>(filter)] = buffers[filter] + offset;
+            modulation[static_cast<size_t>(filter)] = nullptr;
+
+            if (cutoffModulation != nullptr && cutoffModulation[filter] != nullptr) {
+                const float* source = cutoffModulation[filter] + offset;
+                float* held = heldModulation_.data() + static_cast<size_t>(filter * kOversamplingBlock * factor);
+                for (int i = 0; i < oversampledCount; ++i)
+                    held[i] = source[i / factor];
+                modulation[static_cast<size_t>(filter)] = held;
+            }
+        }
+
+        // Cutoff glides run across the whole block, not each piece
+        filterBank_.process(oversampler_.processUp(piece.data(), numFilters, count), numFilters, oversampledCount,
+                            cutoffModulation != nullptr ? modulation.data() : nullptr,
+                            offset * factor, numSamples * factor);
+        oversampler_.processDown(piece.data(), numFilters, count);
+    }
+}
+
+//==============================================================================
+// Filter Control
+//==============================================================================
+
+void FilterEngine::setFilterType(int filterId, FilterType type)
+{
+    if (filterId < 0 || filterId >= filterBank_.getMaxVoices()) return;
+
+    const auto mapping = mapType(type);
+    filterBank_.setModel(filterId, mapping.model);
+    filterBank_.setMode(filterId, mapping.mode);
+}
+
+void FilterEngine::setFilterFrequency(int filterId, float frequency)
+{
+    if (filterId >= 0 && filterId < filterBank_.getMaxVoices())
+        filterBank_.setCutoff(filterId, frequency);
+}
+
+void FilterEngine::setFilterResonance(int filterId, float resonance)
+{
+    if (filterId >= 0 && filterId < filterBank_.getMaxVoices())
+        filterBank_.setResonance(filterId, resonance);
+}
+
+void FilterEngine::setFilterGain(int filterId, float gain)
+{
+    if (filterId >= 0 && filterId < filterBank_.getMaxVoices())
+        filterBank_.setGain(filterId, gain);
+}
+
+void FilterEngine::setFilterStages(int filterId, int stages)
+{
+    if (filterId >= 0 && filterId < filterBank_.getMaxVoices())
+        filterBank_.setStages(filterId, stages);
+}
+
+void FilterEngine::enableFilter(int filterId, bool enabled)
+{
+    if (filterId >= 0 && filterId < filterBank_.getMaxVoices())
+        filterBank_.setEnabled(filterId, enabled);
+}
+
+//==============================================================================
+// Oversampling
+//==============================================================================
+
+void FilterEngine::enableOversampling(bool enabled)
+{
+    config_.enableOversampling = enabled;
+    if (isInitialized_.load()) prepareOversampling();
+}
+
+void FilterEngine::setOversamplingFactor(int factor)
+{
+    config_.oversamplingFactor = factor;
+    if (isInitialized_.load()) prepareOversampling();
+}
+
+int FilterEngine::getOversamplingFactor() const
+{
+    return isInitialized_.load() ? oversampler_.getFactor() : 1;
+}
+
+float FilterEngine::getOversamplingLatency() const
+{
+    return isInitialized_.load() ? oversampler_.getLatency() : 0.0f;
+}
+
+//==============================================================================
+// Access Methods
+//==============================================================================
+
+float FilterEngine::getFilterFrequency(int filterId) const
+{
+    if (filterId < 0 || filterId >= filterBank_.getMaxVoices()) return 0.0f;
+    return filterBank_.getCutoff(filterId);
+}
+
+float FilterEngine::getFilterResonance(int filterId) const
+{
+    if (filterId < 0 || filterId >= filterBank_.getMaxVoices()) return 0.0f;
+    return filterBank_.getResonance(filterId);
+}
+
+bool FilterEngine::isFilterEnabled(int filterId) const
+{
+    if (filterId < 0 || filterId >= filterBank_.getMaxVoices()) return false;
+    return filterBank_.isEnabled(filterId);
+}
+
+} // namespace filtering
+} // namespace audio_engine
+} // namespace vital
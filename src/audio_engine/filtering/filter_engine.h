@@ -17,6 +17,9 @@
 #include <atomic>
 #include <mutex>
 
+#include "zdf_filter_bank.h"
+#include "../utility/oversampler.h"
+
 namespace vital {
 namespace audio_engine {
 namespace filtering {
@@ -29,6 +32,7 @@ namespace filtering {
  * Provides:
  * - Digital filters (lowpass, highpass, bandpass, notch, peaking, etc.)
  * - Analog modeling filters with virtual components
+ * - Zero-delay-feedback SVF and ladder cores with audio-rate cutoff modulation
  * - Oversampling for alias-free filtering
  * - Multi-stage filter chains
  * - Real-time parameter modulation
@@ -44,6 +48,7 @@ public:
         int numFilters = 8;
         bool enableOversampling = true;
         int oversamplingFactor = 2;
+        bool linearPhaseOversampling = false;
         bool enableAnalogModeling = true;
         int filterStages = 4;
         bool enableNonLinearities = true;
@@ -88,10 +93,19 @@ public:
     /** Main processing */
     void process(int numSamples);
     
+    /**
+     * Filter one buffer per filter in place. cutoffModulation may be nullptr
+     * or hold a per-sample cutoff offset in octaves for each filter.
+     */
+    void processFilters(float* const* buffers, int numFilters, int numSamples,
+                        const float* const* cutoffModulation = nullptr) noexcept;
+    
     //==============================================================================
     /** Filter control */
     void setFilterType(int filterId, FilterType type);
     void setFilterFrequency(int filterId, float frequency);
+    
+    /** Normalised 0 to 1; 1 self-oscillates the analog types */
     void setFilterResonance(int filterId, float resonance);
     void setFilterGain(int filterId, float gain);
     void setFilterStages(int filterId, int stages);
@@ -104,17 +118,22 @@ public:
     void setAnalogDrift(float driftAmount);
     
     //==============================================================================
-    /** Oversampling */
+    /** Oversampling through the shared half-band chain; not real-time safe, call between blocks */
     void enableOversampling(bool enabled);
     void setOversamplingFactor(int factor);
     int getOversamplingFactor() const;
     
+    /** Delay added by oversampling, in samples */
+    float getOversamplingLatency() const;
+    
     //==============================================================================
     /** Access methods */
     float getFilterFrequency(int filterId) const;
     float getFilterResonance(int filterId) const;
     bool isFilterEnabled(int filterId) const;
     
+    ZdfFilterBank& getFilterBank() noexcept { return filterBank_; }
+    
 private:
     //==============================================================================
     /** Configuration */
@@ -124,44 +143,20 @@ private:
     std::atomic<bool> isInitialized_{false};
     
     //==============================================================================
-    /** Filter implementation */
-    class Filter {
-    public:
-        void initialize(float sampleRate);
-        void process(float* samples, int numSamples);
-        void setType(FilterType type);
-        void setFrequency(float frequency);
-        void setResonance(float resonance);
-        void setGain(float gain);
-        void setStages(int stages);
-        void enable(bool enabled);
-        
-    private:
-        float sampleRate_ = 44100.0f;
-        FilterType type_ = FilterType::LowPass;
-        float frequency_ = 1000.0f;
-        float resonance_ = 0.7f;
-        float gain_ = 0.0f;
-        int stages_ = 1;
-        bool enabled_ = true;
-        
-        // JUCE filter instances for different types
-        juce::LinkwitzRileyFilter<float> linkwitzRileyFilter_;
-        juce::StateVariableFilter<float> stateVariableFilter_;
-        juce::BiquadFilter<float> biquadFilter_;
-        
-        void updateFilterCoefficients();
-    };
+    /** Every filter is one voice of the bank, so filters are processed in lane groups */
+    ZdfFilterBank filterBank_;
     
-    //==============================================================================
-    /** Filter instances */
-    std::vector<Filter> filters_;
+    /** The bank runs at the oversampled rate; cutoff modulation is held across sub-samples */
+    static constexpr int kOversamplingBlock = 256;
+    utility::Oversampler oversampler_;
+    std::vector<float> heldModulation_;
+    
+    void prepareOversampling();
     
     //==============================================================================
     /** Processing buffers */
     std::vector<std::vector<float>> inputBuffers_;
     std::vector<std::vector<float>> outputBuffers_;
-    std::vector<std::vector<float>> oversampleBuffers_;
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterEngine)
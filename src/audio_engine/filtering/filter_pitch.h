@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+    filter_pitch.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Cutoff pitch domain, fixed-point table positions and state flushing
+    shared by the table-driven filters
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace filtering {
+
+//==============================================================================
+/**
+ * @struct FilterPitch
+ * @brief Cutoffs as log2(frequency / sampleRate), and tables indexed by them
+ *
+ * Holding a cutoff as a pitch makes modulation in octaves an addition and
+ * lets one table serve every sample rate. Tables are sampled StepsPerOctave
+ * to the octave from kMinPitch, and a position in one is 16.16 fixed point,
+ * so the range clamp is integer work that vectorises in lane loops.
+ */
+struct FilterPitch
+{
+    /** Cutoff range: 0.7 Hz to 0.49 fs at 48 kHz */
+    static constexpr float kMinPitch = -16.0f;
+    static constexpr float kMaxPitch = -1.0291463f;
+
+    /** Pitch of a frequency, clamped to the range */
+    static float fromFrequency(float frequency, double sampleRate) noexcept
+    {
+        const float normalised = static_cast<float>(std::max(1.0e-9, static_cast<double>(frequency) / sampleRate));
+        return juce::jlimit(kMinPitch, kMaxPitch, std::log2(normalised));
+    }
+
+    static float toFrequency(float pitch, double sampleRate) noexcept
+    {
+        return static_cast<float>(sampleRate * std::exp2(static_cast<double>(pitch)));
+    }
+
+    //==============================================================================
+    /** A table over the whole range, with one entry past kMaxPitch to interpolate into */
+    template <int StepsPerOctave>
+    struct Table
+    {
+        static constexpr int kSize = static_cast<int>((kMaxPitch - kMinPitch) * StepsPerOctave) + 2;
+        static constexpr float kFixedStepsPerOctave = static_cast<float>(StepsPerOctave) * 65536.0f;
+        static constexpr int kLastPosition = (kSize - 1) * 65536 - 1;
+
+        /** Pitch of entry k */
+        static double pitchAt(int entry) noexcept
+        {
+            return static_cast<double>(kMinPitch) + static_cast<double>(entry) / StepsPerOctave;
+        }
+
+        /** Position of a pitch given relative to kMinPitch */
+        static int toPosition(float pitchAboveMin) noexcept
+        {
+            const int position = static_cast<int>(pitchAboveMin * kFixedStepsPerOctave);
+            return std::min(std::max(position, 0), kLastPosition);
+        }
+
+        static int index(int position) noexcept { return position >> 16; }
+        static float fraction(int position) noexcept { return static_cast<float>(position & 0xffff) * (1.0f / 65536.0f); }
+    };
+
+    //==============================================================================
+    /** tan(pi * 2^pitch), the prewarped integrator gain of a trapezoidal filter, sampled every 1/128 octave */
+    using PrewarpLayout = Table<128>;
+
+    /** The prewarp table, built once and shared by every filter in the process */
+    static const float* getPrewarpTable() noexcept
+    {
+        struct Prewarp
+        {
+            Prewarp()
+            {
+                for (int k = 0; k < PrewarpLayout::kSize; ++k)
+                    values[static_cast<size_t>(k)] = static_cast<float>(std::tan(juce::MathConstants<double>::pi
+                                                                                 * std::exp2(PrewarpLayout::pitchAt(k))));
+            }
+
+            std::array<float, PrewarpLayout::kSize> values{};
+        };
+
+        static const Prewarp table;
+        return table.values.data();
+    }
+
+    /** Integrator gain at a pitch, interpolated from the prewarp table */
+    static float prewarp(const float* table, float pitch) noexcept
+    {
+        const int position = PrewarpLayout::toPosition(pitch - kMinPitch);
+        const int index = PrewarpLayout::index(position);
+        return table[index] + PrewarpLayout::fraction(position) * (table[index + 1] - table[index]);
+    }
+
+    //==============================================================================
+    /** State below this is flushed at the end of each block so decaying filters never reach denormals */
+    static constexpr float kFlushThreshold = 1.0e-15f;
+
+    static float flush(float x) noexcept
+    {
+        return std::abs(x) < kFlushThreshold ? 0.0f : x;
+    }
+};
+
+} // namespace filtering
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,527 @@
+/*
+  ==============================================================================
+    zdf_filter_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the zero-delay-feedback filter bank
+  ==============================================================================
+*/
+
+#include "zdf_filter_bank.h"
+#include "filter_pitch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace filtering {
+
+namespace {
+
+constexpr int kLanes = ZdfFilterBank::kLaneWidth;
+
+constexpr float kMinPitch = FilterPitch::kMinPitch;
+constexpr float kMaxPitch = FilterPitch::kMaxPitch;
+
+/** Positions into FilterPitch's shared prewarp table */
+using TanLayout = FilterPitch::PrewarpLayout;
+
+/** SVF damping at zero and full resonance: Q of 0.5 to 50 */
+constexpr float kMaxDamping = 2.0f;
+constexpr float kMinDamping = 0.02f;
+
+/** Ladder feedback at full resonance, just past the self-oscillation point of 4 */
+constexpr float kMaxLadderFeedback = 4.2f;
+
+/**
+ * Monotonic rational tanh approximation scaled by kClipHeadroom, so full-scale
+ * signals lose under 2% while a self-oscillating loop settles. No compares,
+ * which keeps the ladder's lane loop vectorisable.
+ */
+constexpr float kClipHeadroom = 4.0f;
+
+inline float softClip(float x) noexcept
+{
+    const float squared = x * x * (1.0f / (kClipHeadroom * kClipHeadroom));
+    return x * (27.0f + squared) / (27.0f + 9.0f * squared);
+}
+
+} // namespace
+
+/** Per-chunk pointers for one lane group; missing voices read zeros_ and write sink_ */
+struct ZdfFilterBank::GroupContext
+{
+    int first = 0;
+    int sampleOffset = 0;
+    int blockSize = 1;
+    const float* table = nullptr;
+    std::array<const float*, kLaneWidth> input{};
+    std::array<float*, kLaneWidth> output{};
+    std::array<const float*, kLaneWidth> modulation{};
+};
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void ZdfFilterBank::prepare(int maxVoices, double sampleRate)
+{
+    jassert(maxVoices > 0 && maxVoices <= kMaxVoices);
+    jassert(sampleRate > 0.0);
+
+    maxVoices_ = juce::jlimit(1, kMaxVoices, maxVoices);
+    numGroups_ = (maxVoices_ + kLanes - 1) / kLanes;
+    sampleRate_ = sampleRate;
+
+    const size_t padded = static_cast<size_t>(numGroups_ * kLanes);
+    const size_t stateSize = padded * kMaxStages;
+
+    model_.assign(padded, static_cast<uint8_t>(Model::Svf));
+    mode_.assign(padded, static_cast<uint8_t>(Mode::LowPass));
+    stages_.assign(padded, 1);
+    enabled_.assign(padded, 1);
+    resonance_.assign(padded, 0.3f);
+    gainDecibels_.assign(padded, 0.0f);
+
+    pitch_.assign(padded, FilterPitch::fromFrequency(1000.0f, sampleRate_));
+    targetPitch_ = pitch_;
+
+    for (auto* coefficients : { &gainScale_, &damping_, &svfMix0_, &svfMix1_, &svfMix2_, &feedback_,
+                                &ladderMix0_, &ladderMix1_, &ladderMix2_, &ladderMix3_, &ladderMix4_ })
+        coefficients->assign(padded, 0.0f);
+
+    for (auto* state : { &svfState1_, &svfState2_, &ladderState1_, &ladderState2_, &ladderState3_, &ladderState4_ })
+        state->assign(stateSize, 0.0f);
+
+    for (int voice = 0; voice < static_cast<int>(padded); ++voice)
+        updateCoefficients(voice);
+}
+
+void ZdfFilterBank::setSampleRate(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0);
+    if (sampleRate == sampleRate_) return;
+
+    // Coefficients other than the integrator gain do not depend on the rate, so moving the pitches is enough
+    const auto shift = static_cast<float>(std::log2(sampleRate_ / sampleRate));
+    for (auto* pitches : { &pitch_, &targetPitch_ })
+        for (auto& pitch : *pitches)
+            pitch = juce::jlimit(kMinPitch, kMaxPitch, pitch + shift);
+
+    sampleRate_ = sampleRate;
+    reset();
+}
+
+void ZdfFilterBank::reset() noexcept
+{
+    for (auto* state : { &svfState1_, &svfState2_, &ladderState1_, &ladderState2_, &ladderState3_, &ladderState4_ })
+        std::fill(state->begin(), state->end(), 0.0f);
+
+    pitch_ = targetPitch_;
+}
+
+void ZdfFilterBank::reset(int voice) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    const size_t padded = static_cast<size_t>(numGroups_ * kLanes);
+
+    for (int stage = 0; stage < kMaxStages; ++stage) {
+        const size_t index = static_cast<size_t>(stage) * padded + static_cast<size_t>(voice);
+        for (auto* state : { &svfState1_, &svfState2_, &ladderState1_, &ladderState2_, &ladderState3_, &ladderState4_ })
+            (*state)[index] = 0.0f;
+    }
+}
+
+void ZdfFilterBank::updateCoefficients(int voice) noexcept
+{
+    const auto v = static_cast<size_t>(voice);
+    const auto mode = static_cast<Mode>(mode_[v]);
+    const float resonance = resonance_[v];
+
+    // Ladder: feedback and a mix of the input and the four pole outputs
+    feedback_[v] = kMaxLadderFeedback * resonance;
+
+    float c[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    switch (mode) {
+        case Mode::HighPass: c[0] = 1.0f; c[1] = -4.0f; c[2] = 6.0f; c[3] = -4.0f; c[4] = 1.0f; break;
+        case Mode::BandPass: c[2] = 4.0f; c[3] = -8.0f; c[4] = 4.0f; break;
+        case Mode::Notch:    c[0] = 1.0f; c[2] = -4.0f; c[3] = 8.0f; c[4] = -4.0f; break;
+        default: break;
+    }
+    ladderMix0_[v] = c[0];
+    ladderMix1_[v] = c[1];
+    ladderMix2_[v] = c[2];
+    ladderMix3_[v] = c[3];
+    ladderMix4_[v] = c[4];
+
+    // SVF: output = m0 * input + m1 * band + m2 * low, from Simper's linear trapezoidal SVF
+    const float a = std::pow(10.0f, gainDecibels_[v] / 40.0f);
+    float k = kMaxDamping - (kMaxDamping - kMinDamping) * resonance;
+    float m0 = 0.0f, m1 = 0.0f, m2 = 0.0f;
+    float scale = 1.0f;
+
+    switch (mode) {
+        case Mode::LowPass:   m2 = 1.0f; break;
+        case Mode::HighPass:  m0 = 1.0f; m1 = -k; m2 = -1.0f; break;
+        case Mode::BandPass:  m1 = k; break;
+        case Mode::Notch:     m0 = 1.0f; m1 = -k; break;
+        case Mode::Peak:      m0 = -1.0f; m1 = k; m2 = 2.0f; break;
+        case Mode::AllPass:   m0 = 1.0f; m1 = -2.0f * k; break;
+        case Mode::Bell:      k /= a; m0 = 1.0f; m1 = k * (a * a - 1.0f); break;
+        case Mode::LowShelf:  m0 = 1.0f; m1 = k * (a - 1.0f); m2 = a * a - 1.0f; scale = 1.0f / std::sqrt(a); break;
+        case Mode::HighShelf: m0 = a * a; m1 = k * (1.0f - a) * a; m2 = 1.0f - a * a; scale = std::sqrt(a); break;
+    }
+
+    damping_[v] = k;
+    svfMix0_[v] = m0;
+    svfMix1_[v] = m1;
+    svfMix2_[v] = m2;
+    gainScale_[v] = static_cast<Model>(model_[v]) == Model::Svf ? scale : 1.0f;
+}
+
+//==============================================================================
+// Parameters
+//==============================================================================
+
+void ZdfFilterBank::setModel(int voice, Model model) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    const auto v = static_cast<size_t>(voice);
+    if (model_[v] == static_cast<uint8_t>(model)) return;
+
+    // Only the model's own state starts from silence; it has been tracking the input already
+    model_[v] = static_cast<uint8_t>(model);
+    const size_t padded = static_cast<size_t>(numGroups_ * kLanes);
+    for (int stage = 0; stage < kMaxStages; ++stage) {
+        const size_t index = static_cast<size_t>(stage) * padded + v;
+        if (model == Model::Svf) {
+            svfState1_[index] = svfState2_[index] = 0.0f;
+        }
+        else {
+            ladderState1_[index] = ladderState2_[index] = 0.0f;
+            ladderState3_[index] = ladderState4_[index] = 0.0f;
+        }
+    }
+
+    updateCoefficients(voice);
+}
+
+void ZdfFilterBank::setMode(int voice, Mode mode) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    mode_[static_cast<size_t>(voice)] = static_cast<uint8_t>(mode);
+    updateCoefficients(voice);
+}
+
+void ZdfFilterBank::setCutoff(int voice, float frequency) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    targetPitch_[static_cast<size_t>(voice)] = FilterPitch::fromFrequency(frequency, sampleRate_);
+}
+
+void ZdfFilterBank::snapCutoff(int voice, float frequency) noexcept
+{
+    setCutoff(voice, frequency);
+    pitch_[static_cast<size_t>(voice)] = targetPitch_[static_cast<size_t>(voice)];
+}
+
+float ZdfFilterBank::getCutoff(int voice) const noexcept
+{
+    return static_cast<float>(std::exp2(targetPitch_[static_cast<size_t>(voice)]) * sampleRate_);
+}
+
+void ZdfFilterBank::setResonance(int voice, float resonance) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    resonance_[static_cast<size_t>(voice)] = juce::jlimit(0.0f, 1.0f, resonance);
+    updateCoefficients(voice);
+}
+
+void ZdfFilterBank::setGain(int voice, float gainDecibels) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    gainDecibels_[static_cast<size_t>(voice)] = gainDecibels;
+    updateCoefficients(voice);
+}
+
+void ZdfFilterBank::setStages(int voice, int stages) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    stages_[static_cast<size_t>(voice)] = static_cast<uint8_t>(juce::jlimit(1, kMaxStages, stages));
+}
+
+void ZdfFilterBank::setEnabled(int voice, bool enabled) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    enabled_[static_cast<size_t>(voice)] = enabled ? 1 : 0;
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void ZdfFilterBank::process(float* const* channels, int numVoices, int numSamples,
+                            const float* const* modulation, int blockOffset, int blockSize) noexcept
+{
+    jassert(numVoices <= maxVoices_);
+    jassert(blockOffset >= 0 && blockOffset + numSamples <= blockSize);
+    numVoices = std::min(numVoices, maxVoices_);
+    if (numVoices <= 0 || numSamples <= 0) return;
+
+    const float* table = FilterPitch::getPrewarpTable();
+    const int numActiveGroups = (numVoices + kLanes - 1) / kLanes;
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += kChunk) {
+        const int chunk = std::min(kChunk, numSamples - chunkStart);
+
+        for (int group = 0; group < numActiveGroups; ++group) {
+            GroupContext context;
+            context.first = group * kLanes;
+            context.sampleOffset = blockOffset + chunkStart;
+            context.blockSize = blockSize;
+            context.table = table;
+
+            int maxStages = 0;
+            bool hasSvf = false, hasLadder = false;
+
+            for (int lane = 0; lane < kLanes; ++lane) {
+                const int voice = context.first + lane;
+                const auto v = static_cast<size_t>(voice);
+
+                if (voice < numVoices && enabled_[v] != 0 && channels[voice] != nullptr) {
+                    context.input[static_cast<size_t>(lane)] = channels[voice] + chunkStart;
+                    context.output[static_cast<size_t>(lane)] = channels[voice] + chunkStart;
+
+                    const float* offsets = modulation != nullptr ? modulation[voice] : nullptr;
+                    context.modulation[static_cast<size_t>(lane)] = offsets != nullptr ? offsets + chunkStart : zeros_.data();
+
+                    maxStages = std::max(maxStages, static_cast<int>(stages_[v]));
+                    hasSvf = hasSvf || model_[v] == static_cast<uint8_t>(Model::Svf);
+                    hasLadder = hasLadder || model_[v] == static_cast<uint8_t>(Model::Ladder);
+                }
+                else {
+                    context.input[static_cast<size_t>(lane)] = zeros_.data();
+                    context.output[static_cast<size_t>(lane)] = sink_.data();
+                    context.modulation[static_cast<size_t>(lane)] = zeros_.data();
+                }
+            }
+
+            // Nothing enabled: the channels already hold their dry input
+            switch (maxStages) {
+                case 1: dispatchModels<1>(context, hasSvf, hasLadder, chunk); break;
+                case 2: dispatchModels<2>(context, hasSvf, hasLadder, chunk); break;
+                case 3: dispatchModels<3>(context, hasSvf, hasLadder, chunk); break;
+                case 4: dispatchModels<4>(context, hasSvf, hasLadder, chunk); break;
+                default: break;
+            }
+        }
+    }
+
+    // Every glide lands on its target by the end of the block
+    if (blockOffset + numSamples >= blockSize)
+        pitch_ = targetPitch_;
+}
+
+template <int Stages>
+void ZdfFilterBank::dispatchModels(const GroupContext& context, bool hasSvf, bool hasLadder, int numSamples) noexcept
+{
+    if (hasSvf && hasLadder)
+        renderGroup<Stages, true, true>(context, numSamples);
+    else if (hasLadder)
+        renderGroup<Stages, false, true>(context, numSamples);
+    else
+        renderGroup<Stages, true, false>(context, numSamples);
+}
+
+template <int Stages, bool RunSvf, bool RunLadder>
+void ZdfFilterBank::renderGroup(const GroupContext& context, int numSamples) noexcept
+{
+    const auto first = static_cast<size_t>(context.first);
+    const size_t padded = static_cast<size_t>(numGroups_ * kLanes);
+    const float* table = context.table;
+
+    float* x = laneSignal_.data();
+    float* modulation = laneModulation_.data();
+
+    // Interleave the group's channels and modulation, kLanes per sample
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const float* input = context.input[static_cast<size_t>(lane)];
+        const float* offsets = context.modulation[static_cast<size_t>(lane)];
+        for (int i = 0; i < numSamples; ++i) {
+            x[i * kLanes + lane] = input[i];
+            modulation[i * kLanes + lane] = offsets[i];
+        }
+    }
+
+    // Cutoff glides linearly in pitch across the block, measured from the bottom of the table
+    alignas(32) float start[kLanes], glide[kLanes], scale[kLanes], k[kLanes], feedback[kLanes];
+    const float blockScale = 1.0f / static_cast<float>(context.blockSize);
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const size_t v = first + static_cast<size_t>(lane);
+        glide[lane] = (targetPitch_[v] - pitch_[v]) * blockScale;
+        start[lane] = pitch_[v] + glide[lane] * static_cast<float>(context.sampleOffset) - kMinPitch;
+        scale[lane] = gainScale_[v];
+        k[lane] = damping_[v];
+        feedback[lane] = feedback_[v];
+    }
+
+    // Output mixes and stage masks
+    alignas(32) float m0[kLanes], m1[kLanes], m2[kLanes], ladder[kLanes];
+    alignas(32) float c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes], c4[kLanes];
+    alignas(32) float active[Stages][kLanes];
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const size_t v = first + static_cast<size_t>(lane);
+        m0[lane] = svfMix0_[v];
+        m1[lane] = svfMix1_[v];
+        m2[lane] = svfMix2_[v];
+        c0[lane] = ladderMix0_[v];
+        c1[lane] = ladderMix1_[v];
+        c2[lane] = ladderMix2_[v];
+        c3[lane] = ladderMix3_[v];
+        c4[lane] = ladderMix4_[v];
+        ladder[lane] = model_[v] == static_cast<uint8_t>(Model::Ladder) ? 1.0f : 0.0f;
+
+        for (int stage = 0; stage < Stages; ++stage)
+            active[stage][lane] = stage < stages_[v] ? 1.0f : 0.0f;
+    }
+
+    // State, copied into locals for the chunk
+    alignas(32) float ic1[Stages][kLanes], ic2[Stages][kLanes];
+    alignas(32) float s1[Stages][kLanes], s2[Stages][kLanes], s3[Stages][kLanes], s4[Stages][kLanes];
+    for (int stage = 0; stage < Stages; ++stage) {
+        const size_t base = static_cast<size_t>(stage) * padded + first;
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const size_t n = base + static_cast<size_t>(lane);
+            ic1[stage][lane] = svfState1_[n];
+            ic2[stage][lane] = svfState2_[n];
+            s1[stage][lane] = ladderState1_[n];
+            s2[stage][lane] = ladderState2_[n];
+            s3[stage][lane] = ladderState3_[n];
+            s4[stage][lane] = ladderState4_[n];
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        const int row = i * kLanes;
+
+        // Table position in 16.16 fixed point, so the range clamp is integer work that vectorises
+        alignas(32) float fraction[kLanes], g[kLanes];
+        alignas(32) int index[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const int position = TanLayout::toPosition(start[lane] + glide[lane] * static_cast<float>(i) + modulation[row + lane]);
+            index[lane] = TanLayout::index(position);
+            fraction[lane] = TanLayout::fraction(position);
+        }
+
+        // Prewarped integrator gain, one interpolated table read per lane
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const float t0 = table[index[lane]];
+            g[lane] = (t0 + fraction[lane] * (table[index[lane] + 1] - t0)) * scale[lane];
+        }
+
+        alignas(32) float svfOut[kLanes], ladderOut[kLanes];
+        alignas(32) float a1[kLanes], a2[kLanes], a3[kLanes];
+        alignas(32) float gain[kLanes], reciprocal[kLanes], solve[kLanes];
+
+        if constexpr (RunSvf) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                a1[lane] = 1.0f / (1.0f + g[lane] * (g[lane] + k[lane]));
+                a2[lane] = g[lane] * a1[lane];
+                a3[lane] = g[lane] * a2[lane];
+            }
+            for (int lane = 0; lane < kLanes; ++lane)
+                svfOut[lane] = x[row + lane];
+
+            for (int stage = 0; stage < Stages; ++stage) {
+                for (int lane = 0; lane < kLanes; ++lane) {
+                    const float v0 = svfOut[lane];
+                    const float v3 = v0 - ic2[stage][lane];
+                    const float v1 = a1[lane] * ic1[stage][lane] + a2[lane] * v3;
+                    const float v2 = ic2[stage][lane] + a2[lane] * ic1[stage][lane] + a3[lane] * v3;
+                    ic1[stage][lane] = 2.0f * v1 - ic1[stage][lane];
+                    ic2[stage][lane] = 2.0f * v2 - ic2[stage][lane];
+
+                    const float y = m0[lane] * v0 + m1[lane] * v1 + m2[lane] * v2;
+                    svfOut[lane] = v0 + active[stage][lane] * (y - v0);
+                }
+            }
+        }
+
+        if constexpr (RunLadder) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                reciprocal[lane] = 1.0f / (1.0f + g[lane]);
+                gain[lane] = g[lane] * reciprocal[lane];
+                const float g2 = gain[lane] * gain[lane];
+                solve[lane] = 1.0f / (1.0f + feedback[lane] * g2 * g2);
+            }
+
+            for (int lane = 0; lane < kLanes; ++lane)
+                ladderOut[lane] = x[row + lane];
+
+            for (int stage = 0; stage < Stages; ++stage) {
+                for (int lane = 0; lane < kLanes; ++lane) {
+                    const float G = gain[lane];
+                    const float r = reciprocal[lane];
+
+                    // Each one-pole is y = G * in + S, so the loop solves for its input directly
+                    const float S1 = s1[stage][lane] * r;
+                    const float S2 = s2[stage][lane] * r;
+                    const float S3 = s3[stage][lane] * r;
+                    const float S4 = s4[stage][lane] * r;
+                    const float sigma = ((G * S1 + S2) * G + S3) * G + S4;
+
+                    const float in = ladderOut[lane];
+                    const float u = softClip((in - feedback[lane] * sigma) * solve[lane]);
+                    const float y1 = G * u + S1;
+                    const float y2 = G * y1 + S2;
+                    const float y3 = G * y2 + S3;
+                    const float y4 = G * y3 + S4;
+
+                    s1[stage][lane] = 2.0f * y1 - s1[stage][lane];
+                    s2[stage][lane] = 2.0f * y2 - s2[stage][lane];
+                    s3[stage][lane] = 2.0f * y3 - s3[stage][lane];
+                    s4[stage][lane] = 2.0f * y4 - s4[stage][lane];
+
+                    const float y = c0[lane] * u + c1[lane] * y1 + c2[lane] * y2 + c3[lane] * y3 + c4[lane] * y4;
+                    ladderOut[lane] = in + active[stage][lane] * (y - in);
+                }
+            }
+        }
+
+        for (int lane = 0; lane < kLanes; ++lane) {
+            if constexpr (RunSvf && RunLadder)
+                x[row + lane] = svfOut[lane] + ladder[lane] * (ladderOut[lane] - svfOut[lane]);
+            else if constexpr (RunLadder)
+                x[row + lane] = ladderOut[lane];
+            else
+                x[row + lane] = svfOut[lane];
+        }
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        float* output = context.output[static_cast<size_t>(lane)];
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = x[i * kLanes + lane];
+    }
+
+    for (int stage = 0; stage < Stages; ++stage) {
+        const size_t base = static_cast<size_t>(stage) * padded + first;
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const size_t n = base + static_cast<size_t>(lane);
+            if constexpr (RunSvf) {
+                svfState1_[n] = FilterPitch::flush(ic1[stage][lane]);
+                svfState2_[n] = FilterPitch::flush(ic2[stage][lane]);
+            }
+            if constexpr (RunLadder) {
+                ladderState1_[n] = FilterPitch::flush(s1[stage][lane]);
+                ladderState2_[n] = FilterPitch::flush(s2[stage][lane]);
+                ladderState3_[n] = FilterPitch::flush(s3[stage][lane]);
+                ladderState4_[n] = FilterPitch::flush(s4[stage][lane]);
+            }
+        }
+    }
+}
+
+} // namespace filtering
+} // namespace audio_engine
+} // namespace vital
@@ -16,6 +16,7 @@
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include "modulation_matrix.h"
 
 namespace vital {
 namespace audio_engine {
@@ -140,6 +141,16 @@ public:
     float getEnvelopeValue(int envId) const;
     float getParameterModulation(int parameterId) const;
     
+    //==============================================================================
+    /** Compiled routing; matrix sources are the LFOs, then envelopes, macros and MIDI CCs */
+    ModulationMatrix& getMatrix() { return matrix_; }
+    const ModulationMatrix& getMatrix() const { return matrix_; }
+    
+    int getLFOSourceIndex(int lfoId) const { return lfoId; }
+    int getEnvelopeSourceIndex(int envId) const { return config_.numLFOs + envId; }
+    int getMacroSourceIndex(int macroId) const { return config_.numLFOs + config_.numEnvelopes + macroId; }
+    int getCCSourceIndex(int ccNumber) const { return config_.numLFOs + config_.numEnvelopes + config_.numMacros + ccNumber; }
+    
 private:
     //==============================================================================
     /** Configuration */
@@ -229,6 +240,7 @@ private:
     std::vector<float> macroValues_;
     std::vector<float> midiCCValues_;
     std::vector<ModulationRoute> modulationRoutes_;
+    ModulationMatrix matrix_;
     
     //==============================================================================
     /** Current values */
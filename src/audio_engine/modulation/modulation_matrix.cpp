@@ -0,0 +1,501 @@
+/*
+  ==============================================================================
+    modulation_matrix.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the compiled modulation matrix
+  ==============================================================================
+*/
+
+#include "modulation_matrix.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_MODMATRIX_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_MODMATRIX_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace modulation {
+
+namespace {
+
+/** Routes and voice lanes are padded to this many floats so kernels need no scalar tail */
+constexpr size_t kLaneWidth = 8;
+
+inline size_t padToLanes(size_t size) noexcept
+{
+    return (size + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+}
+
+inline float applyCurve(float x, float linear, float quadratic, float cubic) noexcept
+{
+    return x * (linear + quadratic * std::abs(x) + cubic * x * x);
+}
+
+/** out[i] += curve(in[i]) for one route */
+inline void accumulateCurve(float* out, const float* in, float linear, float quadratic, float cubic,
+                            int numSamples) noexcept
+{
+    int i = 0;
+
+   #if VITAL_MODMATRIX_SSE
+    const __m128 a = _mm_set1_ps(linear);
+    const __m128 b = _mm_set1_ps(quadratic);
+    const __m128 c = _mm_set1_ps(cubic);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 x = _mm_loadu_ps(in + i);
+        const __m128 shape = _mm_add_ps(a, _mm_add_ps(_mm_mul_ps(b, _mm_andnot_ps(signMask, x)),
+                                                      _mm_mul_ps(c, _mm_mul_ps(x, x))));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(x, shape)));
+    }
+   #elif VITAL_MODMATRIX_NEON
+    const float32x4_t a = vdupq_n_f32(linear);
+
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4_t x = vld1q_f32(in + i);
+        float32x4_t shape = vmlaq_n_f32(a, vabsq_f32(x), quadratic);
+        shape = vmlaq_n_f32(shape, vmulq_f32(x, x), cubic);
+        vst1q_f32(out + i, vmlaq_f32(vld1q_f32(out + i), x, shape));
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+        out[i] += applyCurve(in[i], linear, quadratic, cubic);
+}
+
+inline void addConstant(float* out, float value, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+        out[i] += value;
+}
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+ModulationMatrix::~ModulationMatrix()
+{
+    delete pending_.exchange(nullptr);
+    delete retired_.exchange(nullptr);
+    delete active_;
+}
+
+void ModulationMatrix::prepare(const Config& config)
+{
+    jassert(config.numSources > 0 && config.numDestinations > 0);
+    jassert(config.numVoices > 0 && config.maxBlockSize > 0);
+
+    delete pending_.exchange(nullptr);
+    delete retired_.exchange(nullptr);
+    delete active_;
+    active_ = nullptr;
+
+    config_ = config;
+    voiceStride_ = config_.numVoices == 1 ? 1 : padToLanes(static_cast<size_t>(config_.numVoices));
+
+    routes_.assign(static_cast<size_t>(config_.maxRoutes), RouteSpec{});
+    freeRouteIds_.resize(static_cast<size_t>(config_.maxRoutes));
+    std::iota(freeRouteIds_.rbegin(), freeRouteIds_.rend(), 0);
+    removedRouteIds_.clear();
+    removedRouteIds_.reserve(static_cast<size_t>(config_.maxRoutes));
+    unadoptedRouteIds_.clear();
+    unadoptedRouteIds_.reserve(static_cast<size_t>(config_.maxRoutes));
+    numRoutes_ = 0;
+
+    routeDepths_ = std::make_unique<std::atomic<float>[]>(static_cast<size_t>(config_.maxRoutes));
+    for (int route = 0; route < config_.maxRoutes; ++route)
+        routeDepths_[static_cast<size_t>(route)].store(0.0f, std::memory_order_relaxed);
+
+    audioRateSources_.assign(static_cast<size_t>(config_.numSources), 0);
+    audioRateDestinations_.assign(static_cast<size_t>(config_.numDestinations), 0);
+    numAudioRateSources_ = 0;
+    numAudioRateDestinations_ = 0;
+
+    const size_t voiceBlock = static_cast<size_t>(config_.numVoices) * static_cast<size_t>(config_.maxBlockSize);
+    blockSources_.assign(static_cast<size_t>(config_.numSources) * voiceStride_, 0.0f);
+    blockOutputs_.assign(static_cast<size_t>(config_.numDestinations) * voiceStride_, 0.0f);
+    sourceAudio_.assign(static_cast<size_t>(config_.maxAudioRateSources) * voiceBlock, 0.0f);
+    destinationAudio_.assign(static_cast<size_t>(config_.maxAudioRateDestinations) * voiceBlock, 0.0f);
+    remappedAudio_.assign(destinationAudio_.size(), 0.0f);
+}
+
+//==============================================================================
+// Route editing
+//==============================================================================
+
+int ModulationMatrix::addRoute(int source, int destination, float depth, Curve curve)
+{
+    if (source < 0 || source >= config_.numSources || destination < 0 || destination >= config_.numDestinations
+        || freeRouteIds_.empty()) {
+        return -1;
+    }
+
+    const int routeId = freeRouteIds_.back();
+    freeRouteIds_.pop_back();
+
+    routes_[static_cast<size_t>(routeId)] = { source, destination, curve, true };
+    routeDepths_[static_cast<size_t>(routeId)].store(depth, std::memory_order_relaxed);
+    ++numRoutes_;
+    return routeId;
+}
+
+void ModulationMatrix::removeRoute(int routeId)
+{
+    if (routeId < 0 || routeId >= config_.maxRoutes || !routes_[static_cast<size_t>(routeId)].active) return;
+
+    // The live program keeps reading this id's depth until a recompiled one replaces it
+    routes_[static_cast<size_t>(routeId)].active = false;
+    removedRouteIds_.push_back(routeId);
+    --numRoutes_;
+}
+
+void ModulationMatrix::clearRoutes()
+{
+    for (int routeId = 0; routeId < config_.maxRoutes; ++routeId)
+        removeRoute(routeId);
+}
+
+void ModulationMatrix::setRouteDepth(int routeId, float depth) noexcept
+{
+    if (routeId < 0 || routeId >= config_.maxRoutes) return;
+    routeDepths_[static_cast<size_t>(routeId)].store(depth, std::memory_order_relaxed);
+}
+
+bool ModulationMatrix::setSourceRate(int source, Rate rate)
+{
+    if (source < 0 || source >= config_.numSources) return false;
+
+    auto& audioRate = audioRateSources_[static_cast<size_t>(source)];
+    const bool wantsAudio = rate == Rate::Audio;
+    if (audioRate == wantsAudio) return true;
+    if (wantsAudio && numAudioRateSources_ >= config_.maxAudioRateSources) return false;
+
+    audioRate = wantsAudio;
+    numAudioRateSources_ += wantsAudio ? 1 : -1;
+    return true;
+}
+
+bool ModulationMatrix::setDestinationRate(int destination, Rate rate)
+{
+    if (destination < 0 || destination >= config_.numDestinations) return false;
+
+    auto& audioRate = audioRateDestinations_[static_cast<size_t>(destination)];
+    const bool wantsAudio = rate == Rate::Audio;
+    if (audioRate == wantsAudio) return true;
+    if (wantsAudio && numAudioRateDestinations_ >= config_.maxAudioRateDestinations) return false;
+
+    audioRate = wantsAudio;
+    numAudioRateDestinations_ += wantsAudio ? 1 : -1;
+    return true;
+}
+
+//==============================================================================
+// Compilation
+//==============================================================================
+
+void ModulationMatrix::compile()
+{
+    // The program the audio thread replaced last time is safe to free now
+    delete retired_.exchange(nullptr, std::memory_order_acquire);
+
+    // If the last published program was adopted, the routes it dropped are no longer read;
+    // an unclaimed one is replaced and its dropped routes carry over to this program
+    if (Program* unclaimed = pending_.exchange(nullptr, std::memory_order_acq_rel)) {
+        delete unclaimed;
+    } else {
+        freeRouteIds_.insert(freeRouteIds_.end(), unadoptedRouteIds_.begin(), unadoptedRouteIds_.end());
+        unadoptedRouteIds_.clear();
+    }
+
+    unadoptedRouteIds_.insert(unadoptedRouteIds_.end(), removedRouteIds_.begin(), removedRouteIds_.end());
+    removedRouteIds_.clear();
+
+    auto program = std::make_unique<Program>();
+    const auto numDestinations = static_cast<size_t>(config_.numDestinations);
+
+    // Counting sort of the active routes by destination into CSR rows
+    program->rowStart.assign(numDestinations + 1, 0);
+    for (const auto& route : routes_) {
+        if (route.active)
+            ++program->rowStart[static_cast<size_t>(route.destination) + 1];
+    }
+    std::partial_sum(program->rowStart.begin(), program->rowStart.end(), program->rowStart.begin());
+
+    const auto numRoutes = static_cast<size_t>(program->rowStart.back());
+    program->paddedRoutes = padToLanes(numRoutes);
+    program->routeSource.assign(program->paddedRoutes, 0);
+    program->routeSourceOffset.assign(program->paddedRoutes, 0);
+    program->routeId.assign(program->paddedRoutes, -1);
+    program->routeCurve.assign(program->paddedRoutes, 0);
+    program->routeCoefficients.assign(program->paddedRoutes * 3, 0.0f);
+    program->routeValues.assign(program->paddedRoutes, 0.0f);
+
+    std::vector<int> fill(program->rowStart.begin(), program->rowStart.end() - 1);
+    for (int routeId = 0; routeId < config_.maxRoutes; ++routeId) {
+        const auto& route = routes_[static_cast<size_t>(routeId)];
+        if (!route.active) continue;
+
+        const auto index = static_cast<size_t>(fill[static_cast<size_t>(route.destination)]++);
+        program->routeSource[index] = route.source;
+        program->routeSourceOffset[index] = route.source * static_cast<int>(voiceStride_);
+        program->routeId[index] = routeId;
+        program->routeCurve[index] = static_cast<uint8_t>(route.curve);
+    }
+
+    program->modulated.assign(numDestinations, 0);
+    program->destinationSlot.assign(numDestinations, -1);
+    for (size_t destination = 0; destination < numDestinations; ++destination) {
+        if (program->rowStart[destination] == program->rowStart[destination + 1]) continue;
+
+        program->modulated[destination] = 1;
+        program->activeDestinations.push_back(static_cast<int>(destination));
+
+        if (audioRateDestinations_[destination]) {
+            program->destinationSlot[destination] = static_cast<int>(program->audioDestinations.size());
+            program->audioDestinations.push_back(static_cast<int>(destination));
+        }
+    }
+
+    program->sourceSlot.assign(static_cast<size_t>(config_.numSources), -1);
+    for (int source = 0; source < config_.numSources; ++source) {
+        if (audioRateSources_[static_cast<size_t>(source)]) {
+            program->sourceSlot[static_cast<size_t>(source)] = static_cast<int>(program->audioSources.size());
+            program->audioSources.push_back(source);
+        }
+    }
+
+    pending_.store(program.release(), std::memory_order_release);
+}
+
+//==============================================================================
+// Audio thread
+//==============================================================================
+
+void ModulationMatrix::setSourceValue(int source, float value) noexcept
+{
+    float* lanes = blockSources_.data() + static_cast<size_t>(source) * voiceStride_;
+    std::fill(lanes, lanes + config_.numVoices, value);
+}
+
+void ModulationMatrix::setSourceValue(int source, int voice, float value) noexcept
+{
+    blockSources_[static_cast<size_t>(source) * voiceStride_ + static_cast<size_t>(voice)] = value;
+}
+
+float* ModulationMatrix::getSourceBuffer(int source, int voice) noexcept
+{
+    if (active_ == nullptr) return nullptr;
+
+    const int slot = active_->sourceSlot[static_cast<size_t>(source)];
+    return slot >= 0 ? sourceAudioBuffer(slot, voice) : nullptr;
+}
+
+const float* ModulationMatrix::getModulationBuffer(int destination, int voice) const noexcept
+{
+    if (active_ == nullptr) return nullptr;
+
+    const int slot = active_->destinationSlot[static_cast<size_t>(destination)];
+    if (slot < 0) return nullptr;
+
+    return destinationAudio_.data() + (static_cast<size_t>(slot) * static_cast<size_t>(config_.numVoices)
+                                       + static_cast<size_t>(voice)) * static_cast<size_t>(config_.maxBlockSize);
+}
+
+bool ModulationMatrix::isModulated(int destination) const noexcept
+{
+    return active_ != nullptr && active_->modulated[static_cast<size_t>(destination)] != 0;
+}
+
+void ModulationMatrix::process(int numSamples) noexcept
+{
+    jassert(numSamples <= config_.maxBlockSize);
+    numSamples = std::min(numSamples, config_.maxBlockSize);
+
+    if (active_ != nullptr) {
+        Program& program = *active_;
+        refreshCoefficients(program);
+
+        // Audio-rate sources drive block-rate destinations with their first sample
+        for (int source : program.audioSources) {
+            const int slot = program.sourceSlot[static_cast<size_t>(source)];
+            for (int voice = 0; voice < config_.numVoices; ++voice)
+                setSourceValue(source, voice, sourceAudioBuffer(slot, voice)[0]);
+        }
+
+        if (voiceStride_ == 1)
+            evaluateMono(program);
+        else
+            evaluateVoices(program);
+
+        evaluateAudioRate(program, numSamples);
+    }
+
+    // Adopt a newly compiled program for the next block once the last retired one was collected
+    if (retired_.load(std::memory_order_acquire) == nullptr) {
+        if (Program* next = pending_.exchange(nullptr, std::memory_order_acq_rel)) {
+            carryOverOutputs(active_, *next, numSamples);
+            retired_.store(active_, std::memory_order_release);
+            active_ = next;
+        }
+    }
+}
+
+void ModulationMatrix::refreshCoefficients(Program& program) noexcept
+{
+    float* linear = program.routeCoefficients.data();
+    float* quadratic = linear + program.paddedRoutes;
+    float* cubic = quadratic + program.paddedRoutes;
+    const auto numRoutes = static_cast<size_t>(program.rowStart.back());
+
+    for (size_t route = 0; route < numRoutes; ++route) {
+        const float depth = routeDepths_[static_cast<size_t>(program.routeId[route])].load(std::memory_order_relaxed);
+        const auto curve = static_cast<Curve>(program.routeCurve[route]);
+
+        linear[route] = curve == Curve::Linear ? depth : 0.0f;
+        quadratic[route] = curve == Curve::Quadratic ? depth : 0.0f;
+        cubic[route] = curve == Curve::Cubic ? depth : 0.0f;
+    }
+}
+
+void ModulationMatrix::evaluateMono(Program& program) noexcept
+{
+    const float* sources = blockSources_.data();
+    const float* linear = program.routeCoefficients.data();
+    const float* quadratic = linear + program.paddedRoutes;
+    const float* cubic = quadratic + program.paddedRoutes;
+    const int* offsets = program.routeSourceOffset.data();
+    float* values = program.routeValues.data();
+    size_t route = 0;
+
+   #if defined(__AVX2__)
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    for (; route < program.paddedRoutes; route += 8) {
+        const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + route));
+        const __m256 x = _mm256_i32gather_ps(sources, index, 4);
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        const __m256 absX = _mm256_andnot_ps(signMask, x);
+
+       #if defined(__FMA__)
+        __m256 shape = _mm256_fmadd_ps(_mm256_loadu_ps(quadratic + route), absX, _mm256_loadu_ps(linear + route));
+        shape = _mm256_fmadd_ps(_mm256_loadu_ps(cubic + route), x2, shape);
+       #else
+        __m256 shape = _mm256_add_ps(_mm256_loadu_ps(linear + route),
+                                     _mm256_mul_ps(_mm256_loadu_ps(quadratic + route), absX));
+        shape = _mm256_add_ps(shape, _mm256_mul_ps(_mm256_loadu_ps(cubic + route), x2));
+       #endif
+
+        _mm256_storeu_ps(values + route, _mm256_mul_ps(x, shape));
+    }
+   #endif
+
+    for (; route < program.paddedRoutes; ++route)
+        values[route] = applyCurve(sources[offsets[route]], linear[route], quadratic[route], cubic[route]);
+
+    // Segmented sum of each destination row
+    for (int destination : program.activeDestinations) {
+        const auto row = static_cast<size_t>(destination);
+        float sum = 0.0f;
+        for (int index = program.rowStart[row]; index < program.rowStart[row + 1]; ++index)
+            sum += values[index];
+        blockOutputs_[row] = sum;
+    }
+}
+
+void ModulationMatrix::evaluateVoices(const Program& program) noexcept
+{
+    const float* linear = program.routeCoefficients.data();
+    const float* quadratic = linear + program.paddedRoutes;
+    const float* cubic = quadratic + program.paddedRoutes;
+    const int lanes = static_cast<int>(voiceStride_);
+
+    for (int destination : program.activeDestinations) {
+        const auto row = static_cast<size_t>(destination);
+        float* out = blockOutputs_.data() + row * voiceStride_;
+        std::fill(out, out + voiceStride_, 0.0f);
+
+        for (int index = program.rowStart[row]; index < program.rowStart[row + 1]; ++index) {
+            const float* x = blockSources_.data() + static_cast<size_t>(program.routeSourceOffset[static_cast<size_t>(index)]);
+            accumulateCurve(out, x, linear[index], quadratic[index], cubic[index], lanes);
+        }
+    }
+}
+
+void ModulationMatrix::evaluateAudioRate(const Program& program, int numSamples) noexcept
+{
+    const float* linear = program.routeCoefficients.data();
+    const float* quadratic = linear + program.paddedRoutes;
+    const float* cubic = quadratic + program.paddedRoutes;
+
+    for (size_t slot = 0; slot < program.audioDestinations.size(); ++slot) {
+        const auto row = static_cast<size_t>(program.audioDestinations[slot]);
+
+        for (int voice = 0; voice < config_.numVoices; ++voice) {
+            float* out = destinationAudioBuffer(static_cast<int>(slot), voice);
+            std::fill(out, out + numSamples, 0.0f);
+
+            for (int index = program.rowStart[row]; index < program.rowStart[row + 1]; ++index) {
+                const int source = program.routeSource[static_cast<size_t>(index)];
+                const int sourceSlot = program.sourceSlot[static_cast<size_t>(source)];
+
+                if (sourceSlot >= 0) {
+                    accumulateCurve(out, sourceAudioBuffer(sourceSlot, voice), linear[index], quadratic[index],
+                                    cubic[index], numSamples);
+                } else {
+                    const float x = blockSources_[static_cast<size_t>(source) * voiceStride_ + static_cast<size_t>(voice)];
+                    addConstant(out, applyCurve(x, linear[index], quadratic[index], cubic[index]), numSamples);
+                }
+            }
+        }
+    }
+}
+
+void ModulationMatrix::carryOverOutputs(const Program* previous, const Program& next, int numSamples) noexcept
+{
+    // Destinations that lost every route fall back to zero; the rest keep this block's values
+    if (previous != nullptr) {
+        for (int destination : previous->activeDestinations) {
+            if (next.modulated[static_cast<size_t>(destination)] != 0) continue;
+
+            float* out = blockOutputs_.data() + static_cast<size_t>(destination) * voiceStride_;
+            std::fill(out, out + voiceStride_, 0.0f);
+        }
+    }
+
+    // Move per-sample buffers to the new program's slots; a destination that just became
+    // audio rate holds its block value
+    for (size_t slot = 0; slot < next.audioDestinations.size(); ++slot) {
+        const auto destination = static_cast<size_t>(next.audioDestinations[slot]);
+        const int previousSlot = previous != nullptr ? previous->destinationSlot[destination] : -1;
+
+        for (int voice = 0; voice < config_.numVoices; ++voice) {
+            const size_t offset = (slot * static_cast<size_t>(config_.numVoices) + static_cast<size_t>(voice))
+                                  * static_cast<size_t>(config_.maxBlockSize);
+            float* out = remappedAudio_.data() + offset;
+
+            if (previousSlot >= 0) {
+                const float* in = destinationAudioBuffer(previousSlot, voice);
+                std::copy(in, in + numSamples, out);
+            } else {
+                std::fill(out, out + numSamples, blockOutputs_[destination * voiceStride_ + static_cast<size_t>(voice)]);
+            }
+        }
+    }
+
+    destinationAudio_.swap(remappedAudio_);
+}
+
+} // namespace modulation
+} // namespace audio_engine
+} // namespace vital
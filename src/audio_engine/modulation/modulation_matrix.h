@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+    modulation_matrix.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Compiled source-by-destination modulation matrix evaluated once per
+    block with SIMD kernels, at block or audio rate and per voice
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace vital {
+namespace audio_engine {
+namespace modulation {
+
+//==============================================================================
+/**
+ * @class ModulationMatrix
+ * @brief Flattened modulation routing evaluated a block at a time
+ *
+ * Routes are edited on the message thread and compile() flattens them into a
+ * compressed sparse matrix with one row per destination. The compiled
+ * program is handed to the audio thread through an atomic pointer, so the
+ * audio thread never sees a half-edited route list and never locks.
+ *
+ * Each block the owner writes every source (LFO, envelope, macro, CC...) once:
+ * block-rate sources as one value per voice, audio-rate sources as one
+ * buffer per voice. process() then evaluates every route in one pass.
+ * A route's curve is folded into three per-route coefficients,
+ *     out += x * (linear + quadratic * |x| + cubic * x * x),
+ * so routes with different curves share one branch-free FMA kernel: with a
+ * single voice the source values are gathered across routes, with several
+ * voices each route is applied across the voice lanes. Destinations set to
+ * audio rate also get per-sample buffers.
+ *
+ * A compiled program is adopted at the end of a process() call, so source
+ * buffers written for a block always match the program that reads them.
+ * Outputs carry over to the new program: destinations it still modulates
+ * keep their values, so a recompile never drops modulation for a block, and
+ * only destinations that lost every route return to zero. Route depths can
+ * be changed without recompiling; they are picked up at the start of the
+ * next block. A removed route's id is only handed out again once a program
+ * without it is live, so a new route never inherits the depth of one the
+ * audio thread is still evaluating.
+ */
+class ModulationMatrix
+{
+public:
+    //==============================================================================
+    struct Config
+    {
+        int numSources = 144;               // 4 LFOs, 4 envelopes, 8 macros, 128 CCs
+        int numDestinations = 1024;
+        int numVoices = 1;
+        int maxBlockSize = 512;
+        int maxRoutes = 1024;
+        int maxAudioRateSources = 16;
+        int maxAudioRateDestinations = 32;
+    };
+
+    enum class Rate { Block, Audio };
+
+    enum class Curve : uint8_t { Linear, Quadratic, Cubic };   // Odd-symmetric, so bipolar sources keep their sign
+
+    //==============================================================================
+    ModulationMatrix() = default;
+    ~ModulationMatrix();
+
+    /** Allocate every buffer and drop all routes. Not real-time safe. */
+    void prepare(const Config& config);
+
+    const Config& getConfig() const noexcept { return config_; }
+
+    //==============================================================================
+    /** Route editing (message thread); takes effect on the next compile() */
+    int addRoute(int source, int destination, float depth, Curve curve = Curve::Linear);
+    void removeRoute(int routeId);
+    void clearRoutes();
+    int getNumRoutes() const noexcept { return numRoutes_; }
+
+    /** Lock-free and picked up on the next block without recompiling */
+    void setRouteDepth(int routeId, float depth) noexcept;
+
+    /** Evaluation rate; audio-rate slots are limited by the config. Takes effect on the next compile(). */
+    bool setSourceRate(int source, Rate rate);
+    bool setDestinationRate(int destination, Rate rate);
+
+    /** Flatten the routes and hand the result to the audio thread */
+    void compile();
+
+    //==============================================================================
+    /** Source input (audio thread), written before process() */
+    void setSourceValue(int source, float value) noexcept;
+    void setSourceValue(int source, int voice, float value) noexcept;
+
+    /** numSamples values to fill for an audio-rate source, or nullptr if the source is block rate */
+    float* getSourceBuffer(int source, int voice = 0) noexcept;
+
+    /** Evaluate every route for the next numSamples samples (audio thread) */
+    void process(int numSamples) noexcept;
+
+    //==============================================================================
+    /** Summed modulation at the start of the block */
+    float getModulation(int destination, int voice = 0) const noexcept
+    {
+        return blockOutputs_[static_cast<size_t>(destination) * voiceStride_ + static_cast<size_t>(voice)];
+    }
+
+    /** Per-sample modulation of an audio-rate destination, or nullptr for block-rate destinations */
+    const float* getModulationBuffer(int destination, int voice = 0) const noexcept;
+
+    /** True if any compiled route targets the destination */
+    bool isModulated(int destination) const noexcept;
+
+private:
+    //==============================================================================
+    struct RouteSpec
+    {
+        int source = -1;
+        int destination = -1;
+        Curve curve = Curve::Linear;
+        bool active = false;
+    };
+
+    /** Immutable once published; only routeCoefficients is rewritten by the audio thread */
+    struct Program
+    {
+        std::vector<int> rowStart;              // numDestinations + 1
+        std::vector<int> activeDestinations;    // Rows with at least one route
+        std::vector<int> routeSourceOffset;     // source * voiceStride, for the gather
+        std::vector<int> routeSource;
+        std::vector<int> routeId;
+        std::vector<uint8_t> routeCurve;
+        std::vector<float> routeCoefficients;   // Linear, quadratic, cubic planes of paddedRoutes each
+        std::vector<float> routeValues;         // Mono per-route contributions
+        std::vector<int> sourceSlot;            // Audio buffer slot per source or -1
+        std::vector<int> destinationSlot;       // Audio buffer slot per destination or -1
+        std::vector<int> audioSources;
+        std::vector<int> audioDestinations;
+        std::vector<uint8_t> modulated;
+        size_t paddedRoutes = 0;
+    };
+
+    //==============================================================================
+    void refreshCoefficients(Program& program) noexcept;
+    void evaluateMono(Program& program) noexcept;
+    void evaluateVoices(const Program& program) noexcept;
+    void evaluateAudioRate(const Program& program, int numSamples) noexcept;
+    void carryOverOutputs(const Program* previous, const Program& next, int numSamples) noexcept;
+
+    float* sourceAudioBuffer(int slot, int voice) noexcept
+    {
+        return sourceAudio_.data() + (static_cast<size_t>(slot) * static_cast<size_t>(config_.numVoices)
+                                      + static_cast<size_t>(voice)) * static_cast<size_t>(config_.maxBlockSize);
+    }
+
+    float* destinationAudioBuffer(int slot, int voice) noexcept
+    {
+        return destinationAudio_.data() + (static_cast<size_t>(slot) * static_cast<size_t>(config_.numVoices)
+                                           + static_cast<size_t>(voice)) * static_cast<size_t>(config_.maxBlockSize);
+    }
+
+    Config config_;
+    size_t voiceStride_ = 1;                    // Voices padded to the SIMD width, or 1 when monophonic
+
+    /** Message thread */
+    std::vector<RouteSpec> routes_;
+    std::vector<int> freeRouteIds_;
+    std::vector<int> removedRouteIds_;          // Removed since the last compile()
+    std::vector<int> unadoptedRouteIds_;        // Dropped by the published program; free once it is adopted
+    std::vector<uint8_t> audioRateSources_;
+    std::vector<uint8_t> audioRateDestinations_;
+    int numAudioRateSources_ = 0;
+    int numAudioRateDestinations_ = 0;
+    int numRoutes_ = 0;
+    std::unique_ptr<std::atomic<float>[]> routeDepths_;
+
+    /** Program handoff: compile() fills pending_; the end of process() swaps it in for the next block and parks the old one in retired_ */
+    std::atomic<Program*> pending_{nullptr};
+    std::atomic<Program*> retired_{nullptr};
+    Program* active_ = nullptr;
+
+    /** Audio thread buffers */
+    std::vector<float> blockSources_;           // numSources x voiceStride
+    std::vector<float> blockOutputs_;           // numDestinations x voiceStride
+    std::vector<float> sourceAudio_;            // Slots x voices x maxBlockSize
+    std::vector<float> destinationAudio_;
+    std::vector<float> remappedAudio_;          // Destination buffers rearranged for an adopted program
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(ModulationMatrix)
+};
+
+} // namespace modulation
+} // namespace audio_engine
+} // namespace vital
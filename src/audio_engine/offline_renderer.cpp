@@ -0,0 +1,407 @@
+/*
+  ==============================================================================
+    offline_renderer.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+    https://vital.audio
+
+    Implementation of the deterministic offline renderer
+  ==============================================================================
+*/
+
+#include "offline_renderer.h"
+#include "../performance/multithreading.h"
+
+#include <array>
+#include <optional>
+
+namespace vital {
+namespace audio_engine {
+
+namespace {
+
+constexpr int kNumMidiChannels = 16;
+constexpr int kNumMidiNotes = 128;
+constexpr int kSustainController = 64;
+
+juce::int64 secondsToSamples(double seconds, double sampleRate)
+{
+    return static_cast<juce::int64>(std::llround(seconds * sampleRate));
+}
+
+} // namespace
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+OfflineRenderer::Result OfflineRenderer::render(const Settings& settings)
+{
+    Result result;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (settings.sampleRate <= 0.0 || settings.blockSize <= 0 || settings.numChannels <= 0) {
+        result.errorMessage = "Invalid render settings";
+        return result;
+    }
+
+    if (settings.presetFile != juce::File() && !settings.presetFile.existsAsFile()) {
+        result.errorMessage = "Preset file not found: " + settings.presetFile.getFullPathName();
+        return result;
+    }
+
+    std::vector<TimedMessage> events;
+    if (!readMidiFile(settings.midiFile, settings.sampleRate, events, result.errorMessage)) {
+        return result;
+    }
+
+    const juce::int64 lastEventSample = events.empty() ? 0 : events.back().sample;
+    const juce::int64 totalSamples = lastEventSample + secondsToSamples(settings.tailSeconds, settings.sampleRate);
+
+    auto writer = createWriter(settings, result.errorMessage);
+    if (writer == nullptr) {
+        return result;
+    }
+
+    const int numThreads = std::max(1, settings.numThreads);
+    bool rendered = false;
+
+    if (settings.splitMode == SplitMode::ByTimeSegment && numThreads > 1) {
+        const auto segments = findSegments(events, totalSamples,
+                                           secondsToSamples(settings.tailSeconds, settings.sampleRate),
+                                           secondsToSamples(settings.segmentSeconds, settings.sampleRate));
+        result.numSegments = static_cast<int>(segments.size());
+
+        // Segments write disjoint ranges of one buffer, which is then written in order
+        juce::AudioBuffer<float> timeline(settings.numChannels, static_cast<int>(totalSamples));
+        float* const* timelineChannels = timeline.getArrayOfWritePointers();
+        std::vector<juce::String> errors(segments.size());
+        std::atomic<bool> failed{false};
+
+        performance::threading::WorkStealingScheduler scheduler(static_cast<size_t>(numThreads - 1));
+        scheduler.parallel_for(0, segments.size(), 1, [&](size_t index) {
+            const Segment& segment = segments[index];
+            auto sink = [&](const juce::AudioBuffer<float>& block, juce::int64 position, int numSamples) {
+                for (int channel = 0; channel < settings.numChannels; ++channel) {
+                    juce::FloatVectorOperations::copy(timelineChannels[channel] + position,
+                                                      block.getReadPointer(channel), numSamples);
+                }
+                return true;
+            };
+
+            if (!renderSegment(settings, events, segment, 0, sink, errors[index])) {
+                failed.store(true);
+            }
+        });
+
+        if (failed.load()) {
+            for (const auto& error : errors) {
+                if (error.isNotEmpty()) {
+                    result.errorMessage = error;
+                    break;
+                }
+            }
+            return result;
+        }
+
+        rendered = writer->writeFromAudioSampleBuffer(timeline, 0, timeline.getNumSamples());
+    } else {
+        // One engine; blocks stream straight to the writer
+        const int numWorkerThreads = settings.splitMode == SplitMode::ByVoice ? numThreads - 1 : 0;
+        result.numSegments = 1;
+
+        auto sink = [&](const juce::AudioBuffer<float>& block, juce::int64 /*position*/, int numSamples) {
+            return writer->writeFromAudioSampleBuffer(block, 0, numSamples);
+        };
+
+        rendered = renderSegment(settings, events, Segment{0, totalSamples}, numWorkerThreads, sink, result.errorMessage);
+    }
+
+    writer.reset();
+
+    if (!rendered) {
+        if (result.errorMessage.isEmpty()) {
+            result.errorMessage = "Failed to write " + settings.outputFile.getFullPathName();
+        }
+        return result;
+    }
+
+    const auto endTime = std::chrono::steady_clock::now();
+    result.success = true;
+    result.numSamples = totalSamples;
+    result.renderSeconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    if (result.renderSeconds > 0.0) {
+        result.realtimeFactor = (static_cast<double>(totalSamples) / settings.sampleRate) / result.renderSeconds;
+    }
+
+    return result;
+}
+
+std::vector<OfflineRenderer::Result> OfflineRenderer::renderBatch(const std::vector<Settings>& jobs, int numThreads)
+{
+    std::vector<Result> results(jobs.size());
+
+    // Jobs are the unit of parallelism, so each one renders on a single thread
+    performance::threading::WorkStealingScheduler scheduler(static_cast<size_t>(std::max(1, numThreads) - 1));
+    scheduler.parallel_for(0, jobs.size(), 1, [&](size_t index) {
+        Settings job = jobs[index];
+        job.splitMode = SplitMode::None;
+        job.numThreads = 1;
+        results[index] = render(job);
+    });
+
+    return results;
+}
+
+template <typename BlockSink>
+bool OfflineRenderer::renderSegment(const Settings& settings,
+                                    const std::vector<TimedMessage>& events,
+                                    const Segment& segment,
+                                    int numWorkerThreads,
+                                    BlockSink&& sink,
+                                    juce::String& error)
+{
+    VitalAudioEngine engine(makeEngineConfig(settings, numWorkerThreads));
+
+    if (!engine.initialize()) {
+        error = "Failed to initialise audio engine";
+        return false;
+    }
+
+    if (settings.presetFile != juce::File() && !engine.loadPreset(settings.presetFile)) {
+        error = "Failed to load preset: " + settings.presetFile.getFullPathName();
+        return false;
+    }
+
+    juce::AudioBuffer<float> input(settings.numChannels, settings.blockSize);
+    juce::AudioBuffer<float> output(settings.numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+
+    // Controller and program state from before the segment applies from its first sample
+    for (const auto& message : collectStateBefore(events, segment.startSample)) {
+        midi.addEvent(message, 0);
+    }
+
+    auto nextEvent = std::lower_bound(events.begin(), events.end(), segment.startSample,
+        [](const TimedMessage& event, juce::int64 sample) { return event.sample < sample; });
+
+    for (juce::int64 position = segment.startSample; position < segment.endSample; position += settings.blockSize) {
+        const int numSamples = static_cast<int>(std::min<juce::int64>(settings.blockSize, segment.endSample - position));
+
+        input.setSize(settings.numChannels, numSamples, false, false, true);
+        output.setSize(settings.numChannels, numSamples, false, false, true);
+        input.clear();
+        output.clear();
+
+        while (nextEvent != events.end() && nextEvent->sample < position + numSamples) {
+            midi.addEvent(nextEvent->message, static_cast<int>(nextEvent->sample - position));
+            ++nextEvent;
+        }
+
+        engine.processBlock(input, output, midi);
+        midi.clear();
+
+        if (!sink(output, position, numSamples)) {
+            error = "Failed to write rendered audio";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// MIDI Timeline
+//==============================================================================
+
+bool OfflineRenderer::readMidiFile(const juce::File& file, double sampleRate,
+                                   std::vector<TimedMessage>& events, juce::String& error)
+{
+    juce::FileInputStream stream(file);
+    juce::MidiFile midiFile;
+
+    if (!stream.openedOk() || !midiFile.readFrom(stream)) {
+        error = "Failed to read MIDI file: " + file.getFullPathName();
+        return false;
+    }
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    // addSequence keeps events sorted, with ties in track order
+    juce::MidiMessageSequence merged;
+    for (int track = 0; track < midiFile.getNumTracks(); ++track) {
+        merged.addSequence(*midiFile.getTrack(track), 0.0);
+    }
+
+    events.clear();
+    events.reserve(static_cast<size_t>(merged.getNumEvents()));
+
+    for (const auto* holder : merged) {
+        const auto& message = holder->message;
+        if (message.isMetaEvent() || message.isSysEx()) continue;
+
+        events.push_back({ secondsToSamples(message.getTimeStamp(), sampleRate), message });
+    }
+
+    return true;
+}
+
+std::vector<OfflineRenderer::Segment> OfflineRenderer::findSegments(const std::vector<TimedMessage>& events,
+                                                                    juce::int64 totalSamples,
+                                                                    juce::int64 gapSamples,
+                                                                    juce::int64 minSegmentSamples)
+{
+    std::vector<Segment> segments;
+    std::array<int, kNumMidiChannels * kNumMidiNotes> heldNotes{};
+    std::array<bool, kNumMidiChannels> sustainDown{};
+    int numHeld = 0;
+    int numSustained = 0;
+
+    juce::int64 segmentStart = 0;
+    juce::int64 quietSince = 0;
+
+    for (const auto& event : events) {
+        const bool quiet = numHeld == 0 && numSustained == 0;
+
+        // Cut once the previous sound has had gapSamples to ring out
+        const juce::int64 cut = quietSince + gapSamples;
+        if (quiet && cut <= event.sample && cut - segmentStart >= minSegmentSamples) {
+            segments.push_back({ segmentStart, cut });
+            segmentStart = cut;
+        }
+
+        const auto& message = event.message;
+        const int channel = juce::jlimit(1, kNumMidiChannels, message.getChannel()) - 1;
+
+        if (message.isNoteOn()) {
+            ++heldNotes[static_cast<size_t>(channel * kNumMidiNotes + message.getNoteNumber())];
+            ++numHeld;
+        } else if (message.isNoteOff()) {
+            auto& count = heldNotes[static_cast<size_t>(channel * kNumMidiNotes + message.getNoteNumber())];
+            if (count > 0) {
+                --count;
+                --numHeld;
+            }
+        } else if (message.isAllNotesOff() || message.isAllSoundOff()) {
+            for (int note = 0; note < kNumMidiNotes; ++note) {
+                auto& count = heldNotes[static_cast<size_t>(channel * kNumMidiNotes + note)];
+                numHeld -= count;
+                count = 0;
+            }
+        } else if (message.isController() && message.getControllerNumber() == kSustainController) {
+            const bool down = message.getControllerValue() >= 64;
+            if (down != sustainDown[static_cast<size_t>(channel)]) {
+                sustainDown[static_cast<size_t>(channel)] = down;
+                numSustained += down ? 1 : -1;
+            }
+        }
+
+        if (!quiet && numHeld == 0 && numSustained == 0) {
+            quietSince = event.sample;
+        }
+    }
+
+    segments.push_back({ segmentStart, totalSamples });
+    return segments;
+}
+
+std::vector<juce::MidiMessage> OfflineRenderer::collectStateBefore(const std::vector<TimedMessage>& events,
+                                                                  juce::int64 sample)
+{
+    // Latest controller, program, pitch wheel and channel pressure per channel
+    constexpr int kSlotsPerChannel = kNumMidiNotes + 3;
+    std::vector<std::optional<juce::MidiMessage>> state(static_cast<size_t>(kNumMidiChannels * kSlotsPerChannel));
+
+    for (const auto& event : events) {
+        if (event.sample >= sample) break;
+
+        const auto& message = event.message;
+        const int channel = juce::jlimit(1, kNumMidiChannels, message.getChannel()) - 1;
+        int slot = -1;
+
+        if (message.isController()) {
+            slot = message.getControllerNumber();
+        } else if (message.isProgramChange()) {
+            slot = kNumMidiNotes;
+        } else if (message.isPitchWheel()) {
+            slot = kNumMidiNotes + 1;
+        } else if (message.isChannelPressure()) {
+            slot = kNumMidiNotes + 2;
+        }
+
+        if (slot >= 0) {
+            state[static_cast<size_t>(channel * kSlotsPerChannel + slot)] = message;
+        }
+    }
+
+    std::vector<juce::MidiMessage> messages;
+    for (const auto& message : state) {
+        if (message.has_value()) messages.push_back(*message);
+    }
+
+    return messages;
+}
+
+//==============================================================================
+// Engine and Output Setup
+//==============================================================================
+
+VitalAudioEngine::Config OfflineRenderer::makeEngineConfig(const Settings& settings, int numWorkerThreads)
+{
+    VitalAudioEngine::Config config;
+    config.sampleRate = settings.sampleRate;
+    config.bufferSize = settings.blockSize;
+    config.maxChannels = settings.numChannels;
+    config.maxVoices = settings.maxVoices;
+
+    // Voice groups are summed in a fixed order, so worker count does not change the output
+    config.enableMultithreading = numWorkerThreads > 0;
+    config.maxWorkerThreads = numWorkerThreads;
+    config.pinWorkerThreads = false;
+
+    // Quality must not depend on how fast this machine renders
+    config.enableDynamicOptimization = false;
+
+    return config;
+}
+
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderer::createWriter(const Settings& settings, juce::String& error)
+{
+    std::unique_ptr<juce::AudioFormat> format;
+    int bitDepth = settings.bitDepth;
+
+    if (settings.outputFile.hasFileExtension(".flac")) {
+        format = std::make_unique<juce::FlacAudioFormat>();
+        bitDepth = bitDepth <= 16 ? 16 : 24;
+    } else if (settings.outputFile.hasFileExtension(".wav")) {
+        format = std::make_unique<juce::WavAudioFormat>();
+        bitDepth = bitDepth <= 16 ? 16 : (bitDepth <= 24 ? 24 : 32);
+    } else {
+        error = "Unsupported output format (expected .wav or .flac): " + settings.outputFile.getFullPathName();
+        return nullptr;
+    }
+
+    settings.outputFile.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream = settings.outputFile.createOutputStream();
+
+    if (stream == nullptr) {
+        error = "Cannot open output file: " + settings.outputFile.getFullPathName();
+        return nullptr;
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                            settings.sampleRate,
+                                                                            static_cast<unsigned int>(settings.numChannels),
+                                                                            bitDepth, {}, 0));
+    if (writer == nullptr) {
+        error = "Cannot create " + format->getFormatName() + " writer";
+        return nullptr;
+    }
+
+    // The writer owns the stream from here on
+    stream.release();
+    return writer;
+}
+
+} // namespace audio_engine
+} // namespace vital
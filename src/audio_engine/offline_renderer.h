@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    offline_renderer.h
+    Copyright (c) 2025 Vital Audio Engine Team
+    https://vital.audio
+
+    Deterministic offline (faster than real-time) rendering of a preset and
+    a MIDI file to WAV/FLAC, without audio devices or a real-time clock
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <vector>
+#include <memory>
+
+#include "vital_audio_engine.h"
+
+namespace vital {
+namespace audio_engine {
+
+//==============================================================================
+/**
+ * @class OfflineRenderer
+ * @brief Renders MIDI through a VitalAudioEngine as fast as the CPU allows
+ *
+ * The engine is driven block by block from the MIDI file's own timeline.
+ * Event positions are derived from the file only, dynamic CPU-based quality
+ * changes are disabled, and voice-parallel rendering sums voice groups in a
+ * fixed order, so repeated renders with the same settings are bit-identical.
+ *
+ * Work can be spread over several cores in two ways:
+ * - ByVoice: one engine, voice groups rendered on worker threads
+ * - ByTimeSegment: independent engines render disjoint time ranges. Cuts
+ *   are only placed in gaps where no note or sustain pedal is held for at
+ *   least tailSeconds, and controller/program state is replayed at the
+ *   start of each segment. Segment boundaries depend on segmentSeconds,
+ *   not on the thread count.
+ */
+class OfflineRenderer
+{
+public:
+    //==============================================================================
+    enum class SplitMode {
+        None,
+        ByVoice,
+        ByTimeSegment
+    };
+
+    /** Render job description */
+    struct Settings
+    {
+        juce::File presetFile;          // Optional; engine defaults when empty
+        juce::File midiFile;
+        juce::File outputFile;          // .wav or .flac
+
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+        int numChannels = 2;
+        int maxVoices = 32;
+        int bitDepth = 24;
+        double tailSeconds = 2.0;       // Rendered after the last MIDI event
+
+        SplitMode splitMode = SplitMode::None;
+        int numThreads = 1;             // Including the calling thread
+        double segmentSeconds = 10.0;   // Minimum segment length for ByTimeSegment
+    };
+
+    /** Render outcome */
+    struct Result
+    {
+        bool success = false;
+        juce::String errorMessage;
+        juce::int64 numSamples = 0;
+        int numSegments = 0;
+        double renderSeconds = 0.0;
+        double realtimeFactor = 0.0;    // Audio duration / render time
+    };
+
+    //==============================================================================
+    /** Render one job */
+    static Result render(const Settings& settings);
+
+    /** Render independent jobs concurrently, one job per thread at a time */
+    static std::vector<Result> renderBatch(const std::vector<Settings>& jobs, int numThreads);
+
+private:
+    //==============================================================================
+    struct TimedMessage
+    {
+        juce::int64 sample = 0;
+        juce::MidiMessage message;
+    };
+
+    struct Segment
+    {
+        juce::int64 startSample = 0;
+        juce::int64 endSample = 0;
+    };
+
+    //==============================================================================
+    static bool readMidiFile(const juce::File& file, double sampleRate,
+                             std::vector<TimedMessage>& events, juce::String& error);
+
+    static std::vector<Segment> findSegments(const std::vector<TimedMessage>& events,
+                                             juce::int64 totalSamples,
+                                             juce::int64 gapSamples,
+                                             juce::int64 minSegmentSamples);
+
+    static std::vector<juce::MidiMessage> collectStateBefore(const std::vector<TimedMessage>& events,
+                                                             juce::int64 sample);
+
+    static VitalAudioEngine::Config makeEngineConfig(const Settings& settings, int numWorkerThreads);
+
+    /** Render [segment.startSample, segment.endSample) from a freshly initialised engine */
+    template <typename BlockSink>
+    static bool renderSegment(const Settings& settings,
+                              const std::vector<TimedMessage>& events,
+                              const Segment& segment,
+                              int numWorkerThreads,
+                              BlockSink&& sink,
+                              juce::String& error);
+
+    static std::unique_ptr<juce::AudioFormatWriter> createWriter(const Settings& settings, juce::String& error);
+
+    OfflineRenderer() = delete;
+};
+
+} // namespace audio_engine
+} // namespace vital
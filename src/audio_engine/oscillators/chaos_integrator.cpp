@@ -0,0 +1,348 @@
+/*
+  ==============================================================================
+    chaos_integrator.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the lane-parallel chaos integrator
+  ==============================================================================
+*/
+
+#include "chaos_integrator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+namespace {
+
+constexpr int kLanes = ChaosIntegrator::kLaneWidth;
+
+/** Beyond this the trajectory has left the attractor for good */
+constexpr float kDivergenceLimit = 1.0e4f;
+
+/** 441 time units per second matches the original dt of 0.01 per sample at 44.1 kHz */
+constexpr float kDefaultSpeed = 441.0f;
+
+struct LaneState
+{
+    alignas(32) float x[kLanes];
+    alignas(32) float y[kLanes];
+    alignas(32) float z[kLanes];
+};
+
+template <ChaosIntegrator::System S>
+inline void derivative(const LaneState& s, LaneState& d, const ChaosIntegrator::Coefficients& c) noexcept
+{
+    for (int lane = 0; lane < kLanes; ++lane) {
+        if constexpr (S == ChaosIntegrator::System::Lorenz) {
+            // dx/dt = sigma(y-x), dy/dt = x(rho-z)-y, dz/dt = xy-beta*z
+            d.x[lane] = c.p1 * (s.y[lane] - s.x[lane]);
+            d.y[lane] = s.x[lane] * (c.p2 - s.z[lane]) - s.y[lane];
+            d.z[lane] = s.x[lane] * s.y[lane] - c.p3 * s.z[lane];
+        }
+        else {
+            // dx/dt = -(y+z), dy/dt = x + a*y, dz/dt = b + z*(x-c)
+            d.x[lane] = -(s.y[lane] + s.z[lane]);
+            d.y[lane] = s.x[lane] + c.p1 * s.y[lane];
+            d.z[lane] = c.p2 + s.z[lane] * (s.x[lane] - c.p3);
+        }
+    }
+}
+
+/** out = s + h * d, per lane */
+inline void axpy(const LaneState& s, const LaneState& d, const float* h, LaneState& out) noexcept
+{
+    for (int lane = 0; lane < kLanes; ++lane) {
+        out.x[lane] = s.x[lane] + h[lane] * d.x[lane];
+        out.y[lane] = s.y[lane] + h[lane] * d.y[lane];
+        out.z[lane] = s.z[lane] + h[lane] * d.z[lane];
+    }
+}
+
+template <ChaosIntegrator::System S, ChaosIntegrator::Method M>
+inline void step(LaneState& s, const float* dt, const float* halfDt, const float* sixthDt,
+                 const ChaosIntegrator::Coefficients& c) noexcept
+{
+    using Method = ChaosIntegrator::Method;
+
+    LaneState k1, k2;
+    derivative<S>(s, k1, c);
+
+    if constexpr (M == Method::Euler) {
+        axpy(s, k1, dt, s);
+    }
+    else if constexpr (M == Method::RK2) {
+        // Midpoint: slope at the half step
+        LaneState mid;
+        axpy(s, k1, halfDt, mid);
+        derivative<S>(mid, k2, c);
+        axpy(s, k2, dt, s);
+    }
+    else {
+        LaneState k3, k4, probe;
+        axpy(s, k1, halfDt, probe);
+        derivative<S>(probe, k2, c);
+        axpy(s, k2, halfDt, probe);
+        derivative<S>(probe, k3, c);
+        axpy(s, k3, dt, probe);
+        derivative<S>(probe, k4, c);
+
+        for (int lane = 0; lane < kLanes; ++lane) {
+            s.x[lane] += sixthDt[lane] * (k1.x[lane] + 2.0f * (k2.x[lane] + k3.x[lane]) + k4.x[lane]);
+            s.y[lane] += sixthDt[lane] * (k1.y[lane] + 2.0f * (k2.y[lane] + k3.y[lane]) + k4.y[lane]);
+            s.z[lane] += sixthDt[lane] * (k1.z[lane] + 2.0f * (k2.z[lane] + k3.z[lane]) + k4.z[lane]);
+        }
+    }
+}
+
+template <ChaosIntegrator::System S>
+inline const float* observable(const LaneState& s) noexcept
+{
+    return S == ChaosIntegrator::System::Lorenz ? s.y : s.x;
+}
+
+int factorIndex(int factor) noexcept
+{
+    return factor >= 8 ? 3 : factor >= 4 ? 2 : factor >= 2 ? 1 : 0;
+}
+
+/** Blackman-windowed sinc lowpass at 0.45 of the output Nyquist, unity DC gain */
+std::vector<float> designTaps(int factor)
+{
+    const int numTaps = 8 * factor;
+    const double cutoff = 0.45 / factor;    // Cycles per oversampled sample
+    const double centre = 0.5 * (numTaps - 1);
+    const double pi = juce::MathConstants<double>::pi;
+
+    std::vector<float> taps(static_cast<size_t>(numTaps));
+    double sum = 0.0;
+
+    for (int i = 0; i < numTaps; ++i) {
+        const double t = i - centre;
+        const double sinc = 2.0 * cutoff * (t == 0.0 ? 1.0 : std::sin(2.0 * pi * cutoff * t) / (2.0 * pi * cutoff * t));
+        const double phase = 2.0 * pi * i / (numTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        taps[static_cast<size_t>(i)] = static_cast<float>(sinc * window);
+        sum += sinc * window;
+    }
+
+    for (auto& tap : taps)
+        tap = static_cast<float>(tap / sum);
+
+    return taps;
+}
+
+std::array<float, 3> initialState(ChaosIntegrator::System system) noexcept
+{
+    return system == ChaosIntegrator::System::Lorenz ? std::array<float, 3>{ 0.1f, 0.0f, 0.0f }
+                                                     : std::array<float, 3>{ 0.1f, 0.1f, 0.1f };
+}
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void ChaosIntegrator::prepare(const Config& config)
+{
+    jassert(config.maxVoices > 0 && config.maxBlockSize > 0 && config.sampleRate > 0.0);
+
+    config_ = config;
+    coefficients_ = defaultCoefficients(config.system);
+    numGroups_ = (config.maxVoices + kLaneWidth - 1) / kLaneWidth;
+
+    const size_t paddedVoices = static_cast<size_t>(numGroups_) * kLaneWidth;
+    groups_.assign(static_cast<size_t>(numGroups_), LaneGroup{});
+    speeds_.assign(paddedVoices, kDefaultSpeed);
+    outputs_.assign(paddedVoices * static_cast<size_t>(config.maxBlockSize), 0.0f);
+
+    for (int i = 1; i < 4; ++i)
+        taps_[static_cast<size_t>(i)] = designTaps(1 << i);
+
+    history_.assign(static_cast<size_t>(numGroups_) * 2 * kMaxTaps * kLaneWidth, 0.0f);
+    historyPosition_.assign(static_cast<size_t>(numGroups_), 0);
+
+    setOversampling(config.oversampling);
+    reset();
+}
+
+void ChaosIntegrator::setOversampling(int factor) noexcept
+{
+    const int clamped = 1 << factorIndex(factor);
+    if (clamped != config_.oversampling) {
+        config_.oversampling = clamped;
+        clearHistory();
+    }
+}
+
+void ChaosIntegrator::setSampleRate(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0);
+    config_.sampleRate = sampleRate;
+}
+
+void ChaosIntegrator::setSpeed(int voice, float timeUnitsPerSecond) noexcept
+{
+    jassert(voice >= 0 && voice < static_cast<int>(speeds_.size()));
+    speeds_[static_cast<size_t>(voice)] = std::max(0.0f, timeUnitsPerSecond);
+}
+
+void ChaosIntegrator::resetVoice(int voice) noexcept
+{
+    jassert(voice >= 0 && voice < numGroups_ * kLaneWidth);
+
+    const auto start = initialState(config_.system);
+    auto& group = groups_[static_cast<size_t>(voice / kLaneWidth)];
+    const int lane = voice % kLaneWidth;
+
+    group.x[static_cast<size_t>(lane)] = start[0];
+    group.y[static_cast<size_t>(lane)] = start[1];
+    group.z[static_cast<size_t>(lane)] = start[2];
+}
+
+void ChaosIntegrator::reset() noexcept
+{
+    for (int voice = 0; voice < numGroups_ * kLaneWidth; ++voice)
+        resetVoice(voice);
+
+    clearHistory();
+    numDivergences_ = 0;
+}
+
+void ChaosIntegrator::clearHistory() noexcept
+{
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    std::fill(historyPosition_.begin(), historyPosition_.end(), 0);
+}
+
+std::array<float, 3> ChaosIntegrator::getState(int voice) const noexcept
+{
+    const auto& group = groups_[static_cast<size_t>(voice / kLaneWidth)];
+    const size_t lane = static_cast<size_t>(voice % kLaneWidth);
+    return { group.x[lane], group.y[lane], group.z[lane] };
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+void ChaosIntegrator::process(int numVoices, int numSamples) noexcept
+{
+    jassert(numSamples <= config_.maxBlockSize);
+    const int groupsToProcess = std::min(numGroups_, (numVoices + kLaneWidth - 1) / kLaneWidth);
+
+    for (int group = 0; group < groupsToProcess; ++group) {
+        if (config_.system == System::Lorenz) {
+            switch (config_.method) {
+                case Method::Euler: processGroup<System::Lorenz, Method::Euler>(group, numSamples); break;
+                case Method::RK2:   processGroup<System::Lorenz, Method::RK2>(group, numSamples); break;
+                case Method::RK4:   processGroup<System::Lorenz, Method::RK4>(group, numSamples); break;
+            }
+        }
+        else {
+            switch (config_.method) {
+                case Method::Euler: processGroup<System::Rossler, Method::Euler>(group, numSamples); break;
+                case Method::RK2:   processGroup<System::Rossler, Method::RK2>(group, numSamples); break;
+                case Method::RK4:   processGroup<System::Rossler, Method::RK4>(group, numSamples); break;
+            }
+        }
+    }
+}
+
+template <ChaosIntegrator::System S, ChaosIntegrator::Method M>
+void ChaosIntegrator::processGroup(int groupIndex, int numSamples) noexcept
+{
+    LaneGroup& group = groups_[static_cast<size_t>(groupIndex)];
+    const Coefficients coefficients = coefficients_;
+    const int factor = config_.oversampling;
+
+    // Sub-step sizes per lane
+    alignas(32) float dt[kLanes], halfDt[kLanes], sixthDt[kLanes];
+    const float stepScale = 1.0f / static_cast<float>(config_.sampleRate * factor);
+    for (int lane = 0; lane < kLanes; ++lane) {
+        dt[lane] = speeds_[static_cast<size_t>(groupIndex * kLanes + lane)] * stepScale;
+        halfDt[lane] = 0.5f * dt[lane];
+        sixthDt[lane] = dt[lane] * (1.0f / 6.0f);
+    }
+
+    LaneState state;
+    std::copy(group.x.begin(), group.x.end(), state.x);
+    std::copy(group.y.begin(), group.y.end(), state.y);
+    std::copy(group.z.begin(), group.z.end(), state.z);
+
+    float* outputs = outputs_.data() + static_cast<size_t>(groupIndex) * kLanes * static_cast<size_t>(config_.maxBlockSize);
+    const size_t outputStride = static_cast<size_t>(config_.maxBlockSize);
+
+    if (factor == 1) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            step<S, M>(state, dt, halfDt, sixthDt, coefficients);
+
+            const float* value = observable<S>(state);
+            for (int lane = 0; lane < kLanes; ++lane)
+                outputs[static_cast<size_t>(lane) * outputStride + static_cast<size_t>(sample)] = value[lane];
+        }
+    }
+    else {
+        const std::vector<float>& taps = taps_[static_cast<size_t>(factorIndex(factor))];
+        const int numTaps = static_cast<int>(taps.size());
+        float* history = groupHistory(groupIndex);
+        int position = historyPosition_[static_cast<size_t>(groupIndex)];
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            for (int sub = 0; sub < factor; ++sub) {
+                step<S, M>(state, dt, halfDt, sixthDt, coefficients);
+
+                // Doubled history so the newest numTaps values are always contiguous
+                const float* value = observable<S>(state);
+                float* first = history + static_cast<size_t>(position) * kLanes;
+                float* second = history + static_cast<size_t>(position + numTaps) * kLanes;
+                for (int lane = 0; lane < kLanes; ++lane) {
+                    first[lane] = value[lane];
+                    second[lane] = value[lane];
+                }
+                position = position + 1 == numTaps ? 0 : position + 1;
+            }
+
+            // Only the kept output phase of the FIR is evaluated
+            alignas(32) float sum[kLanes] = {};
+            const float* window = history + static_cast<size_t>(position) * kLanes;
+            for (int tap = 0; tap < numTaps; ++tap) {
+                const float coefficient = taps[static_cast<size_t>(tap)];
+                for (int lane = 0; lane < kLanes; ++lane)
+                    sum[lane] += coefficient * window[tap * kLanes + lane];
+            }
+
+            for (int lane = 0; lane < kLanes; ++lane)
+                outputs[static_cast<size_t>(lane) * outputStride + static_cast<size_t>(sample)] = sum[lane];
+        }
+
+        historyPosition_[static_cast<size_t>(groupIndex)] = position;
+    }
+
+    std::copy(state.x, state.x + kLanes, group.x.begin());
+    std::copy(state.y, state.y + kLanes, group.y.begin());
+    std::copy(state.z, state.z + kLanes, group.z.begin());
+
+    restartDivergedLanes(group, groupIndex);
+}
+
+void ChaosIntegrator::restartDivergedLanes(LaneGroup& group, int groupIndex) noexcept
+{
+    for (int lane = 0; lane < kLaneWidth; ++lane) {
+        const size_t i = static_cast<size_t>(lane);
+        const float magnitude = std::abs(group.x[i]) + std::abs(group.y[i]) + std::abs(group.z[i]);
+
+        // Also catches NaN, which fails every comparison
+        if (!(magnitude < kDivergenceLimit)) {
+            resetVoice(groupIndex * kLaneWidth + lane);
+            ++numDivergences_;
+        }
+    }
+}
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
@@ -16,6 +16,11 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
+#include "wavetable.h"
+#include "unison.h"
+#include "chaos_integrator.h"
+#include "noise_field.h"
+#include "../utility/fast_random.h"
 #include <cmath>
 #include <memory>
 #include <string_view>
@@ -26,6 +31,8 @@
 #include <complex>
 #include <chrono>
 #include <thread>
+#include <variant>
+#include <type_traits>
 
 namespace vital {
 namespace audio_engine {
@@ -94,7 +101,7 @@ protected:
     
     /** Standard waveforms for derived classes */
     [[nodiscard]] float generateSine(float phase) const {
-        return std::sin(phase * 2.0f * juce::MathConstants<float>::pi);
+        return Wavetable::fastSin(phase);
     }
     
     [[nodiscard]] float generateSquare(float phase) const {
@@ -109,6 +116,29 @@ protected:
         return 4.0f * std::abs(phase - 0.5f) - 1.0f;
     }
     
+    /** Rational tanh, within 1e-4 of std::tanh and branch-free so block loops vectorise */
+    [[nodiscard]] static float fastTanh(float x) {
+        x = juce::jlimit(-4.97f, 4.97f, x);
+        const float x2 = x * x;
+        const float numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return numerator / denominator;
+    }
+    
+    /** Block helpers: output = tanh(output * drive) * amplitude, and the phase advanced over a block */
+    void shapeBlock(float* output, int numSamples, float drive) {
+        const float gain = amplitude_;
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = fastTanh(output[i] * drive) * gain;
+        }
+        if (numSamples > 0) lastOutput_ = output[numSamples - 1];
+    }
+    
+    void advancePhaseBlock(int numSamples) {
+        phase_ += calculatePhaseIncrement(frequency_) * static_cast<float>(numSamples);
+        phase_ -= std::floor(phase_);
+    }
+    
     std::string name_;
     float frequency_;
     float amplitude_;
@@ -120,6 +150,39 @@ protected:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oscillator)
 };
 
+//==============================================================================
+/**
+ * @class BlockOscillator
+ * @brief CRTP base routing every entry point to the derived block kernel
+ *
+ * Derived classes implement a non-virtual renderBlock(output, numSamples)
+ * that keeps their state in locals for the whole block. process(),
+ * processStereo() and generateSample() forward to it, so a block costs at
+ * most one virtual call, and none through OscillatorHandle.
+ */
+template <typename Derived>
+class BlockOscillator : public Oscillator
+{
+public:
+    using Oscillator::Oscillator;
+    
+    void process(float* output, int numSamples) override {
+        static_cast<Derived*>(this)->renderBlock(output, numSamples);
+    }
+    
+    void processStereo(float* left, float* right, int numSamples) override {
+        static_cast<Derived*>(this)->renderBlock(left, numSamples);
+        std::copy(left, left + numSamples, right);
+    }
+    
+protected:
+    [[nodiscard]] float generateSample() override {
+        float sample = 0.0f;
+        static_cast<Derived*>(this)->renderBlock(&sample, 1);
+        return sample;
+    }
+};
+
 //==============================================================================
 /**
  * @enum NewOscillatorType
@@ -149,7 +212,10 @@ enum class NewOscillatorType : int {
     // Adaptive oscillators
     AdaptiveFM = 5000,
     Evolutionary = 5001,
-    SelfModulating = 5002
+    SelfModulating = 5002,
+    
+    // Table-based oscillators
+    Wavetable = 6000
 };
 
 //==============================================================================
@@ -161,59 +227,55 @@ enum class NewOscillatorType : int {
  * @brief Oscillator based on the Lorenz attractor equations
  * Creates chaotic, organic sounds reminiscent of weather systems
  */
-class LorenzOscillator : public Oscillator
+class LorenzOscillator final : public BlockOscillator<LorenzOscillator>
 {
 public:
     explicit LorenzOscillator(std::string_view name) 
-        : Oscillator(name)
-        , x_(0.1f), y_(0.0f), z_(0.0f)
-        , sigma_(10.0f), rho_(28.0f), beta_(8.0f/3.0f)
-        , dt_(0.01f) {}
+        : BlockOscillator(name)
+        , dt_(0.01f) {
+        integrator_.prepare({ ChaosIntegrator::System::Lorenz, ChaosIntegrator::Method::RK2, 1, 1,
+                              kMaxChunk, sampleRate_ });
+        integrator_.setSpeed(0, dt_ * kReferenceSampleRate);
+    }
     
     void reset() override {
-        x_ = 0.1f; y_ = 0.0f; z_ = 0.0f;
+        integrator_.reset();
         resetPhase();
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = generateNextSample();
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = generateNextSample();
-            left[i] = sample;
-            right[i] = sample;
-        }
+    /** dt is the integration step per sample at 44.1 kHz; other rates keep the same speed */
+    void setParameters(float sigma, float rho, float beta, float dt) {
+        integrator_.setCoefficients({ sigma, rho, beta });
+        dt_ = dt;
+        integrator_.setSpeed(0, dt_ * kReferenceSampleRate);
     }
     
-    void setParameters(float sigma, float rho, float beta, float dt) {
-        sigma_ = sigma; rho_ = rho; beta_ = beta; dt_ = dt;
+    /** Integration method and oversampling (1, 2, 4 or 8); RK2 at 1x by default */
+    void setIntegration(ChaosIntegrator::Method method, int oversampling) {
+        integrator_.setMethod(method);
+        integrator_.setOversampling(oversampling);
     }
     
-private:
-    [[nodiscard]] float generateNextSample() {
-        // Lorenz equations: dx/dt = sigma(y-x), dy/dt = x(rho-z)-y, dz/dt = xy-beta*z
-        auto dx = sigma_ * (y_ - x_);
-        auto dy = x_ * (rho_ - z_) - y_;
-        auto dz = x_ * y_ - beta_ * z_;
+    /** Block kernel: integrate a chunk at a time, then shape the whole block */
+    void renderBlock(float* output, int numSamples) noexcept {
+        integrator_.setSampleRate(sampleRate_);
         
-        x_ += dx * dt_;
-        y_ += dy * dt_;
-        z_ += dz * dt_;
+        for (int start = 0; start < numSamples; start += kMaxChunk) {
+            const int count = std::min(kMaxChunk, numSamples - start);
+            integrator_.process(1, count);
+            std::copy(integrator_.getOutput(0), integrator_.getOutput(0) + count, output + start);
+        }
         
         // Normalize output to [-1, 1] range
-        lastOutput_ = std::tanh(y_ * 0.1f) * amplitude_;
-        advancePhase(calculatePhaseIncrement(frequency_));
-        return lastOutput_;
+        shapeBlock(output, numSamples, 0.1f);
+        advancePhaseBlock(numSamples);
     }
     
-    [[nodiscard]] float generateSample() override { return generateNextSample(); }
+private:
+    static constexpr int kMaxChunk = 256;
+    static constexpr float kReferenceSampleRate = 44100.0f;
     
-    float x_, y_, z_;
-    float sigma_, rho_, beta_;
+    ChaosIntegrator integrator_;
     float dt_;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LorenzOscillator)
@@ -224,59 +286,55 @@ private:
  * @brief Oscillator based on the Rossler attractor equations
  * Generates chaotic patterns with distinctive harmonic content
  */
-class RosslerOscillator : public Oscillator
+class RosslerOscillator final : public BlockOscillator<RosslerOscillator>
 {
 public:
     explicit RosslerOscillator(std::string_view name) 
-        : Oscillator(name)
-        , x_(0.1f), y_(0.1f), z_(0.1f)
-        , a_(0.2f), b_(0.2f), c_(5.7f)
-        , dt_(0.01f) {}
+        : BlockOscillator(name)
+        , dt_(0.01f) {
+        integrator_.prepare({ ChaosIntegrator::System::Rossler, ChaosIntegrator::Method::RK2, 1, 1,
+                              kMaxChunk, sampleRate_ });
+        integrator_.setSpeed(0, dt_ * kReferenceSampleRate);
+    }
     
     void reset() override {
-        x_ = 0.1f; y_ = 0.1f; z_ = 0.1f;
+        integrator_.reset();
         resetPhase();
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = generateNextSample();
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = generateNextSample();
-            left[i] = sample;
-            right[i] = sample;
-        }
+    /** dt is the integration step per sample at 44.1 kHz; other rates keep the same speed */
+    void setParameters(float a, float b, float c, float dt) {
+        integrator_.setCoefficients({ a, b, c });
+        dt_ = dt;
+        integrator_.setSpeed(0, dt_ * kReferenceSampleRate);
     }
     
-    void setParameters(float a, float b, float c, float dt) {
-        a_ = a; b_ = b; c_ = c; dt_ = dt;
+    /** Integration method and oversampling (1, 2, 4 or 8); RK2 at 1x by default */
+    void setIntegration(ChaosIntegrator::Method method, int oversampling) {
+        integrator_.setMethod(method);
+        integrator_.setOversampling(oversampling);
     }
     
-private:
-    [[nodiscard]] float generateNextSample() {
-        // Rossler equations: dx/dt = -(y+z), dy/dt = x + a*y, dz/dt = b + z*(x-c)
-        auto dx = -(y_ + z_);
-        auto dy = x_ + a_ * y_;
-        auto dz = b_ + z_ * (x_ - c_);
+    /** Block kernel: integrate a chunk at a time, then shape the whole block */
+    void renderBlock(float* output, int numSamples) noexcept {
+        integrator_.setSampleRate(sampleRate_);
         
-        x_ += dx * dt_;
-        y_ += dy * dt_;
-        z_ += dz * dt_;
+        for (int start = 0; start < numSamples; start += kMaxChunk) {
+            const int count = std::min(kMaxChunk, numSamples - start);
+            integrator_.process(1, count);
+            std::copy(integrator_.getOutput(0), integrator_.getOutput(0) + count, output + start);
+        }
         
         // Use x component with normalization
-        lastOutput_ = std::tanh(x_ * 0.05f) * amplitude_;
-        advancePhase(calculatePhaseIncrement(frequency_));
-        return lastOutput_;
+        shapeBlock(output, numSamples, 0.05f);
+        advancePhaseBlock(numSamples);
     }
     
-    [[nodiscard]] float generateSample() override { return generateNextSample(); }
+private:
+    static constexpr int kMaxChunk = 256;
+    static constexpr float kReferenceSampleRate = 44100.0f;
     
-    float x_, y_, z_;
-    float a_, b_, c_;
+    ChaosIntegrator integrator_;
     float dt_;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RosslerOscillator)
@@ -287,11 +345,11 @@ private:
  * @brief Discrete chaotic map oscillator
  * Creates discrete-time chaotic patterns
  */
-class HenonOscillator : public Oscillator
+class HenonOscillator final : public BlockOscillator<HenonOscillator>
 {
 public:
     explicit HenonOscillator(std::string_view name) 
-        : Oscillator(name)
+        : BlockOscillator(name)
         , x_(0.1f), y_(0.3f)
         , a_(1.4f), b_(0.3f) {}
     
@@ -300,41 +358,31 @@ public:
         resetPhase();
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = generateNextSample();
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = generateNextSample();
-            left[i] = sample;
-            right[i] = sample;
-        }
-    }
-    
     void setParameters(float a, float b) {
         a_ = a; b_ = b;
     }
     
-private:
-    [[nodiscard]] float generateNextSample() {
+    /** Block kernel: iterate the map with the state in registers, then shape the whole block */
+    void renderBlock(float* output, int numSamples) noexcept {
+        float x = x_, y = y_;
+        const float a = a_, b = b_;
+        
         // Henon map: x(n+1) = 1 - a*x(n)^2 + y(n), y(n+1) = b*x(n)
-        auto new_x = 1.0f - a_ * x_ * x_ + y_;
-        auto new_y = b_ * x_;
+        for (int i = 0; i < numSamples; ++i) {
+            const float newX = 1.0f - a * x * x + y;
+            y = b * x;
+            x = newX;
+            output[i] = x;
+        }
         
-        x_ = new_x;
-        y_ = new_y;
+        x_ = x; y_ = y;
         
         // Normalize output
-        lastOutput_ = std::tanh(x_ * 0.3f) * amplitude_;
-        advancePhase(calculatePhaseIncrement(frequency_));
-        return lastOutput_;
+        shapeBlock(output, numSamples, 0.3f);
+        advancePhaseBlock(numSamples);
     }
     
-    [[nodiscard]] float generateSample() override { return generateNextSample(); }
-    
+private:
     float x_, y_;
     float a_, b_;
     
@@ -347,121 +395,103 @@ private:
 
 /**
  * @class PerlinNoiseOscillator
- * @brief Gradient noise generator using Perlin noise algorithm
+ * @brief Gradient noise generator using Perlin or simplex noise
  * Provides smooth, natural-sounding noise textures
  */
-class PerlinNoiseOscillator : public Oscillator
+class PerlinNoiseOscillator final : public BlockOscillator<PerlinNoiseOscillator>
 {
 public:
+    enum class NoiseType { Perlin, Simplex };
+    
     explicit PerlinNoiseOscillator(std::string_view name) 
-        : Oscillator(name)
-        , frequency_(1.0f)
-        , seed_(12345) {
-        initializePermutation();
+        : BlockOscillator(name)
+        , field_(NoiseField::get(12345)) {
+        frequency_ = 1.0f;
         reset();
     }
     
     void reset() override {
         resetPhase();
+        evolutionPosition_ = 0.0f;
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            auto x = phase_ * frequency_;
-            output[i] = perlinNoise(x, 0.0f, 0.0f) * amplitude_;
-            advancePhase(calculatePhaseIncrement(frequency_));
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            auto x = phase_ * frequency_;
-            float sample = perlinNoise(x, 0.0f, 0.0f) * amplitude_;
-            left[i] = sample;
-            right[i] = sample;
-            advancePhase(calculatePhaseIncrement(frequency_));
-        }
-    }
-    
-    void setFrequency(float freq) override { frequency_ = std::max(0.001f, freq); }
+    /** Tables are shared per seed; building a new seed's tables is not real-time safe */
     void setSeed(int seed) { 
-        seed_ = seed; 
-        initializePermutation(); 
-    }
-    
-private:
-    static constexpr int PERM_SIZE = 256;
-    std::array<int, PERM_SIZE> perm_;
-    float frequency_;
-    int seed_;
-    
-    void initializePermutation() {
-        std::mt19937 gen(seed_);
-        std::uniform_int_distribution<> dis(0, 255);
+        if (seed != field_->getSeed()) field_ = NoiseField::get(seed);
+    }
+    
+    void setNoiseType(NoiseType type) { noiseType_ = type; }
+    
+    /** Drift through the field's y axis, in lattice units per second; 0 keeps the waveform static */
+    void setEvolution(float unitsPerSecond) { evolution_ = std::max(0.0f, unitsPerSecond); }
+    
+    /**
+     * Block kernel. A static Perlin waveform samples the y = z = 0 line of
+     * the field, which reduces to one gradient lookup per lattice cell.
+     * Simplex noise, or any evolving waveform, runs the full 3D kernel
+     * NoiseField::kBatch samples at a time.
+     */
+    void renderBlock(float* output, int numSamples) noexcept {
+        const NoiseField& field = *field_;
+        const float scale = frequency_;
+        const float increment = calculatePhaseIncrement(frequency_);
+        const float gain = amplitude_;
+        float phase = phase_;
         
-        for (int i = 0; i < PERM_SIZE; ++i) {
-            perm_[i] = i;
+        if (noiseType_ == NoiseType::Perlin && evolution_ == 0.0f) {
+            for (int i = 0; i < numSamples; ++i) {
+                output[i] = field.perlinLine(phase * scale) * gain;
+                
+                phase += increment;
+                if (phase >= 1.0f) phase -= 1.0f;
+            }
         }
-        
-        // Fisher-Yates shuffle
-        for (int i = PERM_SIZE - 1; i > 0; --i) {
-            std::uniform_int_distribution<> dis_swap(0, i);
-            int j = dis_swap(gen);
-            std::swap(perm_[i], perm_[j]);
+        else {
+            constexpr int batch = NoiseField::kBatch;
+            const float drift = evolution_ / sampleRate_;
+            float position = evolutionPosition_;
+            alignas(32) float xs[batch], ys[batch], zs[batch] = {}, values[batch];
+            
+            for (int start = 0; start < numSamples; start += batch) {
+                const int count = std::min(batch, numSamples - start);
+                
+                for (int i = 0; i < batch; ++i) {
+                    xs[i] = phase * scale;
+                    ys[i] = position;
+                    if (i < count) {
+                        phase += increment;
+                        if (phase >= 1.0f) phase -= 1.0f;
+                        position += drift;
+                    }
+                }
+                
+                if (noiseType_ == NoiseType::Perlin)
+                    field.perlin(xs, ys, zs, values);
+                else
+                    field.simplex(xs, ys, zs, values);
+                
+                for (int i = 0; i < count; ++i)
+                    output[start + i] = values[i] * gain;
+            }
+            
+            // The Perlin lattice repeats every 256 cells; wrapping keeps float precision
+            evolutionPosition_ = position >= 256.0f ? position - 256.0f : position;
         }
         
-        // Duplicate the permutation
-        for (int i = 0; i < PERM_SIZE; ++i) {
-            perm_[i + PERM_SIZE] = perm_[i];
-        }
-    }
-    
-    [[nodiscard]] float fade(float t) const {
-        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+        phase_ = phase;
+        if (numSamples > 0) lastOutput_ = output[numSamples - 1];
     }
     
-    [[nodiscard]] float lerp(float a, float b, float t) const {
-        return a + t * (b - a);
-    }
-    
-    [[nodiscard]] float grad(int hash, float x, float y, float z) const {
-        int h = hash & 15;
-        float u = h < 8 ? x : y;
-        float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
-        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-    }
-    
-    [[nodiscard]] float perlinNoise(float x, float y, float z) const {
-        auto X = static_cast<int>(std::floor(x)) & 255;
-        auto Y = static_cast<int>(std::floor(y)) & 255;
-        auto Z = static_cast<int>(std::floor(z)) & 255;
-        
-        x -= std::floor(x);
-        y -= std::floor(y);
-        z -= std::floor(z);
-        
-        auto u = fade(x);
-        auto v = fade(y);
-        auto w = fade(z);
-        
-        auto A = perm_[X] + Y;
-        auto AA = perm_[A] + Z;
-        auto AB = perm_[A + 1] + Z;
-        auto B = perm_[X + 1] + Y;
-        auto BA = perm_[B] + Z;
-        auto BB = perm_[B + 1] + Z;
-        
-        return lerp(w, lerp(v, lerp(u, grad(perm_[AA], x, y, z),
-                                             grad(perm_[BA], x-1.0f, y, z)),
-                                       lerp(u, grad(perm_[AB], x, y-1.0f, z),
-                                             grad(perm_[BB], x-1.0f, y-1.0f, z))),
-                           lerp(v, lerp(u, grad(perm_[AA+1], x, y, z-1.0f),
-                                             grad(perm_[BA+1], x-1.0f, y, z-1.0f)),
-                                       lerp(u, grad(perm_[AB+1], x, y-1.0f, z-1.0f),
-                                             grad(perm_[BB+1], x-1.0f, y-1.0f, z-1.0f))));
+    /** Full 3D noise field, in [-1, 1] */
+    [[nodiscard]] float noise(float x, float y, float z) const {
+        return noiseType_ == NoiseType::Perlin ? field_->perlin(x, y, z) : field_->simplex(x, y, z);
     }
     
-    [[nodiscard]] float generateSample() override { return 0.0f; } // Not used for noise
+private:
+    std::shared_ptr<const NoiseField> field_;
+    NoiseType noiseType_ = NoiseType::Perlin;
+    float evolution_ = 0.0f;
+    float evolutionPosition_ = 0.0f;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerlinNoiseOscillator)
 };
@@ -475,35 +505,21 @@ private:
  * @brief Probabilistic sine wave oscillator with quantum uncertainty
  * Incorporates quantum mechanics principles in waveform generation
  */
-class QuantumSineOscillator : public Oscillator
+class QuantumSineOscillator final : public BlockOscillator<QuantumSineOscillator>
 {
 public:
     explicit QuantumSineOscillator(std::string_view name) 
-        : Oscillator(name)
+        : BlockOscillator(name)
         , quantumUncertainty_(0.1f)
         , collapseProbability_(0.01f) {
         std::random_device rd;
-        gen_.seed(rd());
+        random_.setSeed((static_cast<uint64_t>(rd()) << 32) | rd());
     }
     
     void reset() override {
         resetPhase();
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = generateNextSample();
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = generateNextSample();
-            left[i] = sample;
-            right[i] = sample;
-        }
-    }
-    
     void setQuantumUncertainty(float uncertainty) {
         quantumUncertainty_ = juce::jlimit(0.0f, 1.0f, uncertainty);
     }
@@ -512,47 +528,53 @@ public:
         collapseProbability_ = juce::jlimit(0.0f, 0.1f, prob);
     }
     
-private:
-    [[nodiscard]] float generateNextSample() {
-        std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-        
-        // Quantum superposition - multiple probability states
-        auto coherentState = generateSine(phase_);
-        auto excitedState = generateSine(phase_ * 2.0f);
-        auto groundState = 0.0f;
-        
-        // Probability amplitudes
-        auto weightCoherent = 1.0f - quantumUncertainty_;
-        auto weightExcited = quantumUncertainty_ * 0.5f;
-        auto weightGround = quantumUncertainty_ * 0.5f;
+    /** Block kernel: random numbers for a chunk are drawn in one vector pass before the sample loop */
+    void renderBlock(float* output, int numSamples) noexcept {
+        // Probability amplitudes; the ground state is silent
+        const float weightCoherent = 1.0f - quantumUncertainty_;
+        const float weightExcited = quantumUncertainty_ * 0.5f;
+        const float collapse = collapseProbability_;
+        const float increment = calculatePhaseIncrement(frequency_);
+        const float gain = amplitude_;
+        float phase = phase_;
         
-        auto superposition = coherentState * weightCoherent + 
-                           excitedState * weightExcited + 
-                           groundState * weightGround;
+        std::array<float, 2 * kRandomChunk> random;
         
-        // Quantum measurement/collapse
-        if (dis(gen_) < collapseProbability_) {
-            // Collapse to one of the eigenstates
-            auto randVal = dis(gen_);
-            if (randVal < weightCoherent) {
-                superposition = coherentState;
-            } else if (randVal < weightCoherent + weightExcited) {
-                superposition = excitedState;
-            } else {
-                superposition = groundState;
+        for (int start = 0; start < numSamples; start += kRandomChunk) {
+            const int count = std::min(kRandomChunk, numSamples - start);
+            random_.fillUniform(random.data(), 2 * count);
+            
+            for (int i = 0; i < count; ++i) {
+                // Quantum superposition - multiple probability states
+                const float coherentState = generateSine(phase);
+                const float excitedState = generateSine(phase * 2.0f);
+                float superposition = coherentState * weightCoherent + excitedState * weightExcited;
+                
+                // Quantum measurement/collapse to one of the eigenstates
+                if (random[2 * i] < collapse) {
+                    const float randVal = random[2 * i + 1];
+                    superposition = randVal < weightCoherent ? coherentState
+                                  : randVal < weightCoherent + weightExcited ? excitedState
+                                  : 0.0f;
+                }
+                
+                output[start + i] = superposition * gain;
+                
+                phase += increment;
+                if (phase >= 1.0f) phase -= 1.0f;
             }
         }
         
-        lastOutput_ = superposition * amplitude_;
-        advancePhase(calculatePhaseIncrement(frequency_));
-        return lastOutput_;
+        phase_ = phase;
+        if (numSamples > 0) lastOutput_ = output[numSamples - 1];
     }
     
-    [[nodiscard]] float generateSample() override { return generateNextSample(); }
+private:
+    static constexpr int kRandomChunk = 64;
     
     float quantumUncertainty_;
     float collapseProbability_;
-    std::mt19937 gen_;
+    utility::FastRandom random_;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(QuantumSineOscillator)
 };
@@ -566,11 +588,11 @@ private:
  * @brief Self-modifying FM synthesis oscillator
  * The modulation index adapts based on the output signal
  */
-class AdaptiveFMOscillator : public Oscillator
+class AdaptiveFMOscillator final : public BlockOscillator<AdaptiveFMOscillator>
 {
 public:
     explicit AdaptiveFMOscillator(std::string_view name) 
-        : Oscillator(name)
+        : BlockOscillator(name)
         , carrierFreq_(440.0f)
         , modFreq_(220.0f)
         , modIndex_(1.0f)
@@ -582,20 +604,6 @@ public:
         lastOutput_ = 0.0f;
     }
     
-    void process(float* output, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            output[i] = generateNextSample();
-        }
-    }
-    
-    void processStereo(float* left, float* right, int numSamples) override {
-        for (int i = 0; i < numSamples; ++i) {
-            float sample = generateNextSample();
-            left[i] = sample;
-            right[i] = sample;
-        }
-    }
-    
     void setModulationIndex(float index) {
         modIndex_ = std::max(0.0f, index);
     }
@@ -608,26 +616,39 @@ public:
         feedbackAmount_ = juce::jlimit(0.0f, 0.5f, feedback);
     }
     
-private:
-    [[nodiscard]] float generateNextSample() {
-        // Adaptive modulation index based on output
-        auto envelope = std::abs(lastOutput_);
-        auto adaptiveModIndex = modIndex_ * (1.0f + adaptationRate_ * envelope * 10.0f);
+    /** Block kernel: the feedback path is serial, so state stays in registers and sines come from the table */
+    void renderBlock(float* output, int numSamples) noexcept {
+        const float twoPi = 2.0f * juce::MathConstants<float>::pi;
+        const float carrierRadians = carrierFreq_ * twoPi;
+        const float modRadians = modFreq_ * twoPi;
+        const float adaptation = modIndex_ * adaptationRate_ * 10.0f;
+        const float modIndex = modIndex_;
+        const float feedback = feedbackAmount_;
+        const float increment = calculatePhaseIncrement(frequency_);
+        const float gain = amplitude_;
+        float phase = phase_;
+        float last = lastOutput_;
         
-        // FM synthesis
-        auto modSignal = generateSine(modFreq_ * phase_ * 2.0f * juce::MathConstants<float>::pi + 
-                                     feedbackAmount_ * lastOutput_);
-        auto carrierPhase = carrierFreq_ * phase_ * 2.0f * juce::MathConstants<float>::pi + 
-                           adaptiveModIndex * modSignal;
-        
-        lastOutput_ = std::sin(carrierPhase) * amplitude_;
-        advancePhase(calculatePhaseIncrement(frequency_));
+        for (int i = 0; i < numSamples; ++i) {
+            // Adaptive modulation index based on output
+            const float adaptiveModIndex = modIndex + adaptation * std::abs(last);
+            
+            // FM synthesis
+            const float modSignal = generateSine(modRadians * phase + feedback * last);
+            const float carrierPhase = carrierRadians * phase + adaptiveModIndex * modSignal;
+            
+            last = Wavetable::fastSin(carrierPhase * (1.0f / twoPi)) * gain;
+            output[i] = last;
+            
+            phase += increment;
+            if (phase >= 1.0f) phase -= 1.0f;
+        }
         
-        return lastOutput_;
+        phase_ = phase;
+        lastOutput_ = last;
     }
     
-    [[nodiscard]] float generateSample() override { return generateNextSample(); }
-    
+private:
     float carrierFreq_;
     float modFreq_;
     float modIndex_;
@@ -637,6 +658,140 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AdaptiveFMOscillator)
 };
 
+//==============================================================================
+// Table-Based Oscillators
+//==============================================================================
+
+/**
+ * @class WavetableOscillator
+ * @brief Band-limited wavetable oscillator with frame morphing and unison
+ * Renders a shared mipmapped table, so instances cost only their phases;
+ * all unison copies run in one SIMD loop
+ */
+class WavetableOscillator final : public BlockOscillator<WavetableOscillator>
+{
+public:
+    explicit WavetableOscillator(std::string_view name, const UnisonStack::Settings& unison = {}) 
+        : BlockOscillator(name)
+        , table_(Wavetable::getShape(Wavetable::Shape::Saw))
+        , framePosition_(0.0f) {
+        unison_.prepare(1, sampleRate_);
+        unison_.setSettings(unison);
+        unison_.noteOn(0, frequency_);
+    }
+    
+    void reset() override {
+        resetPhase();
+        unison_.noteOn(0, frequency_);
+    }
+    
+    void processStereo(float* left, float* right, int numSamples) override {
+        std::fill(left, left + numSamples, 0.0f);
+        std::fill(right, right + numSamples, 0.0f);
+        render(left, right, numSamples);
+    }
+    
+    /** Table shared with other instances; not real-time safe to build, cheap to swap */
+    void setWavetable(std::shared_ptr<const Wavetable> table) {
+        if (table != nullptr) table_ = std::move(table);
+    }
+    
+    void setShape(Wavetable::Shape shape) { table_ = Wavetable::getShape(shape); }
+    void setFramePosition(float position) { framePosition_ = juce::jlimit(0.0f, 1.0f, position); }
+    
+    /** Unison count, detune, stereo spread, blend and phase randomisation */
+    void setUnison(const UnisonStack::Settings& settings) { unison_.setSettings(settings); }
+    
+    const std::shared_ptr<const Wavetable>& getWavetable() const { return table_; }
+    float getFramePosition() const { return framePosition_; }
+    const UnisonStack::Settings& getUnison() const { return unison_.getSettings(); }
+    
+    /** Block kernel: every unison copy in one SIMD pass, both sides folded to mono */
+    void renderBlock(float* output, int numSamples) noexcept {
+        std::fill(output, output + numSamples, 0.0f);
+        render(output, nullptr, numSamples);
+    }
+    
+private:
+    void render(float* left, float* right, int numSamples) noexcept {
+        unison_.setSampleRate(sampleRate_);
+        unison_.setFrequency(0, frequency_);
+        unison_.render(0, *table_, framePosition_, amplitude_, left, right, numSamples);
+        
+        if (numSamples > 0) lastOutput_ = left[numSamples - 1];
+    }
+    
+    std::shared_ptr<const Wavetable> table_;
+    float framePosition_;
+    UnisonStack unison_;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WavetableOscillator)
+};
+
+//==============================================================================
+// Block Processing Handle
+//==============================================================================
+
+/**
+ * @class OscillatorHandle
+ * @brief Owns one oscillator by value and dispatches to its block kernel statically
+ *
+ * The oscillator lives in a std::variant of the concrete (final) types, so
+ * process() resolves the type once per block with std::visit and then runs
+ * the kernel with no virtual calls. Parameters are still set through the
+ * Oscillator interface via operator->.
+ */
+class OscillatorHandle
+{
+public:
+    using Variant = std::variant<std::monostate,
+                                 LorenzOscillator,
+                                 RosslerOscillator,
+                                 HenonOscillator,
+                                 PerlinNoiseOscillator,
+                                 QuantumSineOscillator,
+                                 AdaptiveFMOscillator,
+                                 WavetableOscillator>;
+    
+    OscillatorHandle() = default;
+    
+    template <typename Type, typename... Args>
+    static OscillatorHandle create(Args&&... args) {
+        OscillatorHandle handle;
+        handle.state_ = std::make_unique<Variant>(std::in_place_type<Type>, std::forward<Args>(args)...);
+        handle.oscillator_ = &std::get<Type>(*handle.state_);
+        return handle;
+    }
+    
+    explicit operator bool() const { return oscillator_ != nullptr; }
+    Oscillator* get() const { return oscillator_; }
+    Oscillator* operator->() const { return oscillator_; }
+    
+    /** Concrete oscillator, or nullptr if the handle holds another type */
+    template <typename Type>
+    Type* getAs() const { return state_ ? std::get_if<Type>(state_.get()) : nullptr; }
+    
+    void process(float* output, int numSamples) {
+        if (!state_) return;
+        std::visit([=](auto& oscillator) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(oscillator)>, std::monostate>)
+                oscillator.renderBlock(output, numSamples);
+        }, *state_);
+    }
+    
+    void processStereo(float* left, float* right, int numSamples) {
+        if (!state_) return;
+        std::visit([=](auto& oscillator) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(oscillator)>, std::monostate>)
+                oscillator.processStereo(left, right, numSamples);
+        }, *state_);
+    }
+    
+private:
+    std::unique_ptr<Variant> state_;
+    Oscillator* oscillator_ = nullptr;
+};
+
 //==============================================================================
 // Factory Class
 //==============================================================================
@@ -648,7 +803,8 @@ private:
 class NewOscillatorFactory
 {
 public:
-    static auto createOscillator(NewOscillatorType type, std::string_view name) -> std::unique_ptr<Oscillator> {
+    static auto createOscillator(NewOscillatorType type, std::string_view name,
+                                 const UnisonStack::Settings& unison = {}) -> std::unique_ptr<Oscillator> {
         switch (type) {
             // Chaos-based oscillators
             case NewOscillatorType::Lorenz:
@@ -670,11 +826,38 @@ public:
             case NewOscillatorType::AdaptiveFM:
                 return std::make_unique<AdaptiveFMOscillator>(name);
             
+            // Table-based oscillators
+            case NewOscillatorType::Wavetable:
+                return std::make_unique<WavetableOscillator>(name, unison);
+            
             default:
                 return nullptr;
         }
     }
     
+    /** Same types as createOscillator(), as a statically dispatched block-processing handle */
+    static OscillatorHandle createHandle(NewOscillatorType type, std::string_view name,
+                                         const UnisonStack::Settings& unison = {}) {
+        switch (type) {
+            case NewOscillatorType::Lorenz:
+                return OscillatorHandle::create<LorenzOscillator>(name);
+            case NewOscillatorType::Rossler:
+                return OscillatorHandle::create<RosslerOscillator>(name);
+            case NewOscillatorType::Henon:
+                return OscillatorHandle::create<HenonOscillator>(name);
+            case NewOscillatorType::Perlin:
+                return OscillatorHandle::create<PerlinNoiseOscillator>(name);
+            case NewOscillatorType::QuantumSine:
+                return OscillatorHandle::create<QuantumSineOscillator>(name);
+            case NewOscillatorType::AdaptiveFM:
+                return OscillatorHandle::create<AdaptiveFMOscillator>(name);
+            case NewOscillatorType::Wavetable:
+                return OscillatorHandle::create<WavetableOscillator>(name, unison);
+            default:
+                return {};
+        }
+    }
+    
     /** Get oscillator type name */
     static std::string getOscillatorName(NewOscillatorType type) {
         switch (type) {
@@ -693,6 +876,7 @@ public:
             case NewOscillatorType::AdaptiveFM: return "AdaptiveFM";
             case NewOscillatorType::Evolutionary: return "Evolutionary";
             case NewOscillatorType::SelfModulating: return "SelfModulating";
+            case NewOscillatorType::Wavetable: return "Wavetable";
             default: return "Unknown";
         }
     }
@@ -714,7 +898,8 @@ public:
             NewOscillatorType::ProbabilisticWave,
             NewOscillatorType::AdaptiveFM,
             NewOscillatorType::Evolutionary,
-            NewOscillatorType::SelfModulating
+            NewOscillatorType::SelfModulating,
+            NewOscillatorType::Wavetable
         };
     }
 };
@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+    noise_field.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the shared noise tables and the Perlin and simplex kernels
+  ==============================================================================
+*/
+
+#include "noise_field.h"
+#include "../utility/shared_table_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+namespace {
+
+constexpr float kSkew = 1.0f / 3.0f;
+constexpr float kUnskew = 1.0f / 6.0f;
+
+/** Gradient directions for simplex noise: the midpoints of a cube's edges */
+constexpr float kSimplexGradients[12][3] = {
+    { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+    { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+    { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 }
+};
+
+/** The original Perlin gradient selection, only used to build the vector tables */
+float referenceGradient(int hash, float x, float y, float z) noexcept
+{
+    const int h = hash & 15;
+    const float u = h < 8 ? x : y;
+    const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
+/** floor() without a libm call; exact for the magnitudes the oscillators use */
+inline int floorToInt(float x) noexcept
+{
+    const int truncated = static_cast<int>(x);
+    return truncated - (x < static_cast<float>(truncated) ? 1 : 0);
+}
+
+inline float lerp(float t, float a, float b) noexcept { return a + t * (b - a); }
+
+} // namespace
+
+//==============================================================================
+// Construction and cache
+//==============================================================================
+
+NoiseField::NoiseField(int seed)
+    : seed_(seed)
+{
+    std::array<int, 256> permutation;
+    for (int i = 0; i < 256; ++i)
+        permutation[static_cast<size_t>(i)] = i;
+
+    // Fisher-Yates with the oscillator's original generator and distribution, so seeds are unchanged
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(seed));
+    for (int i = 255; i > 0; --i) {
+        std::uniform_int_distribution<> swapIndex(0, i);
+        std::swap(permutation[static_cast<size_t>(i)], permutation[static_cast<size_t>(swapIndex(generator))]);
+    }
+
+    for (int i = 0; i < 512; ++i) {
+        const int value = permutation[static_cast<size_t>(i & 255)];
+        perm_[static_cast<size_t>(i)] = static_cast<uint8_t>(value);
+        permMod12_[static_cast<size_t>(i)] = static_cast<uint8_t>(value % 12);
+    }
+
+    // grad() is linear in (x, y, z), so evaluating it on the unit axes gives its vector
+    for (int h = 0; h < 16; ++h) {
+        gradientX_[static_cast<size_t>(h)] = referenceGradient(h, 1.0f, 0.0f, 0.0f);
+        gradientY_[static_cast<size_t>(h)] = referenceGradient(h, 0.0f, 1.0f, 0.0f);
+        gradientZ_[static_cast<size_t>(h)] = referenceGradient(h, 0.0f, 0.0f, 1.0f);
+    }
+
+    // Gradient along x for every lattice cell on the y = z = 0 line
+    for (int i = 0; i <= 256; ++i) {
+        const int hash = perm_[perm_[perm_[static_cast<size_t>(i)]]];
+        lineGradients_[static_cast<size_t>(i)] = gradientX_[static_cast<size_t>(hash & 15)];
+    }
+}
+
+std::shared_ptr<const NoiseField> NoiseField::get(int seed)
+{
+    static utility::SharedTableCache<int, NoiseField> cache;
+
+    return cache.get(seed, [&] { return std::make_shared<const NoiseField>(seed); });
+}
+
+//==============================================================================
+// Perlin
+//==============================================================================
+
+float NoiseField::perlin(float x, float y, float z) const noexcept
+{
+    float xs[kBatch] = { x }, ys[kBatch] = { y }, zs[kBatch] = { z }, result[kBatch];
+    perlin(xs, ys, zs, result);
+    return result[0];
+}
+
+void NoiseField::perlin(const float* x, const float* y, const float* z, float* output) const noexcept
+{
+    alignas(32) float fx[kBatch], fy[kBatch], fz[kBatch];
+    alignas(32) float u[kBatch], v[kBatch], w[kBatch];
+    alignas(32) int cx[kBatch], cy[kBatch], cz[kBatch];
+
+    // Lattice cells, fractions and fade curves
+    for (int i = 0; i < kBatch; ++i) {
+        const int ix = floorToInt(x[i]), iy = floorToInt(y[i]), iz = floorToInt(z[i]);
+        fx[i] = x[i] - static_cast<float>(ix);
+        fy[i] = y[i] - static_cast<float>(iy);
+        fz[i] = z[i] - static_cast<float>(iz);
+        cx[i] = ix & 255;
+        cy[i] = iy & 255;
+        cz[i] = iz & 255;
+        u[i] = fade(fx[i]);
+        v[i] = fade(fy[i]);
+        w[i] = fade(fz[i]);
+    }
+
+    // Corner hashes, corner c at offset (c & 1, (c >> 1) & 1, c >> 2)
+    alignas(32) int hashes[8][kBatch];
+    for (int i = 0; i < kBatch; ++i) {
+        const int a = perm_[static_cast<size_t>(cx[i])] + cy[i];
+        const int b = perm_[static_cast<size_t>(cx[i]) + 1] + cy[i];
+        const int aa = perm_[static_cast<size_t>(a)] + cz[i];
+        const int ab = perm_[static_cast<size_t>(a) + 1] + cz[i];
+        const int ba = perm_[static_cast<size_t>(b)] + cz[i];
+        const int bb = perm_[static_cast<size_t>(b) + 1] + cz[i];
+
+        hashes[0][i] = perm_[static_cast<size_t>(aa)] & 15;
+        hashes[1][i] = perm_[static_cast<size_t>(ba)] & 15;
+        hashes[2][i] = perm_[static_cast<size_t>(ab)] & 15;
+        hashes[3][i] = perm_[static_cast<size_t>(bb)] & 15;
+        hashes[4][i] = perm_[static_cast<size_t>(aa) + 1] & 15;
+        hashes[5][i] = perm_[static_cast<size_t>(ba) + 1] & 15;
+        hashes[6][i] = perm_[static_cast<size_t>(ab) + 1] & 15;
+        hashes[7][i] = perm_[static_cast<size_t>(bb) + 1] & 15;
+    }
+
+    // Gradient dot products
+    alignas(32) float dots[8][kBatch];
+    for (int corner = 0; corner < 8; ++corner) {
+        const float ox = static_cast<float>(corner & 1);
+        const float oy = static_cast<float>((corner >> 1) & 1);
+        const float oz = static_cast<float>(corner >> 2);
+        const int* hash = hashes[corner];
+
+        for (int i = 0; i < kBatch; ++i) {
+            const auto h = static_cast<size_t>(hash[i]);
+            dots[corner][i] = gradientX_[h] * (fx[i] - ox) + gradientY_[h] * (fy[i] - oy) + gradientZ_[h] * (fz[i] - oz);
+        }
+    }
+
+    // Trilinear blend
+    for (int i = 0; i < kBatch; ++i) {
+        const float x00 = lerp(u[i], dots[0][i], dots[1][i]);
+        const float x10 = lerp(u[i], dots[2][i], dots[3][i]);
+        const float x01 = lerp(u[i], dots[4][i], dots[5][i]);
+        const float x11 = lerp(u[i], dots[6][i], dots[7][i]);
+        output[i] = lerp(w[i], lerp(v[i], x00, x10), lerp(v[i], x01, x11));
+    }
+}
+
+//==============================================================================
+// Simplex
+//==============================================================================
+
+float NoiseField::simplex(float x, float y, float z) const noexcept
+{
+    float xs[kBatch] = { x }, ys[kBatch] = { y }, zs[kBatch] = { z }, result[kBatch];
+    simplex(xs, ys, zs, result);
+    return result[0];
+}
+
+void NoiseField::simplex(const float* x, const float* y, const float* z, float* output) const noexcept
+{
+    // Offsets of the four simplex corners from each point, and their lattice coordinates
+    alignas(32) float dx[4][kBatch], dy[4][kBatch], dz[4][kBatch];
+    alignas(32) int ci[4][kBatch], cj[4][kBatch], ck[4][kBatch];
+
+    for (int n = 0; n < kBatch; ++n) {
+        const float s = (x[n] + y[n] + z[n]) * kSkew;
+        const int i = floorToInt(x[n] + s), j = floorToInt(y[n] + s), k = floorToInt(z[n] + s);
+        const float t = static_cast<float>(i + j + k) * kUnskew;
+        const float x0 = x[n] - (static_cast<float>(i) - t);
+        const float y0 = y[n] - (static_cast<float>(j) - t);
+        const float z0 = z[n] - (static_cast<float>(k) - t);
+
+        // Which of the six tetrahedra the point is in, from the ordering of x0, y0, z0
+        const int xy = x0 >= y0 ? 1 : 0;
+        const int yz = y0 >= z0 ? 1 : 0;
+        const int xz = x0 >= z0 ? 1 : 0;
+        const int i1 = xy & xz, j1 = (1 - xy) & yz, k1 = (1 - xz) & (1 - yz);
+        const int i2 = xy | xz, j2 = (1 - xy) | yz, k2 = 1 - (xz & yz);
+
+        dx[0][n] = x0;
+        dy[0][n] = y0;
+        dz[0][n] = z0;
+        dx[1][n] = x0 - static_cast<float>(i1) + kUnskew;
+        dy[1][n] = y0 - static_cast<float>(j1) + kUnskew;
+        dz[1][n] = z0 - static_cast<float>(k1) + kUnskew;
+        dx[2][n] = x0 - static_cast<float>(i2) + 2.0f * kUnskew;
+        dy[2][n] = y0 - static_cast<float>(j2) + 2.0f * kUnskew;
+        dz[2][n] = z0 - static_cast<float>(k2) + 2.0f * kUnskew;
+        dx[3][n] = x0 - 1.0f + 3.0f * kUnskew;
+        dy[3][n] = y0 - 1.0f + 3.0f * kUnskew;
+        dz[3][n] = z0 - 1.0f + 3.0f * kUnskew;
+
+        const int ii = i & 255, jj = j & 255, kk = k & 255;
+        ci[0][n] = ii;      cj[0][n] = jj;      ck[0][n] = kk;
+        ci[1][n] = ii + i1; cj[1][n] = jj + j1; ck[1][n] = kk + k1;
+        ci[2][n] = ii + i2; cj[2][n] = jj + j2; ck[2][n] = kk + k2;
+        ci[3][n] = ii + 1;  cj[3][n] = jj + 1;  ck[3][n] = kk + 1;
+    }
+
+    // Gradient index per corner; every sum stays inside the doubled table
+    alignas(32) int gradients[4][kBatch];
+    for (int corner = 0; corner < 4; ++corner) {
+        for (int n = 0; n < kBatch; ++n) {
+            const int inner = perm_[static_cast<size_t>(cj[corner][n] + perm_[static_cast<size_t>(ck[corner][n])])];
+            gradients[corner][n] = permMod12_[static_cast<size_t>(ci[corner][n] + inner)];
+        }
+    }
+
+    // Radially attenuated contributions; max() replaces the out-of-range branch
+    alignas(32) float sum[kBatch] = {};
+    for (int corner = 0; corner < 4; ++corner) {
+        for (int n = 0; n < kBatch; ++n) {
+            const float* g = kSimplexGradients[gradients[corner][n]];
+            const float ex = dx[corner][n], ey = dy[corner][n], ez = dz[corner][n];
+            float t = std::max(0.0f, 0.6f - ex * ex - ey * ey - ez * ez);
+            t *= t;
+            sum[n] += t * t * (g[0] * ex + g[1] * ey + g[2] * ez);
+        }
+    }
+
+    for (int n = 0; n < kBatch; ++n)
+        output[n] = 32.0f * sum[n];
+}
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
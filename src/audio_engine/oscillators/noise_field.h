@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    noise_field.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Shared, seed-keyed permutation and gradient tables with batched
+    3D Perlin and simplex noise kernels
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+//==============================================================================
+/**
+ * @class NoiseField
+ * @brief Immutable gradient-noise tables for one seed, shared across instances
+ *
+ * Building a field shuffles a 256-entry permutation (the same shuffle the
+ * Perlin oscillator has always used, so seeds keep their sound) and derives
+ * everything the kernels need from it: the doubled permutation, the simplex
+ * gradient indices, per-hash gradient vectors and the per-cell gradients of
+ * the y = z = 0 line. get() hands out one shared field per live seed.
+ *
+ * The batched kernels evaluate kBatch points at once: lattice cells,
+ * fractions, fade curves and interpolation are lane arithmetic the compiler
+ * vectorises, and only the permutation lookups stay per lane. Simplex
+ * corner ordering is computed with comparisons rather than branches.
+ */
+class NoiseField
+{
+public:
+    //==============================================================================
+    static constexpr int kBatch = 8;
+
+    /** Shared field for a seed, built on first use. Not real-time safe. */
+    static std::shared_ptr<const NoiseField> get(int seed);
+
+    /** Use get() */
+    explicit NoiseField(int seed);
+
+    int getSeed() const noexcept { return seed_; }
+
+    //==============================================================================
+    /** Classic 3D Perlin noise in [-1, 1] */
+    float perlin(float x, float y, float z) const noexcept;
+
+    /** 3D simplex noise in roughly [-1, 1]; smoother and without axis-aligned artefacts */
+    float simplex(float x, float y, float z) const noexcept;
+
+    /** kBatch points at once */
+    void perlin(const float* x, const float* y, const float* z, float* output) const noexcept;
+    void simplex(const float* x, const float* y, const float* z, float* output) const noexcept;
+
+    /** perlin(x, 0, 0), reduced to one gradient lookup per lattice cell */
+    float perlinLine(float x) const noexcept
+    {
+        int cell = static_cast<int>(x);
+        cell -= x < static_cast<float>(cell) ? 1 : 0;
+        const float t = x - static_cast<float>(cell);
+        const int index = cell & 255;
+
+        const float g0 = lineGradients_[static_cast<size_t>(index)] * t;
+        const float g1 = lineGradients_[static_cast<size_t>(index) + 1] * (t - 1.0f);
+        return g0 + fade(t) * (g1 - g0);
+    }
+
+    static float fade(float t) noexcept { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+private:
+    //==============================================================================
+    int seed_ = 0;
+    std::array<uint8_t, 512> perm_{};
+    std::array<uint8_t, 512> permMod12_{};
+    std::array<float, 257> lineGradients_{};
+
+    /** Perlin gradient for each 4-bit hash as a vector, so grad() is a dot product */
+    std::array<float, 16> gradientX_{}, gradientY_{}, gradientZ_{};
+
+    JUCE_DECLARE_NON_COPYABLE(NoiseField)
+};
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
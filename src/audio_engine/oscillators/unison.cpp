@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+    unison.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the unison stack layout and rendering
+  ==============================================================================
+*/
+
+#include "unison.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void UnisonStack::prepare(int maxVoices, double sampleRate)
+{
+    jassert(maxVoices > 0 && sampleRate > 0.0);
+
+    maxVoices_ = maxVoices;
+    sampleRate_ = static_cast<float>(sampleRate);
+
+    phases_.assign(static_cast<size_t>(maxVoices) * kMaxUnison, 0.0f);
+    increments_.assign(static_cast<size_t>(maxVoices) * kMaxUnison, 0.0f);
+    frequencies_.assign(static_cast<size_t>(maxVoices), 0.0f);
+
+    setSettings(settings_);
+}
+
+void UnisonStack::setSampleRate(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0);
+
+    if (static_cast<float>(sampleRate) == sampleRate_) return;
+
+    sampleRate_ = static_cast<float>(sampleRate);
+    for (int voice = 0; voice < maxVoices_; ++voice)
+        updateIncrements(voice);
+}
+
+void UnisonStack::setSettings(const Settings& settings) noexcept
+{
+    settings_ = settings;
+    settings_.numVoices = juce::jlimit(1, kMaxUnison, settings.numVoices);
+    settings_.stereoSpread = juce::jlimit(0.0f, 1.0f, settings.stereoSpread);
+    settings_.blend = juce::jlimit(0.0f, 1.0f, settings.blend);
+    settings_.phaseRandomization = juce::jlimit(0.0f, 1.0f, settings.phaseRandomization);
+
+    const int count = settings_.numVoices;
+    const float quarterPi = 0.25f * juce::MathConstants<float>::pi;
+
+    detuneRatios_.fill(0.0f);
+    gainsLeft_.fill(0.0f);
+    gainsRight_.fill(0.0f);
+
+    float power = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        // Position in [-1, 1], 0 for a lone copy
+        const float position = count == 1 ? 0.0f : 2.0f * static_cast<float>(i) / static_cast<float>(count - 1) - 1.0f;
+        detuneRatios_[static_cast<size_t>(i)] = std::exp2(position * 0.5f * settings_.detuneCents / 1200.0f);
+
+        // Innermost one (odd counts) or two (even counts) copies are the centre
+        const bool centre = std::abs(position) * static_cast<float>(count - 1) <= 1.0f;
+        const float level = centre ? 1.0f : settings_.blend;
+
+        // Pan follows the detune position, so every mirrored pair is split across the channels
+        const float pan = position * settings_.stereoSpread;
+        const float angle = quarterPi * (pan + 1.0f);
+
+        gainsLeft_[static_cast<size_t>(i)] = level * std::cos(angle);
+        gainsRight_[static_cast<size_t>(i)] = level * std::sin(angle);
+        power += level * level;
+    }
+
+    const float normalise = 1.0f / std::sqrt(std::max(power, 1.0e-6f));
+    for (int i = 0; i < count; ++i) {
+        gainsLeft_[static_cast<size_t>(i)] *= normalise;
+        gainsRight_[static_cast<size_t>(i)] *= normalise;
+    }
+
+    for (int voice = 0; voice < maxVoices_; ++voice)
+        updateIncrements(voice);
+}
+
+//==============================================================================
+// Voices
+//==============================================================================
+
+void UnisonStack::noteOn(int voice, float frequency) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+
+    float* phases = voicePhases(voice);
+    for (int i = 0; i < kMaxUnison; ++i)
+        phases[i] = nextRandom() * settings_.phaseRandomization;
+
+    setFrequency(voice, frequency);
+}
+
+void UnisonStack::setFrequency(int voice, float frequency) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+
+    frequencies_[static_cast<size_t>(voice)] = std::max(0.0f, frequency);
+    updateIncrements(voice);
+}
+
+void UnisonStack::updateIncrements(int voice) noexcept
+{
+    const float base = frequencies_[static_cast<size_t>(voice)] / sampleRate_;
+    float* increments = voiceIncrements(voice);
+
+    for (int i = 0; i < kMaxUnison; ++i)
+        increments[i] = base * detuneRatios_[static_cast<size_t>(i)];
+}
+
+float UnisonStack::nextRandom() noexcept
+{
+    // xorshift32, top 24 bits to [0, 1)
+    randomState_ ^= randomState_ << 13;
+    randomState_ ^= randomState_ >> 17;
+    randomState_ ^= randomState_ << 5;
+    return static_cast<float>(randomState_ >> 8) * (1.0f / 16777216.0f);
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void UnisonStack::render(int voice, const Wavetable& table, float framePosition, float gain,
+                         float* left, float* right, int numSamples) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+
+    const int count = settings_.numVoices;
+
+    if (right != nullptr) {
+        for (int i = 0; i < kMaxUnison; ++i) {
+            scaledLeft_[static_cast<size_t>(i)] = gainsLeft_[static_cast<size_t>(i)] * gain;
+            scaledRight_[static_cast<size_t>(i)] = gainsRight_[static_cast<size_t>(i)] * gain;
+        }
+    }
+    else {
+        // Both sides folded so a centred copy keeps unit gain
+        const float fold = gain * juce::MathConstants<float>::sqrt2 * 0.5f;
+        for (int i = 0; i < kMaxUnison; ++i)
+            scaledLeft_[static_cast<size_t>(i)] = (gainsLeft_[static_cast<size_t>(i)] + gainsRight_[static_cast<size_t>(i)]) * fold;
+    }
+
+    WavetableRenderer::Lanes lanes;
+    lanes.phases = voicePhases(voice);
+    lanes.increments = voiceIncrements(voice);
+    lanes.gainsLeft = scaledLeft_.data();
+    lanes.gainsRight = scaledRight_.data();
+    lanes.numLanes = count;
+
+    WavetableRenderer::render(table, framePosition, lanes, left, right, numSamples);
+}
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
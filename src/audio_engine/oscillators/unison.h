@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+    unison.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Detuned unison stacks rendered as wavetable lanes in one SIMD loop
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "wavetable.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+//==============================================================================
+/**
+ * @class UnisonStack
+ * @brief Up to kMaxUnison detuned copies per voice, rendered together
+ *
+ * Every voice owns kMaxUnison structure-of-arrays lanes (phase and phase
+ * increment), and one stereo gain layout is shared by all voices. A voice
+ * renders all of its copies with a single WavetableRenderer call, so a
+ * 16-voice supersaw costs four SIMD lane groups rather than sixteen
+ * oscillator objects.
+ *
+ * Copies are spread symmetrically over +/- detuneCents / 2 and panned by the
+ * same position scaled by stereoSpread, flat copies left and sharp copies
+ * right, so the stack is balanced for every count; blend sets the level of
+ * the outer copies against the centre one (or two). The layout is normalised to
+ * constant power, so changing the voice count does not change loudness.
+ */
+class UnisonStack
+{
+public:
+    //==============================================================================
+    static constexpr int kMaxUnison = 16;
+
+    struct Settings
+    {
+        int numVoices = 1;                  // Copies per voice, 1 .. kMaxUnison
+        float detuneCents = 20.0f;          // Distance between the outermost copies
+        float stereoSpread = 1.0f;          // 0 = all centred, 1 = outermost copies hard left/right
+        float blend = 1.0f;                 // Outer copy level relative to the centre, 0 .. 1
+        float phaseRandomization = 1.0f;    // Fraction of a cycle copies are scattered by on noteOn()
+    };
+
+    //==============================================================================
+    UnisonStack() = default;
+
+    /** Size lane storage for maxVoices voices. Not real-time safe. */
+    void prepare(int maxVoices, double sampleRate);
+
+    /** Recompute the detune and gain layout; cheap, and safe to call between blocks */
+    void setSettings(const Settings& settings) noexcept;
+    const Settings& getSettings() const noexcept { return settings_; }
+
+    int getNumVoices() const noexcept { return maxVoices_; }
+
+    /** Rescale every voice's increments for a new sample rate */
+    void setSampleRate(double sampleRate) noexcept;
+
+    //==============================================================================
+    /** Restart a voice's copies at scattered phases and set its pitch */
+    void noteOn(int voice, float frequency) noexcept;
+
+    /** Retune a voice without touching its phases */
+    void setFrequency(int voice, float frequency) noexcept;
+
+    /**
+     * Add numSamples of a voice's stack to left and right, scaled by gain.
+     * right may be nullptr for a mono sum of both sides.
+     */
+    void render(int voice, const Wavetable& table, float framePosition, float gain,
+                float* left, float* right, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    void updateIncrements(int voice) noexcept;
+    float nextRandom() noexcept;
+
+    float* voicePhases(int voice) noexcept { return phases_.data() + static_cast<size_t>(voice) * kMaxUnison; }
+    float* voiceIncrements(int voice) noexcept { return increments_.data() + static_cast<size_t>(voice) * kMaxUnison; }
+
+    Settings settings_;
+    int maxVoices_ = 0;
+    float sampleRate_ = 44100.0f;
+    uint32_t randomState_ = 0x9e3779b9u;
+
+    /** Shared layout, zero past numVoices so padded lanes stay silent */
+    std::array<float, kMaxUnison> detuneRatios_{};
+    std::array<float, kMaxUnison> gainsLeft_{};
+    std::array<float, kMaxUnison> gainsRight_{};
+    std::array<float, kMaxUnison> scaledLeft_{};
+    std::array<float, kMaxUnison> scaledRight_{};
+
+    /** Per voice, kMaxUnison lanes each */
+    std::vector<float> phases_;
+    std::vector<float> increments_;
+    std::vector<float> frequencies_;
+
+    JUCE_DECLARE_NON_COPYABLE(UnisonStack)
+};
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
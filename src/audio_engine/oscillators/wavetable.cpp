@@ -0,0 +1,326 @@
+/*
+  ==============================================================================
+    wavetable.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the mipmapped wavetables and the lane renderer
+  ==============================================================================
+*/
+
+#include "wavetable.h"
+#include "../utility/shared_table_cache.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_WAVETABLE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_WAVETABLE_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+namespace {
+
+constexpr int kFftOrder = 11;
+static_assert((1 << kFftOrder) == Wavetable::kFrameSize, "FFT order must match the frame size");
+
+/** Most lanes one render() call can take; unison stacks stay far below this */
+constexpr int kMaxLanes = 64;
+
+/** Periodic Catmull-Rom resampling of an arbitrary-length cycle to kFrameSize samples */
+std::vector<float> resampleCycle(const std::vector<float>& cycle)
+{
+    std::vector<float> frame(Wavetable::kFrameSize, 0.0f);
+    const int size = static_cast<int>(cycle.size());
+    if (size == 0) return frame;
+
+    if (size == Wavetable::kFrameSize) {
+        std::copy(cycle.begin(), cycle.end(), frame.begin());
+        return frame;
+    }
+
+    const auto at = [&cycle, size](int index) { return cycle[static_cast<size_t>(((index % size) + size) % size)]; };
+    const double step = static_cast<double>(size) / Wavetable::kFrameSize;
+
+    for (int i = 0; i < Wavetable::kFrameSize; ++i) {
+        const double position = i * step;
+        const int index = static_cast<int>(position);
+        const float t = static_cast<float>(position - index);
+        const float p0 = at(index - 1), p1 = at(index), p2 = at(index + 1), p3 = at(index + 2);
+        frame[static_cast<size_t>(i)] = p1 + 0.5f * t * (p2 - p0 + t * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3
+                                                         + t * (3.0f * (p1 - p2) + p3 - p0)));
+    }
+
+    return frame;
+}
+
+/** One cycle of a basic shape, built from its harmonic series up to the frame's Nyquist */
+std::vector<float> makeShapeFrame(Wavetable::Shape shape)
+{
+    constexpr int size = Wavetable::kFrameSize;
+    const float pi = juce::MathConstants<float>::pi;
+    const float halfSize = 0.5f * static_cast<float>(size);
+
+    // Interleaved complex bins in juce::dsp::FFT's real-only layout
+    std::vector<float> spectrum(2 * static_cast<size_t>(size), 0.0f);
+
+    for (int k = 1; k < size / 2; ++k) {
+        float& re = spectrum[2 * static_cast<size_t>(k)];
+        float& im = spectrum[2 * static_cast<size_t>(k) + 1];
+        const float harmonic = static_cast<float>(k);
+        const bool odd = (k & 1) != 0;
+
+        switch (shape) {
+            case Wavetable::Shape::Sine:     im = k == 1 ? -halfSize : 0.0f; break;
+            case Wavetable::Shape::Saw:      im = halfSize * 2.0f / (pi * harmonic); break;
+            case Wavetable::Shape::Square:   im = odd ? -halfSize * 4.0f / (pi * harmonic) : 0.0f; break;
+            case Wavetable::Shape::Triangle: re = odd ? halfSize * 8.0f / (pi * pi * harmonic * harmonic) : 0.0f; break;
+        }
+    }
+
+    juce::dsp::FFT fft(kFftOrder);
+    fft.performRealOnlyInverseTransform(spectrum.data());
+    spectrum.resize(static_cast<size_t>(size));
+    return spectrum;
+}
+
+uint64_t hashFrames(const std::vector<std::vector<float>>& frames) noexcept
+{
+    uint64_t hash = 1469598103934665603ull;
+    const auto mix = [&hash](uint32_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    mix(static_cast<uint32_t>(frames.size()));
+    for (const auto& frame : frames) {
+        mix(static_cast<uint32_t>(frame.size()));
+        for (float sample : frame) {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &sample, sizeof(bits));
+            mix(bits);
+        }
+    }
+
+    return hash;
+}
+
+inline float catmullRom(float p0, float p1, float p2, float p3, float t) noexcept
+{
+    const float c1 = 0.5f * (p2 - p0);
+    const float c2 = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
+    const float c3 = 0.5f * (p3 - p0) + 1.5f * (p1 - p2);
+    return ((c3 * t + c2) * t + c1) * t + p1;
+}
+
+} // namespace
+
+//==============================================================================
+// Construction and sharing
+//==============================================================================
+
+Wavetable::Wavetable(const std::vector<std::vector<float>>& frames)
+    : numFrames_(juce::jlimit(1, kMaxFrames, static_cast<int>(frames.size())))
+{
+    data_.assign(static_cast<size_t>(kNumLevels) * static_cast<size_t>(numFrames_) * kRowStride, 0.0f);
+
+    juce::dsp::FFT fft(kFftOrder);
+    std::vector<float> spectrum(2 * static_cast<size_t>(kFrameSize));
+    std::vector<float> levelBuffer(2 * static_cast<size_t>(kFrameSize));
+
+    for (int frame = 0; frame < numFrames_; ++frame) {
+        const auto cycle = frame < static_cast<int>(frames.size()) ? resampleCycle(frames[static_cast<size_t>(frame)])
+                                                                   : std::vector<float>(kFrameSize, 0.0f);
+
+        std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+        std::copy(cycle.begin(), cycle.end(), spectrum.begin());
+        fft.performRealOnlyForwardTransform(spectrum.data());
+
+        // No DC, and the Nyquist bin would only alias at the top level
+        spectrum[0] = spectrum[1] = 0.0f;
+        spectrum[kFrameSize] = spectrum[kFrameSize + 1] = 0.0f;
+
+        for (int level = 0; level < kNumLevels; ++level) {
+            const int topHarmonic = (kFrameSize / 2) >> level;
+
+            std::copy(spectrum.begin(), spectrum.end(), levelBuffer.begin());
+            std::fill(levelBuffer.begin() + 2 * (topHarmonic + 1), levelBuffer.end(), 0.0f);
+            fft.performRealOnlyInverseTransform(levelBuffer.data());
+
+            float* row = data_.data() + (static_cast<size_t>(level) * static_cast<size_t>(numFrames_)
+                                         + static_cast<size_t>(frame)) * kRowStride;
+            row[0] = levelBuffer[kFrameSize - 1];
+            std::copy(levelBuffer.begin(), levelBuffer.begin() + kFrameSize, row + 1);
+            row[kFrameSize + 1] = levelBuffer[0];
+            row[kFrameSize + 2] = levelBuffer[1];
+            row[kFrameSize + 3] = levelBuffer[2];
+        }
+    }
+}
+
+std::shared_ptr<const Wavetable> Wavetable::getShape(Shape shape)
+{
+    static const std::array<std::shared_ptr<const Wavetable>, 4> shapes = [] {
+        std::array<std::shared_ptr<const Wavetable>, 4> tables;
+        for (int i = 0; i < 4; ++i)
+            tables[static_cast<size_t>(i)] = std::make_shared<const Wavetable>(
+                std::vector<std::vector<float>>{ makeShapeFrame(static_cast<Shape>(i)) });
+        return tables;
+    }();
+
+    return shapes[static_cast<size_t>(shape)];
+}
+
+std::shared_ptr<const Wavetable> Wavetable::create(const std::vector<std::vector<float>>& frames)
+{
+    static utility::SharedTableCache<uint64_t, Wavetable> cache;
+
+    return cache.get(hashFrames(frames), [&] { return std::make_shared<const Wavetable>(frames); });
+}
+
+std::array<float, Wavetable::kSineTableSize + 1> Wavetable::buildSineTable() noexcept
+{
+    std::array<float, kSineTableSize + 1> values{};
+    for (int i = 0; i <= kSineTableSize; ++i)
+        values[static_cast<size_t>(i)] = static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * i / kSineTableSize));
+    return values;
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void WavetableRenderer::render(const Wavetable& table, float framePosition, const Lanes& lanes,
+                               float* left, float* right, int numSamples) noexcept
+{
+    jassert(lanes.numLanes <= kMaxLanes);
+    const int numLanes = paddedLanes(std::min(lanes.numLanes, kMaxLanes));
+
+    const float position = juce::jlimit(0.0f, 1.0f, framePosition) * static_cast<float>(table.getNumFrames() - 1);
+    const int frameA = std::min(static_cast<int>(position), table.getNumFrames() - 1);
+    const int frameB = std::min(frameA + 1, table.getNumFrames() - 1);
+    const float morph = position - static_cast<float>(frameA);
+    const bool morphing = frameB != frameA && morph > 0.0f;
+
+    // Mip level per lane, fixed for the block
+    std::array<const float*, kMaxLanes> rowsA{};
+    std::array<const float*, kMaxLanes> rowsB{};
+    for (int lane = 0; lane < numLanes; ++lane) {
+        const int level = Wavetable::levelForIncrement(lanes.increments[lane]);
+        rowsA[static_cast<size_t>(lane)] = table.getRow(level, frameA);
+        rowsB[static_cast<size_t>(lane)] = table.getRow(level, frameB);
+    }
+
+    const float size = static_cast<float>(Wavetable::kFrameSize);
+
+    for (int group = 0; group < numLanes; group += kLaneWidth) {
+        const float* const* groupA = rowsA.data() + group;
+        const float* const* groupB = rowsB.data() + group;
+
+       #if VITAL_WAVETABLE_SSE
+        __m128 phase = _mm_loadu_ps(lanes.phases + group);
+        const __m128 increment = _mm_loadu_ps(lanes.increments + group);
+        const __m128 gainLeft = _mm_loadu_ps(lanes.gainsLeft + group);
+        const __m128 gainRight = _mm_loadu_ps(lanes.gainsRight + group);
+        const __m128 sizeV = _mm_set1_ps(size);
+        const __m128 morphV = _mm_set1_ps(morph);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            // Wrap to [0, 1): truncation plus a correction for negative phases
+            __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(phase));
+            whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmpgt_ps(whole, phase), one));
+            phase = _mm_sub_ps(phase, whole);
+
+            const __m128 scaled = _mm_mul_ps(phase, sizeV);
+            const __m128i index = _mm_cvttps_epi32(scaled);
+            const __m128 t = _mm_sub_ps(scaled, _mm_cvtepi32_ps(index));
+
+            alignas(16) int32_t indices[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+
+            // One unaligned load per lane fetches its four control points; a transpose makes them lane-parallel
+            __m128 p0 = _mm_loadu_ps(groupA[0] + indices[0] - 1);
+            __m128 p1 = _mm_loadu_ps(groupA[1] + indices[1] - 1);
+            __m128 p2 = _mm_loadu_ps(groupA[2] + indices[2] - 1);
+            __m128 p3 = _mm_loadu_ps(groupA[3] + indices[3] - 1);
+
+            if (morphing) {
+                p0 = _mm_add_ps(p0, _mm_mul_ps(morphV, _mm_sub_ps(_mm_loadu_ps(groupB[0] + indices[0] - 1), p0)));
+                p1 = _mm_add_ps(p1, _mm_mul_ps(morphV, _mm_sub_ps(_mm_loadu_ps(groupB[1] + indices[1] - 1), p1)));
+                p2 = _mm_add_ps(p2, _mm_mul_ps(morphV, _mm_sub_ps(_mm_loadu_ps(groupB[2] + indices[2] - 1), p2)));
+                p3 = _mm_add_ps(p3, _mm_mul_ps(morphV, _mm_sub_ps(_mm_loadu_ps(groupB[3] + indices[3] - 1), p3)));
+            }
+
+            _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+
+            const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(p2, p0));
+            const __m128 c2 = _mm_sub_ps(_mm_add_ps(p0, _mm_add_ps(p2, p2)),
+                                         _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.5f), p1), _mm_mul_ps(half, p3)));
+            const __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(p3, p0)),
+                                         _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(p1, p2)));
+            const __m128 value = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, t), c2), t), c1), t), p1);
+
+            // Horizontal sums of the weighted lanes
+            __m128 sumLeft = _mm_mul_ps(value, gainLeft);
+            sumLeft = _mm_add_ps(sumLeft, _mm_movehl_ps(sumLeft, sumLeft));
+            sumLeft = _mm_add_ss(sumLeft, _mm_shuffle_ps(sumLeft, sumLeft, 1));
+            left[sample] += _mm_cvtss_f32(sumLeft);
+
+            if (right != nullptr) {
+                __m128 sumRight = _mm_mul_ps(value, gainRight);
+                sumRight = _mm_add_ps(sumRight, _mm_movehl_ps(sumRight, sumRight));
+                sumRight = _mm_add_ss(sumRight, _mm_shuffle_ps(sumRight, sumRight, 1));
+                right[sample] += _mm_cvtss_f32(sumRight);
+            }
+
+            phase = _mm_add_ps(phase, increment);
+        }
+
+        // Store wrapped phases
+        __m128 whole = _mm_cvtepi32_ps(_mm_cvttps_epi32(phase));
+        whole = _mm_sub_ps(whole, _mm_and_ps(_mm_cmpgt_ps(whole, phase), one));
+        _mm_storeu_ps(lanes.phases + group, _mm_sub_ps(phase, whole));
+       #else
+        for (int lane = 0; lane < kLaneWidth; ++lane) {
+            const float* a = groupA[lane];
+            const float* b = groupB[lane];
+            const float increment = lanes.increments[group + lane];
+            const float gainLeft = lanes.gainsLeft[group + lane];
+            const float gainRight = lanes.gainsRight[group + lane];
+            float phase = lanes.phases[group + lane];
+
+            for (int sample = 0; sample < numSamples; ++sample) {
+                phase -= std::floor(phase);
+                const float scaled = phase * size;
+                const int index = static_cast<int>(scaled);
+                const float t = scaled - static_cast<float>(index);
+
+                float p[4];
+                for (int k = 0; k < 4; ++k)
+                    p[k] = a[index + k - 1] + morph * (b[index + k - 1] - a[index + k - 1]);
+
+                const float value = catmullRom(p[0], p[1], p[2], p[3], t);
+                left[sample] += value * gainLeft;
+                if (right != nullptr)
+                    right[sample] += value * gainRight;
+
+                phase += increment;
+            }
+
+            lanes.phases[group + lane] = phase - std::floor(phase);
+        }
+       #endif
+    }
+}
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+    wavetable.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Immutable, mipmapped band-limited wavetables shared across oscillator
+    instances, and the SIMD lane kernel that renders them
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace oscillators {
+
+//==============================================================================
+/**
+ * @class Wavetable
+ * @brief Band-limited wavetable with one mip level per octave
+ *
+ * Every frame is resampled to kFrameSize samples and stored at kNumLevels
+ * levels; level L keeps harmonics up to kFrameSize / 2 >> L, so the level
+ * picked for a phase increment never has a partial above Nyquist. Each row
+ * carries one guard sample before and three after the cycle so cubic
+ * interpolation needs no wrapping.
+ *
+ * Tables are immutable once built and handed out as shared_ptr<const>, so
+ * any number of oscillators and threads can render the same table. The
+ * basic shapes and identical user frames are built once per process.
+ */
+class Wavetable
+{
+public:
+    //==============================================================================
+    static constexpr int kFrameSize = 2048;
+    static constexpr int kNumLevels = 11;
+    static constexpr int kMaxFrames = 256;
+
+    enum class Shape { Sine, Saw, Square, Triangle };
+
+    /** Shared table for a basic shape, built on first use */
+    static std::shared_ptr<const Wavetable> getShape(Shape shape);
+
+    /**
+     * Shared table for the given single-cycle frames (any length, at most
+     * kMaxFrames). Identical frame sets return the same table while it is
+     * alive. Not real-time safe.
+     */
+    static std::shared_ptr<const Wavetable> create(const std::vector<std::vector<float>>& frames);
+
+    int getNumFrames() const noexcept { return numFrames_; }
+
+    /** Coarsest level whose top harmonic stays below Nyquist for this phase increment (cycles per sample) */
+    static int levelForIncrement(float increment) noexcept
+    {
+        const float harmonicsAllowed = 0.5f / std::max(std::abs(increment), 1.0e-9f);
+        int exponent = 0;
+        std::frexp(static_cast<float>(kFrameSize / 2) / harmonicsAllowed, &exponent);
+        return juce::jlimit(0, kNumLevels - 1, exponent);
+    }
+
+    /** kFrameSize samples of one frame at one level; row[-1] and row[kFrameSize .. kFrameSize + 2] are valid */
+    const float* getRow(int level, int frame) const noexcept
+    {
+        return data_.data() + (static_cast<size_t>(level) * static_cast<size_t>(numFrames_)
+                               + static_cast<size_t>(frame)) * kRowStride + 1;
+    }
+
+    /** sin(2 pi phase) from a shared table, for per-sample sine evaluation without std::sin */
+    static float fastSin(float phase) noexcept
+    {
+        // Integer floor keeps this free of libm calls; the table index wraps with a mask
+        const float position = phase * static_cast<float>(kSineTableSize);
+        int whole = static_cast<int>(position);
+        whole -= position < static_cast<float>(whole) ? 1 : 0;
+        const float t = position - static_cast<float>(whole);
+        const int index = whole & (kSineTableSize - 1);
+        const float* table = sineTable_.data();
+        return table[index] + t * (table[index + 1] - table[index]);
+    }
+
+    //==============================================================================
+    /** Use create() or getShape() */
+    explicit Wavetable(const std::vector<std::vector<float>>& frames);
+
+private:
+    static constexpr int kRowStride = kFrameSize + 4;
+    static constexpr int kSineTableSize = 4096;
+
+    static std::array<float, kSineTableSize + 1> buildSineTable() noexcept;
+
+    /** Built during static initialisation so fastSin() inlines to a few instructions with no guard */
+    static inline const std::array<float, kSineTableSize + 1> sineTable_ = buildSineTable();
+
+    int numFrames_ = 0;
+    std::vector<float> data_;   // Levels x frames x kRowStride
+
+    JUCE_DECLARE_NON_COPYABLE(Wavetable)
+};
+
+//==============================================================================
+/**
+ * @class WavetableRenderer
+ * @brief Renders many phase lanes of one wavetable in a single SIMD loop
+ *
+ * Lanes are structure-of-arrays and processed kLaneWidth at a time: phases
+ * advance together, the four cubic control points are gathered per lane,
+ * morphed between the two nearest frames and interpolated with a
+ * Catmull-Rom cubic. Each lane picks its mip level once per block from its
+ * increment. Lanes past numLanes up to the padded count must have zero gain.
+ */
+class WavetableRenderer
+{
+public:
+    static constexpr int kLaneWidth = 4;
+
+    struct Lanes
+    {
+        float* phases = nullptr;                // In [0, 1), advanced in place
+        const float* increments = nullptr;      // Cycles per sample
+        const float* gainsLeft = nullptr;
+        const float* gainsRight = nullptr;
+        int numLanes = 0;                       // Arrays hold numLanes rounded up to kLaneWidth
+    };
+
+    static int paddedLanes(int numLanes) noexcept { return (numLanes + kLaneWidth - 1) / kLaneWidth * kLaneWidth; }
+
+    /**
+     * Adds the lanes' output to left (and right, if not null) for numSamples.
+     * framePosition in [0, 1] morphs across the table's frames.
+     */
+    static void render(const Wavetable& table, float framePosition, const Lanes& lanes,
+                       float* left, float* right, int numSamples) noexcept;
+};
+
+} // namespace oscillators
+} // namespace audio_engine
+} // namespace vital
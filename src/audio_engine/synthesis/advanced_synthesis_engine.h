@@ -18,6 +18,10 @@
 #include <atomic>
 #include <mutex>
 
+#include "modal_bank.h"
+#include "waveguide_bank.h"
+#include "granular_engine.h"
+
 namespace vital {
 namespace audio_engine {
 namespace synthesis {
@@ -56,18 +60,19 @@ public:
         bool enableAdvancedEnvelopes = true;
         
         // Modal synthesis settings
-        int maxModes = 16;
+        int maxModes = ModalBank::kMaxModes;
         float modeDecay = 0.995f;
         
         // Physical modeling settings
-        int stringCount = 4;
+        int stringCount = WaveguideBank::kMaxVoices;
+        float lowestStringFrequency = 27.5f;     // String loops are preallocated down to this note
         int filterOrder = 4;
         bool enableNonLinearities = true;
         
         // Granular synthesis settings
         int grainSize = 1024;
         int grainOverlap = 4;
-        int maxGrains = 64;
+        int maxGrains = GranularEngine::kMaxGrains;
         bool enablePitchShifting = true;
         
         // Hybrid analog settings
@@ -103,13 +108,9 @@ public:
         // Synthesis type
         int synthesisType = 0;
         
-        // State parameters
-        std::vector<float> parameters;
+        // State parameters (inline so voices carry no heap allocation)
+        std::array<float, 128> parameters{};
         std::chrono::steady_clock::time_point startTime;
-        
-        VoiceState() {
-            parameters.resize(128, 0.0f);
-        }
     };
     
     //==============================================================================
@@ -157,6 +158,16 @@ public:
     /** Main processing */
     void process(int numSamples);
     
+    /** Render a sub-block of the current block, starting at startSample */
+    void process(int startSample, int numSamples);
+    
+    /**
+     * Render voices [firstVoice, firstVoice + numVoices) and add them into outputs.
+     * Only touches state owned by those voices, so disjoint ranges may be
+     * rendered concurrently from different threads.
+     */
+    void renderVoices(int firstVoice, int numVoices, float* const* outputs, int numChannels, int numSamples);
+    
     /** Process single sample */
     float processSample(float input, int channel = 0);
     
@@ -272,34 +283,55 @@ private:
     /** Modal synthesis components */
     class ModalSynthesizer {
     public:
-        struct Mode {
-            float frequency = 440.0f;
-            float amplitude = 1.0f;
-            float decay = 0.99f;
-            float phase = 0.0f;
-        };
+        using Mode = ModalBank::Mode;
+        using Material = ModalBank::Material;
+        
+        void initialize(int maxModes, float sampleRate) { bank_.prepare(maxModes, sampleRate); }
         
-        void initialize(int maxModes, float sampleRate);
-        void process(float* output, int numSamples, const std::vector<Mode>& modes);
-        void setMode(int modeId, const Mode& mode);
+        /** Render the bank and add it into output; excitation optionally drives every mode */
+        void process(float* output, int numSamples, const float* excitation = nullptr) noexcept {
+            bank_.process(output, numSamples, excitation);
+        }
+        
+        void setMode(int modeId, const Mode& mode) noexcept { bank_.setMode(modeId, mode); }
+        void setMaterial(Material material, float fundamental, int numModes) noexcept {
+            bank_.setMaterial(material, fundamental, numModes);
+        }
+        void strike(int sampleOffset, float velocity) noexcept { bank_.strike(sampleOffset, velocity); }
+        
+        ModalBank& getBank() noexcept { return bank_; }
         
     private:
-        std::vector<Mode> modes_;
-        float sampleRate_ = 44100.0f;
-        int maxModes_ = 0;
+        ModalBank bank_;
     };
     
     //==============================================================================
     /** Physical modeling components */
     class PhysicalModelingSynthesizer {
     public:
-        void initialize(int stringCount, float sampleRate);
-        void processKarplusStrong(float* output, int numSamples, float frequency, float excitation);
+        using StringSettings = WaveguideBank::StringSettings;
+        
+        /** Preallocates every string loop for notes down to lowestFrequency */
+        void initialize(int stringCount, float lowestFrequency, float sampleRate) {
+            stringCount_ = stringCount;
+            sampleRate_ = sampleRate;
+            strings_.prepare(stringCount, lowestFrequency, sampleRate);
+        }
+        
+        /** Render every sounding string and add it into output */
+        void processKarplusStrong(float* output, int numSamples) noexcept { strings_.process(output, numSamples); }
         void processImpedance(float* output, int numSamples, const std::vector<float>& impedance);
         
+        void pluck(int stringId, float frequency, float velocity, const StringSettings& settings) noexcept {
+            strings_.pluck(stringId, frequency, velocity, settings);
+        }
+        void setStringFrequency(int stringId, float frequency) noexcept { strings_.setFrequency(stringId, frequency); }
+        void releaseString(int stringId) noexcept { strings_.release(stringId); }
+        
+        WaveguideBank& getStrings() noexcept { return strings_; }
+        
     private:
-        std::vector<std::vector<float>> delayLines_;
-        std::vector<float> stringFrequencies_;
+        WaveguideBank strings_;
         int stringCount_ = 0;
         float sampleRate_ = 44100.0f;
     };
@@ -308,22 +340,34 @@ private:
     /** Granular synthesis components */
     class GranularSynthesizer {
     public:
-        struct Grain {
-            float position = 0.0f;
-            float duration = 1.0f;
-            float amplitude = 1.0f;
-            float pitch = 1.0f;
-            bool active = false;
-        };
+        using Grain = GranularEngine::GrainParams;
+        using Cloud = GranularEngine::CloudSettings;
+        
+        /** The grain pool is fixed at GranularEngine::kMaxGrains; grainSize sets the default grain length */
+        void initialize(int maxGrains, int grainSize, float sampleRate) {
+            jassert(maxGrains <= GranularEngine::kMaxGrains);
+            juce::ignoreUnused(maxGrains);
+            grainSize_ = grainSize;
+            sampleRate_ = sampleRate;
+            engine_.prepare(sampleRate);
+        }
+        
+        /** Register a source before playback; not real-time safe */
+        void setSource(int slot, std::shared_ptr<const GrainSource> source) { engine_.setSource(slot, std::move(source)); }
+        
+        /** Render every active grain and add it into left and right (nullptr for mono) */
+        void process(float* left, float* right, int numSamples) noexcept { engine_.process(left, right, numSamples); }
+        
+        /** Queue a grain from any one producer thread; sampleTime 0 starts it at the next block */
+        bool addGrain(const Grain& grain, int64_t sampleTime = 0) noexcept { return engine_.schedule(grain, sampleTime); }
+        bool setCloud(const Cloud& cloud) noexcept { return engine_.setCloud(cloud); }
+        
+        float getDefaultGrainSeconds() const noexcept { return static_cast<float>(grainSize_) / sampleRate_; }
         
-        void initialize(int maxGrains, int grainSize, float sampleRate);
-        void process(float* output, int numSamples, const std::vector<float>& source);
-        void addGrain(const Grain& grain);
+        GranularEngine& getEngine() noexcept { return engine_; }
         
     private:
-        std::vector<Grain> grains_;
-        std::vector<float> grainBuffer_;
-        int maxGrains_ = 0;
+        GranularEngine engine_;
         int grainSize_ = 1024;
         float sampleRate_ = 44100.0f;
     };
@@ -0,0 +1,487 @@
+/*
+  ==============================================================================
+    granular_engine.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of grain sources, the grain pool, scheduling and rendering
+  ==============================================================================
+*/
+
+#include "granular_engine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace synthesis {
+
+namespace {
+
+constexpr uint16_t kEndOfList = static_cast<uint16_t>(GranularEngine::kMaxGrains);
+
+inline int floorToInt(float x) noexcept
+{
+    const int truncated = static_cast<int>(x);
+    return truncated - (x < static_cast<float>(truncated) ? 1 : 0);
+}
+
+} // namespace
+
+//==============================================================================
+// GrainSource
+//==============================================================================
+
+std::shared_ptr<const GrainSource> GrainSource::fromSamples(std::vector<float> samples, double sampleRate)
+{
+    if (samples.size() < 2 || sampleRate <= 0.0) return nullptr;
+
+    auto source = std::make_shared<GrainSource>();
+    source->owned_ = std::move(samples);
+    source->data_ = source->owned_.data();
+    source->length_ = static_cast<int64_t>(source->owned_.size());
+    source->sampleRate_ = sampleRate;
+    return source;
+}
+
+std::shared_ptr<const GrainSource> GrainSource::mapFile(const juce::File& file, double sampleRate, int64_t dataOffset)
+{
+    if (!file.existsAsFile() || sampleRate <= 0.0 || dataOffset < 0 || dataOffset % sizeof(float) != 0)
+        return nullptr;
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    const auto size = static_cast<int64_t>(mapped->getSize());
+    if (mapped->getData() == nullptr || size <= dataOffset) return nullptr;
+
+    const int64_t length = (size - dataOffset) / static_cast<int64_t>(sizeof(float));
+    if (length < 2) return nullptr;
+
+    auto source = std::make_shared<GrainSource>();
+    source->data_ = reinterpret_cast<const float*>(static_cast<const char*>(mapped->getData()) + dataOffset);
+    source->length_ = length;
+    source->sampleRate_ = sampleRate;
+    source->mapped_ = std::move(mapped);
+    return source;
+}
+
+void GrainSource::prefetch() const noexcept
+{
+    constexpr int64_t floatsPerPage = 4096 / static_cast<int64_t>(sizeof(float));
+
+    float sum = 0.0f;
+    for (int64_t i = 0; i < length_; i += floatsPerPage)
+        sum += data_[i];
+
+    // Keeps the reads from being optimised away
+    static std::atomic<float> sink{ 0.0f };
+    sink.store(sum, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+GranularEngine::GranularEngine()
+{
+    for (int window = 0; window < kNumWindows; ++window)
+        buildWindow(static_cast<Window>(window), windows_[static_cast<size_t>(window)].data());
+
+    prepare(sampleRate_);
+}
+
+void GranularEngine::prepare(double sampleRate)
+{
+    jassert(sampleRate > 0.0);
+    sampleRate_ = sampleRate;
+
+    retireAll();
+    numPending_ = 0;
+    queue_.reset();
+
+    cloud_ = {};
+    nextCloudTime_ = 0.0;
+    sampleClock_.store(0, std::memory_order_release);
+    numDropped_.store(0, std::memory_order_relaxed);
+}
+
+void GranularEngine::setSource(int slot, std::shared_ptr<const GrainSource> source)
+{
+    jassert(slot >= 0 && slot < kMaxSources);
+    if (slot >= 0 && slot < kMaxSources)
+        sources_[static_cast<size_t>(slot)] = std::move(source);
+}
+
+void GranularEngine::buildWindow(Window window, float* table) noexcept
+{
+    const float pi = juce::MathConstants<float>::pi;
+
+    for (int k = 0; k <= kWindowSize; ++k) {
+        const float x = static_cast<float>(k) / static_cast<float>(kWindowSize);
+        float value = 0.0f;
+
+        switch (window) {
+            case Window::Hann:
+                value = 0.5f - 0.5f * std::cos(2.0f * pi * x);
+                break;
+
+            case Window::Tukey: {
+                // Flat top with cosine tapers over the outer quarter on each side
+                constexpr float taper = 0.25f;
+                const float edge = std::min(x, 1.0f - x);
+                value = edge >= taper ? 1.0f : 0.5f - 0.5f * std::cos(pi * edge / taper);
+                break;
+            }
+
+            case Window::Gaussian: {
+                // Lifted so both ends reach exactly zero
+                constexpr float width = 0.15f;
+                const auto gauss = [width](float t) { return std::exp(-0.5f * ((t - 0.5f) / width) * ((t - 0.5f) / width)); };
+                value = (gauss(x) - gauss(0.0f)) / (1.0f - gauss(0.0f));
+                break;
+            }
+
+            case Window::Expodec: {
+                // Percussive: a short linear attack into an exponential decay that lands on zero
+                constexpr float attack = 0.02f;
+                constexpr float steepness = 5.0f;
+                if (x < attack) {
+                    value = x / attack;
+                }
+                else {
+                    const float end = std::exp(-steepness);
+                    value = (std::exp(-steepness * (x - attack) / (1.0f - attack)) - end) / (1.0f - end);
+                }
+                break;
+            }
+        }
+
+        table[k] = value;
+    }
+
+    table[0] = 0.0f;
+    table[kWindowSize] = 0.0f;
+    table[kWindowSize + 1] = 0.0f;
+}
+
+//==============================================================================
+// Scheduling
+//==============================================================================
+
+bool GranularEngine::push(const Command& command) noexcept
+{
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    queue_.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0) {
+        if (command.type == Command::Type::Spawn)
+            numDropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    commands_[static_cast<size_t>(size1 > 0 ? start1 : start2)] = command;
+    queue_.finishedWrite(1);
+    return true;
+}
+
+bool GranularEngine::schedule(const GrainParams& grain, int64_t sampleTime) noexcept
+{
+    Command command;
+    command.type = Command::Type::Spawn;
+    command.time = sampleTime;
+    command.grain = grain;
+    return push(command);
+}
+
+bool GranularEngine::setCloud(const CloudSettings& cloud) noexcept
+{
+    Command command;
+    command.type = Command::Type::Cloud;
+    command.cloud = cloud;
+    return push(command);
+}
+
+bool GranularEngine::stopAll() noexcept
+{
+    Command command;
+    command.type = Command::Type::StopAll;
+    return push(command);
+}
+
+void GranularEngine::drainCommands() noexcept
+{
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    queue_.prepareToRead(queue_.getNumReady(), start1, size1, start2, size2);
+
+    const auto handle = [this](const Command& command) {
+        switch (command.type) {
+            case Command::Type::Spawn:
+                if (numPending_ < kMaxPending)
+                    pending_[static_cast<size_t>(numPending_++)] = { command.time, command.grain };
+                else
+                    numDropped_.fetch_add(1, std::memory_order_relaxed);
+                break;
+
+            case Command::Type::Cloud:
+                // A cloud that was off starts now rather than catching up
+                if (command.cloud.enabled && !cloud_.enabled)
+                    nextCloudTime_ = static_cast<double>(sampleClock_.load(std::memory_order_relaxed));
+                cloud_ = command.cloud;
+                break;
+
+            case Command::Type::StopAll:
+                retireAll();
+                numPending_ = 0;
+                break;
+        }
+    };
+
+    for (int i = 0; i < size1; ++i)
+        handle(commands_[static_cast<size_t>(start1 + i)]);
+    for (int i = 0; i < size2; ++i)
+        handle(commands_[static_cast<size_t>(start2 + i)]);
+
+    queue_.finishedRead(size1 + size2);
+}
+
+//==============================================================================
+// Pool
+//==============================================================================
+
+void GranularEngine::retireAll() noexcept
+{
+    for (int i = 0; i < kMaxGrains; ++i)
+        grains_[static_cast<size_t>(i)].next = static_cast<uint16_t>(i + 1);
+
+    freeHead_ = 0;
+    numActiveGrains_ = 0;
+    numActive_.store(0, std::memory_order_relaxed);
+}
+
+void GranularEngine::spawn(const GrainParams& params, int offset) noexcept
+{
+    const GrainSource* source = params.source >= 0 && params.source < kMaxSources
+                                    ? sources_[static_cast<size_t>(params.source)].get()
+                                    : nullptr;
+
+    if (source == nullptr || freeHead_ == kEndOfList) {
+        numDropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto index = static_cast<uint16_t>(freeHead_);
+    Grain& grain = grains_[index];
+    freeHead_ = grain.next;
+
+    const double durationSamples = std::max(1.0, static_cast<double>(params.durationSeconds) * sampleRate_);
+    const float angle = 0.25f * juce::MathConstants<float>::pi * (juce::jlimit(-1.0f, 1.0f, params.pan) + 1.0f);
+
+    grain.position = juce::jlimit(0.0, static_cast<double>(source->getLength() - 1), params.position);
+    grain.increment = params.pitch * static_cast<float>(source->getSampleRate() / sampleRate_);
+    grain.windowPhase = 0.0f;
+    grain.windowIncrement = static_cast<float>(kWindowSize / durationSamples);
+    grain.gainLeft = params.amplitude * std::cos(angle);
+    grain.gainRight = params.amplitude * std::sin(angle);
+    grain.startOffset = std::max(0, offset);
+    grain.window = static_cast<uint8_t>(params.window);
+    grain.source = static_cast<uint8_t>(params.source);
+
+    active_[static_cast<size_t>(numActiveGrains_++)] = index;
+}
+
+void GranularEngine::spawnCloudGrain(int offset) noexcept
+{
+    const GrainSource* source = sources_[static_cast<size_t>(juce::jlimit(0, kMaxSources - 1, cloud_.source))].get();
+    if (source == nullptr) return;
+
+    GrainParams grain;
+    grain.source = cloud_.source;
+    grain.durationSeconds = std::max(0.001f, cloud_.durationSeconds * (1.0f + cloud_.durationJitter * random_.nextBipolar()));
+    grain.position = juce::jlimit(0.0f, 1.0f, cloud_.position + cloud_.positionJitter * random_.nextBipolar())
+                   * static_cast<double>(source->getLength() - 1);
+    grain.pitch = cloud_.pitch * std::exp2(cloud_.pitchJitter * random_.nextBipolar() / 12.0f);
+    grain.amplitude = cloud_.amplitude;
+    grain.pan = cloud_.panSpread * random_.nextBipolar();
+    grain.window = cloud_.window;
+
+    spawn(grain, offset);
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void GranularEngine::process(float* left, float* right, int numSamples) noexcept
+{
+    drainCommands();
+
+    const bool stereo = right != nullptr;
+    const int64_t clock = sampleClock_.load(std::memory_order_relaxed);
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += kChunk) {
+        const int chunk = std::min(kChunk, numSamples - chunkStart);
+        const int64_t chunkTime = clock + chunkStart;
+        const int64_t chunkEnd = chunkTime + chunk;
+
+        // Scheduled grains due in this chunk, at their sample
+        for (int i = 0; i < numPending_;) {
+            const Pending& due = pending_[static_cast<size_t>(i)];
+            if (due.time < chunkEnd) {
+                spawn(due.grain, static_cast<int>(std::max<int64_t>(0, due.time - chunkTime)));
+                pending_[static_cast<size_t>(i)] = pending_[static_cast<size_t>(--numPending_)];
+            }
+            else {
+                ++i;
+            }
+        }
+
+        // Cloud grains
+        if (cloud_.enabled && cloud_.density > 0.0f) {
+            const double mean = sampleRate_ / static_cast<double>(cloud_.density);
+            const float randomness = juce::jlimit(0.0f, 1.0f, cloud_.randomTiming);
+            nextCloudTime_ = std::max(nextCloudTime_, static_cast<double>(chunkTime));
+
+            while (nextCloudTime_ < static_cast<double>(chunkEnd)) {
+                spawnCloudGrain(static_cast<int>(nextCloudTime_ - static_cast<double>(chunkTime)));
+
+                // Blend of a fixed period and an exponential interval with the same mean
+                const float exponential = -std::log(1.0f - random_.nextFloat());
+                nextCloudTime_ += std::max(1.0, mean * ((1.0f - randomness) + randomness * exponential));
+            }
+        }
+
+        std::fill(mixLeft_.begin(), mixLeft_.begin() + chunk, 0.0f);
+        if (stereo)
+            std::fill(mixRight_.begin(), mixRight_.begin() + chunk, 0.0f);
+
+        for (int i = 0; i < numActiveGrains_; ++i)
+            renderGrain(grains_[active_[static_cast<size_t>(i)]], chunk, stereo);
+
+        for (int i = 0; i < chunk; ++i)
+            left[chunkStart + i] += mixLeft_[static_cast<size_t>(i)];
+
+        if (stereo) {
+            for (int i = 0; i < chunk; ++i)
+                right[chunkStart + i] += mixRight_[static_cast<size_t>(i)];
+        }
+
+        advanceGrains(chunk);
+    }
+
+    sampleClock_.store(clock + numSamples, std::memory_order_release);
+    numActive_.store(numActiveGrains_, std::memory_order_relaxed);
+}
+
+void GranularEngine::renderGrain(const Grain& grain, int numSamples, bool stereo) noexcept
+{
+    const int begin = grain.startOffset;
+    const float windowEnd = static_cast<float>(kWindowSize);
+
+    // Samples left in the window, clipped to the chunk
+    const float remaining = std::ceil((windowEnd - grain.windowPhase) / grain.windowIncrement);
+    const int count = std::min(numSamples - begin, static_cast<int>(std::min(remaining, static_cast<float>(numSamples))));
+    if (count <= 0) return;
+
+    const GrainSource& source = *sources_[grain.source];
+    const float* window = windows_[grain.window].data();
+
+    // Rebase on the grain's current sample so offsets within the chunk stay small floats
+    const int64_t last = source.getLength() - 2;
+    const int64_t base = juce::jlimit<int64_t>(0, last, static_cast<int64_t>(std::floor(grain.position)));
+    const float* samples = source.getData() + base;
+    const float fraction = static_cast<float>(grain.position - static_cast<double>(base));
+
+    const float increment = grain.increment;
+    const float phase = grain.windowPhase;
+    const float phaseIncrement = grain.windowIncrement;
+
+    float gainLeft = grain.gainLeft;
+    float gainRight = grain.gainRight;
+    if (!stereo) {
+        // Both sides folded so a centred grain keeps its amplitude
+        gainLeft = (gainLeft + gainRight) * juce::MathConstants<float>::sqrt2 * 0.5f;
+        gainRight = 0.0f;
+    }
+
+    float* left = mixLeft_.data() + begin;
+    float* right = mixRight_.data() + begin;
+
+    // Clamp the source reads only if this run leaves the source
+    const float firstOffset = fraction;
+    const float lastOffset = fraction + static_cast<float>(count - 1) * increment;
+    const auto lowest = static_cast<float>(-base);
+    const auto highest = static_cast<float>(last - base);
+    const bool inside = std::min(firstOffset, lastOffset) >= lowest && std::max(firstOffset, lastOffset) < highest;
+
+    const auto render = [&](auto clampReads, auto writeRight) {
+        alignas(32) float w0[kChunk], w1[kChunk], wf[kChunk], s0[kChunk], s1[kChunk], sf[kChunk];
+
+        // Positions and fractions are affine in the sample index and vectorise
+        for (int i = 0; i < count; ++i) {
+            const float t = static_cast<float>(i);
+            wf[i] = std::min(phase + t * phaseIncrement, windowEnd);
+
+            float offset = fraction + t * increment;
+            if constexpr (decltype(clampReads)::value)
+                offset = std::min(std::max(offset, lowest), highest);
+            sf[i] = offset;
+        }
+
+        // Window and source reads
+        for (int i = 0; i < count; ++i) {
+            const int windowIndex = static_cast<int>(wf[i]);
+            wf[i] -= static_cast<float>(windowIndex);
+            w0[i] = window[windowIndex];
+            w1[i] = window[windowIndex + 1];
+
+            const int index = floorToInt(sf[i]);
+            sf[i] -= static_cast<float>(index);
+            s0[i] = samples[index];
+            s1[i] = samples[index + 1];
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const float gain = w0[i] + wf[i] * (w1[i] - w0[i]);
+            const float value = gain * (s0[i] + sf[i] * (s1[i] - s0[i]));
+
+            left[i] += value * gainLeft;
+            if constexpr (decltype(writeRight)::value)
+                right[i] += value * gainRight;
+        }
+    };
+
+    if (inside) {
+        if (stereo) render(std::false_type{}, std::true_type{});
+        else        render(std::false_type{}, std::false_type{});
+    }
+    else {
+        if (stereo) render(std::true_type{}, std::true_type{});
+        else        render(std::true_type{}, std::false_type{});
+    }
+}
+
+void GranularEngine::advanceGrains(int numSamples) noexcept
+{
+    for (int i = 0; i < numActiveGrains_;) {
+        const uint16_t index = active_[static_cast<size_t>(i)];
+        Grain& grain = grains_[index];
+
+        const int elapsed = numSamples - grain.startOffset;
+        if (elapsed > 0) {
+            grain.position += static_cast<double>(elapsed) * grain.increment;
+            grain.windowPhase += static_cast<float>(elapsed) * grain.windowIncrement;
+        }
+        grain.startOffset = std::max(0, grain.startOffset - numSamples);
+
+        if (grain.windowPhase >= static_cast<float>(kWindowSize)) {
+            grain.next = static_cast<uint16_t>(freeHead_);
+            freeHead_ = index;
+            active_[static_cast<size_t>(i)] = active_[static_cast<size_t>(--numActiveGrains_)];
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+} // namespace synthesis
+} // namespace audio_engine
+} // namespace vital
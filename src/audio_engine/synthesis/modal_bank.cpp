@@ -0,0 +1,432 @@
+/*
+  ==============================================================================
+    modal_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the modal resonator bank and its material presets
+  ==============================================================================
+*/
+
+#include "modal_bank.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace synthesis {
+
+namespace {
+
+constexpr int kLanes = ModalBank::kLaneWidth;
+
+/** ln(1000): a T60 decay of t seconds is a per-sample radius of exp(-kLn1000 / (t * rate)) */
+constexpr float kLn1000 = 6.90775528f;
+
+/** Measured church bell partials relative to the prime: hum, prime, tierce, quint, nominal and above */
+constexpr float kBellRatios[] = { 0.5f, 1.0f, 1.183f, 1.506f, 2.0f, 2.514f,
+                                  2.662f, 3.011f, 4.166f, 5.433f, 6.796f, 8.215f };
+constexpr int kNumBellRatios = static_cast<int>(sizeof(kBellRatios) / sizeof(kBellRatios[0]));
+
+/** Modes ringing for less than this are an inaudible click, and their radius would underflow */
+constexpr float kMinDecaySeconds = 0.002f;
+
+/** Plate and membrane modes come from an m x n grid; 32 x 32 covers kMaxModes */
+constexpr int kGridSize = 32;
+constexpr float kPlateAspectSquared = 1.37f * 1.37f;
+
+/**
+ * Coupled-form resonators for one lane group. Each sample the state rotates
+ * by r * e^(jw), the excitation is added through the mode's complex gain,
+ * and the imaginary part is the output.
+ */
+template <bool Driven>
+void renderLanes(float* real, float* imaginary, const float* rotationCos, const float* rotationSin,
+                 const float* exciteReal, const float* exciteImaginary,
+                 float* mix, const float* excitation, int numSamples) noexcept
+{
+    alignas(32) float re[kLanes], im[kLanes], c[kLanes], s[kLanes], er[kLanes], ei[kLanes];
+    for (int lane = 0; lane < kLanes; ++lane) {
+        re[lane] = real[lane];
+        im[lane] = imaginary[lane];
+        c[lane] = rotationCos[lane];
+        s[lane] = rotationSin[lane];
+        er[lane] = exciteReal[lane];
+        ei[lane] = exciteImaginary[lane];
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float x = Driven ? excitation[i] : 0.0f;
+        float* out = mix + static_cast<size_t>(i) * kLanes;
+
+        for (int lane = 0; lane < kLanes; ++lane) {
+            float nextRe = c[lane] * re[lane] - s[lane] * im[lane];
+            float nextIm = s[lane] * re[lane] + c[lane] * im[lane];
+            if constexpr (Driven) {
+                nextRe += x * er[lane];
+                nextIm += x * ei[lane];
+            }
+            re[lane] = nextRe;
+            im[lane] = nextIm;
+            out[lane] += nextIm;
+        }
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        real[lane] = re[lane];
+        imaginary[lane] = im[lane];
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// Presets
+//==============================================================================
+
+ModalBank::MaterialPreset ModalBank::getPreset(Material material) noexcept
+{
+    switch (material) {
+        case Material::Wood:     return { ModeLayout::Bar, 0.6f, 1.6f, 0.6f };
+        case Material::Metal:    return { ModeLayout::Bar, 4.0f, 0.6f, 1.5f };
+        case Material::Glass:    return { ModeLayout::Shell, 2.5f, 1.0f, 1.2f };
+        case Material::Bell:     return { ModeLayout::Bell, 8.0f, 0.8f, 1.0f };
+        case Material::Plate:    return { ModeLayout::Plate, 5.0f, 0.9f, 1.2f };
+        case Material::Membrane: return { ModeLayout::Membrane, 0.8f, 1.2f, 0.8f };
+    }
+    return {};
+}
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void ModalBank::prepare(int maxModes, double sampleRate)
+{
+    jassert(maxModes > 0 && maxModes <= kMaxModes && sampleRate > 0.0);
+
+    maxModes_ = juce::jlimit(1, kMaxModes, maxModes);
+    sampleRate_ = static_cast<float>(sampleRate);
+
+    const int groups = (maxModes_ + kLaneWidth - 1) / kLaneWidth;
+    const size_t padded = static_cast<size_t>(groups * kLaneWidth);
+
+    modes_.assign(static_cast<size_t>(maxModes_), Mode{});
+    real_.assign(padded, 0.0f);
+    imaginary_.assign(padded, 0.0f);
+    rotationCos_.assign(padded, 0.0f);
+    rotationSin_.assign(padded, 0.0f);
+    exciteReal_.assign(padded, 0.0f);
+    exciteImaginary_.assign(padded, 0.0f);
+    groupRinging_.assign(static_cast<size_t>(groups), 0);
+    groupAudible_.assign(static_cast<size_t>(groups), 0);
+
+    numStrikes_ = 0;
+    numActiveGroups_ = 0;
+    setNumModes(numModes_ == 0 ? maxModes_ : numModes_);
+}
+
+void ModalBank::setSampleRate(double sampleRate) noexcept
+{
+    jassert(sampleRate > 0.0);
+
+    sampleRate_ = static_cast<float>(sampleRate);
+    for (int i = 0; i < maxModes_; ++i)
+        updateCoefficients(i);
+}
+
+void ModalBank::setMode(int index, const Mode& mode) noexcept
+{
+    jassert(index >= 0 && index < maxModes_);
+    if (index < 0 || index >= maxModes_) return;
+
+    modes_[static_cast<size_t>(index)] = mode;
+    updateCoefficients(index);
+}
+
+void ModalBank::setNumModes(int numModes) noexcept
+{
+    numModes_ = juce::jlimit(0, maxModes_, numModes);
+
+    for (int i = 0; i < maxModes_; ++i) {
+        updateCoefficients(i);
+        if (i >= numModes_) {
+            real_[static_cast<size_t>(i)] = 0.0f;
+            imaginary_[static_cast<size_t>(i)] = 0.0f;
+        }
+    }
+}
+
+void ModalBank::setMaterial(const MaterialPreset& preset, float fundamental, int numModes) noexcept
+{
+    numModes = juce::jlimit(0, maxModes_, numModes);
+
+    std::array<float, kMaxModes> ratios{};
+
+    if (preset.layout == ModeLayout::Plate || preset.layout == ModeLayout::Membrane) {
+        // Lowest numModes of the (m, n) grid, relative to the (1, 1) mode
+        std::array<float, kGridSize * kGridSize> grid{};
+        for (int m = 1; m <= kGridSize; ++m) {
+            for (int n = 1; n <= kGridSize; ++n) {
+                const float value = static_cast<float>(m * m) + static_cast<float>(n * n) / kPlateAspectSquared;
+                grid[static_cast<size_t>((m - 1) * kGridSize + n - 1)] = value;
+            }
+        }
+
+        const auto middle = grid.begin() + numModes;
+        std::partial_sort(grid.begin(), middle, grid.end());
+
+        const float lowest = grid[0];
+        for (int k = 0; k < numModes; ++k) {
+            const float ratio = grid[static_cast<size_t>(k)] / lowest;
+            ratios[static_cast<size_t>(k)] = preset.layout == ModeLayout::Plate ? ratio : std::sqrt(ratio);
+        }
+    }
+    else {
+        for (int k = 0; k < numModes; ++k) {
+            const float index = static_cast<float>(k);
+            float ratio = 1.0f;
+
+            switch (preset.layout) {
+                case ModeLayout::Harmonic:
+                    ratio = index + 1.0f;
+                    break;
+
+                case ModeLayout::Bar: {
+                    // Free-free beam: (2k + 3) / 3.0112 squared, with the exact first root
+                    const float beta = k == 0 ? 3.0112f : 2.0f * index + 3.0f;
+                    ratio = (beta / 3.0112f) * (beta / 3.0112f);
+                    break;
+                }
+
+                case ModeLayout::Shell: {
+                    // Ring bending modes n(n^2 - 1) / sqrt(n^2 + 1) from n = 2
+                    const auto shell = [](float n) { return n * (n * n - 1.0f) / std::sqrt(n * n + 1.0f); };
+                    ratio = shell(index + 2.0f) / shell(2.0f);
+                    break;
+                }
+
+                case ModeLayout::Bell:
+                    ratio = k < kNumBellRatios
+                                ? kBellRatios[k]
+                                : kBellRatios[kNumBellRatios - 1] * std::pow((index + 1.0f) / static_cast<float>(kNumBellRatios), 1.6f);
+                    break;
+
+                case ModeLayout::Plate:
+                case ModeLayout::Membrane:
+                    break;
+            }
+
+            ratios[static_cast<size_t>(k)] = ratio;
+        }
+    }
+
+    // Amplitudes roll off with frequency; normalised so a unit strike never peaks above one
+    const float rolloff = 1.0f / std::max(0.05f, preset.brightness);
+    float sum = 0.0f;
+    for (int k = 0; k < numModes; ++k)
+        sum += std::pow(ratios[static_cast<size_t>(k)], -rolloff);
+    const float normalise = 1.0f / std::max(sum, 1.0e-6f);
+
+    for (int k = 0; k < numModes; ++k) {
+        const float ratio = ratios[static_cast<size_t>(k)];
+
+        Mode& mode = modes_[static_cast<size_t>(k)];
+        mode.frequency = fundamental * ratio;
+        mode.amplitude = std::pow(ratio, -rolloff) * normalise;
+        mode.decaySeconds = preset.decaySeconds * std::pow(ratio, -preset.damping);
+        mode.phase = 0.0f;
+    }
+
+    setNumModes(numModes);
+}
+
+void ModalBank::updateCoefficients(int index) noexcept
+{
+    const auto i = static_cast<size_t>(index);
+    const Mode& mode = modes_[i];
+
+    // Modes past the count, at or above Nyquist, silent or dying within a few milliseconds never ring
+    const bool audible = index < numModes_
+                      && mode.frequency > 0.0f && mode.frequency < 0.49f * sampleRate_
+                      && mode.amplitude != 0.0f && mode.decaySeconds >= kMinDecaySeconds;
+
+    if (audible) {
+        const float radius = std::exp(-kLn1000 / (mode.decaySeconds * sampleRate_));
+        const float omega = juce::MathConstants<float>::twoPi * mode.frequency / sampleRate_;
+        rotationCos_[i] = radius * std::cos(omega);
+        rotationSin_[i] = radius * std::sin(omega);
+        exciteReal_[i] = mode.amplitude * std::cos(mode.phase);
+        exciteImaginary_[i] = mode.amplitude * std::sin(mode.phase);
+    }
+    else {
+        rotationCos_[i] = rotationSin_[i] = 0.0f;
+        exciteReal_[i] = exciteImaginary_[i] = 0.0f;
+    }
+
+    const int group = index / kLaneWidth;
+    const size_t first = static_cast<size_t>(group * kLaneWidth);
+    bool groupAudible = false;
+    for (size_t lane = first; lane < first + kLaneWidth; ++lane)
+        groupAudible = groupAudible || exciteReal_[lane] != 0.0f || exciteImaginary_[lane] != 0.0f;
+    groupAudible_[static_cast<size_t>(group)] = groupAudible ? 1 : 0;
+}
+
+//==============================================================================
+// Excitation
+//==============================================================================
+
+void ModalBank::strike(int sampleOffset, float velocity) noexcept
+{
+    if (numStrikes_ == kMaxStrikes) return;
+    strikes_[static_cast<size_t>(numStrikes_++)] = { std::max(0, sampleOffset), velocity };
+}
+
+void ModalBank::reset() noexcept
+{
+    std::fill(real_.begin(), real_.end(), 0.0f);
+    std::fill(imaginary_.begin(), imaginary_.end(), 0.0f);
+    std::fill(groupRinging_.begin(), groupRinging_.end(), 0);
+    numStrikes_ = 0;
+    numActiveGroups_ = 0;
+}
+
+void ModalBank::applyStrike(float velocity) noexcept
+{
+    if (velocity == 0.0f) return;
+
+    for (int group = 0; group < numGroups(); ++group) {
+        if (!groupAudible_[static_cast<size_t>(group)]) continue;
+
+        const size_t first = static_cast<size_t>(group * kLaneWidth);
+        for (size_t lane = first; lane < first + kLaneWidth; ++lane) {
+            real_[lane] += velocity * exciteReal_[lane];
+            imaginary_[lane] += velocity * exciteImaginary_[lane];
+        }
+        groupRinging_[static_cast<size_t>(group)] = 1;
+    }
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void ModalBank::process(float* output, int numSamples, const float* excitation) noexcept
+{
+    // Strikes in offset order; the list is tiny, so insertion sort
+    for (int i = 1; i < numStrikes_; ++i) {
+        for (int j = i; j > 0 && strikes_[static_cast<size_t>(j)].offset < strikes_[static_cast<size_t>(j - 1)].offset; --j)
+            std::swap(strikes_[static_cast<size_t>(j)], strikes_[static_cast<size_t>(j - 1)]);
+    }
+
+    const int groups = numGroups();
+    std::array<uint8_t, kMaxModes / kLaneWidth> rendered{};
+    int nextStrike = 0;
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += kChunk) {
+        const int chunk = std::min(kChunk, numSamples - chunkStart);
+        std::fill(laneMix_.begin(), laneMix_.begin() + chunk * kLaneWidth, 0.0f);
+
+        int position = 0;
+        while (position < chunk) {
+            // Strikes due now, including any past the end of the block on its last sample
+            while (nextStrike < numStrikes_) {
+                const int offset = std::min(strikes_[static_cast<size_t>(nextStrike)].offset, numSamples - 1);
+                if (offset > chunkStart + position) break;
+                applyStrike(strikes_[static_cast<size_t>(nextStrike++)].velocity);
+            }
+
+            int end = chunk;
+            if (nextStrike < numStrikes_)
+                end = std::min(end, std::min(strikes_[static_cast<size_t>(nextStrike)].offset, numSamples - 1) - chunkStart);
+
+            const int length = end - position;
+            const float* drive = excitation != nullptr ? excitation + chunkStart + position : nullptr;
+
+            // A non-silent excitation signal wakes every audible group
+            if (drive != nullptr) {
+                bool driven = false;
+                for (int i = 0; i < length && !driven; ++i)
+                    driven = drive[i] != 0.0f;
+
+                if (driven) {
+                    for (int group = 0; group < groups; ++group)
+                        groupRinging_[static_cast<size_t>(group)] |= groupAudible_[static_cast<size_t>(group)];
+                }
+                else {
+                    drive = nullptr;
+                }
+            }
+
+            for (int group = 0; group < groups; ++group) {
+                if (!groupRinging_[static_cast<size_t>(group)]) continue;
+
+                renderGroup(group, laneMix_.data() + static_cast<size_t>(position) * kLaneWidth, drive, length);
+                rendered[static_cast<size_t>(group)] = 1;
+            }
+
+            position = end;
+        }
+
+        // Fold the lanes of each sample into the output
+        for (int i = 0; i < chunk; ++i) {
+            const float* lanes = laneMix_.data() + static_cast<size_t>(i) * kLaneWidth;
+            float sum = 0.0f;
+            for (int lane = 0; lane < kLaneWidth; ++lane)
+                sum += lanes[lane];
+            output[chunkStart + i] += sum;
+        }
+
+        cullSilentGroups();
+    }
+
+    numStrikes_ = 0;
+    numActiveGroups_ = 0;
+    for (int group = 0; group < groups; ++group)
+        numActiveGroups_ += rendered[static_cast<size_t>(group)];
+}
+
+void ModalBank::renderGroup(int group, float* mix, const float* excitation, int numSamples) noexcept
+{
+    const size_t first = static_cast<size_t>(group * kLaneWidth);
+
+    if (excitation != nullptr) {
+        renderLanes<true>(real_.data() + first, imaginary_.data() + first,
+                          rotationCos_.data() + first, rotationSin_.data() + first,
+                          exciteReal_.data() + first, exciteImaginary_.data() + first,
+                          mix, excitation, numSamples);
+    }
+    else {
+        renderLanes<false>(real_.data() + first, imaginary_.data() + first,
+                           rotationCos_.data() + first, rotationSin_.data() + first,
+                           exciteReal_.data() + first, exciteImaginary_.data() + first,
+                           mix, nullptr, numSamples);
+    }
+}
+
+void ModalBank::cullSilentGroups() noexcept
+{
+    constexpr float threshold = kSilenceThreshold * kSilenceThreshold;
+
+    for (int group = 0; group < numGroups(); ++group) {
+        if (!groupRinging_[static_cast<size_t>(group)]) continue;
+
+        // Silent lanes are zeroed one by one, which also keeps fast modes out of denormals
+        const size_t first = static_cast<size_t>(group * kLaneWidth);
+        bool ringing = false;
+        for (size_t lane = first; lane < first + kLaneWidth; ++lane) {
+            if (real_[lane] * real_[lane] + imaginary_[lane] * imaginary_[lane] < threshold) {
+                real_[lane] = 0.0f;
+                imaginary_[lane] = 0.0f;
+            }
+            else {
+                ringing = true;
+            }
+        }
+
+        groupRinging_[static_cast<size_t>(group)] = ringing ? 1 : 0;
+    }
+}
+
+} // namespace synthesis
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+    modal_bank.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Structure-of-arrays bank of coupled-form resonators for modal synthesis
+    with hundreds of modes
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace synthesis {
+
+//==============================================================================
+/**
+ * @class ModalBank
+ * @brief Up to kMaxModes decaying resonators rendered kLaneWidth modes at a time
+ *
+ * Each mode is a coupled-form (complex rotation) resonator: its state is
+ * multiplied by r * e^(jw) every sample. The form is stable for any decay
+ * below one, and it keeps its tuning down to very low frequencies, where a
+ * direct-form biquad loses precision. The rotation, decay and excitation
+ * gains live in separate arrays padded to whole lane groups, so the kernel
+ * is straight-line arithmetic across kLaneWidth modes that the compiler
+ * turns into SIMD.
+ *
+ * Excitation is sample accurate. strike() events split the block at their
+ * offsets, and an optional excitation signal drives every mode sample by
+ * sample. Material presets lay out mode ratios, amplitudes and
+ * frequency-dependent decay for common resonating bodies.
+ *
+ * Culling works at two levels. Modes above Nyquist, with no amplitude or
+ * with a decay of a few milliseconds never make a group audible. Modes that
+ * have decayed below the silence threshold are zeroed, and a group with no
+ * ringing modes is skipped until it is excited again.
+ * Presets lay modes out in ascending frequency, so the fast-decaying high
+ * modes share groups and drop out first.
+ */
+class ModalBank
+{
+public:
+    //==============================================================================
+    static constexpr int kLaneWidth = 8;
+    static constexpr int kMaxModes = 256;
+
+    /** One resonant mode */
+    struct Mode
+    {
+        float frequency = 440.0f;       // Hz
+        float amplitude = 1.0f;         // Response to a unit strike
+        float decaySeconds = 1.0f;      // Time to fall 60 dB
+        float phase = 0.0f;             // Starting phase of the response, radians
+    };
+
+    /** How the body's modes are spaced relative to the fundamental */
+    enum class ModeLayout
+    {
+        Harmonic,       // Ideal string or tube
+        Bar,            // Free-free beam: marimba, xylophone, glockenspiel
+        Plate,          // Simply supported rectangular plate
+        Membrane,       // Rectangular membrane
+        Shell,          // Bending modes of a thin ring or glass
+        Bell            // Tuned church bell partials, then a stretched series
+    };
+
+    enum class Material { Wood, Metal, Glass, Bell, Plate, Membrane };
+
+    /** Layout and damping of a material */
+    struct MaterialPreset
+    {
+        ModeLayout layout = ModeLayout::Harmonic;
+        float decaySeconds = 1.0f;      // T60 of the fundamental
+        float damping = 1.0f;           // T60 falls with (f / f0)^damping
+        float brightness = 1.0f;        // Amplitude falls with (f / f0)^-(1 / brightness)
+    };
+
+    static MaterialPreset getPreset(Material material) noexcept;
+
+    //==============================================================================
+    ModalBank() = default;
+
+    /** Size the mode arrays. Not real-time safe. */
+    void prepare(int maxModes, double sampleRate);
+
+    void setSampleRate(double sampleRate) noexcept;
+
+    /** Set one mode; coefficients are recomputed but the ringing state is kept */
+    void setMode(int index, const Mode& mode) noexcept;
+
+    /** Lay out numModes modes of a material above fundamental */
+    void setMaterial(const MaterialPreset& preset, float fundamental, int numModes) noexcept;
+    void setMaterial(Material material, float fundamental, int numModes) noexcept
+    {
+        setMaterial(getPreset(material), fundamental, numModes);
+    }
+
+    /** Modes beyond numModes are silent and never processed */
+    void setNumModes(int numModes) noexcept;
+    int getNumModes() const noexcept { return numModes_; }
+
+    const Mode& getMode(int index) const noexcept { return modes_[static_cast<size_t>(index)]; }
+
+    //==============================================================================
+    /**
+     * Strike every mode with velocity at sampleOffset into the next process()
+     * call. Up to kMaxStrikes strikes per block; later ones are dropped.
+     */
+    void strike(int sampleOffset, float velocity) noexcept;
+
+    /** Silence every mode immediately */
+    void reset() noexcept;
+
+    /**
+     * Render numSamples and add them into output. excitation, if given,
+     * drives every mode with its samples in addition to any strikes.
+     */
+    void process(float* output, int numSamples, const float* excitation = nullptr) noexcept;
+
+    //==============================================================================
+    /** Lane groups that rendered in the last block, for profiling culling */
+    int getNumActiveGroups() const noexcept { return numActiveGroups_; }
+
+    /** Modes whose group rendered in the last block */
+    int getNumActiveModes() const noexcept { return numActiveGroups_ * kLaneWidth; }
+
+private:
+    //==============================================================================
+    static constexpr int kMaxStrikes = 32;
+    static constexpr int kChunk = 256;
+    static constexpr float kSilenceThreshold = 1.0e-5f;     // -100 dB, amplitude
+
+    struct Strike
+    {
+        int offset = 0;
+        float velocity = 0.0f;
+    };
+
+    void updateCoefficients(int index) noexcept;
+    void applyStrike(float velocity) noexcept;
+    void renderGroup(int group, float* mix, const float* excitation, int numSamples) noexcept;
+    void cullSilentGroups() noexcept;
+
+    int numGroups() const noexcept { return (numModes_ + kLaneWidth - 1) / kLaneWidth; }
+
+    int maxModes_ = 0;
+    int numModes_ = 0;
+    float sampleRate_ = 44100.0f;
+    int numActiveGroups_ = 0;
+
+    std::vector<Mode> modes_;
+
+    /** Per mode, padded to whole groups: state, rotation r * e^(jw), and strike gains */
+    std::vector<float> real_, imaginary_;
+    std::vector<float> rotationCos_, rotationSin_;
+    std::vector<float> exciteReal_, exciteImaginary_;
+
+    /** Groups currently ringing, and groups that can ring at all */
+    std::vector<uint8_t> groupRinging_, groupAudible_;
+
+    std::array<Strike, kMaxStrikes> strikes_{};
+    int numStrikes_ = 0;
+
+    /** Per-sample lane accumulators, kChunk x kLaneWidth */
+    alignas(32) std::array<float, kChunk * kLaneWidth> laneMix_{};
+
+    JUCE_DECLARE_NON_COPYABLE(ModalBank)
+};
+
+} // namespace synthesis
+} // namespace audio_engine
+} // namespace vital
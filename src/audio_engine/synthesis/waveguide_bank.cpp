@@ -0,0 +1,413 @@
+/*
+  ==============================================================================
+    waveguide_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the waveguide string bank
+  ==============================================================================
+*/
+
+#include "waveguide_bank.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vital {
+namespace audio_engine {
+namespace synthesis {
+
+namespace {
+
+constexpr int kLanes = WaveguideBank::kLaneWidth;
+
+/** Strongest dispersion allpass coefficient; closer to -1 rings at Nyquist */
+constexpr float kMaxDispersion = 0.85f;
+
+/** Bisection steps when a high note must weaken the dispersion to fit its period */
+constexpr int kDispersionSearchSteps = 16;
+
+/** At brightness 0 the top of the spectrum decays this much faster than the fundamental */
+constexpr float kDarkestDecayRatio = 0.001f;
+
+/** Phase delay in samples of the first-order allpass (c + z^-1) / (1 + c z^-1) at omega */
+float allpassPhaseDelay(float c, float omega) noexcept
+{
+    const float phase = -std::atan2(std::sin(omega), c + std::cos(omega))
+                      + std::atan2(c * std::sin(omega), 1.0f + c * std::cos(omega));
+    return -phase / omega;
+}
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void WaveguideBank::prepare(int maxVoices, float lowestFrequency, double sampleRate)
+{
+    jassert(maxVoices > 0 && maxVoices <= kMaxVoices && lowestFrequency > 0.0f && sampleRate > 0.0);
+
+    maxVoices_ = juce::jlimit(1, kMaxVoices, maxVoices);
+    numGroups_ = (maxVoices_ + kLaneWidth - 1) / kLaneWidth;
+    sampleRate_ = static_cast<float>(sampleRate);
+    lowestFrequency_ = std::max(1.0f, lowestFrequency);
+
+    // Longest period plus headroom for the filters' phase delay, rounded up to a power of two
+    const int longest = static_cast<int>(std::ceil(sampleRate_ / lowestFrequency_)) + 8;
+    ringSize_ = 1;
+    while (ringSize_ < longest)
+        ringSize_ <<= 1;
+    ringMask_ = static_cast<uint32_t>(ringSize_ - 1);
+    writeIndex_ = 0;
+
+    const size_t padded = static_cast<size_t>(numGroups_ * kLaneWidth);
+    rings_.assign(padded * static_cast<size_t>(ringSize_), 0.0f);
+
+    for (auto* array : { &frequency_, &decaySeconds_, &brightness_, &dispersion_, &releaseSeconds_,
+                         &tuning_, &lossGain_, &lossPole_, &dispersionCoeff_, &dispersionMix_,
+                         &tuningIn_, &tuningOut_, &lossOut_,
+                         &dispersionIn1_, &dispersionOut1_, &dispersionIn2_, &dispersionOut2_, &peak_ })
+        array->assign(padded, 0.0f);
+
+    delay_.assign(padded, kMinDelay);
+    excitation_.assign(padded * kMaxExcitationTail, 0.0f);
+    excitationLength_.assign(padded, 0);
+    excitationRead_.assign(padded, 0);
+    active_.assign(padded, 0);
+    released_.assign(padded, 0);
+
+    for (int voice = 0; voice < static_cast<int>(padded); ++voice) {
+        frequency_[static_cast<size_t>(voice)] = 440.0f;
+        decaySeconds_[static_cast<size_t>(voice)] = settings_.decaySeconds;
+        brightness_[static_cast<size_t>(voice)] = settings_.brightness;
+        releaseSeconds_[static_cast<size_t>(voice)] = settings_.releaseSeconds;
+        updateFilters(voice);
+    }
+}
+
+void WaveguideBank::updateFilters(int voice) noexcept
+{
+    const auto v = static_cast<size_t>(voice);
+
+    const float frequency = juce::jlimit(lowestFrequency_, 0.25f * sampleRate_, frequency_[v]);
+    const float omega = juce::MathConstants<float>::twoPi * frequency / sampleRate_;
+    const float period = sampleRate_ / frequency;
+
+    // Loss: one-pole lowpass from two decay times, the fundamental's T60 and a shorter one at
+    // Nyquist set by brightness, so strings are equally dark across the keyboard
+    const float t60 = std::max(0.01f, released_[v] ? std::min(releaseSeconds_[v], decaySeconds_[v]) : decaySeconds_[v]);
+    const float highRatio = std::pow(kDarkestDecayRatio, 1.0f - juce::jlimit(0.0f, 1.0f, brightness_[v]));
+    const float tripGain = std::pow(10.0f, -3.0f / (t60 * frequency));
+    const float nyquistGain = std::pow(10.0f, -3.0f / (t60 * highRatio * frequency));
+    const float pole = (tripGain - nyquistGain) / (tripGain + nyquistGain);
+    const float lowpassMagnitude = (1.0f - pole) / std::sqrt(1.0f - 2.0f * pole * std::cos(omega) + pole * pole);
+
+    lossPole_[v] = pole;
+    lossGain_[v] = std::min(0.99999f, tripGain / lowpassMagnitude);
+
+    const float lossDelay = std::atan2(pole * std::sin(omega), 1.0f - pole * std::cos(omega)) / omega;
+
+    // Dispersion: two allpasses with more delay at low frequencies, so upper partials go sharp.
+    // Each costs at least a sample, so they are bypassed for an ideal string, and on high notes
+    // the coefficient is weakened until the integer delay keeps kMinDelay samples.
+    const float available = period - lossDelay - (static_cast<float>(kMinDelay) + 0.5f);
+    float coefficient = -kMaxDispersion * juce::jlimit(0.0f, 1.0f, dispersion_[v]);
+    float dispersionDelay = 0.0f;
+
+    if (coefficient < 0.0f && available > 2.0f) {
+        dispersionDelay = 2.0f * allpassPhaseDelay(coefficient, omega);
+
+        if (dispersionDelay > available) {
+            // Phase delay falls monotonically towards one sample as the coefficient goes to zero
+            float weakest = 0.0f;
+            for (int step = 0; step < kDispersionSearchSteps; ++step) {
+                const float middle = 0.5f * (coefficient + weakest);
+                if (2.0f * allpassPhaseDelay(middle, omega) > available)
+                    coefficient = middle;
+                else
+                    weakest = middle;
+            }
+            coefficient = weakest;
+            dispersionDelay = coefficient < 0.0f ? 2.0f * allpassPhaseDelay(coefficient, omega) : 0.0f;
+        }
+    } else {
+        coefficient = 0.0f;
+    }
+
+    dispersionCoeff_[v] = coefficient;
+    dispersionMix_[v] = coefficient < 0.0f ? 1.0f : 0.0f;
+
+    // Whatever is left is split into an integer delay and a fraction d in [0.5, 1.5)
+    const float remaining = period - lossDelay - dispersionDelay;
+    const int integer = std::max(kMinDelay, static_cast<int>(std::floor(remaining - 0.5f)));
+    const float fraction = remaining - static_cast<float>(integer);
+
+    delay_[v] = integer;
+
+    // Allpass coefficient with a phase delay of exactly fraction at the fundamental
+    tuning_[v] = std::sin((1.0f - fraction) * 0.5f * omega) / std::sin((1.0f + fraction) * 0.5f * omega);
+}
+
+//==============================================================================
+// Voices
+//==============================================================================
+
+void WaveguideBank::pluck(int voice, float frequency, float velocity, const StringSettings& settings) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    if (voice < 0 || voice >= maxVoices_) return;
+
+    const auto v = static_cast<size_t>(voice);
+
+    frequency_[v] = frequency;
+    decaySeconds_[v] = settings.decaySeconds;
+    brightness_[v] = settings.brightness;
+    dispersion_[v] = settings.dispersion;
+    releaseSeconds_[v] = settings.releaseSeconds;
+    released_[v] = 0;
+    updateFilters(voice);
+
+    tuningIn_[v] = tuningOut_[v] = lossOut_[v] = 0.0f;
+    dispersionIn1_[v] = dispersionOut1_[v] = dispersionIn2_[v] = dispersionOut2_[v] = 0.0f;
+
+    float* ring = rings_.data() + v * static_cast<size_t>(ringSize_);
+    std::fill(ring, ring + ringSize_, 0.0f);
+
+    // The burst spans the whole period. The next `delay` reads come from the samples just behind
+    // the write index; the rest is added to the loop output as it is written.
+    const int delay = delay_[v];
+    const float period = sampleRate_ / juce::jlimit(lowestFrequency_, 0.25f * sampleRate_, frequency_[v]);
+    const int tail = juce::jlimit(0, kMaxExcitationTail, static_cast<int>(std::round(period)) - delay);
+    const int length = delay + tail;
+
+    float* excitation = excitation_.data() + v * static_cast<size_t>(kMaxExcitationTail);
+    excitationLength_[v] = tail;
+    excitationRead_[v] = 0;
+
+    const auto at = [&](int k) -> float& {
+        return k < delay ? ring[(writeIndex_ - static_cast<uint32_t>(delay) + static_cast<uint32_t>(k)) & ringMask_]
+                         : excitation[k - delay];
+    };
+
+    // Noise burst, smoothed more for darker strings
+    const float smoothing = (1.0f - juce::jlimit(0.0f, 1.0f, settings.brightness)) * 0.9f;
+    float state = 0.0f;
+    float mean = 0.0f;
+    for (int k = 0; k < length; ++k) {
+        state = (1.0f - smoothing) * random_.nextBipolar() + smoothing * state;
+        at(k) = state;
+        mean += state;
+    }
+
+    // Remove the burst's DC, which the loop would otherwise carry as a slowly decaying offset
+    mean /= static_cast<float>(length);
+    for (int k = 0; k < length; ++k)
+        at(k) -= mean;
+
+    // Pluck position comb, run backwards in place: a pluck at p cancels the harmonics with a node at p
+    const int combDelay = juce::jlimit(1, std::max(1, length - 1),
+                                       static_cast<int>(std::round(settings.pluckPosition * static_cast<float>(length))));
+    for (int k = length - 1; k >= combDelay; --k)
+        at(k) -= at(k - combDelay);
+
+    float peak = 0.0f;
+    for (int k = 0; k < length; ++k)
+        peak = std::max(peak, std::abs(at(k)));
+    const float scale = peak > 0.0f ? velocity / peak : 0.0f;
+    for (int k = 0; k < length; ++k)
+        at(k) *= scale;
+
+    peak_[v] = std::abs(velocity);
+    active_[v] = velocity != 0.0f ? 1 : 0;
+}
+
+void WaveguideBank::setFrequency(int voice, float frequency) noexcept
+{
+    jassert(voice >= 0 && voice < maxVoices_);
+    if (voice < 0 || voice >= maxVoices_) return;
+
+    frequency_[static_cast<size_t>(voice)] = frequency;
+    updateFilters(voice);
+}
+
+void WaveguideBank::release(int voice) noexcept
+{
+    if (voice < 0 || voice >= maxVoices_ || !active_[static_cast<size_t>(voice)]) return;
+
+    released_[static_cast<size_t>(voice)] = 1;
+    updateFilters(voice);
+}
+
+void WaveguideBank::kill(int voice) noexcept
+{
+    if (voice < 0 || voice >= maxVoices_) return;
+
+    const auto v = static_cast<size_t>(voice);
+    active_[v] = 0;
+    released_[v] = 0;
+    excitationLength_[v] = 0;
+    tuningIn_[v] = tuningOut_[v] = lossOut_[v] = 0.0f;
+    dispersionIn1_[v] = dispersionOut1_[v] = dispersionIn2_[v] = dispersionOut2_[v] = 0.0f;
+
+    // Inactive lanes still run inside their group, so their loop must be silent
+    float* ring = rings_.data() + v * static_cast<size_t>(ringSize_);
+    std::fill(ring, ring + ringSize_, 0.0f);
+}
+
+void WaveguideBank::reset() noexcept
+{
+    for (int voice = 0; voice < maxVoices_; ++voice)
+        kill(voice);
+}
+
+int WaveguideBank::getNumActiveVoices() const noexcept
+{
+    int count = 0;
+    for (int voice = 0; voice < maxVoices_; ++voice)
+        count += active_[static_cast<size_t>(voice)];
+    return count;
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void WaveguideBank::process(float* output, int numSamples) noexcept
+{
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += kChunk) {
+        const int chunk = std::min(kChunk, numSamples - chunkStart);
+        std::fill(laneMix_.begin(), laneMix_.begin() + chunk * kLaneWidth, 0.0f);
+
+        for (int group = 0; group < numGroups_; ++group) {
+            const size_t first = static_cast<size_t>(group * kLaneWidth);
+            bool sounding = false;
+            for (size_t lane = first; lane < first + kLaneWidth; ++lane)
+                sounding = sounding || active_[lane] != 0;
+
+            if (sounding)
+                renderGroup(group, laneMix_.data(), chunk);
+        }
+
+        writeIndex_ += static_cast<uint32_t>(chunk);
+
+        // Fold the lanes of each sample into the output
+        for (int i = 0; i < chunk; ++i) {
+            const float* lanes = laneMix_.data() + static_cast<size_t>(i) * kLaneWidth;
+            float sum = 0.0f;
+            for (int lane = 0; lane < kLaneWidth; ++lane)
+                sum += lanes[lane];
+            output[chunkStart + i] += sum;
+        }
+
+        cullSilentVoices();
+    }
+}
+
+void WaveguideBank::renderGroup(int group, float* mix, int numSamples) noexcept
+{
+    const size_t first = static_cast<size_t>(group * kLaneWidth);
+
+    float* rings[kLanes];
+    const float* excitation[kLanes];
+    alignas(32) int32_t delay[kLanes], excitationLeft[kLanes];
+    alignas(32) float tuning[kLanes], lossGain[kLanes], lossPole[kLanes], dispersion[kLanes], dispersionMix[kLanes];
+    alignas(32) float tuningIn[kLanes], tuningOut[kLanes], lossOut[kLanes];
+    alignas(32) float in1[kLanes], out1[kLanes], in2[kLanes], out2[kLanes], peak[kLanes];
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const size_t v = first + static_cast<size_t>(lane);
+        rings[lane] = rings_.data() + v * static_cast<size_t>(ringSize_);
+        delay[lane] = delay_[v];
+        tuning[lane] = tuning_[v];
+        lossGain[lane] = lossGain_[v];
+        lossPole[lane] = lossPole_[v];
+        dispersion[lane] = dispersionCoeff_[v];
+        dispersionMix[lane] = dispersionMix_[v];
+        excitation[lane] = excitation_.data() + v * static_cast<size_t>(kMaxExcitationTail) + excitationRead_[v];
+        excitationLeft[lane] = excitationLength_[v] - excitationRead_[v];
+        tuningIn[lane] = tuningIn_[v];
+        tuningOut[lane] = tuningOut_[v];
+        lossOut[lane] = lossOut_[v];
+        in1[lane] = dispersionIn1_[v];
+        out1[lane] = dispersionOut1_[v];
+        in2[lane] = dispersionIn2_[v];
+        out2[lane] = dispersionOut2_[v];
+        peak[lane] = 0.0f;
+    }
+
+    // Bursts still being written after a pluck; only the first few samples of a note need this
+    int excitationSamples = 0;
+    for (int lane = 0; lane < kLanes; ++lane)
+        excitationSamples = std::max(excitationSamples, excitationLeft[lane]);
+    excitationSamples = std::min(excitationSamples, numSamples);
+
+    uint32_t write = writeIndex_;
+
+    for (int i = 0; i < numSamples; ++i, ++write) {
+        alignas(32) float x[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane)
+            x[lane] = rings[lane][(write - static_cast<uint32_t>(delay[lane])) & ringMask_];
+
+        alignas(32) float y[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+            // Fractional delay allpass
+            const float tuned = tuning[lane] * (x[lane] - tuningOut[lane]) + tuningIn[lane];
+            tuningIn[lane] = x[lane];
+            tuningOut[lane] = tuned;
+
+            // Loss lowpass
+            const float lossy = lossOut[lane] + (1.0f - lossPole[lane]) * (lossGain[lane] * tuned - lossOut[lane]);
+            lossOut[lane] = lossy;
+
+            // Dispersion allpasses
+            const float d1 = dispersion[lane] * (lossy - out1[lane]) + in1[lane];
+            in1[lane] = lossy;
+            out1[lane] = d1;
+            const float d2 = dispersion[lane] * (d1 - out2[lane]) + in2[lane];
+            in2[lane] = d1;
+            out2[lane] = d2;
+
+            y[lane] = lossy + dispersionMix[lane] * (d2 - lossy);
+            peak[lane] = std::max(peak[lane], std::abs(y[lane]));
+        }
+
+        float* out = mix + static_cast<size_t>(i) * kLanes;
+        for (int lane = 0; lane < kLanes; ++lane)
+            out[lane] += y[lane];
+
+        // The rest of a burst follows the part already in the ring, delay samples later
+        if (i < excitationSamples) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                if (i < excitationLeft[lane])
+                    y[lane] += excitation[lane][i];
+            }
+        }
+
+        for (int lane = 0; lane < kLanes; ++lane)
+            rings[lane][write & ringMask_] = y[lane];
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const size_t v = first + static_cast<size_t>(lane);
+        tuningIn_[v] = tuningIn[lane];
+        tuningOut_[v] = tuningOut[lane];
+        lossOut_[v] = lossOut[lane];
+        dispersionIn1_[v] = in1[lane];
+        dispersionOut1_[v] = out1[lane];
+        dispersionIn2_[v] = in2[lane];
+        dispersionOut2_[v] = out2[lane];
+        peak_[v] = peak[lane];
+        excitationRead_[v] = std::min(excitationLength_[v], excitationRead_[v] + numSamples);
+    }
+}
+
+void WaveguideBank::cullSilentVoices() noexcept
+{
+    for (int voice = 0; voice < maxVoices_; ++voice) {
+        if (active_[static_cast<size_t>(voice)] && peak_[static_cast<size_t>(voice)] < kSilenceThreshold)
+            kill(voice);
+    }
+}
+
+} // namespace synthesis
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+    waveguide_bank.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Preallocated Karplus-Strong / digital waveguide strings with fractional
+    delay tuning, rendered several voices per SIMD lane
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../utility/fast_random.h"
+
+namespace vital {
+namespace audio_engine {
+namespace synthesis {
+
+//==============================================================================
+/**
+ * @class WaveguideBank
+ * @brief Up to kMaxVoices plucked strings with allocation-free, accurately tuned loops
+ *
+ * Every voice owns a power-of-two ring buffer sized in prepare() for the
+ * lowest note, so pitch changes only move a read offset. All rings share one
+ * write index, and wrapping is a mask.
+ *
+ * The loop of each string is: integer delay, then a first-order allpass for
+ * the fractional part of the period, then a one-pole loss filter (decay and
+ * brightness), then two first-order allpasses for stiffness dispersion. The
+ * allpass coefficient is solved exactly for the phase delay left over at
+ * the fundamental once the other filters' phase delays are subtracted, so
+ * the fundamental is in tune at any pitch. Integer-length Karplus-Strong
+ * drifts by tens of cents in the top octaves.
+ *
+ * The dispersion allpasses cost at least a sample each, so they are
+ * bypassed for an ideal string and weakened on high notes until the integer
+ * delay keeps kMinDelay samples. A pluck excites the whole period: the part
+ * of the burst that does not fit in the integer delay is added to the loop
+ * output over the first samples, so short loops are excited as fully as
+ * long ones.
+ *
+ * Voice state lives in arrays of kLaneWidth voices. Each lane loop reads
+ * its ring per lane, and every filter stage is lane arithmetic the compiler
+ * turns into SIMD. Voices that fall below the silence threshold are cleared,
+ * and lane groups with no sounding voice are skipped.
+ */
+class WaveguideBank
+{
+public:
+    //==============================================================================
+    static constexpr int kLaneWidth = 8;
+    static constexpr int kMaxVoices = 64;
+
+    /** Per-voice string character */
+    struct StringSettings
+    {
+        float decaySeconds = 3.0f;      // T60 of the fundamental
+        float brightness = 0.7f;        // 0 dark to 1 no loss filtering
+        float dispersion = 0.0f;        // 0 ideal string to 1 very stiff
+        float pluckPosition = 0.15f;    // Fraction of the string from the bridge
+        float releaseSeconds = 0.15f;   // T60 after release()
+    };
+
+    //==============================================================================
+    WaveguideBank() = default;
+
+    /**
+     * Allocate every ring for notes down to lowestFrequency at sampleRate.
+     * Not real-time safe.
+     */
+    void prepare(int maxVoices, float lowestFrequency, double sampleRate);
+
+    int getMaxVoices() const noexcept { return maxVoices_; }
+    float getLowestFrequency() const noexcept { return lowestFrequency_; }
+
+    //==============================================================================
+    /** Start a voice: retune it, apply settings and fill its loop with a shaped noise burst */
+    void pluck(int voice, float frequency, float velocity, const StringSettings& settings) noexcept;
+    void pluck(int voice, float frequency, float velocity) noexcept { pluck(voice, frequency, velocity, settings_); }
+
+    /** Retune a sounding voice (vibrato, glide); frequencies below the prepared lowest note are clamped */
+    void setFrequency(int voice, float frequency) noexcept;
+
+    /** Default settings for pluck() without explicit settings */
+    void setDefaultSettings(const StringSettings& settings) noexcept { settings_ = settings; }
+
+    /** Damp a voice with its release time */
+    void release(int voice) noexcept;
+
+    void kill(int voice) noexcept;
+    void reset() noexcept;
+
+    bool isActive(int voice) const noexcept { return active_[static_cast<size_t>(voice)] != 0; }
+    int getNumActiveVoices() const noexcept;
+
+    //==============================================================================
+    /** Render every sounding voice and add the mono sum into output */
+    void process(float* output, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int kChunk = 256;
+    static constexpr float kSilenceThreshold = 1.0e-5f;
+
+    /** Shortest integer delay; a burst this short still has a fundamental once its DC is removed */
+    static constexpr int kMinDelay = 2;
+
+    /** Longest part of a burst held outside the ring, covering the filters' phase delay at full dispersion */
+    static constexpr int kMaxExcitationTail = 32;
+
+    void updateFilters(int voice) noexcept;
+    void renderGroup(int group, float* mix, int numSamples) noexcept;
+    void cullSilentVoices() noexcept;
+
+    int maxVoices_ = 0;
+    int numGroups_ = 0;
+    float sampleRate_ = 44100.0f;
+    float lowestFrequency_ = 27.5f;
+
+    /** Rings: voices x ringSize, one shared write index */
+    std::vector<float> rings_;
+    int ringSize_ = 0;
+    uint32_t ringMask_ = 0;
+    uint32_t writeIndex_ = 0;
+
+    /** Voice parameters, padded to whole lane groups */
+    std::vector<float> frequency_, decaySeconds_, brightness_, dispersion_, releaseSeconds_;
+    std::vector<uint8_t> active_, released_;
+
+    /** Loop filters: integer delay, tuning allpass, loss gain and pole, dispersion coefficient and mix (0 bypasses) */
+    std::vector<int32_t> delay_;
+    std::vector<float> tuning_, lossGain_, lossPole_, dispersionCoeff_, dispersionMix_;
+
+    /** Burst samples past the integer delay, written into the ring behind the loop output after a pluck */
+    std::vector<float> excitation_;
+    std::vector<int32_t> excitationLength_, excitationRead_;
+
+    /** Filter state */
+    std::vector<float> tuningIn_, tuningOut_, lossOut_;
+    std::vector<float> dispersionIn1_, dispersionOut1_, dispersionIn2_, dispersionOut2_;
+    std::vector<float> peak_;
+
+    StringSettings settings_;
+    utility::FastRandom random_;
+
+    /** Per-sample lane accumulators, kChunk x kLaneWidth */
+    alignas(32) std::array<float, kChunk * kLaneWidth> laneMix_{};
+
+    JUCE_DECLARE_NON_COPYABLE(WaveguideBank)
+};
+
+} // namespace synthesis
+} // namespace audio_engine
+} // namespace vital
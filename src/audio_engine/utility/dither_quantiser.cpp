@@ -0,0 +1,423 @@
+/*
+  ==============================================================================
+    dither_quantiser.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Shaping curves, the lane-parallel quantiser kernel and the output writers
+  ==============================================================================
+*/
+
+#include "dither_quantiser.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_QUANTISER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_QUANTISER_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+namespace {
+
+using Dither = DitherQuantiser::Dither;
+using Shaping = DitherQuantiser::Shaping;
+
+constexpr int kLanes = DitherQuantiser::kLanes;
+static_assert(kLanes == 4, "the lane operations are 128 bits wide");
+
+/** Highest rate the weighted curves are used at */
+constexpr double kMaxWeightedRate = 64000.0;
+
+/** Wannamaker's 9-tap psychoacoustically optimal error filters for 44.1 kHz */
+constexpr std::array<float, 9> kFWeighted = { 2.412f, -3.370f, 3.937f, -4.174f, 3.353f,
+                                              -2.205f, 1.281f, -0.569f, 0.0847f };
+constexpr std::array<float, 9> kEWeighted = { 2.847f, -4.685f, 6.214f, -7.184f, 6.639f,
+                                              -5.032f, 3.263f, -1.632f, 0.4191f };
+
+//==============================================================================
+/** One value per channel of a group, and the matching xorshift32 states */
+#if VITAL_QUANTISER_SSE
+using Lanes = __m128;
+using Bits = __m128i;
+
+inline Lanes load(const float* source) noexcept { return _mm_loadu_ps(source); }
+inline void store(float* destination, Lanes value) noexcept { _mm_storeu_ps(destination, value); }
+inline Lanes splat(float value) noexcept { return _mm_set1_ps(value); }
+inline Lanes add(Lanes a, Lanes b) noexcept { return _mm_add_ps(a, b); }
+inline Lanes subtract(Lanes a, Lanes b) noexcept { return _mm_sub_ps(a, b); }
+inline Lanes multiply(Lanes a, Lanes b) noexcept { return _mm_mul_ps(a, b); }
+inline Lanes clamp(Lanes value, Lanes low, Lanes high) noexcept { return _mm_min_ps(_mm_max_ps(value, low), high); }
+
+/** Nearest integer, ties to even, under the default rounding mode */
+inline Lanes roundToInteger(Lanes value) noexcept { return _mm_cvtepi32_ps(_mm_cvtps_epi32(value)); }
+
+inline Bits loadBits(const uint32_t* source) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+inline void storeBits(uint32_t* destination, Bits value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value); }
+
+inline Bits xorshift(Bits s) noexcept
+{
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+    s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+    return _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+}
+
+/** The top 23 bits as the mantissa of a value in [1, 2) */
+inline Lanes toUnitRange(Bits s) noexcept { return _mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(s, 9), _mm_set1_epi32(0x3f800000))); }
+#elif VITAL_QUANTISER_NEON
+using Lanes = float32x4_t;
+using Bits = uint32x4_t;
+
+inline Lanes load(const float* source) noexcept { return vld1q_f32(source); }
+inline void store(float* destination, Lanes value) noexcept { vst1q_f32(destination, value); }
+inline Lanes splat(float value) noexcept { return vdupq_n_f32(value); }
+inline Lanes add(Lanes a, Lanes b) noexcept { return vaddq_f32(a, b); }
+inline Lanes subtract(Lanes a, Lanes b) noexcept { return vsubq_f32(a, b); }
+inline Lanes multiply(Lanes a, Lanes b) noexcept { return vmulq_f32(a, b); }
+inline Lanes clamp(Lanes value, Lanes low, Lanes high) noexcept { return vminq_f32(vmaxq_f32(value, low), high); }
+
+inline Lanes roundToInteger(Lanes value) noexcept
+{
+   #if defined(__aarch64__)
+    return vrndnq_f32(value);
+   #else
+    // Half away from zero, then truncate
+    const uint32x4_t negative = vcltq_f32(value, vdupq_n_f32(0.0f));
+    const float32x4_t half = vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+    return vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(value, half)));
+   #endif
+}
+
+inline Bits loadBits(const uint32_t* source) noexcept { return vld1q_u32(source); }
+inline void storeBits(uint32_t* destination, Bits value) noexcept { vst1q_u32(destination, value); }
+
+inline Bits xorshift(Bits s) noexcept
+{
+    s = veorq_u32(s, vshlq_n_u32(s, 13));
+    s = veorq_u32(s, vshrq_n_u32(s, 17));
+    return veorq_u32(s, vshlq_n_u32(s, 5));
+}
+
+inline Lanes toUnitRange(Bits s) noexcept { return vreinterpretq_f32_u32(vorrq_u32(vshrq_n_u32(s, 9), vdupq_n_u32(0x3f800000u))); }
+#else
+struct Lanes
+{
+    std::array<float, kLanes> values;
+};
+
+struct Bits
+{
+    std::array<uint32_t, kLanes> values;
+};
+
+template <typename Result, typename Function>
+inline Result map(Function&& function) noexcept
+{
+    Result result;
+    for (size_t lane = 0; lane < kLanes; ++lane)
+        result.values[lane] = function(lane);
+    return result;
+}
+
+inline Lanes load(const float* source) noexcept { return map<Lanes>([=](size_t i) { return source[i]; }); }
+inline void store(float* destination, Lanes value) noexcept { std::copy(value.values.begin(), value.values.end(), destination); }
+inline Lanes splat(float value) noexcept { return map<Lanes>([=](size_t) { return value; }); }
+inline Lanes add(Lanes a, Lanes b) noexcept { return map<Lanes>([&](size_t i) { return a.values[i] + b.values[i]; }); }
+inline Lanes subtract(Lanes a, Lanes b) noexcept { return map<Lanes>([&](size_t i) { return a.values[i] - b.values[i]; }); }
+inline Lanes multiply(Lanes a, Lanes b) noexcept { return map<Lanes>([&](size_t i) { return a.values[i] * b.values[i]; }); }
+
+inline Lanes clamp(Lanes value, Lanes low, Lanes high) noexcept
+{
+    return map<Lanes>([&](size_t i) { return std::min(std::max(value.values[i], low.values[i]), high.values[i]); });
+}
+
+inline Lanes roundToInteger(Lanes value) noexcept { return map<Lanes>([&](size_t i) { return std::nearbyint(value.values[i]); }); }
+
+inline Bits loadBits(const uint32_t* source) noexcept { return map<Bits>([=](size_t i) { return source[i]; }); }
+inline void storeBits(uint32_t* destination, Bits value) noexcept { std::copy(value.values.begin(), value.values.end(), destination); }
+
+inline Bits xorshift(Bits s) noexcept
+{
+    return map<Bits>([&](size_t i) {
+        uint32_t x = s.values[i];
+        x ^= x << 13;
+        x ^= x >> 17;
+        return x ^ (x << 5);
+    });
+}
+
+inline Lanes toUnitRange(Bits s) noexcept
+{
+    return map<Lanes>([&](size_t i) {
+        const uint32_t bits = (s.values[i] >> 9) | 0x3f800000u;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    });
+}
+#endif
+
+//==============================================================================
+/**
+ * Quantiser with a compile-time dither type and error filter order. The
+ * transposed filter state and the dither generators are unrolled into
+ * registers for the whole block. Clipping happens after the error is taken,
+ * so the feedback path is a subtract, a round trip through integers, a
+ * subtract and one multiply-add, and the fed-back error never exceeds half a
+ * step plus the dither. The generators are independent of that path, so
+ * dither costs almost nothing once the filter is running.
+ */
+template <Dither Type, int Order>
+struct QuantiserKernel
+{
+    static constexpr size_t kTaps = Order > 0 ? static_cast<size_t>(Order) : 1;
+
+    /** Plain arrays: vector types lose their alignment attributes as template arguments */
+    struct State
+    {
+        Lanes taps[kTaps];
+    };
+
+    template <size_t Tap>
+    static Lanes next(const State& state) noexcept
+    {
+        if constexpr (Tap + 1 < kTaps)
+            return state.taps[Tap + 1];
+        else
+            return splat(0.0f);
+    }
+
+    /** state[k] = state[k + 1] + c[k] * error, in order so every tap reads its neighbour before it changes */
+    template <size_t... Taps>
+    static void update(State& state, const State& c, Lanes error, std::index_sequence<Taps...>) noexcept
+    {
+        ((state.taps[Taps] = add(next<Taps>(state), multiply(c.taps[Taps], error))), ...);
+    }
+
+    static void run(const float* coefficients, float* stateMemory, uint32_t* randomMemory, const float* input,
+                    float* output, int numSamples, float low, float high, float amount) noexcept
+    {
+        State c, state;
+        for (size_t tap = 0; tap < kTaps; ++tap) {
+            c.taps[tap] = splat(coefficients[tap]);
+            state.taps[tap] = load(stateMemory + tap * kLanes);
+        }
+
+        Bits first = loadBits(randomMemory);
+        Bits second = loadBits(randomMemory + kLanes);
+        const Lanes lowest = splat(low), highest = splat(high), scale = splat(amount);
+
+        for (int i = 0; i < numSamples; ++i) {
+            Lanes dithered = load(input + i * kLanes);
+            const Lanes signal = dithered;
+
+            if constexpr (Type == Dither::Rectangular) {
+                first = xorshift(first);
+                dithered = add(dithered, multiply(subtract(toUnitRange(first), splat(1.5f)), scale));
+            } else if constexpr (Type == Dither::Triangular) {
+                // Both uniforms sit in [1, 2), so their difference is already centred
+                first = xorshift(first);
+                second = xorshift(second);
+                dithered = add(dithered, multiply(subtract(toUnitRange(first), toUnitRange(second)), scale));
+            }
+
+            if constexpr (Order > 0) {
+                const Lanes quantised = roundToInteger(subtract(dithered, state.taps[0]));
+                const Lanes error = subtract(quantised, subtract(signal, state.taps[0]));
+                update(state, c, error, std::make_index_sequence<kTaps>());
+                store(output + i * kLanes, clamp(quantised, lowest, highest));
+            } else {
+                store(output + i * kLanes, clamp(roundToInteger(dithered), lowest, highest));
+            }
+        }
+
+        for (size_t tap = 0; tap < kTaps; ++tap)
+            store(stateMemory + tap * kLanes, state.taps[tap]);
+
+        storeBits(randomMemory, first);
+        storeBits(randomMemory + kLanes, second);
+    }
+};
+
+using KernelFunction = void (*)(const float*, float*, uint32_t*, const float*, float*, int, float, float, float) noexcept;
+using KernelRow = std::array<KernelFunction, DitherQuantiser::kMaxOrder + 1>;
+
+template <Dither Type, size_t... Orders>
+constexpr KernelRow makeKernels(std::index_sequence<Orders...>) noexcept
+{
+    return { &QuantiserKernel<Type, static_cast<int>(Orders)>::run... };
+}
+
+/** Kernels indexed by dither type and filter order */
+constexpr std::array<KernelRow, 3> kKernels = {
+    makeKernels<Dither::None>(std::make_index_sequence<DitherQuantiser::kMaxOrder + 1>()),
+    makeKernels<Dither::Rectangular>(std::make_index_sequence<DitherQuantiser::kMaxOrder + 1>()),
+    makeKernels<Dither::Triangular>(std::make_index_sequence<DitherQuantiser::kMaxOrder + 1>())
+};
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void DitherQuantiser::prepare(const Config& config)
+{
+    config_ = config;
+    config_.numChannels = juce::jlimit(1, kMaxChannels, config.numChannels);
+    config_.bitDepth = juce::jlimit(8, 24, config.bitDepth);
+    config_.ditherAmount = std::max(0.0f, config.ditherAmount);
+    scale_ = static_cast<float>(1 << (config_.bitDepth - 1));
+
+    Shaping shaping = config_.shaping;
+    if ((shaping == Shaping::FWeighted || shaping == Shaping::EWeighted) && config_.sampleRate > kMaxWeightedRate)
+        shaping = Shaping::SecondOrder;
+
+    std::array<float, kMaxOrder> curve{};
+    switch (shaping) {
+        case Shaping::None:        order_ = 0; break;
+        case Shaping::FirstOrder:  order_ = 1; curve[0] = 1.0f; break;
+        case Shaping::SecondOrder: order_ = 2; curve[0] = 2.0f; curve[1] = -1.0f; break;
+        case Shaping::FWeighted:   order_ = kMaxOrder; curve = kFWeighted; break;
+        case Shaping::EWeighted:   order_ = kMaxOrder; curve = kEWeighted; break;
+    }
+
+    const float strength = juce::jlimit(0.0f, 1.0f, config_.shapingStrength);
+    for (size_t tap = 0; tap < curve.size(); ++tap)
+        coefficients_[tap] = curve[tap] * strength;
+
+    groups_.resize(static_cast<size_t>((config_.numChannels + kLanes - 1) / kLanes));
+    reset();
+}
+
+void DitherQuantiser::reset() noexcept
+{
+    // splitmix64 from the seed, so every lane of every group starts an unrelated stream
+    uint64_t seed = config_.seed;
+    for (auto& group : groups_) {
+        for (auto& lane : group.random) {
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            z ^= z >> 31;
+            lane = static_cast<uint32_t>(z) | 1u;   // xorshift32 must never hold zero
+        }
+        group.state.fill(0.0f);
+    }
+
+    stateScale_ = scale_;
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+void DitherQuantiser::process(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const float step = 1.0f / scale_;
+
+    run(channels, numChannels, numSamples, scale_, [&](int first, int lanes, int offset, int count) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            float* destination = channels[first + lane] + offset;
+            for (int i = 0; i < count; ++i)
+                destination[i] = quantised_[static_cast<size_t>(i * kLanes + lane)] * step;
+        }
+    });
+}
+
+void DitherQuantiser::process(const float* const* channels, int numChannels, int numSamples,
+                              void* destination, Format format) noexcept
+{
+    numChannels = juce::jmin(numChannels, config_.numChannels);
+
+    // A format narrower than the configured depth is quantised at its own width
+    const int width = format == Format::Int16 ? 16 : 24;
+    const int bitDepth = juce::jmin(config_.bitDepth, width);
+    const float scale = static_cast<float>(1 << (bitDepth - 1));
+    const int justify = 1 << (width - bitDepth);
+
+    if (format == Format::Int16) {
+        auto* pcm = static_cast<int16_t*>(destination);
+        run(channels, numChannels, numSamples, scale, [&](int first, int lanes, int offset, int count) {
+            for (int i = 0; i < count; ++i) {
+                int16_t* frame = pcm + static_cast<size_t>(offset + i) * static_cast<size_t>(numChannels) + first;
+                for (int lane = 0; lane < lanes; ++lane)
+                    frame[lane] = static_cast<int16_t>(static_cast<int>(quantised_[static_cast<size_t>(i * kLanes + lane)]) * justify);
+            }
+        });
+    } else {
+        auto* pcm = static_cast<uint8_t*>(destination);
+        run(channels, numChannels, numSamples, scale, [&](int first, int lanes, int offset, int count) {
+            for (int i = 0; i < count; ++i) {
+                uint8_t* frame = pcm + (static_cast<size_t>(offset + i) * static_cast<size_t>(numChannels) + first) * 3;
+                for (int lane = 0; lane < lanes; ++lane) {
+                    const auto value = static_cast<uint32_t>(static_cast<int>(quantised_[static_cast<size_t>(i * kLanes + lane)]) * justify);
+                    frame[3 * lane] = static_cast<uint8_t>(value);
+                    frame[3 * lane + 1] = static_cast<uint8_t>(value >> 8);
+                    frame[3 * lane + 2] = static_cast<uint8_t>(value >> 16);
+                }
+            }
+        });
+    }
+}
+
+template <typename Writer>
+void DitherQuantiser::run(const float* const* channels, int numChannels, int numSamples, float scale, Writer&& writer) noexcept
+{
+    numChannels = juce::jmin(numChannels, config_.numChannels);
+    setStateScale(scale);
+
+    for (int first = 0; first < numChannels; first += kLanes) {
+        Group& group = groups_[static_cast<size_t>(first / kLanes)];
+        const int lanes = juce::jmin(kLanes, numChannels - first);
+
+        for (int offset = 0; offset < numSamples; offset += kChunk) {
+            const int count = juce::jmin(kChunk, numSamples - offset);
+
+            // Gather into lane order, in units of one quantisation step; idle lanes stay silent
+            for (int lane = 0; lane < lanes; ++lane) {
+                const float* source = channels[first + lane] + offset;
+                for (int i = 0; i < count; ++i)
+                    frames_[static_cast<size_t>(i * kLanes + lane)] = source[i] * scale;
+            }
+            for (int lane = lanes; lane < kLanes; ++lane)
+                for (int i = 0; i < count; ++i)
+                    frames_[static_cast<size_t>(i * kLanes + lane)] = 0.0f;
+
+            quantiseChunk(group, count, scale);
+            writer(first, lanes, offset, count);
+        }
+    }
+}
+
+void DitherQuantiser::quantiseChunk(Group& group, int numSamples, float scale) noexcept
+{
+    kKernels[static_cast<size_t>(config_.dither)][static_cast<size_t>(order_)](
+        coefficients_.data(), group.state.data(), group.random.data(), frames_.data(),
+        quantised_.data(), numSamples, -scale, scale - 1.0f, config_.ditherAmount);
+}
+
+void DitherQuantiser::setStateScale(float scale) noexcept
+{
+    if (scale == stateScale_) return;
+
+    // The error filters hold steps of the previous width; keep the error they carry
+    const float ratio = scale / stateScale_;
+    for (auto& group : groups_)
+        for (auto& value : group.state)
+            value *= ratio;
+
+    stateScale_ = scale;
+}
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
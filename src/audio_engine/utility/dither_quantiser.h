@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    dither_quantiser.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Final-stage word length reduction: per-channel dither streams, FIR error
+    feedback noise shaping and direct PCM output
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class DitherQuantiser
+ * @brief Dithered, noise-shaped quantiser for the end of the signal chain
+ *
+ * Error feedback is recursive in time, so the vectors run across channels
+ * instead: channels are taken in groups of kLanes, one channel per lane.
+ * Every channel has its own pair of xorshift32 dither streams, the FastRandom
+ * generator stepped in registers inside the quantiser loop, so a TPDF value
+ * is two vector steps and a subtract. A block is gathered into lane order,
+ * dithered, quantised and scattered
+ * straight into the destination, either back into the float channels or
+ * into interleaved 16- or 24-bit PCM for the host.
+ *
+ * Shaping curves are FIR error filters, so the noise transfer function is
+ * 1 - sum(c[k] z^-(k+1)). The filter runs in transposed form with its state
+ * unrolled into registers, so each sample adds one multiply-add per tap to
+ * the feedback path. Dither is added inside the loop and shaped with the
+ * quantisation error. Clipping is applied after the error is taken, so an
+ * overload is never fed back and cannot make the loop unstable.
+ *
+ * The weighted curves are designed for 44.1 and 48 kHz; above 64 kHz they
+ * would move noise into the audio band, so second order shaping is used
+ * instead.
+ */
+class DitherQuantiser
+{
+public:
+    //==============================================================================
+    static constexpr int kLanes = 4;
+    static constexpr int kMaxChannels = 64;
+    static constexpr int kMaxOrder = 9;
+
+    enum class Dither : uint8_t { None, Rectangular, Triangular };
+
+    /** Error filters: first or second order highpass, or the 9-tap F- and E-weighted curves of Wannamaker */
+    enum class Shaping : uint8_t { None, FirstOrder, SecondOrder, FWeighted, EWeighted };
+
+    /** Interleaved host formats, little endian */
+    enum class Format : uint8_t { Int16, Int24 };
+
+    struct Config
+    {
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int bitDepth = 16;                  // 8 to 24
+        Dither dither = Dither::Triangular;
+        float ditherAmount = 1.0f;          // 1 is the standard +-1 LSB TPDF or +-0.5 LSB RPDF
+        Shaping shaping = Shaping::FWeighted;
+        float shapingStrength = 1.0f;       // Scales the error filter from flat (0) to the full curve (1)
+        uint64_t seed = 0x5eed5eedull;
+    };
+
+    //==============================================================================
+    DitherQuantiser() = default;
+
+    /** Set up the curve and the channel groups. Not real-time safe. */
+    void prepare(const Config& config);
+
+    /** Clear the error filters and restart the dither streams */
+    void reset() noexcept;
+
+    const Config& getConfig() const noexcept { return config_; }
+    int getOrder() const noexcept { return order_; }
+
+    //==============================================================================
+    /** Quantise channels in place to multiples of 2^(1 - bitDepth) */
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /**
+     * Quantise channels into an interleaved host buffer with numChannels
+     * samples per frame. Values are bitDepth wide, left-justified in the
+     * format; a bitDepth wider than the format is reduced to its width.
+     */
+    void process(const float* const* channels, int numChannels, int numSamples,
+                 void* destination, Format format) noexcept;
+
+private:
+    //==============================================================================
+    /** Samples per gathered block */
+    static constexpr int kChunk = 64;
+
+    struct Group
+    {
+        /** Two xorshift32 states per channel */
+        alignas(16) std::array<uint32_t, 2 * kLanes> random{};
+        alignas(16) std::array<float, kLanes * kMaxOrder> state{};
+    };
+
+    /** Quantise in steps of 1 / scale */
+    template <typename Writer>
+    void run(const float* const* channels, int numChannels, int numSamples, float scale, Writer&& writer) noexcept;
+
+    void quantiseChunk(Group& group, int numSamples, float scale) noexcept;
+
+    /** Rescale the error filter state when the quantisation step changes */
+    void setStateScale(float scale) noexcept;
+
+    Config config_;
+    int order_ = 0;
+    std::array<float, kMaxOrder> coefficients_{};
+    float scale_ = 32768.0f;
+    float stateScale_ = 32768.0f;
+    std::vector<Group> groups_;
+
+    /** Lane-ordered block buffers: scaled input and quantised values */
+    alignas(16) std::array<float, kLanes * kChunk> frames_{};
+    alignas(16) std::array<float, kLanes * kChunk> quantised_{};
+
+    JUCE_DECLARE_NON_COPYABLE(DitherQuantiser)
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+    fast_random.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Small-state xorshift generator that fills blocks of uniform floats
+    four lanes at a time
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_FAST_RANDOM_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_FAST_RANDOM_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class FastRandom
+ * @brief Four independent xorshift32 lanes for audio-rate noise and decisions
+ *
+ * Each lane is a xorshift32 stream seeded through splitmix64, so nearby
+ * seeds still give unrelated streams. fillUniform() advances all four lanes
+ * with one vector step and turns the top 23 bits into floats by writing
+ * them into the mantissa of 1.0, so a block costs a few integer
+ * instructions per sample and never calls a distribution object.
+ *
+ * Not suitable for anything needing statistical quality beyond audio noise.
+ */
+class FastRandom
+{
+public:
+    static constexpr int kLanes = 4;
+
+    explicit FastRandom(uint64_t seed = 0x2545f4914f6cdd1dull) noexcept { setSeed(seed); }
+
+    void setSeed(uint64_t seed) noexcept
+    {
+        for (auto& lane : state_) {
+            // splitmix64; xorshift32 must never be seeded with zero
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            z ^= z >> 31;
+            lane = static_cast<uint32_t>(z) | 1u;
+        }
+        next_ = kLanes;
+    }
+
+    /** One value in [0, 1) */
+    float nextFloat() noexcept
+    {
+        if (next_ == kLanes) {
+            step(buffer_.data());
+            next_ = 0;
+        }
+        return buffer_[static_cast<size_t>(next_++)];
+    }
+
+    /** One value in [-1, 1) */
+    float nextBipolar() noexcept { return 2.0f * nextFloat() - 1.0f; }
+
+    /** numSamples values in [0, 1) */
+    void fillUniform(float* output, int numSamples) noexcept
+    {
+        int i = 0;
+        for (; i + kLanes <= numSamples; i += kLanes)
+            step(output + i);
+
+        for (; i < numSamples; ++i)
+            output[i] = nextFloat();
+    }
+
+    /** numSamples values in [-1, 1) */
+    void fillBipolar(float* output, int numSamples) noexcept
+    {
+        fillUniform(output, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = 2.0f * output[i] - 1.0f;
+    }
+
+private:
+    /** Advance every lane once and write kLanes floats in [0, 1) */
+    void step(float* output) noexcept
+    {
+       #if VITAL_FAST_RANDOM_SSE
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state_.data()));
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+        s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state_.data()), s);
+
+        const __m128i mantissa = _mm_or_si128(_mm_srli_epi32(s, 9), _mm_set1_epi32(0x3f800000));
+        _mm_storeu_ps(output, _mm_sub_ps(_mm_castsi128_ps(mantissa), _mm_set1_ps(1.0f)));
+       #elif VITAL_FAST_RANDOM_NEON
+        uint32x4_t s = vld1q_u32(state_.data());
+        s = veorq_u32(s, vshlq_n_u32(s, 13));
+        s = veorq_u32(s, vshrq_n_u32(s, 17));
+        s = veorq_u32(s, vshlq_n_u32(s, 5));
+        vst1q_u32(state_.data(), s);
+
+        const uint32x4_t mantissa = vorrq_u32(vshrq_n_u32(s, 9), vdupq_n_u32(0x3f800000u));
+        vst1q_f32(output, vsubq_f32(vreinterpretq_f32_u32(mantissa), vdupq_n_f32(1.0f)));
+       #else
+        for (int lane = 0; lane < kLanes; ++lane) {
+            uint32_t s = state_[static_cast<size_t>(lane)];
+            s ^= s << 13;
+            s ^= s >> 17;
+            s ^= s << 5;
+            state_[static_cast<size_t>(lane)] = s;
+
+            const uint32_t bits = (s >> 9) | 0x3f800000u;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            output[lane] = value - 1.0f;
+        }
+       #endif
+    }
+
+    alignas(16) std::array<uint32_t, kLanes> state_{};
+    alignas(16) std::array<float, kLanes> buffer_{};
+    int next_ = kLanes;
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,495 @@
+/*
+  ==============================================================================
+    oversampler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Half-band design and the polyphase up and down sampling stages
+  ==============================================================================
+*/
+
+#include "oversampler.h"
+#include "shared_table_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+namespace {
+
+using Phase = HalfBandCascade::Phase;
+
+constexpr double kPi = juce::MathConstants<double>::pi;
+
+/** Stopband rejection of every stage */
+constexpr double kAttenuationDb = 100.0;
+
+/** Audio band kept by the cascade, as a fraction of the base rate */
+constexpr double kPassband = 0.45;
+
+/**
+ * Transition width of a stage, as a fraction of its higher rate: from the top
+ * of the audio band to its first image. Each stage doubles the rate, so the
+ * band shrinks relative to it and the transition widens.
+ */
+double getTransition(int stage) noexcept
+{
+    return 0.5 - kPassband / static_cast<double>(1 << stage);
+}
+
+//==============================================================================
+/** Elliptic polyphase IIR half-band design after Valenzuela and Constantinides */
+double integerPower(double x, int n) noexcept
+{
+    double result = 1.0;
+    for (; n > 0; n >>= 1, x *= x)
+        if (n & 1) result *= x;
+    return result;
+}
+
+double accumulateNumerator(double q, int order, int index) noexcept
+{
+    double sum = 0.0, term = 0.0, sign = 1.0;
+    int i = 0;
+    do {
+        term = integerPower(q, i * (i + 1)) * std::sin((i * 2 + 1) * index * kPi / order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1.0e-100);
+    return sum;
+}
+
+double accumulateDenominator(double q, int order, int index) noexcept
+{
+    double sum = 0.0, term = 0.0, sign = -1.0;
+    int i = 1;
+    do {
+        term = integerPower(q, i * i) * std::cos(i * 2 * index * kPi / order) * sign;
+        sum += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1.0e-100);
+    return sum;
+}
+
+std::vector<float> designAllpass(double transition)
+{
+    double k = std::tan((1.0 - transition * 2.0) * kPi * 0.25);
+    k *= k;
+    const double root = std::pow(1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - root) / (1.0 + root);
+    const double e4 = e * e * e * e;
+    const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    // Smallest odd order that reaches the attenuation
+    const double ripple = std::pow(10.0, -kAttenuationDb / 10.0);
+    const double a = ripple / (1.0 - ripple);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    order = std::max(3, order | 1);
+
+    std::vector<float> coefficients(static_cast<size_t>((order - 1) / 2));
+    for (int index = 0; index < static_cast<int>(coefficients.size()); ++index) {
+        const double numerator = accumulateNumerator(q, order, index + 1) * std::pow(q, 0.25);
+        const double denominator = accumulateDenominator(q, order, index + 1) + 0.5;
+        const double ww = numerator / denominator;
+        const double wwSquared = ww * ww;
+        const double x = std::sqrt((1.0 - wwSquared * k) * (1.0 - wwSquared / k)) / (1.0 + wwSquared);
+        coefficients[static_cast<size_t>(index)] = static_cast<float>((1.0 - x) / (1.0 + x));
+    }
+    return coefficients;
+}
+
+/** Group delay at DC of the two allpass branches, in samples at the higher rate */
+float getAllpassDelay(const std::vector<float>& coefficients) noexcept
+{
+    double delay = 0.0;
+    for (float c : coefficients)
+        delay += 2.0 * (1.0 - c) / (1.0 + c);
+    return static_cast<float>(delay * 0.5);
+}
+
+//==============================================================================
+double besselI0(double x) noexcept
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 64 && term > 1.0e-12 * sum; ++k) {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+    }
+    return sum;
+}
+
+/** Kaiser-windowed half-band of length 4 * halfTaps - 1; returns the nonzero taps besides the centre, which is 0.5 */
+std::vector<float> designHalfBandFir(int halfTaps)
+{
+    // The odd length puts the centre on an odd index, so the even indices hold the nonzero taps
+    const double beta = 0.1102 * (kAttenuationDb - 8.7);
+    const int length = 4 * halfTaps - 1;
+    const int centre = (length - 1) / 2;
+
+    std::vector<double> taps(static_cast<size_t>(2 * halfTaps));
+    double sum = 0.0;
+    for (int k = 0; k < 2 * halfTaps; ++k) {
+        const double offset = static_cast<double>(2 * k - centre);
+        const double position = 2.0 * (2 * k) / (length - 1) - 1.0;
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - position * position))) / besselI0(beta);
+        taps[static_cast<size_t>(k)] = std::sin(0.5 * kPi * offset) / (kPi * offset) * window;
+        sum += taps[static_cast<size_t>(k)];
+    }
+
+    // Exactly unity gain at DC: the taps sum to one half, like the centre
+    std::vector<float> result(taps.size());
+    for (size_t k = 0; k < taps.size(); ++k)
+        result[k] = static_cast<float>(taps[k] * 0.5 / sum);
+    return result;
+}
+
+/** Largest stopband magnitude of a half-band, in dB, from its zero-phase amplitude on a grid */
+double getStopbandPeak(const std::vector<float>& taps, double transition) noexcept
+{
+    constexpr int kGridPoints = 512;
+    const int centre = static_cast<int>(taps.size()) - 1;
+    const double start = 0.25 + 0.5 * transition;
+
+    double peak = 0.0;
+    for (int point = 0; point <= kGridPoints; ++point) {
+        const double frequency = start + (0.5 - start) * point / kGridPoints;
+        double amplitude = 0.5;
+        for (size_t k = 0; k < taps.size(); ++k)
+            amplitude += taps[k] * std::cos(2.0 * kPi * frequency * static_cast<double>(2 * static_cast<int>(k) - centre));
+        peak = std::max(peak, std::abs(amplitude));
+    }
+    return 20.0 * std::log10(std::max(peak, 1.0e-20));
+}
+
+/** Shortest Kaiser half-band that reaches the attenuation; the length estimate runs short for short filters */
+std::vector<float> designLinearPhase(double transition)
+{
+    const double estimate = (kAttenuationDb - 7.95) / (14.36 * transition) + 1.0;
+    int halfTaps = static_cast<int>(std::ceil((estimate + 1.0) / 4.0));
+
+    auto taps = designHalfBandFir(halfTaps);
+    while (getStopbandPeak(taps, transition) > -kAttenuationDb && halfTaps < 64)
+        taps = designHalfBandFir(++halfTaps);
+    return taps;
+}
+
+//==============================================================================
+/** One first-order allpass section in z^-2, run at the lower rate */
+inline void runSection(float& signal, float c, float& x, float& y) noexcept
+{
+    const float next = (signal - y) * c + x;
+    x = signal;
+    y = signal = next;
+}
+
+/**
+ * Polyphase allpass branches with a compile-time section count. The sections
+ * are unrolled by a fold, so their state stays in registers for the whole
+ * block. Even-numbered sections belong to the first branch, odd-numbered
+ * ones to the second.
+ */
+template <int Count>
+struct AllpassKernel
+{
+    using State = std::array<float, Count>;
+
+    template <size_t... Sections>
+    static void runBranches(float& first, float& second, const State& c, State& x, State& y,
+                            std::index_sequence<Sections...>) noexcept
+    {
+        (runSection(Sections % 2 == 0 ? first : second, c[Sections], x[Sections], y[Sections]), ...);
+    }
+
+    /** Both branches take every input sample and produce alternate output samples */
+    static void upsample(const float* coefficients, float* inputState, float* outputState,
+                         const float* input, float* output, int numSamples) noexcept
+    {
+        State c, x, y;
+        std::copy(coefficients, coefficients + Count, c.begin());
+        std::copy(inputState, inputState + Count, x.begin());
+        std::copy(outputState, outputState + Count, y.begin());
+
+        for (int i = 0; i < numSamples; ++i) {
+            float first = input[i];
+            float second = input[i];
+            runBranches(first, second, c, x, y, std::make_index_sequence<Count>());
+            output[2 * i] = first;
+            output[2 * i + 1] = second;
+        }
+
+        std::copy(x.begin(), x.end(), inputState);
+        std::copy(y.begin(), y.end(), outputState);
+    }
+
+    /** Odd input samples feed the first branch and even ones the second; the output is their mean */
+    static void downsample(const float* coefficients, float* inputState, float* outputState,
+                           const float* input, float* output, int numSamples) noexcept
+    {
+        State c, x, y;
+        std::copy(coefficients, coefficients + Count, c.begin());
+        std::copy(inputState, inputState + Count, x.begin());
+        std::copy(outputState, outputState + Count, y.begin());
+
+        for (int i = 0; i < numSamples; ++i) {
+            float first = input[2 * i + 1];
+            float second = input[2 * i];
+            runBranches(first, second, c, x, y, std::make_index_sequence<Count>());
+            output[i] = 0.5f * (first + second);
+        }
+
+        std::copy(x.begin(), x.end(), inputState);
+        std::copy(y.begin(), y.end(), outputState);
+    }
+};
+
+using AllpassFunction = void (*)(const float*, float*, float*, const float*, float*, int) noexcept;
+
+template <size_t... Indices>
+constexpr std::array<AllpassFunction, sizeof...(Indices)> makeUpsamplers(std::index_sequence<Indices...>) noexcept
+{
+    return { &AllpassKernel<static_cast<int>(Indices) + 1>::upsample... };
+}
+
+template <size_t... Indices>
+constexpr std::array<AllpassFunction, sizeof...(Indices)> makeDownsamplers(std::index_sequence<Indices...>) noexcept
+{
+    return { &AllpassKernel<static_cast<int>(Indices) + 1>::downsample... };
+}
+
+/** Kernels indexed by section count - 1 */
+constexpr auto kUpsamplers = makeUpsamplers(std::make_index_sequence<HalfBandCascade::kMaxAllpass>());
+constexpr auto kDownsamplers = makeDownsamplers(std::make_index_sequence<HalfBandCascade::kMaxAllpass>());
+
+} // namespace
+
+//==============================================================================
+// Designs
+//==============================================================================
+
+HalfBandCascade::HalfBandCascade(int factor, Phase phase)
+    : factor_(factor), phase_(phase)
+{
+    jassert(factor == 1 || factor == 2 || factor == 4 || factor == 8);
+
+    for (int stage = 0; (1 << stage) < factor && stage < kMaxStages; ++stage) {
+        Stage design;
+        if (phase == Phase::Minimum) {
+            design.allpass = designAllpass(getTransition(stage));
+            design.delay = getAllpassDelay(design.allpass);
+        } else {
+            design.taps = designLinearPhase(getTransition(stage));
+            design.delay = static_cast<float>(design.taps.size() - 1);
+        }
+
+        // Up and down, converted from the stage's higher rate to the base rate
+        latency_ += 2.0f * design.delay / static_cast<float>(2 << stage);
+        stages_.push_back(std::move(design));
+    }
+}
+
+std::shared_ptr<const HalfBandCascade> HalfBandCascade::get(int factor, Phase phase)
+{
+    static SharedTableCache<std::pair<int, Phase>, HalfBandCascade> cache;
+
+    factor = factor >= 8 ? 8 : factor >= 4 ? 4 : factor >= 2 ? 2 : 1;
+    return cache.get(std::make_pair(factor, phase), [&] { return std::make_shared<const HalfBandCascade>(factor, phase); });
+}
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void Oversampler::prepare(const Config& config)
+{
+    jassert(config.numChannels > 0 && config.numChannels <= kMaxChannels);
+    jassert(config.maxBlockSize > 0);
+
+    design_ = HalfBandCascade::get(config.factor, config.phase);
+
+    config_ = config;
+    config_.factor = design_->getFactor();
+    config_.numChannels = juce::jlimit(1, kMaxChannels, config.numChannels);
+    config_.maxBlockSize = std::max(1, config.maxBlockSize);
+
+    const int numStages = design_->getNumStages();
+    const size_t channels = static_cast<size_t>(config_.numChannels);
+
+    // Level 0 is only needed to hand out a copy when the factor is 1
+    size_t total = 0;
+    for (int level = numStages == 0 ? 0 : 1; level <= numStages; ++level) {
+        levelOffsets_[static_cast<size_t>(level)] = total;
+        total += channels * static_cast<size_t>(config_.maxBlockSize << level);
+    }
+    buffers_.assign(total, 0.0f);
+    outputPointers_.assign(channels, nullptr);
+
+    size_t maxTaps = 0;
+    for (int stage = 0; stage < numStages; ++stage)
+        maxTaps = std::max(maxTaps, design_->getStage(stage).taps.size());
+
+    // The widest stage input is the last one, at half the top rate
+    const size_t lineSize = static_cast<size_t>(config_.maxBlockSize * config_.factor / 2) + maxTaps;
+    filterLine_.assign(maxTaps > 0 ? lineSize : 0, 0.0f);
+    delayLine_.assign(maxTaps > 0 ? lineSize : 0, 0.0f);
+    accumulator_.assign(maxTaps > 0 ? lineSize : 0, 0.0f);
+
+    states_.assign(channels * static_cast<size_t>(numStages), StageState{});
+    for (size_t index = 0; index < states_.size(); ++index) {
+        const auto& stage = design_->getStage(static_cast<int>(index % static_cast<size_t>(numStages)));
+        jassert(stage.allpass.size() <= static_cast<size_t>(HalfBandCascade::kMaxAllpass));
+
+        const size_t taps = stage.taps.size();
+        states_[index].upHistory.assign(taps > 0 ? taps - 1 : 0, 0.0f);
+        states_[index].evenHistory.assign(taps > 0 ? taps - 1 : 0, 0.0f);
+        states_[index].oddHistory.assign(taps / 2, 0.0f);
+    }
+}
+
+void Oversampler::reset() noexcept
+{
+    for (auto& state : states_) {
+        state.upInput.fill(0.0f);
+        state.upOutput.fill(0.0f);
+        state.downInput.fill(0.0f);
+        state.downOutput.fill(0.0f);
+        std::fill(state.upHistory.begin(), state.upHistory.end(), 0.0f);
+        std::fill(state.evenHistory.begin(), state.evenHistory.end(), 0.0f);
+        std::fill(state.oddHistory.begin(), state.oddHistory.end(), 0.0f);
+    }
+}
+
+float* Oversampler::getBuffer(int level, int channel) noexcept
+{
+    return buffers_.data() + levelOffsets_[static_cast<size_t>(level)]
+         + static_cast<size_t>(channel) * static_cast<size_t>(config_.maxBlockSize << level);
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+float* const* Oversampler::processUp(const float* const* input, int numChannels, int numSamples) noexcept
+{
+    jassert(design_ != nullptr && numChannels <= config_.numChannels && numSamples <= config_.maxBlockSize);
+    numChannels = juce::jmin(numChannels, config_.numChannels);
+    numSamples = juce::jmin(numSamples, config_.maxBlockSize);
+
+    const int numStages = design_->getNumStages();
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (numStages == 0) {
+            std::copy(input[channel], input[channel] + numSamples, getBuffer(0, channel));
+        } else {
+            const float* source = input[channel];
+            for (int stage = 0; stage < numStages; ++stage) {
+                float* destination = getBuffer(stage + 1, channel);
+                upsampleStage(stage, states_[static_cast<size_t>(channel * numStages + stage)],
+                              source, destination, numSamples << stage);
+                source = destination;
+            }
+        }
+        outputPointers_[static_cast<size_t>(channel)] = getBuffer(numStages, channel);
+    }
+
+    return outputPointers_.data();
+}
+
+void Oversampler::processDown(float* const* output, int numChannels, int numSamples) noexcept
+{
+    jassert(design_ != nullptr && numChannels <= config_.numChannels && numSamples <= config_.maxBlockSize);
+    numChannels = juce::jmin(numChannels, config_.numChannels);
+    numSamples = juce::jmin(numSamples, config_.maxBlockSize);
+
+    const int numStages = design_->getNumStages();
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (numStages == 0) {
+            const float* source = getBuffer(0, channel);
+            std::copy(source, source + numSamples, output[channel]);
+            continue;
+        }
+
+        for (int stage = numStages - 1; stage >= 0; --stage) {
+            float* destination = stage == 0 ? output[channel] : getBuffer(stage, channel);
+            downsampleStage(stage, states_[static_cast<size_t>(channel * numStages + stage)],
+                            getBuffer(stage + 1, channel), destination, numSamples << stage);
+        }
+    }
+}
+
+void Oversampler::upsampleStage(int stage, StageState& state, const float* input, float* output, int numSamples) noexcept
+{
+    const auto& design = design_->getStage(stage);
+
+    if (!design.allpass.empty()) {
+        kUpsamplers[design.allpass.size() - 1](design.allpass.data(), state.upInput.data(), state.upOutput.data(),
+                                               input, output, numSamples);
+        return;
+    }
+
+    // Even outputs are the FIR branch, odd ones the centre tap: a delay of halfTaps - 1
+    const float* taps = design.taps.data();
+    const int numTaps = static_cast<int>(design.taps.size());
+    const int history = numTaps - 1;
+    const int halfTaps = numTaps / 2;
+
+    float* line = filterLine_.data();
+    float* sum = accumulator_.data();
+    std::copy(state.upHistory.begin(), state.upHistory.end(), line);
+    std::copy(input, input + numSamples, line + history);
+    std::fill(sum, sum + numSamples, 0.0f);
+
+    // Tap by tap across the block, so every step is a vector multiply-add over the whole block
+    for (int k = 0; k < numTaps; ++k)
+        juce::FloatVectorOperations::addWithMultiply(sum, line + history - k, 2.0f * taps[k], numSamples);
+
+    for (int i = 0; i < numSamples; ++i) {
+        output[2 * i] = sum[i];
+        output[2 * i + 1] = line[i + halfTaps];
+    }
+
+    std::copy(line + numSamples, line + numSamples + history, state.upHistory.begin());
+}
+
+void Oversampler::downsampleStage(int stage, StageState& state, const float* input, float* output, int numSamples) noexcept
+{
+    const auto& design = design_->getStage(stage);
+
+    if (!design.allpass.empty()) {
+        kDownsamplers[design.allpass.size() - 1](design.allpass.data(), state.downInput.data(), state.downOutput.data(),
+                                                 input, output, numSamples);
+        return;
+    }
+
+    // Even inputs go through the FIR branch, odd ones through the centre tap's delay
+    const float* taps = design.taps.data();
+    const int numTaps = static_cast<int>(design.taps.size());
+    const int history = numTaps - 1;
+    const int halfTaps = numTaps / 2;
+
+    float* evenLine = filterLine_.data();
+    float* oddLine = delayLine_.data();
+    float* sum = accumulator_.data();
+    std::copy(state.evenHistory.begin(), state.evenHistory.end(), evenLine);
+    std::copy(state.oddHistory.begin(), state.oddHistory.end(), oddLine);
+    for (int i = 0; i < numSamples; ++i) {
+        evenLine[history + i] = input[2 * i];
+        oddLine[halfTaps + i] = input[2 * i + 1];
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        sum[i] = 0.5f * oddLine[i];
+
+    for (int k = 0; k < numTaps; ++k)
+        juce::FloatVectorOperations::addWithMultiply(sum, evenLine + history - k, taps[k], numSamples);
+
+    std::copy(sum, sum + numSamples, output);
+    std::copy(evenLine + numSamples, evenLine + numSamples + history, state.evenHistory.begin());
+    std::copy(oddLine + numSamples, oddLine + numSamples + halfTaps, state.oddHistory.begin());
+}
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+    oversampler.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Shared half-band oversampling: polyphase IIR or FIR cascades for 2x, 4x
+    and 8x with preallocated per-chain buffers and reported latency
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class HalfBandCascade
+ * @brief Filter designs for every 2x stage of one oversampling factor and phase
+ *
+ * Minimum phase stages are polyphase IIR half-bands: two chains of
+ * first-order allpass sections running at the lower rate, designed from an
+ * elliptic prototype. Linear phase stages are Kaiser-windowed FIR half-bands,
+ * where every other tap is zero, so each polyphase branch is either the
+ * nonzero taps or a plain delay.
+ *
+ * The first stage carries the steep transition from 0.45 fs to 0.55 fs;
+ * later stages only have to reject images of an already band-limited signal,
+ * so they are much shorter. Every stage rejects at least 100 dB.
+ *
+ * Designs are immutable and shared: get() hands out one instance per factor
+ * and phase for as long as anyone holds it.
+ */
+class HalfBandCascade
+{
+public:
+    //==============================================================================
+    enum class Phase : uint8_t { Minimum, Linear };
+
+    static constexpr int kMaxStages = 3;
+    static constexpr int kMaxAllpass = 16;
+
+    struct Stage
+    {
+        /** Minimum phase: allpass coefficients, alternating between the two branches */
+        std::vector<float> allpass;
+
+        /** Linear phase: the nonzero taps of the filtering branch, symmetric */
+        std::vector<float> taps;
+
+        /** Delay of one pass through the stage, up or down, in samples at the stage's higher rate */
+        float delay = 0.0f;
+    };
+
+    //==============================================================================
+    /** Shared designs for factor 1, 2, 4 or 8, built on first use. Not real-time safe. */
+    static std::shared_ptr<const HalfBandCascade> get(int factor, Phase phase);
+
+    /** Use get() */
+    HalfBandCascade(int factor, Phase phase);
+
+    int getFactor() const noexcept { return factor_; }
+    Phase getPhase() const noexcept { return phase_; }
+    int getNumStages() const noexcept { return static_cast<int>(stages_.size()); }
+    const Stage& getStage(int index) const noexcept { return stages_[static_cast<size_t>(index)]; }
+
+    /** Delay of upsampling then downsampling, in samples at the base rate; low-frequency group delay for minimum phase */
+    float getLatency() const noexcept { return latency_; }
+
+private:
+    int factor_;
+    Phase phase_;
+    std::vector<Stage> stages_;
+    float latency_ = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE(HalfBandCascade)
+};
+
+//==============================================================================
+/**
+ * @class Oversampler
+ * @brief One multichannel oversampling chain for a nonlinear stage
+ *
+ * A stage opts in by owning an Oversampler: processUp() runs the input
+ * through the cascade into buffers at factor times the rate, the stage works
+ * on those in place, and processDown() brings them back. Every buffer, filter
+ * state and FIR scratch line is allocated in prepare(), so the audio thread
+ * never allocates. Chains of the same factor and phase share one design and
+ * report the same latency, so a host can compensate every oversampled stage
+ * consistently.
+ */
+class Oversampler
+{
+public:
+    //==============================================================================
+    using Phase = HalfBandCascade::Phase;
+
+    static constexpr int kMaxFactor = 8;
+
+    /** Most channels in one chain */
+    static constexpr int kMaxChannels = 64;
+
+    struct Config
+    {
+        int factor = 2;                 // 1, 2, 4 or 8; 1 passes audio straight through
+        Phase phase = Phase::Minimum;
+        int numChannels = 2;
+        int maxBlockSize = 512;         // Base-rate samples per call
+    };
+
+    //==============================================================================
+    Oversampler() = default;
+
+    /** Fetch the design and allocate every buffer. Not real-time safe. */
+    void prepare(const Config& config);
+
+    /** Clear the filter state */
+    void reset() noexcept;
+
+    int getFactor() const noexcept { return config_.factor; }
+    Phase getPhase() const noexcept { return config_.phase; }
+    int getNumChannels() const noexcept { return config_.numChannels; }
+    int getMaxBlockSize() const noexcept { return config_.maxBlockSize; }
+
+    /** Delay added by processUp() then processDown(), in base-rate samples */
+    float getLatency() const noexcept { return design_ != nullptr ? design_->getLatency() : 0.0f; }
+
+    //==============================================================================
+    /**
+     * Upsample numSamples (at most getMaxBlockSize()) of the first numChannels
+     * channels. Returns channel pointers to numSamples * getFactor() samples,
+     * which stay valid until the next call and may be processed in place.
+     */
+    float* const* processUp(const float* const* input, int numChannels, int numSamples) noexcept;
+
+    /** Downsample the buffers returned by the last processUp() into numSamples of each channel */
+    void processDown(float* const* output, int numChannels, int numSamples) noexcept;
+
+    /**
+     * Oversample channels in place around callback(float* const* channels,
+     * int numOversampledSamples), in pieces of at most getMaxBlockSize().
+     */
+    template <typename Callback>
+    void process(float* const* channels, int numChannels, int numSamples, Callback&& callback) noexcept
+    {
+        std::array<float*, kMaxChannels> piece{};
+        numChannels = juce::jmin(numChannels, config_.numChannels);
+
+        for (int offset = 0; offset < numSamples; offset += config_.maxBlockSize) {
+            const int count = juce::jmin(config_.maxBlockSize, numSamples - offset);
+            for (int channel = 0; channel < numChannels; ++channel)
+                piece[static_cast<size_t>(channel)] = channels[channel] + offset;
+
+            callback(processUp(piece.data(), numChannels, count), count * config_.factor);
+            processDown(piece.data(), numChannels, count);
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr int kMaxAllpass = HalfBandCascade::kMaxAllpass;
+
+    /** One channel's state for one stage */
+    struct StageState
+    {
+        std::array<float, kMaxAllpass> upInput{}, upOutput{};
+        std::array<float, kMaxAllpass> downInput{}, downOutput{};
+        std::vector<float> upHistory, evenHistory, oddHistory;
+    };
+
+    void upsampleStage(int stage, StageState& state, const float* input, float* output, int numSamples) noexcept;
+    void downsampleStage(int stage, StageState& state, const float* input, float* output, int numSamples) noexcept;
+
+    float* getBuffer(int level, int channel) noexcept;
+
+    Config config_;
+    std::shared_ptr<const HalfBandCascade> design_;
+
+    /** Buffers for every level above the base rate, channel-major */
+    std::vector<float> buffers_;
+    std::array<size_t, HalfBandCascade::kMaxStages + 1> levelOffsets_{};
+    std::vector<float*> outputPointers_;
+
+    /** numChannels x numStages */
+    std::vector<StageState> states_;
+
+    /** FIR lines (history followed by the block) for the filtering and delay branches, and the branch sum */
+    std::vector<float> filterLine_, delayLine_, accumulator_;
+
+    JUCE_DECLARE_NON_COPYABLE(Oversampler)
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
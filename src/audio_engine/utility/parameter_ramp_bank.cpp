@@ -0,0 +1,376 @@
+/*
+  ==============================================================================
+    parameter_ramp_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Implementation of the parameter ramp bank
+  ==============================================================================
+*/
+
+#include "parameter_ramp_bank.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_RAMP_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_RAMP_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+namespace {
+
+/** dest[i] = start + increment * (i + 1); each lane is computed from its index so no error accumulates */
+inline void fillLinearRamp(float* dest, float start, float increment, int numSamples) noexcept
+{
+    int i = 0;
+
+   #if VITAL_RAMP_SSE
+    const __m128 startV = _mm_set1_ps(start);
+    const __m128 incrementV = _mm_set1_ps(increment);
+    const __m128 four = _mm_set1_ps(4.0f);
+    __m128 index = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(dest + i, _mm_add_ps(startV, _mm_mul_ps(incrementV, index)));
+        index = _mm_add_ps(index, four);
+    }
+   #elif VITAL_RAMP_NEON
+    const float32x4_t startV = vdupq_n_f32(start);
+    const float32x4_t four = vdupq_n_f32(4.0f);
+    const float indices[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    float32x4_t index = vld1q_f32(indices);
+
+    for (; i + 4 <= numSamples; i += 4) {
+        vst1q_f32(dest + i, vmlaq_n_f32(startV, index, increment));
+        index = vaddq_f32(index, four);
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+        dest[i] = start + increment * static_cast<float>(i + 1);
+}
+
+} // namespace
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void ParameterRampBank::prepare(const Config& config)
+{
+    jassert(config.numParameters > 0);
+    jassert(config.maxBlockSize > 0);
+
+    config_ = config;
+    config_.maxActiveRamps = std::max(0, config_.maxActiveRamps);
+    numWords_ = (static_cast<size_t>(config_.numParameters) + 63) / 64;
+
+    const auto numParameters = static_cast<size_t>(config_.numParameters);
+    const int defaultRampSamples = static_cast<int>(std::round(config_.defaultSmoothingMs * 0.001 * config_.sampleRate));
+
+    targets_ = std::make_unique<std::atomic<float>[]>(numParameters);
+    rampSamples_ = std::make_unique<std::atomic<int>[]>(numParameters);
+    pending_ = std::make_unique<std::atomic<uint64_t>[]>(numWords_);
+
+    for (size_t i = 0; i < numParameters; ++i) {
+        targets_[i].store(0.0f, std::memory_order_relaxed);
+        rampSamples_[i].store(defaultRampSamples, std::memory_order_relaxed);
+    }
+
+    for (size_t word = 0; word < numWords_; ++word)
+        pending_[word].store(0, std::memory_order_relaxed);
+
+    current_.assign(numParameters, 0.0f);
+    increment_.assign(numParameters, 0.0f);
+    rampTarget_.assign(numParameters, 0.0f);
+    remaining_.assign(numParameters, 0);
+    rampSlot_.assign(numParameters, -1);
+    active_.assign(numWords_, 0);
+    finished_.assign(numWords_, 0);
+    changed_.assign(numWords_, 0);
+    numChanged_ = 0;
+    numDroppedRamps_ = 0;
+
+    rampBuffers_.assign(static_cast<size_t>(config_.maxActiveRamps) * static_cast<size_t>(config_.maxBlockSize), 0.0f);
+    freeSlots_.clear();
+    freeSlots_.reserve(static_cast<size_t>(config_.maxActiveRamps));
+    for (int slot = config_.maxActiveRamps - 1; slot >= 0; --slot)
+        freeSlots_.push_back(slot);
+
+    for (auto& subscription : subscriptions_) {
+        for (auto& mask : subscription->masks)
+            mask.resize(numWords_, 0);
+        subscription->staged.resize(numWords_, 0);
+    }
+}
+
+void ParameterRampBank::reset() noexcept
+{
+    adoptSubscriptions();
+
+    for (size_t word = 0; word < numWords_; ++word)
+        pending_[word].store(0, std::memory_order_relaxed);
+
+    for (int paramId = 0; paramId < config_.numParameters; ++paramId) {
+        releaseSlot(paramId);
+        current_[static_cast<size_t>(paramId)] = targets_[static_cast<size_t>(paramId)].load(std::memory_order_relaxed);
+        remaining_[static_cast<size_t>(paramId)] = 0;
+    }
+
+    std::fill(active_.begin(), active_.end(), 0);
+    std::fill(finished_.begin(), finished_.end(), 0);
+    std::fill(changed_.begin(), changed_.end(), 0);
+    numChanged_ = 0;
+}
+
+//==============================================================================
+// Message thread
+//==============================================================================
+
+void ParameterRampBank::setTarget(int paramId, float value) noexcept
+{
+    if (!isValidId(paramId)) return;
+
+    // Publish the value before the dirty bit so process() never sees the bit without it
+    targets_[static_cast<size_t>(paramId)].store(value, std::memory_order_relaxed);
+    pending_[wordIndex(paramId)].fetch_or(bitMask(paramId), std::memory_order_release);
+}
+
+void ParameterRampBank::setSmoothingTime(int paramId, float timeMs) noexcept
+{
+    if (!isValidId(paramId)) return;
+
+    const int samples = static_cast<int>(std::round(std::max(0.0f, timeMs) * 0.001 * config_.sampleRate));
+    rampSamples_[static_cast<size_t>(paramId)].store(samples, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Subscriptions
+//==============================================================================
+
+int ParameterRampBank::addSubscriber()
+{
+    auto subscription = std::make_unique<Subscription>();
+    for (auto& mask : subscription->masks)
+        mask.assign(numWords_, 0);
+    subscription->staged.assign(numWords_, 0);
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    subscriptions_.push_back(std::move(subscription));
+    return static_cast<int>(subscriptions_.size()) - 1;
+}
+
+void ParameterRampBank::subscribe(int subscriber, int paramId) noexcept
+{
+    subscribeRange(subscriber, paramId, 1);
+}
+
+void ParameterRampBank::subscribeRange(int subscriber, int firstParamId, int numParams) noexcept
+{
+    jassert(subscriber >= 0 && subscriber < static_cast<int>(subscriptions_.size()));
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto& subscription = *subscriptions_[static_cast<size_t>(subscriber)];
+
+    const int end = std::min(firstParamId + numParams, config_.numParameters);
+    for (int paramId = std::max(0, firstParamId); paramId < end; ++paramId)
+        subscription.staged[wordIndex(paramId)] |= bitMask(paramId);
+
+    publishSubscription(subscription);
+}
+
+void ParameterRampBank::subscribeAll(int subscriber) noexcept
+{
+    subscribeRange(subscriber, 0, config_.numParameters);
+}
+
+void ParameterRampBank::unsubscribeAll(int subscriber) noexcept
+{
+    setSubscription(subscriber, nullptr, 0);
+}
+
+void ParameterRampBank::setSubscription(int subscriber, const int* paramIds, int numIds) noexcept
+{
+    jassert(subscriber >= 0 && subscriber < static_cast<int>(subscriptions_.size()));
+
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    auto& subscription = *subscriptions_[static_cast<size_t>(subscriber)];
+
+    std::fill(subscription.staged.begin(), subscription.staged.end(), 0);
+    for (int i = 0; i < numIds; ++i) {
+        if (isValidId(paramIds[i]))
+            subscription.staged[wordIndex(paramIds[i])] |= bitMask(paramIds[i]);
+    }
+
+    publishSubscription(subscription);
+}
+
+bool ParameterRampBank::isSubscribed(int subscriber, int paramId) const noexcept
+{
+    if (subscriber < 0 || subscriber >= static_cast<int>(subscriptions_.size()) || !isValidId(paramId))
+        return false;
+
+    return (subscriptions_[static_cast<size_t>(subscriber)]->liveMask()[wordIndex(paramId)] & bitMask(paramId)) != 0;
+}
+
+void ParameterRampBank::publishSubscription(Subscription& subscription) noexcept
+{
+    auto& back = subscription.masks[static_cast<size_t>(subscription.back)];
+    std::copy(subscription.staged.begin(), subscription.staged.end(), back.begin());
+
+    // Whatever was pending, adopted or not, becomes the next back buffer
+    const int previous = subscription.pending.exchange(subscription.back | Subscription::kFresh, std::memory_order_acq_rel);
+    subscription.back = previous & ~Subscription::kFresh;
+}
+
+void ParameterRampBank::adoptSubscriptions() noexcept
+{
+    for (auto& subscription : subscriptions_) {
+        if ((subscription->pending.load(std::memory_order_relaxed) & Subscription::kFresh) == 0) continue;
+
+        const int next = subscription->pending.exchange(subscription->live, std::memory_order_acq_rel);
+        subscription->live = next & ~Subscription::kFresh;
+    }
+}
+
+//==============================================================================
+// Audio thread
+//==============================================================================
+
+void ParameterRampBank::process(int numSamples) noexcept
+{
+    jassert(numSamples <= config_.maxBlockSize);
+    numSamples = std::min(numSamples, config_.maxBlockSize);
+
+    numChanged_ = 0;
+    adoptSubscriptions();
+
+    for (size_t word = 0; word < numWords_; ++word) {
+        changed_[word] = 0;
+
+        // Ramps that completed last block hand their buffer back now that nobody reads it
+        for (uint64_t bits = finished_[word]; bits != 0; bits &= bits - 1)
+            releaseSlot(static_cast<int>(word * 64) + std::countr_zero(bits));
+        finished_[word] = 0;
+
+        for (uint64_t bits = pending_[word].exchange(0, std::memory_order_acquire); bits != 0; bits &= bits - 1) {
+            const int paramId = static_cast<int>(word * 64) + std::countr_zero(bits);
+            startRamp(paramId, targets_[static_cast<size_t>(paramId)].load(std::memory_order_relaxed));
+        }
+
+        for (uint64_t bits = active_[word]; bits != 0; bits &= bits - 1)
+            advanceRamp(static_cast<int>(word * 64) + std::countr_zero(bits), numSamples);
+
+        numChanged_ += std::popcount(changed_[word]);
+    }
+}
+
+void ParameterRampBank::jumpTo(int paramId, float value) noexcept
+{
+    if (!isValidId(paramId)) return;
+
+    const auto index = static_cast<size_t>(paramId);
+    const auto word = wordIndex(paramId);
+    const auto bit = bitMask(paramId);
+
+    targets_[index].store(value, std::memory_order_relaxed);
+    current_[index] = value;
+    remaining_[index] = 0;
+    active_[word] &= ~bit;
+    changed_[word] &= ~bit;
+
+    // The ramp buffer may still be read this block, so it is returned on the next process()
+    if (rampSlot_[index] >= 0)
+        finished_[word] |= bit;
+}
+
+const float* ParameterRampBank::getRamp(int paramId) const noexcept
+{
+    const int slot = rampSlot_[static_cast<size_t>(paramId)];
+    if (slot < 0 || !hasChanged(paramId)) return nullptr;
+
+    return rampBuffers_.data() + static_cast<size_t>(slot) * static_cast<size_t>(config_.maxBlockSize);
+}
+
+void ParameterRampBank::startRamp(int paramId, float target) noexcept
+{
+    const auto index = static_cast<size_t>(paramId);
+    const auto word = wordIndex(paramId);
+    const auto bit = bitMask(paramId);
+    const int rampSamples = rampSamples_[index].load(std::memory_order_relaxed);
+
+    if (target == current_[index] && remaining_[index] == 0) return;
+
+    if (rampSamples > 1) {
+        if (rampSlot_[index] < 0 && !freeSlots_.empty()) {
+            rampSlot_[index] = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+
+        if (rampSlot_[index] >= 0) {
+            increment_[index] = (target - current_[index]) / static_cast<float>(rampSamples);
+            rampTarget_[index] = target;
+            remaining_[index] = rampSamples;
+            active_[word] |= bit;
+            return;
+        }
+
+        ++numDroppedRamps_;
+    }
+
+    // Unsmoothed: step to the target for the whole block
+    releaseSlot(paramId);
+    current_[index] = target;
+    remaining_[index] = 0;
+    active_[word] &= ~bit;
+    changed_[word] |= bit;
+}
+
+void ParameterRampBank::advanceRamp(int paramId, int numSamples) noexcept
+{
+    const auto index = static_cast<size_t>(paramId);
+    const auto word = wordIndex(paramId);
+    const auto bit = bitMask(paramId);
+
+    float* ramp = rampBuffers_.data() + static_cast<size_t>(rampSlot_[index]) * static_cast<size_t>(config_.maxBlockSize);
+    const float start = current_[index];
+    const int rampLength = std::min(remaining_[index], numSamples);
+
+    fillLinearRamp(ramp, start, increment_[index], rampLength);
+    remaining_[index] -= rampLength;
+
+    if (remaining_[index] == 0) {
+        // Land exactly on the target whatever the increment's rounding, and hold it for the rest of the block
+        current_[index] = rampTarget_[index];
+
+        if (rampLength > 0)
+            ramp[rampLength - 1] = current_[index];
+        std::fill(ramp + rampLength, ramp + numSamples, current_[index]);
+
+        active_[word] &= ~bit;
+        finished_[word] |= bit;
+    } else {
+        current_[index] = ramp[rampLength - 1];
+    }
+
+    changed_[word] |= bit;
+}
+
+void ParameterRampBank::releaseSlot(int paramId) noexcept
+{
+    auto& slot = rampSlot_[static_cast<size_t>(paramId)];
+    if (slot >= 0) {
+        freeSlots_.push_back(slot);
+        slot = -1;
+    }
+}
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+    parameter_ramp_bank.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Lock-free parameter change handoff with per-sample smoothing ramps
+    and per-consumer change subscriptions
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <bit>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class ParameterRampBank
+ * @brief Dirty-tracked parameter values with per-sample ramp buffers
+ *
+ * Any thread may post a new target with setTarget(): the value goes into a
+ * per-parameter atomic and the parameter's bit is set in an atomic pending
+ * bitset, so posting never locks or allocates and repeated changes between
+ * blocks coalesce into one.
+ *
+ * Once per block the audio thread calls process(), which swaps out the
+ * pending words, starts a linear ramp for every new target and advances the
+ * ramps already running. Parameters that moved this block are flagged in a
+ * changed bitset; forEachChanged() walks only those bits, masked by the ids a
+ * consumer subscribed to, so a quiet block costs one pass over
+ * numParameters / 64 words instead of one call per parameter and consumer.
+ *
+ * A ramping parameter gets a block-sized buffer of per-sample values from a
+ * fixed pool, which DSP code reads through getRamp(). When the pool is
+ * exhausted the parameter jumps to its target instead.
+ *
+ * Subscriptions may be edited from any thread while the audio thread reads
+ * them. Each subscriber's mask is triple buffered: edits are applied to a
+ * staged copy under a writer-side mutex and published whole, and process()
+ * adopts the newest published mask at the start of the block, so a consumer
+ * never sees a half-rewritten subscription.
+ */
+class ParameterRampBank
+{
+public:
+    //==============================================================================
+    struct Config
+    {
+        int numParameters = 1024;
+        int maxBlockSize = 512;
+        int maxActiveRamps = 64;            // Ramp buffers in the pool
+        double sampleRate = 48000.0;
+        float defaultSmoothingMs = 20.0f;   // 0 jumps straight to the target
+    };
+
+    //==============================================================================
+    ParameterRampBank() = default;
+    ~ParameterRampBank() = default;
+
+    /** Allocate all storage and reset every value to zero. Not real-time safe. */
+    void prepare(const Config& config);
+
+    /** Jump every parameter to its latest target and drop running ramps (audio thread) */
+    void reset() noexcept;
+
+    int getNumParameters() const noexcept { return config_.numParameters; }
+
+    //==============================================================================
+    /** Post a new target; lock-free and callable from any thread */
+    void setTarget(int paramId, float value) noexcept;
+
+    /** Ramp length for future targets of paramId; lock-free and callable from any thread */
+    void setSmoothingTime(int paramId, float timeMs) noexcept;
+
+    //==============================================================================
+    /** Register a consumer with an empty subscription, before processing starts. Not real-time safe. */
+    int addSubscriber();
+
+    /** Edits take effect at the next process(); callable from any thread but the audio thread */
+    void subscribe(int subscriber, int paramId) noexcept;
+    void subscribeRange(int subscriber, int firstParamId, int numParams) noexcept;
+    void subscribeAll(int subscriber) noexcept;
+    void unsubscribeAll(int subscriber) noexcept;
+
+    /** Replace the whole subscription in one step */
+    void setSubscription(int subscriber, const int* paramIds, int numIds) noexcept;
+
+    /** Against the mask adopted by the last process() (audio thread) */
+    bool isSubscribed(int subscriber, int paramId) const noexcept;
+
+    //==============================================================================
+    /** Consume posted targets and advance ramps by numSamples (audio thread) */
+    void process(int numSamples) noexcept;
+
+    /**
+     * Set a value immediately and cancel its ramp, e.g. for sample-accurate
+     * automation (audio thread). The caller applies the value itself, so the
+     * parameter is no longer reported as changed for this block.
+     */
+    void jumpTo(int paramId, float value) noexcept;
+
+    /**
+     * Calls fn(paramId, value, ramp) for every parameter that changed in the
+     * last process() call and that subscriber is subscribed to. value is the
+     * value at the end of the block; ramp holds one value per sample, or is
+     * nullptr when the parameter stepped without smoothing.
+     */
+    template <typename Function>
+    void forEachChanged(int subscriber, Function&& fn) const noexcept
+    {
+        jassert(subscriber >= 0 && subscriber < static_cast<int>(subscriptions_.size()));
+        const uint64_t* mask = subscriptions_[static_cast<size_t>(subscriber)]->liveMask();
+
+        for (size_t word = 0; word < changed_.size(); ++word) {
+            uint64_t bits = changed_[word] & mask[word];
+
+            while (bits != 0) {
+                const int paramId = static_cast<int>(word * 64) + std::countr_zero(bits);
+                bits &= bits - 1;
+                fn(paramId, current_[static_cast<size_t>(paramId)], getRamp(paramId));
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Value at the end of the last processed block */
+    float getValue(int paramId) const noexcept { return current_[static_cast<size_t>(paramId)]; }
+
+    /** Per-sample values for the last processed block, or nullptr if the parameter is not ramping */
+    const float* getRamp(int paramId) const noexcept;
+
+    bool hasChanged(int paramId) const noexcept
+    {
+        return (changed_[static_cast<size_t>(paramId) >> 6] >> (paramId & 63)) & 1u;
+    }
+
+    bool isRamping(int paramId) const noexcept
+    {
+        return (active_[static_cast<size_t>(paramId) >> 6] >> (paramId & 63)) & 1u;
+    }
+
+    int getNumChanged() const noexcept { return numChanged_; }
+
+    /** Ramps that jumped to their target because the buffer pool was full */
+    int getNumDroppedRamps() const noexcept { return numDroppedRamps_; }
+
+private:
+    //==============================================================================
+    static size_t wordIndex(int paramId) noexcept { return static_cast<size_t>(paramId) >> 6; }
+    static uint64_t bitMask(int paramId) noexcept { return uint64_t(1) << (paramId & 63); }
+
+    bool isValidId(int paramId) const noexcept { return paramId >= 0 && paramId < config_.numParameters; }
+
+    /**
+     * One subscriber's masks: the audio thread reads masks[live], writers fill
+     * masks[back], and pending holds the third index, with kFresh set while it
+     * has been published but not adopted.
+     */
+    struct Subscription
+    {
+        static constexpr int kFresh = 4;
+
+        std::array<std::vector<uint64_t>, 3> masks;
+        std::vector<uint64_t> staged;
+        int live = 0;
+        int back = 1;
+        std::atomic<int> pending{ 2 };
+
+        const uint64_t* liveMask() const noexcept { return masks[static_cast<size_t>(live)].data(); }
+    };
+
+    void startRamp(int paramId, float target) noexcept;
+    void advanceRamp(int paramId, int numSamples) noexcept;
+    void releaseSlot(int paramId) noexcept;
+
+    /** Writer side, with subscriptionMutex_ held: publish the staged mask */
+    void publishSubscription(Subscription& subscription) noexcept;
+
+    /** Audio thread: adopt every freshly published mask */
+    void adoptSubscriptions() noexcept;
+
+    Config config_;
+    size_t numWords_ = 0;
+
+    /** Shared with posting threads */
+    std::unique_ptr<std::atomic<float>[]> targets_;
+    std::unique_ptr<std::atomic<int>[]> rampSamples_;
+    std::unique_ptr<std::atomic<uint64_t>[]> pending_;
+
+    /** Audio thread state */
+    std::vector<float> current_;
+    std::vector<float> increment_;
+    std::vector<float> rampTarget_;
+    std::vector<int> remaining_;
+    std::vector<int> rampSlot_;
+    std::vector<uint64_t> active_;
+    std::vector<uint64_t> finished_;
+    std::vector<uint64_t> changed_;
+    int numChanged_ = 0;
+    int numDroppedRamps_ = 0;
+
+    /** Ramp buffer pool, maxActiveRamps x maxBlockSize */
+    std::vector<float> rampBuffers_;
+    std::vector<int> freeSlots_;
+
+    /** Subscriber masks of numWords_ words each; the mutex only orders writers */
+    std::vector<std::unique_ptr<Subscription>> subscriptions_;
+    std::mutex subscriptionMutex_;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(ParameterRampBank)
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
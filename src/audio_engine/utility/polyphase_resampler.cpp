@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+    polyphase_resampler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Sinc table design, the vectorised tap kernel and the streaming converter
+  ==============================================================================
+*/
+
+#include "polyphase_resampler.h"
+#include "shared_table_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define VITAL_RESAMPLER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define VITAL_RESAMPLER_NEON 1
+#endif
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+namespace {
+
+constexpr double kPi = juce::MathConstants<double>::pi;
+
+/** Interpolated ratios step in 32.32 fixed point; the top bits of the fraction pick the row */
+constexpr int kFractionBits = 32;
+constexpr int kRowBits = 10;
+constexpr int kRowShift = kFractionBits - kRowBits;
+static_assert((1 << kRowBits) == PolyphaseSincTable::kInterpolatedPhases, "row bits must match the table");
+
+double besselI0(double x) noexcept
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 64 && term > 1.0e-12 * sum; ++k) {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+    }
+    return sum;
+}
+
+double getKaiserBeta(double attenuationDb) noexcept
+{
+    if (attenuationDb > 50.0) return 0.1102 * (attenuationDb - 8.7);
+    if (attenuationDb > 21.0) return 0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0);
+    return 0.0;
+}
+
+bool isWhole(double rate) noexcept
+{
+    return rate >= 1.0 && std::abs(rate - std::round(rate)) < 1.0e-9 * rate;
+}
+
+//==============================================================================
+#if defined(__AVX__)
+inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 sum) noexcept
+{
+   #if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, sum);
+   #else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), sum);
+   #endif
+}
+#endif
+
+/** Dot product of an input line and a table row; numTaps is a multiple of kTapAlignment */
+inline float dot(const float* input, const float* taps, int numTaps) noexcept
+{
+    int k = 0;
+
+   #if defined(__AVX__)
+    __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps(), sum3 = _mm256_setzero_ps();
+    for (; k + 32 <= numTaps; k += 32) {
+        sum0 = multiplyAdd(_mm256_loadu_ps(input + k),      _mm256_loadu_ps(taps + k),      sum0);
+        sum1 = multiplyAdd(_mm256_loadu_ps(input + k + 8),  _mm256_loadu_ps(taps + k + 8),  sum1);
+        sum2 = multiplyAdd(_mm256_loadu_ps(input + k + 16), _mm256_loadu_ps(taps + k + 16), sum2);
+        sum3 = multiplyAdd(_mm256_loadu_ps(input + k + 24), _mm256_loadu_ps(taps + k + 24), sum3);
+    }
+    for (; k < numTaps; k += 8)
+        sum0 = multiplyAdd(_mm256_loadu_ps(input + k), _mm256_loadu_ps(taps + k), sum0);
+
+    const __m256 sum = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    return _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 1)));
+   #elif VITAL_RESAMPLER_SSE
+    __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+    for (; k < numTaps; k += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(input + k),     _mm_loadu_ps(taps + k)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(input + k + 4), _mm_loadu_ps(taps + k + 4)));
+    }
+    __m128 sum = _mm_add_ps(sum0, sum1);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+   #elif VITAL_RESAMPLER_NEON
+    float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+    for (; k < numTaps; k += 8) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(input + k),     vld1q_f32(taps + k));
+        sum1 = vmlaq_f32(sum1, vld1q_f32(input + k + 4), vld1q_f32(taps + k + 4));
+    }
+    const float32x4_t sum = vaddq_f32(sum0, sum1);
+    const float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+   #else
+    std::array<float, PolyphaseSincTable::kTapAlignment> sums{};
+    for (; k < numTaps; k += PolyphaseSincTable::kTapAlignment)
+        for (int lane = 0; lane < PolyphaseSincTable::kTapAlignment; ++lane)
+            sums[static_cast<size_t>(lane)] += input[k + lane] * taps[k + lane];
+    return std::accumulate(sums.begin(), sums.end(), 0.0f);
+   #endif
+}
+
+} // namespace
+
+//==============================================================================
+// Sinc Tables
+//==============================================================================
+
+bool PolyphaseSincTable::Design::operator<(const Design& other) const noexcept
+{
+    return std::tie(numPhases, numTaps, cutoff, attenuationDb)
+         < std::tie(other.numPhases, other.numTaps, other.cutoff, other.attenuationDb);
+}
+
+PolyphaseSincTable::PolyphaseSincTable(const Design& design)
+    : design_(design),
+      rows_(static_cast<size_t>(design.numPhases + 1) * static_cast<size_t>(design.numTaps))
+{
+    jassert(design_.numTaps % kTapAlignment == 0 && design_.numPhases > 0);
+
+    const double beta = getKaiserBeta(design_.attenuationDb);
+    const double normaliser = 1.0 / besselI0(beta);
+    const double cutoff = design_.cutoff;
+    const double half = 0.5 * design_.numTaps;
+
+    std::vector<double> row(static_cast<size_t>(design_.numTaps));
+    for (int phase = 0; phase <= design_.numPhases; ++phase) {
+        const double fraction = static_cast<double>(phase) / design_.numPhases;
+
+        // Tap k meets the input sample this far before the output time
+        double sum = 0.0;
+        for (int k = 0; k < design_.numTaps; ++k) {
+            const double distance = half - 1.0 + fraction - k;
+            const double position = distance / half;
+            const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - position * position))) * normaliser;
+            const double argument = kPi * cutoff * distance;
+            const double sinc = std::abs(argument) < 1.0e-12 ? 1.0 : std::sin(argument) / argument;
+            row[static_cast<size_t>(k)] = cutoff * sinc * window;
+            sum += row[static_cast<size_t>(k)];
+        }
+
+        float* destination = rows_.data() + static_cast<size_t>(phase) * static_cast<size_t>(design_.numTaps);
+        for (int k = 0; k < design_.numTaps; ++k)
+            destination[k] = static_cast<float>(row[static_cast<size_t>(k)] / sum);
+    }
+}
+
+std::shared_ptr<const PolyphaseSincTable> PolyphaseSincTable::get(const Design& design)
+{
+    static SharedTableCache<Design, PolyphaseSincTable> cache;
+
+    return cache.get(design, [&] { return std::make_shared<const PolyphaseSincTable>(design); });
+}
+
+//==============================================================================
+// Setup
+//==============================================================================
+
+void PolyphaseResampler::prepare(const Config& config)
+{
+    jassert(config.inputRate > 0.0 && config.outputRate > 0.0);
+
+    config_ = config;
+    config_.numChannels = juce::jlimit(1, kMaxChannels, config.numChannels);
+
+    // Downsampling widens the kernel so the cutoff tracks the output Nyquist
+    const double scale = std::min(1.0, getRatio());
+    const int baseTaps = std::max(PolyphaseSincTable::kTapAlignment, config_.numTaps);
+    numTaps_ = static_cast<int>(std::ceil(baseTaps / scale));
+    numTaps_ = (numTaps_ + PolyphaseSincTable::kTapAlignment - 1) / PolyphaseSincTable::kTapAlignment
+             * PolyphaseSincTable::kTapAlignment;
+
+    PolyphaseSincTable::Design design;
+    design.numTaps = numTaps_;
+    design.cutoff = static_cast<float>(juce::jlimit(0.01, 1.0, static_cast<double>(config_.cutoff)) * scale);
+    design.attenuationDb = config_.attenuationDb;
+
+    // Whole rates reduce to L / M; the output step is M / L input samples
+    interpolate_ = true;
+    if (isWhole(config_.inputRate) && isWhole(config_.outputRate)) {
+        const auto input = static_cast<int64_t>(std::llround(config_.inputRate));
+        const auto output = static_cast<int64_t>(std::llround(config_.outputRate));
+        const int64_t divisor = std::gcd(input, output);
+
+        if (output / divisor <= PolyphaseSincTable::kMaxExactPhases) {
+            interpolate_ = false;
+            denominator_ = output / divisor;
+            stepWhole_ = (input / divisor) / denominator_;
+            stepFraction_ = (input / divisor) % denominator_;
+        }
+    }
+
+    if (interpolate_) {
+        const auto step = static_cast<int64_t>(std::llround(config_.inputRate / config_.outputRate
+                                                            * static_cast<double>(int64_t{ 1 } << kFractionBits)));
+        denominator_ = int64_t{ 1 } << kFractionBits;
+        stepWhole_ = step >> kFractionBits;
+        stepFraction_ = step & (denominator_ - 1);
+    }
+
+    design.numPhases = interpolate_ ? PolyphaseSincTable::kInterpolatedPhases : static_cast<int>(denominator_);
+    table_ = PolyphaseSincTable::get(design);
+
+    lineLength_ = numTaps_ + kChunk;
+    lines_.assign(static_cast<size_t>(config_.numChannels) * static_cast<size_t>(lineLength_), 0.0f);
+    silence_.assign(static_cast<size_t>(numTaps_ / 2), 0.0f);
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    std::fill(lines_.begin(), lines_.end(), 0.0f);
+    filled_ = config_.timeAligned ? numTaps_ / 2 - 1 : numTaps_ - 1;
+    start_ = 0;
+    phase_ = 0;
+}
+
+float PolyphaseResampler::getLatency() const noexcept
+{
+    return config_.timeAligned ? 0.0f : static_cast<float>(numTaps_ / 2);
+}
+
+int PolyphaseResampler::getRequiredInput(int numOutput) const noexcept
+{
+    if (numOutput <= 0 || table_ == nullptr) return 0;
+
+    const int64_t position = phase_ + static_cast<int64_t>(numOutput - 1) * (stepWhole_ * denominator_ + stepFraction_);
+    const int64_t lastStart = start_ + position / denominator_;
+    return static_cast<int>(std::max<int64_t>(0, lastStart + numTaps_ - filled_));
+}
+
+int PolyphaseResampler::getMaxOutput(int numInput) const noexcept
+{
+    if (table_ == nullptr) return 0;
+
+    const int64_t spare = static_cast<int64_t>(filled_) + numInput - numTaps_ - start_;
+    if (spare < 0) return 0;
+
+    const int64_t count = (spare * denominator_ - phase_) / (stepWhole_ * denominator_ + stepFraction_) + 1;
+    return static_cast<int>(std::min<int64_t>(count, std::numeric_limits<int>::max()));
+}
+
+//==============================================================================
+// Processing
+//==============================================================================
+
+PolyphaseResampler::Result PolyphaseResampler::process(const float* const* input, int numChannels, int numInput,
+                                                       float* const* output, int maxOutput) noexcept
+{
+    Result result;
+    if (table_ == nullptr) return result;
+
+    numChannels = juce::jmin(numChannels, config_.numChannels);
+
+    for (;;) {
+        result.produced += interpolate_ ? render<true>(numChannels, output, result.produced, maxOutput)
+                                        : render<false>(numChannels, output, result.produced, maxOutput);
+
+        // Stop when the input is used up, or when outputs are ready but there is no room for them
+        if (result.consumed >= numInput || start_ + numTaps_ <= filled_)
+            break;
+
+        compact();
+
+        const int count = juce::jmin(lineLength_ - filled_, numInput - result.consumed);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float* source = input[channel] + result.consumed;
+            std::copy(source, source + count, lines_.data() + static_cast<size_t>(channel * lineLength_ + filled_));
+        }
+
+        filled_ += count;
+        result.consumed += count;
+    }
+
+    return result;
+}
+
+int PolyphaseResampler::flush(float* const* output, int numChannels, int maxOutput) noexcept
+{
+    std::array<const float*, kMaxChannels> silence{};
+    silence.fill(silence_.data());
+    return process(silence.data(), numChannels, static_cast<int>(silence_.size()), output, maxOutput).produced;
+}
+
+template <bool Interpolate>
+int PolyphaseResampler::render(int numChannels, float* const* output, int offset, int maxOutput) noexcept
+{
+    const auto& table = *table_;
+    const float* lines = lines_.data();
+    int produced = 0;
+
+    while (offset + produced < maxOutput && start_ + numTaps_ <= filled_) {
+        const size_t index = static_cast<size_t>(offset + produced);
+
+        if constexpr (Interpolate) {
+            const int row = static_cast<int>(phase_ >> kRowShift);
+            const float fraction = static_cast<float>(phase_ & ((int64_t{ 1 } << kRowShift) - 1))
+                                 * (1.0f / static_cast<float>(int64_t{ 1 } << kRowShift));
+            const float* low = table.getRow(row);
+            const float* high = table.getRow(row + 1);
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float* line = lines + channel * lineLength_ + start_;
+                const float a = dot(line, low, numTaps_);
+                const float b = dot(line, high, numTaps_);
+                output[channel][index] = a + fraction * (b - a);
+            }
+        } else {
+            const float* taps = table.getRow(static_cast<int>(phase_));
+            for (int channel = 0; channel < numChannels; ++channel)
+                output[channel][index] = dot(lines + channel * lineLength_ + start_, taps, numTaps_);
+        }
+
+        ++produced;
+        start_ += static_cast<int>(stepWhole_);
+        phase_ += stepFraction_;
+        if (phase_ >= denominator_) {
+            phase_ -= denominator_;
+            ++start_;
+        }
+    }
+
+    return produced;
+}
+
+void PolyphaseResampler::compact() noexcept
+{
+    if (start_ == 0) return;
+
+    // Every channel's line moves by the same amount
+    const int keep = filled_ - start_;
+    for (int channel = 0; channel < config_.numChannels; ++channel) {
+        float* line = lines_.data() + static_cast<size_t>(channel * lineLength_);
+        std::copy(line + start_, line + filled_, line);
+    }
+
+    filled_ = keep;
+    start_ = 0;
+}
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+    polyphase_resampler.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Arbitrary-ratio sample rate conversion with shared Kaiser-windowed sinc
+    phase tables and a streaming multichannel converter
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class PolyphaseSincTable
+ * @brief Kaiser-windowed sinc kernel sampled at every phase of one conversion
+ *
+ * Row p holds the taps for an output that falls p / numPhases of the way
+ * between two input samples, laid out in input order and padded to a multiple
+ * of kTapAlignment, so one output is a single dot product with the input
+ * line. There is one extra row for phase 1 so neighbouring rows can always be
+ * blended. Each row sums to exactly one, so DC passes with no phase-dependent
+ * ripple.
+ *
+ * Ratios between integer rates reduce to a fraction L / M; when L is at most
+ * kMaxExactPhases the table has L rows and every output uses an exact row.
+ * This covers every pair of 44.1, 48, 96 and 192 kHz. Other ratios use
+ * kInterpolatedPhases rows and blend the two nearest.
+ *
+ * Tables are immutable and shared: get() hands out one instance per design
+ * for as long as anyone holds it.
+ */
+class PolyphaseSincTable
+{
+public:
+    //==============================================================================
+    static constexpr int kTapAlignment = 8;
+    static constexpr int kMaxExactPhases = 1024;
+    static constexpr int kInterpolatedPhases = 1024;
+
+    struct Design
+    {
+        int numPhases = kInterpolatedPhases;
+        int numTaps = 128;              // Multiple of kTapAlignment, in input samples
+        float cutoff = 0.95f;           // Sinc cutoff as a fraction of the input Nyquist
+        float attenuationDb = 100.0f;   // Kaiser window stopband
+
+        bool operator<(const Design& other) const noexcept;
+    };
+
+    //==============================================================================
+    /** Shared table for a design, built on first use. Not real-time safe. */
+    static std::shared_ptr<const PolyphaseSincTable> get(const Design& design);
+
+    /** Use get() */
+    explicit PolyphaseSincTable(const Design& design);
+
+    const Design& getDesign() const noexcept { return design_; }
+    int getNumPhases() const noexcept { return design_.numPhases; }
+    int getNumTaps() const noexcept { return design_.numTaps; }
+
+    /** Taps for phase 0 to getNumPhases() inclusive */
+    const float* getRow(int phase) const noexcept
+    {
+        return rows_.data() + static_cast<size_t>(phase) * static_cast<size_t>(design_.numTaps);
+    }
+
+private:
+    Design design_;
+    std::vector<float> rows_;
+
+    JUCE_DECLARE_NON_COPYABLE(PolyphaseSincTable)
+};
+
+//==============================================================================
+/**
+ * @class PolyphaseResampler
+ * @brief Streaming multichannel sample rate converter
+ *
+ * process() takes any number of input samples and returns how many it
+ * consumed and how many outputs it produced, so the same converter serves
+ * both directions of flow:
+ *
+ * - Push (offline, live input): feed blocks as they come, with room for
+ *   getMaxOutput(numInput) outputs, then flush() at the end of a render.
+ * - Pull (real-time playback of assets): ask getRequiredInput(numOutput),
+ *   read that much, and process() yields exactly numOutput samples.
+ *
+ * The kernel spans numTaps input samples, widened by the rate ratio when
+ * downsampling so the cutoff follows the output Nyquist. With timeAligned set
+ * the line starts half a kernel short, so output n lands exactly on input
+ * time n / ratio and the first outputs wait for lookahead. Otherwise the line
+ * starts full of silence: outputs begin immediately, getLatency() input
+ * samples late. Every buffer is allocated in prepare(), so the audio thread
+ * never allocates.
+ */
+class PolyphaseResampler
+{
+public:
+    //==============================================================================
+    static constexpr int kMaxChannels = 64;
+
+    struct Config
+    {
+        double inputRate = 44100.0;
+        double outputRate = 48000.0;
+        int numChannels = 2;
+        int numTaps = 128;              // Kernel length at the lower of the two rates
+        float cutoff = 0.95f;           // Fraction of the lower Nyquist
+        float attenuationDb = 100.0f;
+        bool timeAligned = true;
+    };
+
+    struct Result
+    {
+        int consumed = 0;
+        int produced = 0;
+    };
+
+    //==============================================================================
+    PolyphaseResampler() = default;
+
+    /** Fetch the table and allocate every buffer. Not real-time safe. */
+    void prepare(const Config& config);
+
+    /** Clear the input line and restart at phase zero */
+    void reset() noexcept;
+
+    const Config& getConfig() const noexcept { return config_; }
+    double getRatio() const noexcept { return config_.outputRate / config_.inputRate; }
+
+    /** True when every output uses an exact table row */
+    bool isExact() const noexcept { return table_ != nullptr && !interpolate_; }
+
+    /** Input samples by which outputs trail the input; 0 when time aligned */
+    float getLatency() const noexcept;
+
+    //==============================================================================
+    /** Input samples needed before the next numOutput outputs can be produced */
+    int getRequiredInput(int numOutput) const noexcept;
+
+    /** Most outputs that numInput more input samples can produce */
+    int getMaxOutput(int numInput) const noexcept;
+
+    /**
+     * Convert the first numChannels channels. Consumes input until it runs out
+     * or maxOutput outputs are written; samples left unconsumed must be
+     * offered again.
+     */
+    Result process(const float* const* input, int numChannels, int numInput,
+                   float* const* output, int maxOutput) noexcept;
+
+    /** Push half a kernel of silence through to drain the tail of a render; returns the outputs written */
+    int flush(float* const* output, int numChannels, int maxOutput) noexcept;
+
+private:
+    //==============================================================================
+    /** Input samples copied into the line per pass */
+    static constexpr int kChunk = 1024;
+
+    template <bool Interpolate>
+    int render(int numChannels, float* const* output, int offset, int maxOutput) noexcept;
+
+    void compact() noexcept;
+
+    Config config_;
+    std::shared_ptr<const PolyphaseSincTable> table_;
+    bool interpolate_ = false;
+    int numTaps_ = 0;
+
+    /** Output step in input samples: stepWhole_ + stepFraction_ / denominator_ */
+    int64_t denominator_ = 1;
+    int64_t stepWhole_ = 1;
+    int64_t stepFraction_ = 0;
+
+    /** Position of the next output: first tap at line index start_, plus phase_ / denominator_ */
+    int start_ = 0;
+    int64_t phase_ = 0;
+
+    /** Input lines, channel-major, each numTaps_ + kChunk long, holding filled_ samples */
+    std::vector<float> lines_;
+    int lineLength_ = 0;
+    int filled_ = 0;
+
+    /** Silence fed by flush() */
+    std::vector<float> silence_;
+
+    JUCE_DECLARE_NON_COPYABLE(PolyphaseResampler)
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+    shared_table_cache.h
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Keyed cache of immutable shared tables that lives only as long as the
+    tables are in use
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace vital {
+namespace audio_engine {
+namespace utility {
+
+//==============================================================================
+/**
+ * @class SharedTableCache
+ * @brief Hands out one immutable Table per Key for as long as anyone holds it
+ *
+ * Entries are weak, so a table is freed with its last user and rebuilt on
+ * the next request. Tables are built outside the lock: two threads asking
+ * for the same missing key may both build it, but only the first insert is
+ * handed out. Expired entries are pruned whenever a new table is inserted.
+ *
+ * Not real-time safe; call from setup code.
+ */
+template <typename Key, typename Table>
+class SharedTableCache
+{
+public:
+    SharedTableCache() = default;
+
+    /** The cached table for key, or the one build() returns if there is none */
+    template <typename Builder>
+    std::shared_ptr<const Table> get(const Key& key, Builder&& build)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = entries_.find(key); it != entries_.end()) {
+                if (auto table = it->second.lock())
+                    return table;
+            }
+        }
+
+        std::shared_ptr<const Table> table = build();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = entries_[key];
+        if (auto existing = entry.lock())
+            return existing;
+
+        entry = table;
+
+        for (auto it = entries_.begin(); it != entries_.end();)
+            it = it->second.expired() ? entries_.erase(it) : std::next(it);
+
+        return table;
+    }
+
+    /** Keys currently held, including ones whose tables have just expired */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<Key, std::weak_ptr<const Table>> entries_;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE(SharedTableCache)
+};
+
+} // namespace utility
+} // namespace audio_engine
+} // namespace vital
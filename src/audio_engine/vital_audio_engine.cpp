@@ -37,17 +37,36 @@ VitalAudioEngine::VitalAudioEngine(const Config& config)
     
     // Initialize core components
     voices_.resize(config_.maxVoices);
-    freeVoiceIds_.reserve(config_.maxVoices);
     
     for (int i = 0; i < config_.maxVoices; ++i) {
         voices_[i].id = i;
         voices_[i].parameters.resize(kMaxParameters, 0.0f);
-        freeVoiceIds_.push_back(i);
     }
     
+    core::VoiceAllocator::Config allocatorConfig;
+    allocatorConfig.maxVoices = config_.maxVoices;
+    allocatorConfig.stealPolicy = config_.voiceStealPolicy;
+    allocatorConfig.groupMode = config_.voiceGroupMode;
+    allocatorConfig.enableStealing = config_.enableVoiceStealing;
+    voiceAllocator_.prepare(allocatorConfig);
+    
     // Setup parameter system
     parameterSystem_.initialize(kMaxParameters);
     
+    utility::ParameterRampBank::Config rampConfig;
+    rampConfig.numParameters = kMaxParameters;
+    rampConfig.maxBlockSize = config_.bufferSize;
+    rampConfig.sampleRate = config_.sampleRate;
+    parameterRamps_.prepare(rampConfig);
+    
+    for (auto& subscriber : parameterSubscribers_) {
+        subscriber = parameterRamps_.addSubscriber();
+        parameterRamps_.subscribeAll(subscriber);
+    }
+    
+    // Pre-size the event pipeline so the audio thread never allocates
+    eventScheduler_.prepare(kMaxScheduledEvents);
+    
     startTime_ = std::chrono::steady_clock::now();
     engineState_.lastUpdate = startTime_;
 }
@@ -112,11 +131,22 @@ bool VitalAudioEngine::initialize()
             return false;
         }
         
-        // Setup worker threads if enabled
-        if (config_.enableMultithreading) {
-            workerThreadPool_ = std::make_unique<juce::ThreadPool>(config_.maxWorkerThreads);
+        // Setup voice rendering; with multithreading disabled every group
+        // renders on the audio thread
+        core::ParallelVoiceRenderer::Config rendererConfig;
+        rendererConfig.numWorkers = config_.enableMultithreading ? config_.maxWorkerThreads : 0;
+        rendererConfig.maxVoices = config_.maxVoices;
+        rendererConfig.maxBlockSize = config_.bufferSize;
+        rendererConfig.numChannels = config_.maxChannels;
+        rendererConfig.pinThreads = config_.pinWorkerThreads;
+        
+        if (!voiceRenderer_.prepare(rendererConfig)) {
+            logError("Failed to start voice rendering threads", "INIT");
+            return false;
         }
         
+        voiceBus_.setSize(config_.maxChannels, config_.bufferSize);
+        
         // Load default settings
         loadDefaultSettings();
         
@@ -163,10 +193,7 @@ void VitalAudioEngine::shutdown()
     shutdownCore();
     
     // Cleanup worker threads
-    if (workerThreadPool_) {
-        workerThreadPool_->close();
-        workerThreadPool_.reset();
-    }
+    voiceRenderer_.release();
     
     // Clear all periodic tasks
     periodicTasks_.clear();
@@ -207,6 +234,7 @@ void VitalAudioEngine::reset()
     
     // Reset parameters
     parameterSystem_.resetAll();
+    parameterRamps_.reset();
     
     // Reset internal state
     masterGain_ = 1.0f;
@@ -259,6 +287,7 @@ void VitalAudioEngine::processBlock(const juce::AudioBuffer<float>& input,
                                    const juce::MidiBuffer& midiMessages)
 {
     if (!engineState_.isInitialized || engineState_.isSuspended) {
+        eventScheduler_.clear();
         output.copyFrom(0, 0, input.getReadPointer(0), input.getNumSamples());
         return;
     }
@@ -268,23 +297,23 @@ void VitalAudioEngine::processBlock(const juce::AudioBuffer<float>& input,
     const int numChannels = std::min(input.getNumChannels(), output.getNumChannels());
     
     try {
-        // Ensure output buffer is properly sized
-        output.setSize(numChannels, numSamples, false, false);
+        // Ensure output buffer is properly sized without reallocating
+        output.setSize(numChannels, numSamples, false, false, true);
         
-        // Process MIDI messages
-        processMidiBuffer(midiMessages);
+        // Collect this block's MIDI in a single pass; automation scheduled
+        // through scheduleParameterChange() is already queued
+        eventScheduler_.addMidiBuffer(midiMessages, midiChannel_);
         
         // Update parameters
         updateParameters(numSamples);
         
-        // Allocate new voices if needed
-        allocateVoices(midiMessages);
+        // Render voices in sub-blocks split at every event timestamp
+        eventScheduler_.process(numSamples,
+            [this](const core::EventScheduler::Event& event) { handleScheduledEvent(event); },
+            [this, &output](int startSample, int subBlockSamples) { renderSubBlock(output, startSample, subBlockSamples); });
         
-        // Update existing voices
-        updateVoiceStates();
-        
-        // Process through synthesis engines
-        processSynthesizers(numSamples);
+        // Return voices whose release tails have finished
+        deallocateFinishedVoices();
         
         // Apply effects processing
         applyEffectsProcessing(numSamples);
@@ -308,6 +337,7 @@ void VitalAudioEngine::processBlock(const juce::AudioBuffer<float>& input,
         
     } catch (const std::exception& e) {
         logError(std::string("Exception in processBlock: ") + e.what(), "PROCESS");
+        eventScheduler_.clear();
         // Fallback to input passthrough
         output.copyFrom(0, 0, input.getReadPointer(0), numSamples);
     }
@@ -344,119 +374,87 @@ void VitalAudioEngine::noteOn(int note, float velocity, int channel, int voiceId
     velocity = juce::jlimit(0.0f, 1.0f, velocity);
     const float frequency = noteNumberToFrequency(note);
     
-    int targetVoiceId = voiceId;
+    // Allocate voice if none specified, otherwise claim the requested one
+    const auto allocation = (voiceId == -1)
+        ? voiceAllocator_.noteOn(note, channel, velocity)
+        : voiceAllocator_.assign(voiceId, note, channel, velocity);
     
-    // Allocate voice if none specified
-    if (targetVoiceId == -1) {
-        targetVoiceId = allocateVoice(note, velocity);
-        if (targetVoiceId == -1) {
-            logError("Failed to allocate voice for note " + std::to_string(note), "VOICE");
-            return;
-        }
+    if (allocation.voiceId == -1) {
+        realTimeMetrics_.droppedVoices++;
+        return;
     }
     
-    // Configure voice
-    if (targetVoiceId >= 0 && targetVoiceId < voices_.size()) {
-        Voice& voice = voices_[targetVoiceId];
-        voice.note = note;
-        voice.velocity = velocity;
-        voice.channel = channel;
-        voice.frequency = frequency;
-        voice.amplitude = velocity;
-        voice.active = true;
-        voice.startTime = std::chrono::steady_clock::now();
-        
-        // Update synthesis engines with voice information
-        synthesisEngine_.setVoiceNote(targetVoiceId, note);
-        synthesisEngine_.setVoiceVelocity(targetVoiceId, velocity);
-        
-        engineState_.activeVoices++;
-        engineState_.totalNotesProcessed++;
-        
-        logMessage("Note ON: " + std::to_string(note) + " velocity: " + 
-                   std::to_string(velocity) + " voice: " + std::to_string(targetVoiceId));
+    // Cut off the voice that was stolen to make room for this note
+    if (allocation.stolenVoiceId != -1 && !allocation.retriggered) {
+        synthesisEngine_.deallocateVoice(allocation.stolenVoiceId);
+        realTimeMetrics_.droppedVoices++;
     }
+    
+    // Configure voice
+    Voice& voice = voices_[allocation.voiceId];
+    voice.note = note;
+    voice.velocity = velocity;
+    voice.channel = channel;
+    voice.frequency = frequency;
+    voice.amplitude = velocity;
+    voice.active = true;
+    voice.priority = 0;
+    voice.startTime = std::chrono::steady_clock::now();
+    
+    // Update synthesis engines with voice information
+    synthesisEngine_.setVoiceNote(allocation.voiceId, note);
+    synthesisEngine_.setVoiceVelocity(allocation.voiceId, velocity);
+    
+    engineState_.activeVoices = voiceAllocator_.getNumSoundingVoices();
+    engineState_.performance.totalNotesProcessed++;
 }
 
 void VitalAudioEngine::noteOff(int note, int channel, int voiceId)
 {
     if (!engineState_.isInitialized) return;
     
-    int targetVoiceId = voiceId;
-    
-    // Find voice if not specified
-    if (targetVoiceId == -1) {
-        for (auto& voice : voices_) {
-            if (voice.active && voice.note == note && voice.channel == channel) {
-                targetVoiceId = voice.id;
-                break;
-            }
-        }
+    // The allocator tracks voices per (channel, note), so no scan is needed
+    int targetVoiceId = -1;
+    if (voiceId == -1) {
+        targetVoiceId = voiceAllocator_.noteOff(note, channel);
+    } else if (voiceAllocator_.release(voiceId)) {
+        targetVoiceId = voiceId;
     }
     
-    if (targetVoiceId >= 0 && targetVoiceId < voices_.size()) {
-        Voice& voice = voices_[targetVoiceId];
-        voice.active = false;
-        
-        // Trigger release phase in synthesis engines
-        synthesisEngine_.setVoiceNoteOff(targetVoiceId);
-        
-        engineState_.activeVoices = std::max(0, engineState_.activeVoices - 1);
-        
-        // Return voice to free list
-        freeVoiceIds_.push_back(targetVoiceId);
-        
-        logMessage("Note OFF: " + std::to_string(note) + " voice: " + std::to_string(targetVoiceId));
-    }
+    if (targetVoiceId == -1) return;
+    
+    // Trigger release phase in synthesis engines; the voice is returned to
+    // the free list by deallocateFinishedVoices() once its tail has finished
+    synthesisEngine_.setVoiceNoteOff(targetVoiceId);
 }
 
 void VitalAudioEngine::allNotesOff(int channel)
 {
-    for (auto& voice : voices_) {
-        if (voice.active && (channel == -1 || voice.channel == channel)) {
-            voice.active = false;
-            freeVoiceIds_.push_back(voice.id);
-        }
-    }
+    voiceAllocator_.forEachSoundingVoice(channel, [this](int voiceId) {
+        voiceAllocator_.free(voiceId);
+        voices_[voiceId].active = false;
+    });
     
-    engineState_.activeVoices = 0;
+    engineState_.activeVoices = voiceAllocator_.getNumSoundingVoices();
     synthesisEngine_.allNotesOff(channel);
-    
-    logMessage("All notes off for channel " + std::to_string(channel));
 }
 
-int VitalAudioEngine::allocateVoice(int note, float velocity)
+int VitalAudioEngine::allocateVoice(int note, float velocity, int channel)
 {
-    if (freeVoiceIds_.empty()) {
-        if (config_.enableVoiceStealing) {
-            // Steal the lowest priority active voice
-            int lowestPriorityVoice = -1;
-            int lowestPriority = std::numeric_limits<int>::max();
-            
-            for (auto& voice : voices_) {
-                if (voice.active && voice.priority < lowestPriority) {
-                    lowestPriority = voice.priority;
-                    lowestPriorityVoice = voice.id;
-                }
-            }
-            
-            if (lowestPriorityVoice != -1) {
-                voices_[lowestPriorityVoice].active = false;
-                freeVoiceIds_.push_back(lowestPriorityVoice);
-                realTimeMetrics_.droppedVoices++;
-            }
-        } else {
-            return -1; // No voice available
-        }
-    }
+    const auto allocation = voiceAllocator_.noteOn(note, channel, juce::jlimit(0.0f, 1.0f, velocity));
     
-    if (!freeVoiceIds_.empty()) {
-        int voiceId = freeVoiceIds_.back();
-        freeVoiceIds_.pop_back();
-        return voiceId;
+    if (allocation.stolenVoiceId != -1 && !allocation.retriggered) {
+        synthesisEngine_.deallocateVoice(allocation.stolenVoiceId);
+        realTimeMetrics_.droppedVoices++;
     }
     
-    return -1;
+    return allocation.voiceId;
+}
+
+void VitalAudioEngine::setVoiceStealPolicy(core::VoiceAllocator::StealPolicy policy)
+{
+    config_.voiceStealPolicy = policy;
+    voiceAllocator_.setStealPolicy(policy);
 }
 
 int VitalAudioEngine::getNumActiveVoices() const
@@ -478,9 +476,10 @@ void VitalAudioEngine::setOscillatorType(int oscillatorId, int type)
     if (oscillatorId < 0 || oscillatorId >= oscillators_.size()) return;
     
     // Create new oscillator based on type
-    auto newOscillator = oscillatorFactory_.createOscillator(
+    auto newOscillator = oscillatorFactory_.createHandle(
         static_cast<oscillators::NewOscillatorType>(type), 
-        "Oscillator_" + std::to_string(oscillatorId)
+        "Oscillator_" + std::to_string(oscillatorId),
+        config_.unison
     );
     
     if (newOscillator) {
@@ -521,12 +520,8 @@ void VitalAudioEngine::setParameter(int paramId, float value)
     
     parameterSystem_.setParameter(paramId, value);
     
-    // Apply to relevant engines
-    synthesisEngine_.setParameter(paramId, value);
-    effectsEngine_.setParameter(paramId, value);
-    spectralEngine_.setParameter(paramId, value);
-    modulationEngine_.setParameter(paramId, value);
-    filterEngine_.setParameter(paramId, value);
+    // Handed to the audio thread, which forwards it to subscribed engines on the next block
+    parameterRamps_.setTarget(paramId, value);
 }
 
 float VitalAudioEngine::getParameter(int paramId) const
@@ -540,7 +535,14 @@ void VitalAudioEngine::setParameterSmoothing(int paramId, float timeMs)
 {
     if (paramId < 0 || paramId >= kMaxParameters) return;
     
-    parameterSystem_.setSmoothingTime(paramId, timeMs);
+    parameterRamps_.setSmoothingTime(paramId, timeMs);
+}
+
+void VitalAudioEngine::setParameterSubscription(ParameterTarget target, const std::vector<int>& paramIds)
+{
+    // Published whole and adopted by the audio thread at its next block
+    parameterRamps_.setSubscription(parameterSubscribers_[static_cast<size_t>(target)],
+                                    paramIds.data(), static_cast<int>(paramIds.size()));
 }
 
 //==============================================================================
@@ -679,7 +681,7 @@ bool VitalAudioEngine::initializeOscillators()
         oscillators_.reserve(config_.numOscillators);
         
         for (int i = 0; i < config_.numOscillators; ++i) {
-            auto oscillator = oscillatorFactory_.createOscillator(
+            auto oscillator = oscillatorFactory_.createHandle(
                 oscillators::NewOscillatorType::Lorenz, 
                 "Oscillator_" + std::to_string(i)
             );
@@ -737,7 +739,19 @@ bool VitalAudioEngine::initializeModulation()
     modConfig.numEnvelopes = config_.numEnvelopes;
     modConfig.enableMacros = config_.enableMacros;
     
-    return modulationEngine_.initialize(modConfig);
+    if (!modulationEngine_.initialize(modConfig)) {
+        return false;
+    }
+    
+    // Matrix sources follow the engine's LFO, envelope, macro and CC index layout
+    modulation::ModulationMatrix::Config matrixConfig;
+    matrixConfig.numSources = modConfig.numLFOs + modConfig.numEnvelopes + modConfig.numMacros + modConfig.maxMIDICC;
+    matrixConfig.numDestinations = kMaxParameters;
+    matrixConfig.numVoices = config_.maxVoices;
+    matrixConfig.maxBlockSize = config_.bufferSize;
+    modulationEngine_.getMatrix().prepare(matrixConfig);
+    
+    return true;
 }
 
 bool VitalAudioEngine::initializeFilters()
@@ -747,6 +761,7 @@ bool VitalAudioEngine::initializeFilters()
     filterConfig.numFilters = 8;
     filterConfig.enableOversampling = config_.enableOversampling;
     filterConfig.oversamplingFactor = config_.oversamplingFactor;
+    filterConfig.linearPhaseOversampling = config_.linearPhaseOversampling;
     
     return filterEngine_.initialize(filterConfig);
 }
@@ -802,12 +817,25 @@ void VitalAudioEngine::updateParameters(int numSamples)
 {
     parameterSystem_.process(numSamples);
     
-    // Apply smoothed parameter updates to engines
-    for (int i = 0; i < kMaxParameters; ++i) {
-        float value = parameterSystem_.getParameter(i);
-        synthesisEngine_.setParameter(i, value);
-        effectsEngine_.setParameter(i, value);
-        spectralEngine_.setParameter(i, value);
+    // Only parameters that were posted or are still ramping reach the engines
+    parameterRamps_.process(numSamples);
+    if (parameterRamps_.getNumChanged() == 0) return;
+    
+    // Engines take one value per block, the end of any ramp; per-sample ramps are read from getParameterRamps()
+    for (int target = 0; target < kNumParameterTargets; ++target) {
+        parameterRamps_.forEachChanged(parameterSubscribers_[static_cast<size_t>(target)],
+            [this, target](int paramId, float value, const float* /* ramp */) {
+                applyParameter(static_cast<ParameterTarget>(target), paramId, value);
+            });
+    }
+}
+
+void VitalAudioEngine::applyParameter(ParameterTarget target, int paramId, float value)
+{
+    switch (target) {
+        case ParameterTarget::Synthesis:  synthesisEngine_.setParameter(paramId, value); break;
+        case ParameterTarget::Effects:    effectsEngine_.setParameter(paramId, value); break;
+        case ParameterTarget::NumTargets: break;
     }
 }
 
@@ -821,17 +849,46 @@ void VitalAudioEngine::processMidiInput(int numSamples)
     }
 }
 
-void VitalAudioEngine::allocateVoices(const juce::MidiBuffer& midiMessages)
+void VitalAudioEngine::handleScheduledEvent(const core::EventScheduler::Event& event)
+{
+    using EventType = core::EventScheduler::Event::Type;
+    
+    switch (event.type) {
+        case EventType::NoteOn:
+            noteOn(event.number, event.value, event.channel);
+            break;
+        case EventType::NoteOff:
+            noteOff(event.number, event.channel);
+            break;
+        case EventType::AllNotesOff:
+            allNotesOff(event.channel);
+            break;
+        case EventType::Controller:
+            modulationEngine_.setCCValue(event.number, event.value);
+            break;
+        case EventType::ParameterChange:
+            // Sample-accurate: skip smoothing and apply before the next sub-block renders
+            if (event.number >= 0 && event.number < kMaxParameters) {
+                parameterSystem_.setParameter(event.number, event.value);
+                parameterRamps_.jumpTo(event.number, event.value);
+                
+                for (int target = 0; target < kNumParameterTargets; ++target) {
+                    if (parameterRamps_.isSubscribed(parameterSubscribers_[static_cast<size_t>(target)], event.number)) {
+                        applyParameter(static_cast<ParameterTarget>(target), event.number, event.value);
+                    }
+                }
+            }
+            break;
+    }
+}
+
+void VitalAudioEngine::renderSubBlock(juce::AudioBuffer<float>& output, int startSample, int numSamples)
 {
-    juce::MidiBuffer::Iterator midiIterator(midiMessages);
-    juce::MidiMessage midiMessage;
-    int sampleNumber;
+    // Update existing voices
+    updateVoiceStates();
     
-    while (midiIterator.getNextEvent(midiMessage, sampleNumber)) {
-        if (midiMessage.isNoteOn()) {
-            allocateVoice(midiMessage.getNoteNumber(), midiMessage.getVelocity() / 127.0f);
-        }
-    }
+    // Process through synthesis engines
+    processSynthesizers(output, startSample, numSamples);
 }
 
 void VitalAudioEngine::updateVoiceStates()
@@ -844,14 +901,33 @@ void VitalAudioEngine::updateVoiceStates()
             if (synthState) {
                 voice.frequency = synthState->frequency;
                 voice.amplitude = synthState->amplitude;
+                voiceAllocator_.setVoiceLevel(voice.id, voice.amplitude);
             }
         }
     }
 }
 
-void VitalAudioEngine::processSynthesizers(int numSamples)
+void VitalAudioEngine::processSynthesizers(juce::AudioBuffer<float>& output, int startSample, int numSamples)
 {
-    synthesisEngine_.process(numSamples);
+    // The bus is sized for one configured block in initialize(); longer
+    // sub-blocks go through it in pieces so the audio thread never reallocates
+    const int busSamples = voiceBus_.getNumSamples();
+    const int busChannels = voiceBus_.getNumChannels();
+    
+    for (int offset = 0; offset < numSamples; offset += busSamples) {
+        const int chunk = std::min(busSamples, numSamples - offset);
+        voiceBus_.clear(0, chunk);
+        
+        voiceRenderer_.render(voiceBus_, 0, chunk,
+            [this](int /*group*/, int firstVoice, int numVoices, float* const* outputs, int numChannels, int groupSamples) {
+                synthesisEngine_.renderVoices(firstVoice, numVoices, outputs, numChannels, groupSamples);
+            });
+        
+        // Voice bus feeds the master output
+        for (int channel = 0; channel < output.getNumChannels(); ++channel) {
+            output.copyFrom(channel, startSample + offset, voiceBus_, std::min(channel, busChannels - 1), 0, chunk);
+        }
+    }
 }
 
 void VitalAudioEngine::applyEffectsProcessing(int numSamples)
@@ -1072,7 +1148,17 @@ void VitalAudioEngine::shutdownFilters()
 
 void VitalAudioEngine::deallocateFinishedVoices()
 {
-    // Implementation would check for finished voices and deallocate them
+    voiceAllocator_.forEachSoundingVoice(-1, [this](int voiceId) {
+        if (voiceAllocator_.getStage(voiceId) != core::VoiceAllocator::VoiceStage::Released) return;
+        
+        const auto* synthState = synthesisEngine_.getVoiceState(voiceId);
+        if (synthState == nullptr || !synthState->active) {
+            voiceAllocator_.free(voiceId);
+            voices_[voiceId].active = false;
+        }
+    });
+    
+    engineState_.activeVoices = voiceAllocator_.getNumSoundingVoices();
 }
 
 void VitalAudioEngine::loadDefaultSettings()
@@ -1111,6 +1197,13 @@ void VitalAudioEngine::setParameterAutomation(int paramId, const std::vector<flo
     parameterSystem_.setAutomation(paramId, automation);
 }
 
+bool VitalAudioEngine::scheduleParameterChange(int paramId, float value, int sampleOffset)
+{
+    if (paramId < 0 || paramId >= kMaxParameters) return false;
+    
+    return eventScheduler_.addParameterChange(sampleOffset, paramId, value);
+}
+
 void VitalAudioEngine::applyModulation(int paramId, float& value, int sample)
 {
     float modValue = modulationEngine_.getValue(paramId);
@@ -1128,6 +1221,7 @@ void VitalAudioEngine::setVoicePriority(int voiceId, int priority)
 {
     if (voiceId >= 0 && voiceId < voices_.size()) {
         voices_[voiceId].priority = priority;
+        voiceAllocator_.setVoicePriority(voiceId, priority);
     }
 }
 
@@ -1138,9 +1232,9 @@ void VitalAudioEngine::setParameterAutomation(int paramId, float* automationData
 
 void VitalAudioEngine::deallocateVoice(int voiceId)
 {
-    if (voiceId >= 0 && voiceId < voices_.size()) {
+    if (voiceId >= 0 && voiceId < voices_.size() && voiceAllocator_.free(voiceId)) {
         voices_[voiceId].active = false;
-        freeVoiceIds_.push_back(voiceId);
+        engineState_.activeVoices = voiceAllocator_.getNumSoundingVoices();
     }
 }
 
@@ -26,6 +26,9 @@
 #include <juce_dsp/juce_dsp.h>
 
 #include "core/audio_engine_core.h"
+#include "core/event_scheduler.h"
+#include "core/parallel_voice_renderer.h"
+#include "core/voice_allocator.h"
 #include "oscillators/new_oscillators.h"
 #include "synthesis/advanced_synthesis_engine.h"
 #include "effects/effects_processing_engine.h"
@@ -35,6 +38,8 @@
 #include "filtering/filter_engine.h"
 #include "utility/vital_constants.h"
 #include "utility/parameter_system.h"
+#include "utility/parameter_ramp_bank.h"
+#include <array>
 
 namespace vital {
 namespace audio_engine {
@@ -72,6 +77,7 @@ public:
         bool highQualityMode = true;
         bool enableOversampling = true;
         int oversamplingFactor = 2;
+        bool linearPhaseOversampling = false;
         bool enableAntialiasing = true;
         bool enableUltraLowNoise = true;
         
@@ -79,6 +85,7 @@ public:
         bool enableSIMD = true;
         bool enableMultithreading = true;
         int maxWorkerThreads = 4;
+        bool pinWorkerThreads = true;
         float cpuLimit = 0.85f;
         bool enableDynamicOptimization = true;
         
@@ -88,6 +95,7 @@ public:
         bool enableAdvancedSynthesis = true;
         bool enableGranularSynthesis = true;
         bool enablePhysicalModeling = true;
+        oscillators::UnisonStack::Settings unison;     // Applied to wavetable oscillators
         
         // Effects settings
         bool enableEffectsProcessing = true;
@@ -105,6 +113,10 @@ public:
         size_t maxMemoryUsage = 512 * 1024 * 1024; // 512MB
         bool enableMemoryOptimization = true;
         bool enableVoiceStealing = true;
+        
+        // Voice allocation settings
+        core::VoiceAllocator::StealPolicy voiceStealPolicy = core::VoiceAllocator::StealPolicy::ReleaseStageFirst;
+        core::VoiceAllocator::GroupMode voiceGroupMode = core::VoiceAllocator::GroupMode::Global;
     };
     
     //==============================================================================
@@ -174,9 +186,13 @@ public:
     /** Voice information */
     int getNumActiveVoices() const;
     int getMaxVoices() const;
-    int allocateVoice(int note, float velocity);
+    int allocateVoice(int note, float velocity, int channel = 1);
     void deallocateVoice(int voiceId);
     
+    /** Voice allocation policy */
+    void setVoiceStealPolicy(core::VoiceAllocator::StealPolicy policy);
+    core::VoiceAllocator& getVoiceAllocator() { return voiceAllocator_; }
+    
     //==============================================================================
     /** Oscillator management */
     void setOscillatorType(int oscillatorId, int type);
@@ -204,16 +220,28 @@ public:
     audio_quality::AudioProcessor& getAudioQualityProcessor() { return audioQualityProcessor_; }
     
     //==============================================================================
-    /** Parameter management */
+    /** Parameter management; setParameter is lock-free and reaches the engines on the next block */
     void setParameter(int paramId, float value);
     float getParameter(int paramId) const;
     void setParameterSmoothing(int paramId, float timeMs);
+    
+    /** Engines that receive parameter changes; only these two have a generic setParameter entry point */
+    enum class ParameterTarget { Synthesis, Effects, NumTargets };
+    
+    /** Restrict the ids a target is sent (every id by default), from the next block. Not real-time safe. */
+    void setParameterSubscription(ParameterTarget target, const std::vector<int>& paramIds);
+    
+    /** Per-sample smoothed values of the parameters ramping in the current block */
+    const utility::ParameterRampBank& getParameterRamps() const { return parameterRamps_; }
     void setModulationSource(int paramId, int source, float depth);
     
     /** Parameter automation */
     void setParameterAutomation(int paramId, const std::vector<float>& automation);
     void applyModulation(int paramId, float& value, int sample);
     
+    /** Sample-accurate automation for the next processBlock() call (audio thread only) */
+    bool scheduleParameterChange(int paramId, float value, int sampleOffset);
+    
     //==============================================================================
     /** Global engine controls */
     void setMasterGain(float gain);
@@ -333,7 +361,7 @@ private:
     
     /** Oscillator system */
     oscillators::NewOscillatorFactory oscillatorFactory_;
-    std::vector<std::unique_ptr<oscillators::Oscillator>> oscillators_;
+    std::vector<oscillators::OscillatorHandle> oscillators_;
     
     /** Effects processing */
     effects::EffectsProcessingEngine effectsEngine_;
@@ -345,9 +373,14 @@ private:
     /** Parameter system */
     utility::ParameterSystem parameterSystem_;
     
+    /** Dirty-tracked, smoothed parameter values and one subscription per ParameterTarget */
+    static constexpr int kNumParameterTargets = static_cast<int>(ParameterTarget::NumTargets);
+    utility::ParameterRampBank parameterRamps_;
+    std::array<int, kNumParameterTargets> parameterSubscribers_{};
+    
     //==============================================================================
     /** Threading and scheduling */
-    std::unique_ptr<juce::ThreadPool> workerThreadPool_;
+    core::ParallelVoiceRenderer voiceRenderer_;
     std::vector<std::unique_ptr<juce::Timer>> periodicTasks_;
     std::atomic<bool> shutdownRequested_{false};
     
@@ -355,6 +388,12 @@ private:
     juce::AbstractFifo midiInputQueue_{1024};
     juce::AbstractFifo parameterQueue_{256};
     
+    /** Sample-accurate event pipeline, sized once at construction */
+    core::EventScheduler eventScheduler_;
+    
+    /** Voice groups are summed here, one configured block at a time */
+    juce::AudioBuffer<float> voiceBus_;
+    
     //==============================================================================
     /** Internal initialization methods */
     bool initializeCore();
@@ -377,11 +416,13 @@ private:
     //==============================================================================
     /** Processing methods */
     void updateParameters(int numSamples);
+    void applyParameter(ParameterTarget target, int paramId, float value);
     void processMidiInput(int numSamples);
-    void allocateVoices(const juce::MidiBuffer& midiMessages);
+    void handleScheduledEvent(const core::EventScheduler::Event& event);
+    void renderSubBlock(juce::AudioBuffer<float>& output, int startSample, int numSamples);
     void deallocateFinishedVoices();
     void updateVoiceStates();
-    void processSynthesizers(int numSamples);
+    void processSynthesizers(juce::AudioBuffer<float>& output, int startSample, int numSamples);
     void applyEffectsProcessing(int numSamples);
     void applySpectralProcessing(int numSamples);
     void applyAudioQualityProcessing(int numSamples);
@@ -406,8 +447,7 @@ private:
     };
     
     std::vector<Voice> voices_;
-    std::vector<int> freeVoiceIds_;
-    std::priority_queue<int> voicePriorityQueue_;
+    core::VoiceAllocator voiceAllocator_;
     
     //==============================================================================
     /** Utility methods */
@@ -452,6 +492,7 @@ private:
     /** Constants and magic numbers */
     static constexpr int kMaxParameters = 1024;
     static constexpr int kMaxAutomationPoints = 16384;
+    static constexpr int kMaxScheduledEvents = 2048;
     static constexpr float kMaxCPUUsage = 0.95f;
     static constexpr size_t kMinMemoryThreshold = 64 * 1024 * 1024; // 64MB
     
@@ -202,12 +202,14 @@ public:
         
         // Convert to table indices
         float position = phase * table_size;
-        size_t index = static_cast<size_t>(position);
+        size_t index = std::min(static_cast<size_t>(position), table_size - 1);
         float fraction = position - index;
         
-        // Linear interpolation without branches
+        // Linear interpolation without branches; the next index wraps with a mask instead of a modulo
+        size_t next = index + 1;
+        next &= -static_cast<size_t>(next < table_size);
         float sample1 = wavetable[index];
-        float sample2 = wavetable[(index + 1) % table_size];
+        float sample2 = wavetable[next];
         
         return sample1 + fraction * (sample2 - sample1);
     }
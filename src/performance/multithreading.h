@@ -12,9 +12,11 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <fstream>
 #include <functional>
 #include <future>
 #include <memory>
@@ -25,6 +27,10 @@
 #include <vector>
 #include <type_traits>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
 namespace vital {
 namespace performance {
 namespace threading {
@@ -244,6 +250,93 @@ private:
     std::atomic<size_t> tail_;
 };
 
+/**
+ * Chase-Lev work-stealing deque
+ *
+ * The owning thread pushes and pops at the bottom (LIFO); any other thread
+ * may steal from the top (FIFO). All operations are lock-free. Capacity is
+ * fixed at construction so the owner never allocates: push() returns false
+ * when the deque is full and the caller is expected to run the item itself.
+ */
+template<typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque stores items in atomics");
+    
+public:
+    explicit ChaseLevDeque(size_t capacity = 1024)
+        : capacity_(round_up_pow2(capacity)), mask_(capacity_ - 1),
+          buffer_(std::make_unique<std::atomic<T>[]>(capacity_)) {}
+    
+    // Owner only
+    bool push(T item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(capacity_)) return false;
+        
+        buffer_[static_cast<size_t>(bottom) & mask_].store(item, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Owner only
+    bool pop(T& item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        item = buffer_[static_cast<size_t>(bottom) & mask_].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last item: race the thieves for it
+            const bool won = top_.compare_exchange_strong(top, top + 1,
+                                                          std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    // Any thread
+    bool steal(T& item) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_acquire);
+        
+        if (top >= bottom) return false;
+        
+        item = buffer_[static_cast<size_t>(top) & mask_].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(top, top + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+    
+    size_t size_approx() const {
+        const int64_t size = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+    
+    size_t capacity() const { return capacity_; }
+    
+private:
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+    
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<std::atomic<T>[]> buffer_;
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+};
+
 // ============================================================================
 // Thread-Safe Audio Buffer
 // ============================================================================
@@ -338,6 +431,20 @@ private:
 // Work Stealing Scheduler
 // ============================================================================
 
+// Processor hint for spin-wait loops
+inline void cpu_relax() {
+    #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        _mm_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #else
+        std::this_thread::yield();
+    #endif
+}
+
+class WorkStealingScheduler;
+class TaskGroup;
+
 /**
  * Work stealing task for parallel processing
  */
@@ -346,61 +453,114 @@ public:
     virtual ~WorkStealingTask() = default;
     virtual void execute() = 0;
     virtual std::unique_ptr<WorkStealingTask> split() { return nullptr; }
+    
+private:
+    friend class WorkStealingScheduler;
+    friend class TaskGroup;
+    
+    std::atomic<int>* group_pending_ = nullptr;  // Completion counter of the owning TaskGroup
+    bool owned_by_scheduler_ = false;           // Deleted after execution (submit())
 };
 
 /**
  * Work stealing scheduler for dynamic load balancing
+ *
+ * Every worker owns a Chase-Lev deque; external threads that submit work
+ * claim one of max_external_threads extra deques on first use. A thread
+ * finds its deque through thread-local storage, pops its own work LIFO and
+ * steals FIFO from the others without taking any lock. Idle workers spin
+ * for spin_attempts steal rounds and then park until new work is queued.
+ *
+ * The thread-local record holds one entry per scheduler, so a thread can
+ * submit to several schedulers, and a worker of one can feed another, without
+ * losing its own deque. External claims are handed back when the thread exits
+ * or when it needs room for an entry for yet another scheduler. Work left in a
+ * released deque is stolen as usual.
+ *
+ * When the calling thread has no deque or its deque is full, the task is
+ * executed inline, so submitting never blocks or allocates.
  */
 class WorkStealingScheduler {
 public:
+    static constexpr size_t max_external_threads = 8;
+    static constexpr size_t deque_capacity = 1024;
+    static constexpr size_t max_parallel_for_tasks = 64;
+    static constexpr int spin_attempts = 256;
+    
     WorkStealingScheduler(size_t num_threads = std::thread::hardware_concurrency()) 
-        : num_threads_(num_threads) {
-        // Create thread-local deques
-        deques_.reserve(num_threads_);
-        for (size_t i = 0; i < num_threads_; ++i) {
-            deques_.emplace_back();
+        : num_threads_(num_threads),
+          num_slots_(num_threads + max_external_threads),
+          instance_id_(next_instance_id()),
+          slot_stats_(std::make_unique<SlotStatistics[]>(num_threads + max_external_threads)) {
+        // Create per-thread deques
+        deques_.reserve(num_slots_);
+        for (size_t i = 0; i < num_slots_; ++i) {
+            deques_.push_back(std::make_unique<ChaseLevDeque<WorkStealingTask*>>(deque_capacity));
         }
         
         // Start worker threads
+        threads_.reserve(num_threads_);
         for (size_t i = 0; i < num_threads_; ++i) {
             threads_.emplace_back(&WorkStealingScheduler::worker_thread, this, i);
         }
     }
     
     ~WorkStealingScheduler() {
-        stop_ = true;
-        work_available_cv_.notify_all();
+        stop_.store(true);
+        wake_workers(true);
         
         for (auto& thread : threads_) {
             if (thread.joinable()) thread.join();
         }
+        
+        // Free submitted tasks that never ran
+        WorkStealingTask* task = nullptr;
+        for (auto& deque : deques_) {
+            while (deque->steal(task)) {
+                if (task->owned_by_scheduler_) delete task;
+            }
+        }
     }
     
     // Submit work to thread pool
     void submit(std::unique_ptr<WorkStealingTask> task) {
-        size_t current_thread_id = get_current_thread_id();
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            deques_[current_thread_id].push_back(std::move(task));
-        }
-        work_available_cv_.notify_one();
+        if (!task) return;
+        
+        WorkStealingTask* raw_task = task.release();
+        raw_task->owned_by_scheduler_ = true;
+        raw_task->group_pending_ = nullptr;
+        outstanding_tasks_.fetch_add(1, std::memory_order_relaxed);
+        enqueue(raw_task);
     }
     
-    // Execute tasks until queue is empty
+    // Execute tasks on the calling thread until every submitted task has completed.
+    // Must not be called from inside a task.
     void execute_until_empty() {
-        execute_tasks(1); // Use current thread
+        help_until([this] { return outstanding_tasks_.load(std::memory_order_acquire) == 0; });
     }
     
     // Execute tasks with timeout
     void execute_for(std::chrono::milliseconds timeout) {
-        auto start = std::chrono::high_resolution_clock::now();
-        while (std::chrono::high_resolution_clock::now() - start < timeout) {
-            if (!execute_tasks(0)) { // Try to steal work
+        const size_t slot = current_slot();
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (!run_one(slot)) {
                 std::this_thread::sleep_for(std::chrono::microseconds(100));
             }
         }
     }
     
+    /**
+     * Call body(i) for every i in [begin, end), split into at most
+     * max_parallel_for_tasks chunks of at least grain_size indices. The
+     * calling thread executes chunks as well and returns when all are done.
+     * Chunk tasks live on the caller's stack, so nothing is allocated.
+     */
+    template<typename Body>
+    void parallel_for(size_t begin, size_t end, size_t grain_size, Body&& body);
+    
+    size_t num_threads() const { return num_threads_; }
+    
     // Get scheduler statistics
     struct Statistics {
         size_t total_tasks_completed = 0;
@@ -414,13 +574,17 @@ public:
         Statistics stats;
         stats.tasks_per_thread.resize(num_threads_);
         
-        for (size_t i = 0; i < num_threads_; ++i) {
-            stats.tasks_per_thread[i] = completed_tasks_[i].load();
+        for (size_t i = 0; i < num_slots_; ++i) {
+            const size_t completed = slot_stats_[i].completed.load(std::memory_order_relaxed);
+            if (i < num_threads_) {
+                stats.tasks_per_thread[i] = completed;
+            }
+            
+            stats.total_tasks_completed += completed;
+            stats.total_steal_attempts += slot_stats_[i].steal_attempts.load(std::memory_order_relaxed);
+            stats.successful_steals += slot_stats_[i].successful_steals.load(std::memory_order_relaxed);
         }
         
-        stats.total_steal_attempts = total_steal_attempts_.load();
-        stats.successful_steals = successful_steals_.load();
-        
         if (stats.total_steal_attempts > 0) {
             stats.load_balance_efficiency = 
                 static_cast<double>(stats.successful_steals) / stats.total_steal_attempts;
@@ -430,102 +594,308 @@ public:
     }
     
 private:
+    friend class TaskGroup;
+    
+    static constexpr size_t no_slot = static_cast<size_t>(-1);
+    
+    // Per-slot counters on their own cache lines so workers never share them
+    struct alignas(64) SlotStatistics {
+        std::atomic<size_t> completed{0};
+        std::atomic<size_t> steal_attempts{0};
+        std::atomic<size_t> successful_steals{0};
+    };
+    
+    // Claims on the external deques, shared with the threads holding them so
+    // a thread that outlives the scheduler can still hand its claim back
+    struct ExternalSlots {
+        std::atomic<bool> claimed[max_external_threads] = {};
+    };
+    
+    // Deques owned by the current thread, one entry per scheduler it uses;
+    // destroyed at thread exit, which releases its external claims
+    struct ThreadSlots {
+        static constexpr size_t max_schedulers = 8;
+        
+        struct Entry {
+            uint64_t scheduler_id = 0;
+            size_t index = no_slot;
+            std::shared_ptr<ExternalSlots> external;  // Set for a claimed external deque
+            size_t external_index = 0;
+            
+            void release() {
+                if (external) {
+                    external->claimed[external_index].store(false, std::memory_order_release);
+                    external.reset();
+                }
+                scheduler_id = 0;
+                index = no_slot;
+            }
+        };
+        
+        Entry worker;                                 // The scheduler this thread works for, if any
+        std::array<Entry, max_schedulers> external;
+        size_t next_eviction = 0;
+        uint32_t victim_seed = 0x9e3779b9u;
+        
+        ThreadSlots() = default;
+        ThreadSlots(const ThreadSlots&) = delete;
+        ThreadSlots& operator=(const ThreadSlots&) = delete;
+        
+        ~ThreadSlots() {
+            for (auto& entry : external) entry.release();
+        }
+    };
+    
+    static thread_local ThreadSlots thread_slots_;
+    
     size_t num_threads_;
-    std::vector<std::deque<std::unique_ptr<WorkStealingTask>>> deques_;
+    size_t num_slots_;
+    uint64_t instance_id_;
+    std::vector<std::unique_ptr<ChaseLevDeque<WorkStealingTask*>>> deques_;
     std::vector<std::thread> threads_;
+    std::unique_ptr<SlotStatistics[]> slot_stats_;
+    std::shared_ptr<ExternalSlots> external_slots_ = std::make_shared<ExternalSlots>();
     std::atomic<bool> stop_{false};
-    std::atomic<size_t> current_thread_id_{0};
     
-    // Statistics
-    std::vector<std::atomic<size_t>> completed_tasks_;
-    std::atomic<size_t> total_steal_attempts_{0};
-    std::atomic<size_t> successful_steals_{0};
+    alignas(64) std::atomic<size_t> outstanding_tasks_{0};
+    alignas(64) std::atomic<uint32_t> work_epoch_{0};
+    alignas(64) std::atomic<int> parked_workers_{0};
     
-    mutable std::mutex queue_mutex_;
-    std::condition_variable work_available_cv_;
+    static uint64_t next_instance_id() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1) + 1;
+    }
     
     void worker_thread(size_t thread_id) {
-        current_thread_id_.store(thread_id);
-        completed_tasks_.resize(num_threads_);
+        thread_slots_.worker.scheduler_id = instance_id_;
+        thread_slots_.worker.index = thread_id;
+        thread_slots_.victim_seed = static_cast<uint32_t>(thread_id * 2654435761u) | 1u;
+        int idle_rounds = 0;
         
-        while (!stop_) {
-            if (!execute_tasks(thread_id)) {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
-                work_available_cv_.wait_for(lock, std::chrono::milliseconds(10));
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (run_one(thread_id)) {
+                idle_rounds = 0;
+                continue;
+            }
+            
+            if (++idle_rounds < spin_attempts) {
+                cpu_relax();
+                continue;
+            }
+            
+            // Park; the queued-work check closes the race with a concurrent enqueue
+            const uint32_t epoch = work_epoch_.load();
+            parked_workers_.fetch_add(1);
+            if (!stop_.load() && !has_queued_work()) {
+                work_epoch_.wait(epoch);
             }
+            parked_workers_.fetch_sub(1);
+            idle_rounds = 0;
         }
     }
     
-    bool execute_tasks(size_t thread_id) {
-        bool executed_work = false;
+    // Deque index of the calling thread, claiming an external slot if needed
+    size_t current_slot() {
+        ThreadSlots& slots = thread_slots_;
+        if (slots.worker.scheduler_id == instance_id_) return slots.worker.index;
         
-        while (true) {
-            // Try to pop from local deque (LIFO)
-            std::unique_ptr<WorkStealingTask> task;
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                if (!deques_[thread_id].empty()) {
-                    task = std::move(deques_[thread_id].back());
-                    deques_[thread_id].pop_back();
-                }
-            }
-            
-            if (task) {
-                task->execute();
-                executed_work = true;
-                completed_tasks_[thread_id]++;
+        for (const auto& entry : slots.external) {
+            if (entry.scheduler_id == instance_id_) return entry.index;
+        }
+        
+        for (size_t i = 0; i < max_external_threads; ++i) {
+            bool expected = false;
+            if (!external_slots_->claimed[i].compare_exchange_strong(expected, true, std::memory_order_acquire,
+                                                                     std::memory_order_relaxed)) {
                 continue;
             }
             
-            // Try to steal from other deques (FIFO)
-            bool stole_work = steal_work(thread_id);
-            if (!stole_work) break;
+            // A free entry, or else the oldest claim on another scheduler is given up
+            auto free_entry = std::find_if(slots.external.begin(), slots.external.end(),
+                                           [](const auto& entry) { return entry.scheduler_id == 0; });
+            auto& entry = free_entry != slots.external.end()
+                              ? *free_entry
+                              : slots.external[slots.next_eviction++ % ThreadSlots::max_schedulers];
+            entry.release();
+            
+            entry.scheduler_id = instance_id_;
+            entry.index = num_threads_ + i;
+            entry.external = external_slots_;
+            entry.external_index = i;
+            return entry.index;
         }
         
-        return executed_work;
+        return no_slot;
+    }
+    
+    void enqueue(WorkStealingTask* task) {
+        const size_t slot = current_slot();
+        if (slot == no_slot || !deques_[slot]->push(task)) {
+            run_task(task, slot);
+            return;
+        }
+        wake_workers(false);
+    }
+    
+    void wake_workers(bool all) {
+        work_epoch_.fetch_add(1);
+        if (all) {
+            work_epoch_.notify_all();
+        } else if (parked_workers_.load() > 0) {
+            work_epoch_.notify_one();
+        }
+    }
+    
+    bool has_queued_work() const {
+        for (const auto& deque : deques_) {
+            if (deque->size_approx() > 0) return true;
+        }
+        return false;
     }
     
-    bool steal_work(size_t thread_id) {
-        size_t attempts = 0;
-        size_t num_victims = num_threads_ - 1;
+    // Run tasks on the calling thread until done() holds, without sleeping
+    template<typename Predicate>
+    void help_until(Predicate&& done) {
+        const size_t slot = current_slot();
+        while (!done()) {
+            if (!run_one(slot)) cpu_relax();
+        }
+    }
+    
+    bool run_one(size_t slot) {
+        WorkStealingTask* task = nullptr;
+        
+        // Local deque first (LIFO), then steal from others (FIFO)
+        if ((slot != no_slot && deques_[slot]->pop(task)) || steal_work(slot, task)) {
+            run_task(task, slot);
+            return true;
+        }
         
-        if (num_victims == 0) return false;
+        return false;
+    }
+    
+    bool steal_work(size_t slot, WorkStealingTask*& task) {
+        // xorshift32 victim selection spreads thieves across deques
+        uint32_t& seed = thread_slots_.victim_seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        const size_t start = seed % num_slots_;
         
-        total_steal_attempts_++;
+        if (slot != no_slot) {
+            slot_stats_[slot].steal_attempts.fetch_add(1, std::memory_order_relaxed);
+        }
         
-        // Try to steal from random victim
-        while (attempts < num_victims * 2) {
-            size_t victim = (thread_id + 1 + attempts) % num_threads_;
-            std::unique_ptr<WorkStealingTask> task;
+        for (size_t i = 0; i < num_slots_; ++i) {
+            const size_t victim = (start + i) % num_slots_;
+            if (victim == slot) continue;
             
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                if (!deques_[victim].empty()) {
-                    task = std::move(deques_[victim].front());
-                    deques_[victim].pop_front();
+            if (deques_[victim]->steal(task)) {
+                if (slot != no_slot) {
+                    slot_stats_[slot].successful_steals.fetch_add(1, std::memory_order_relaxed);
                 }
-            }
-            
-            if (task) {
-                task->execute();
-                successful_steals_++;
-                completed_tasks_[thread_id]++;
                 return true;
             }
-            
-            attempts++;
         }
         
         return false;
     }
     
-    size_t get_current_thread_id() {
-        // In a real implementation, this would use thread-local storage
-        // For this example, we'll use the atomic counter
-        return current_thread_id_.load();
+    void run_task(WorkStealingTask* task, size_t slot) {
+        // Group tasks may be destroyed as soon as the counter drops, so read first
+        std::atomic<int>* group_pending = task->group_pending_;
+        const bool owned = task->owned_by_scheduler_;
+        
+        task->execute();
+        
+        if (slot != no_slot) {
+            slot_stats_[slot].completed.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        if (owned) {
+            delete task;
+            outstanding_tasks_.fetch_sub(1, std::memory_order_release);
+        } else if (group_pending != nullptr) {
+            group_pending->fetch_sub(1, std::memory_order_release);
+        }
     }
 };
 
+inline thread_local WorkStealingScheduler::ThreadSlots WorkStealingScheduler::thread_slots_{};
+
+/**
+ * Set of tasks that can be awaited together
+ *
+ * Tasks are not owned by the group and must outlive wait(). wait() keeps the
+ * calling thread executing queued work instead of sleeping, so the join
+ * latency is bounded by the longest task already running elsewhere rather
+ * than by thread wake-up times.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingScheduler& scheduler) : scheduler_(scheduler) {}
+    ~TaskGroup() { wait(); }
+    
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    
+    void run(WorkStealingTask& task) {
+        task.owned_by_scheduler_ = false;
+        task.group_pending_ = &pending_;
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        scheduler_.enqueue(&task);
+    }
+    
+    void wait() {
+        scheduler_.help_until([this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+    
+    bool is_done() const { return pending_.load(std::memory_order_acquire) == 0; }
+    
+private:
+    WorkStealingScheduler& scheduler_;
+    std::atomic<int> pending_{0};
+};
+
+template<typename Body>
+void WorkStealingScheduler::parallel_for(size_t begin, size_t end, size_t grain_size, Body&& body) {
+    if (end <= begin) return;
+    
+    using BodyType = std::remove_reference_t<Body>;
+    
+    const size_t count = end - begin;
+    const size_t grain = std::max<size_t>(1, grain_size);
+    const size_t num_chunks = std::min(max_parallel_for_tasks, (count + grain - 1) / grain);
+    
+    if (num_chunks <= 1 || num_threads_ == 0) {
+        for (size_t i = begin; i < end; ++i) body(i);
+        return;
+    }
+    
+    struct ChunkTask final : WorkStealingTask {
+        BodyType* body = nullptr;
+        size_t first = 0;
+        size_t last = 0;
+        
+        void execute() override {
+            for (size_t i = first; i < last; ++i) (*body)(i);
+        }
+    };
+    
+    // Declared before the group so the group's join runs before they are destroyed
+    std::array<ChunkTask, max_parallel_for_tasks> chunks;
+    TaskGroup group(*this);
+    
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        chunks[chunk].body = &body;
+        chunks[chunk].first = begin + count * chunk / num_chunks;
+        chunks[chunk].last = begin + count * (chunk + 1) / num_chunks;
+        group.run(chunks[chunk]);
+    }
+    
+    group.wait();
+}
+
 // ============================================================================
 // Audio Thread Manager
 // ============================================================================
@@ -682,26 +1052,18 @@ public:
         }
     }
     
-    // Process multiple voice buffers in parallel
+    // Process multiple voice buffers in parallel; the calling thread takes part
     template<typename VoiceProcessor>
     void process_voices_parallel(const std::vector<float*>& input_buffers,
                                 std::vector<float*>& output_buffers,
                                 size_t num_samples,
                                 VoiceProcessor&& processor) {
-        size_t num_voices = std::min(input_buffers.size(), output_voices_.load());
+        size_t num_voices = std::min({input_buffers.size(), output_buffers.size(), output_voices_.load()});
         if (num_voices == 0) return;
         
-        // Submit voice processing tasks to work stealing scheduler
-        for (size_t voice = 0; voice < num_voices; ++voice) {
-            auto task = std::make_unique<VoiceProcessingTask>(
-                input_buffers[voice], output_buffers[voice], num_samples, 
-                std::forward<VoiceProcessor>(processor));
-            
-            scheduler_.submit(std::move(task));
-        }
-        
-        // Wait for completion
-        scheduler_.execute_until_empty();
+        scheduler_.parallel_for(0, num_voices, 1, [&](size_t voice) {
+            processor(input_buffers[voice], output_buffers[voice], num_samples);
+        });
     }
     
     // Set active voice count
@@ -718,24 +1080,6 @@ private:
     std::vector<std::vector<float>> voice_buffers_;
     std::atomic<size_t> output_voices_{0};
     WorkStealingScheduler scheduler_;
-    
-    class VoiceProcessingTask : public WorkStealingTask {
-    public:
-        VoiceProcessingTask(float* input, float* output, size_t samples,
-                          std::function<void(float*, float*, size_t)> processor)
-            : input_(input), output_(output), samples_(samples), 
-              processor_(std::move(processor)) {}
-        
-        void execute() override {
-            processor_(input_, output_, samples_);
-        }
-        
-    private:
-        float* input_;
-        float* output_;
-        size_t samples_;
-        std::function<void(float*, float*, size_t)> processor_;
-    };
 };
 
 // ============================================================================
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+    test_biquad_coefficient_cache.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Response and modulation stability of the table-driven biquad, and the
+    shared prewarp table it reads
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "filtering/biquad_coefficient_cache.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace vital::audio_engine::filtering;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kPi = 3.14159265358979323846;
+
+/** Magnitude of the filter's steady-state response to a sine, measured against the input's */
+double measureGain(CachedBiquad& filter, double frequency)
+{
+    constexpr int kLength = 48000;
+    constexpr int kSettle = 24000;
+
+    std::vector<float> signal(kLength);
+    for (int i = 0; i < kLength; ++i)
+        signal[static_cast<size_t>(i)] = static_cast<float>(std::sin(2.0 * kPi * frequency * i / kSampleRate));
+
+    filter.reset();
+    filter.process(signal.data(), kLength);
+
+    double sum = 0.0;
+    for (int i = kSettle; i < kLength; ++i)
+        sum += static_cast<double>(signal[static_cast<size_t>(i)]) * signal[static_cast<size_t>(i)];
+    return std::sqrt(2.0 * sum / (kLength - kSettle));
+}
+
+/** |H| of the RBJ cookbook design for a type and Q at cutoff, evaluated at a frequency */
+double designGain(CachedBiquad::Type type, double q, double cutoff, double frequency)
+{
+    using Type = CachedBiquad::Type;
+
+    const double w = 2.0 * kPi * cutoff / kSampleRate;
+    const double cosW = std::cos(w);
+    const double alpha = std::sin(w) / (2.0 * q);
+
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+    switch (type) {
+        case Type::LowPass:  b0 = 0.5 * (1.0 - cosW); b1 = 1.0 - cosW;    b2 = b0;          break;
+        case Type::HighPass: b0 = 0.5 * (1.0 + cosW); b1 = -(1.0 + cosW); b2 = b0;          break;
+        case Type::BandPass: b0 = alpha;              b1 = 0.0;           b2 = -alpha;      break;
+        case Type::Notch:    b0 = 1.0;                b1 = -2.0 * cosW;   b2 = 1.0;         break;
+        case Type::AllPass:  b0 = 1.0 - alpha;        b1 = -2.0 * cosW;   b2 = 1.0 + alpha; break;
+    }
+
+    const std::complex<double> z1 = std::polar(1.0, -2.0 * kPi * frequency / kSampleRate);
+    const std::complex<double> z2 = z1 * z1;
+    return std::abs((b0 + b1 * z1 + b2 * z2) / ((1.0 + alpha) - 2.0 * cosW * z1 + (1.0 - alpha) * z2));
+}
+
+/** Peak output for unit noise while the cutoff swings +-2 octaves around 2 kHz at modulationRate */
+float peakUnderModulation(CachedBiquad::Type type, float q, double modulationRate, int stages)
+{
+    constexpr int kLength = 96 * 1024;
+
+    CachedBiquad filter;
+    filter.prepare(kSampleRate);
+    filter.setResponse(type, q);
+    filter.setStages(stages);
+    filter.snapFrequency(2000.0f);
+
+    std::vector<float> signal(kLength), modulation(kLength);
+    uint32_t seed = 12345;
+    for (int i = 0; i < kLength; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        signal[static_cast<size_t>(i)] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        modulation[static_cast<size_t>(i)] = static_cast<float>(2.0 * std::sin(2.0 * kPi * modulationRate * i / kSampleRate));
+    }
+
+    float peak = 0.0f;
+    for (int start = 0; start < kLength; start += 512) {
+        filter.process(signal.data() + start, 512, modulation.data() + start);
+        for (int i = start; i < start + 512; ++i)
+            peak = std::isfinite(signal[static_cast<size_t>(i)]) ? std::max(peak, std::abs(signal[static_cast<size_t>(i)]))
+                                                                 : 1.0e30f;
+    }
+    return peak;
+}
+
+} // namespace
+
+TEST_CASE("CachedBiquad matches the RBJ design at a fixed cutoff", "[filtering][biquad]")
+{
+    using Type = CachedBiquad::Type;
+
+    for (auto type : { Type::LowPass, Type::HighPass, Type::BandPass, Type::Notch, Type::AllPass }) {
+        for (float q : { 0.7071f, 5.0f }) {
+            CachedBiquad filter;
+            filter.prepare(kSampleRate);
+            filter.setResponse(type, q);
+            filter.snapFrequency(1000.0f);
+
+            for (double frequency : { 250.0, 900.0, 1000.0, 1100.0, 4000.0 }) {
+                const double expected = designGain(type, q, 1000.0, frequency);
+                const double measured = measureGain(filter, frequency);
+                INFO("type " << static_cast<int>(type) << " q " << q << " at " << frequency << " Hz");
+                CHECK(measured == Catch::Approx(expected).margin(0.01).epsilon(0.02));
+            }
+        }
+    }
+}
+
+TEST_CASE("CachedBiquad stays bounded under audio-rate cutoff modulation", "[filtering][biquad]")
+{
+    using Type = CachedBiquad::Type;
+
+    for (auto type : { Type::LowPass, Type::BandPass, Type::HighPass }) {
+        for (float q : { 5.0f, 20.0f }) {
+            for (double rate : { 5.0, 2000.0 }) {
+                INFO("type " << static_cast<int>(type) << " q " << q << " modulated at " << rate << " Hz");
+                // Resonant peak gain is about Q for unit noise, so a generous multiple of it flags divergence
+                CHECK(peakUnderModulation(type, q, rate, 1) < 4.0f * q);
+                CHECK(peakUnderModulation(type, q, rate, 2) < 4.0f * q * q);
+            }
+        }
+    }
+}
+
+TEST_CASE("Prewarp table tracks tan(pi f / fs) across the cutoff range", "[filtering][biquad]")
+{
+    const float* table = FilterPitch::getPrewarpTable();
+    CHECK(table == FilterPitch::getPrewarpTable());
+
+    for (double frequency : { 20.0, 440.0, 1000.0, 5000.0, 15000.0, 23000.0 }) {
+        const float pitch = FilterPitch::fromFrequency(static_cast<float>(frequency), kSampleRate);
+        INFO(frequency << " Hz");
+        // Linear interpolation between 1/128 octave entries; the error grows as tan steepens near Nyquist
+        const double tolerance = frequency < 16000.0 ? 1.0e-4 : 5.0e-3;
+        CHECK(FilterPitch::prewarp(table, pitch) == Catch::Approx(std::tan(kPi * frequency / kSampleRate)).epsilon(tolerance));
+    }
+}
+
+TEST_CASE("CachedBiquad passes audio through until it has a response", "[filtering][biquad]")
+{
+    CachedBiquad filter;
+    filter.prepare(kSampleRate);
+    filter.snapFrequency(1000.0f);
+
+    std::vector<float> signal{ 1.0f, -0.5f, 0.25f, 0.0f };
+    const auto input = signal;
+    filter.process(signal.data(), static_cast<int>(signal.size()));
+    CHECK(signal == input);
+
+    filter.setResponse(CachedBiquad::Type::BandPass, 100.0f);
+    CHECK(filter.getType() == CachedBiquad::Type::BandPass);
+    CHECK(filter.getQ() == 40.0f);
+}
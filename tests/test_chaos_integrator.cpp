@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+    test_chaos_integrator.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Accuracy, sample-rate independence and divergence handling of the
+    chaos integrator
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "oscillators/chaos_integrator.h"
+
+#include <array>
+#include <cmath>
+
+using namespace vital::audio_engine::oscillators;
+using System = ChaosIntegrator::System;
+using Method = ChaosIntegrator::Method;
+
+namespace {
+
+constexpr int kBlock = 256;
+
+using State = std::array<double, 3>;
+
+State derivative(System system, const State& s)
+{
+    if (system == System::Lorenz)
+        return { 10.0 * (s[1] - s[0]), s[0] * (28.0 - s[2]) - s[1], s[0] * s[1] - 8.0 / 3.0 * s[2] };
+    return { -(s[1] + s[2]), s[0] + 0.2 * s[1], 0.2 + s[2] * (s[0] - 5.7) };
+}
+
+/** Double precision RK4 with a much finer step than any test configuration */
+State reference(System system, double time)
+{
+    State s = system == System::Lorenz ? State{ 0.1, 0.0, 0.0 } : State{ 0.1, 0.1, 0.1 };
+    const int steps = static_cast<int>(std::ceil(time / 1.0e-5));
+    const double h = time / steps;
+
+    const auto add = [](const State& a, const State& b, double scale) {
+        return State{ a[0] + scale * b[0], a[1] + scale * b[1], a[2] + scale * b[2] };
+    };
+
+    for (int i = 0; i < steps; ++i) {
+        const State k1 = derivative(system, s);
+        const State k2 = derivative(system, add(s, k1, 0.5 * h));
+        const State k3 = derivative(system, add(s, k2, 0.5 * h));
+        const State k4 = derivative(system, add(s, k3, h));
+        for (size_t c = 0; c < 3; ++c)
+            s[c] += h / 6.0 * (k1[c] + 2.0 * k2[c] + 2.0 * k3[c] + k4[c]);
+    }
+    return s;
+}
+
+/** Integrate voice 0 for numSamples and return its largest coordinate error against the reference */
+double stateError(System system, Method method, int oversampling, double sampleRate, float speed, int numSamples)
+{
+    ChaosIntegrator integrator;
+    integrator.prepare({ system, method, oversampling, 1, kBlock, sampleRate });
+    integrator.setSpeed(0, speed);
+
+    for (int done = 0; done < numSamples; done += kBlock)
+        integrator.process(1, std::min(kBlock, numSamples - done));
+
+    const auto state = integrator.getState(0);
+    const auto expected = reference(system, speed * numSamples / sampleRate);
+
+    double worst = 0.0;
+    for (size_t c = 0; c < 3; ++c)
+        worst = std::max(worst, std::abs(state[c] - expected[c]));
+    return worst;
+}
+
+} // namespace
+
+TEST_CASE("ChaosIntegrator follows the attractor for either system", "[oscillators][chaos]")
+{
+    // Half a time unit: long enough to leave the start point, short enough that chaos stays tame
+    for (const auto system : { System::Lorenz, System::Rossler }) {
+        INFO((system == System::Lorenz ? "Lorenz" : "Rossler"));
+        CHECK(stateError(system, Method::RK4, 1, 48000.0, 100.0f, 240) < 1.0e-3);
+        CHECK(stateError(system, Method::RK2, 2, 48000.0, 100.0f, 240) < 1.0e-2);
+    }
+}
+
+TEST_CASE("ChaosIntegrator error falls with method order and oversampling", "[oscillators][chaos]")
+{
+    // Coarse steps of 0.02 time units make the differences obvious
+    const double euler = stateError(System::Lorenz, Method::Euler, 1, 44100.0, 882.0f, 100);
+    const double rk2 = stateError(System::Lorenz, Method::RK2, 1, 44100.0, 882.0f, 100);
+    const double rk4 = stateError(System::Lorenz, Method::RK4, 1, 44100.0, 882.0f, 100);
+    const double rk2Oversampled = stateError(System::Lorenz, Method::RK2, 4, 44100.0, 882.0f, 100);
+
+    CHECK(rk2 < euler);
+    CHECK(rk4 < rk2);
+    CHECK(rk2Oversampled < rk2);
+}
+
+TEST_CASE("ChaosIntegrator pitch does not depend on the sample rate", "[oscillators][chaos]")
+{
+    // The same quarter second at three host rates lands on the same point
+    const auto stateAt = [](double sampleRate) {
+        ChaosIntegrator integrator;
+        integrator.prepare({ System::Rossler, Method::RK4, 1, 1, kBlock, sampleRate });
+        integrator.setSpeed(0, 20.0f);
+        const int numSamples = static_cast<int>(sampleRate / 4.0);
+        for (int done = 0; done < numSamples; done += kBlock)
+            integrator.process(1, std::min(kBlock, numSamples - done));
+        return integrator.getState(0);
+    };
+
+    const auto low = stateAt(44100.0);
+    const auto mid = stateAt(96000.0);
+    const auto high = stateAt(192000.0);
+
+    for (size_t c = 0; c < 3; ++c) {
+        CHECK(mid[c] == Catch::Approx(low[c]).margin(1.0e-3));
+        CHECK(high[c] == Catch::Approx(low[c]).margin(1.0e-3));
+    }
+}
+
+TEST_CASE("ChaosIntegrator voices run independently across lane groups", "[oscillators][chaos]")
+{
+    ChaosIntegrator integrator;
+    integrator.prepare({ System::Lorenz, Method::RK4, 2, 12, kBlock, 48000.0 });
+
+    for (int voice = 0; voice < 12; ++voice)
+        integrator.setSpeed(voice, 200.0f);
+    integrator.setSpeed(3, 0.0f);
+    integrator.setSpeed(10, 50.0f);
+
+    integrator.process(12, kBlock);
+
+    // Voice 9 sits in the second lane group but matches voice 0
+    for (int i = 0; i < kBlock; ++i)
+        REQUIRE(integrator.getOutput(9)[i] == integrator.getOutput(0)[i]);
+
+    const auto still = integrator.getState(3);
+    CHECK(still[0] == 0.1f);
+    CHECK(still[1] == 0.0f);
+
+    CHECK(integrator.getState(10)[0] != integrator.getState(0)[0]);
+
+    // Restarting one voice leaves the others alone
+    const auto before = integrator.getState(0);
+    integrator.resetVoice(9);
+    CHECK(integrator.getState(9)[0] == 0.1f);
+    CHECK(integrator.getState(0) == before);
+
+    // Voices past numVoices in an unprocessed group do not move
+    integrator.process(4, kBlock);
+    CHECK(integrator.getState(9)[0] == 0.1f);
+}
+
+TEST_CASE("ChaosIntegrator restarts voices that leave the attractor", "[oscillators][chaos]")
+{
+    ChaosIntegrator integrator;
+    integrator.prepare({ System::Lorenz, Method::Euler, 1, 1, kBlock, 8000.0 });
+
+    // Steps of 0.5 time units blow forward Euler up within a few samples
+    integrator.setSpeed(0, 4000.0f);
+    integrator.process(1, kBlock);
+
+    CHECK(integrator.getNumDivergences() > 0);
+    for (float value : integrator.getState(0))
+        CHECK(std::isfinite(value));
+
+    integrator.reset();
+    CHECK(integrator.getNumDivergences() == 0);
+}
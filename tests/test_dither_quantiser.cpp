@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+    test_dither_quantiser.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Step size, clipping and PCM packing of the dithered quantiser
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "utility/dither_quantiser.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace vital::audio_engine::utility;
+
+namespace {
+
+constexpr int kLength = 1000;
+
+DitherQuantiser::Config makeConfig(int bitDepth, DitherQuantiser::Dither dither, DitherQuantiser::Shaping shaping)
+{
+    DitherQuantiser::Config config;
+    config.numChannels = 2;
+    config.bitDepth = bitDepth;
+    config.dither = dither;
+    config.shaping = shaping;
+    return config;
+}
+
+/** Two channels of sine, the second one louder than full scale */
+std::vector<std::vector<float>> makeSignal()
+{
+    std::vector<std::vector<float>> channels(2, std::vector<float>(kLength));
+    for (int i = 0; i < kLength; ++i) {
+        const float phase = 0.05f * static_cast<float>(i);
+        channels[0][static_cast<size_t>(i)] = 0.9f * std::sin(phase);
+        channels[1][static_cast<size_t>(i)] = 1.5f * std::sin(phase);
+    }
+    return channels;
+}
+
+int32_t readInt24(const uint8_t* bytes)
+{
+    const auto value = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16);
+    return static_cast<int32_t>(value << 8) >> 8;
+}
+
+} // namespace
+
+TEST_CASE("DitherQuantiser rounds to the configured step in place", "[utility][dither]")
+{
+    DitherQuantiser quantiser;
+    quantiser.prepare(makeConfig(12, DitherQuantiser::Dither::None, DitherQuantiser::Shaping::None));
+
+    auto channels = makeSignal();
+    const auto original = channels;
+    float* pointers[] = { channels[0].data(), channels[1].data() };
+    quantiser.process(pointers, 2, kLength);
+
+    const float step = 1.0f / 2048.0f;
+    for (int i = 0; i < kLength; ++i) {
+        const float value = channels[0][static_cast<size_t>(i)];
+        REQUIRE(std::abs(value / step - std::round(value / step)) < 1.0e-3f);
+        REQUIRE(std::abs(value - original[0][static_cast<size_t>(i)]) <= 0.5f * step + 1.0e-6f);
+
+        // Overloads clip to the largest codes
+        REQUIRE(channels[1][static_cast<size_t>(i)] >= -1.0f);
+        REQUIRE(channels[1][static_cast<size_t>(i)] <= 1.0f - step);
+    }
+}
+
+TEST_CASE("DitherQuantiser reduces a depth wider than the format instead of wrapping", "[utility][dither]")
+{
+    using Shaping = DitherQuantiser::Shaping;
+
+    for (auto shaping : { Shaping::None, Shaping::FWeighted }) {
+        DitherQuantiser quantiser;
+        quantiser.prepare(makeConfig(24, DitherQuantiser::Dither::Triangular, shaping));
+
+        const auto channels = makeSignal();
+        const float* pointers[] = { channels[0].data(), channels[1].data() };
+        std::vector<int16_t> pcm(2 * kLength);
+        quantiser.process(pointers, 2, kLength, pcm.data(), DitherQuantiser::Format::Int16);
+
+        // Dither and shaping add a few steps of noise; a wrapped sample is off by most of full scale
+        float worst = 0.0f;
+        bool clipped = true;
+        for (int i = 0; i < kLength; ++i) {
+            const float decoded = static_cast<float>(pcm[static_cast<size_t>(2 * i)]) / 32768.0f;
+            worst = std::max(worst, std::abs(decoded - channels[0][static_cast<size_t>(i)]));
+
+            const float loud = channels[1][static_cast<size_t>(i)];
+            const int16_t code = pcm[static_cast<size_t>(2 * i + 1)];
+            if (loud > 1.0f) clipped = clipped && code > 32000;
+            if (loud < -1.0f) clipped = clipped && code < -32000;
+        }
+
+        INFO("shaping " << static_cast<int>(shaping));
+        CHECK(worst < 64.0f / 32768.0f);
+        CHECK(clipped);
+    }
+}
+
+TEST_CASE("DitherQuantiser left-justifies a narrow depth in 24-bit PCM", "[utility][dither]")
+{
+    DitherQuantiser quantiser;
+    quantiser.prepare(makeConfig(16, DitherQuantiser::Dither::None, DitherQuantiser::Shaping::None));
+
+    const auto channels = makeSignal();
+    const float* pointers[] = { channels[0].data(), channels[1].data() };
+    std::vector<uint8_t> pcm(3 * 2 * kLength);
+    quantiser.process(pointers, 2, kLength, pcm.data(), DitherQuantiser::Format::Int24);
+
+    bool justified = true, close = true;
+    for (int i = 0; i < kLength; ++i) {
+        const int32_t value = readInt24(pcm.data() + 6 * i);
+        justified = justified && (value & 0xff) == 0;
+        close = close && std::abs(static_cast<float>(value) / 8388608.0f - channels[0][static_cast<size_t>(i)]) <= 0.5f / 32768.0f + 1.0e-6f;
+    }
+    CHECK(justified);
+    CHECK(close);
+}
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+    test_event_scheduler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Sub-block splitting, event ordering and MIDI decoding of the event
+    scheduler
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/event_scheduler.h"
+
+#include <utility>
+#include <vector>
+
+using namespace vital::audio_engine::core;
+using Event = EventScheduler::Event;
+
+namespace {
+
+/** Everything one process() call did, in call order */
+struct Trace
+{
+    /** Sub-block starts and lengths */
+    std::vector<std::pair<int, int>> blocks;
+
+    /** Events with the sample position the walk had reached when they were handled */
+    std::vector<std::pair<int, Event>> events;
+};
+
+Trace run(EventScheduler& scheduler, int numSamples)
+{
+    Trace trace;
+    int position = 0;
+    scheduler.process(numSamples,
+        [&](const Event& event) { trace.events.emplace_back(position, event); },
+        [&](int start, int count) {
+            trace.blocks.emplace_back(start, count);
+            position = start + count;
+        });
+    return trace;
+}
+
+} // namespace
+
+TEST_CASE("EventScheduler splits the block at every event", "[core][events]")
+{
+    EventScheduler scheduler;
+    scheduler.prepare(16);
+
+    // Added out of order, with two events sharing a timestamp
+    scheduler.addParameterChange(300, 5, 0.5f);
+    scheduler.addParameterChange(100, 1, 0.1f);
+    scheduler.addParameterChange(100, 2, 0.2f);
+    scheduler.addParameterChange(0, 3, 0.3f);
+
+    const auto trace = run(scheduler, 512);
+
+    const std::vector<std::pair<int, int>> expectedBlocks{ { 0, 100 }, { 100, 200 }, { 300, 212 } };
+    CHECK(trace.blocks == expectedBlocks);
+
+    // Each event is handled right before the sub-block that starts at its offset
+    REQUIRE(trace.events.size() == 4);
+    CHECK(trace.events[0].first == 0);
+    CHECK(trace.events[0].second.number == 3);
+    CHECK(trace.events[1].first == 100);
+    CHECK(trace.events[1].second.number == 1);
+    CHECK(trace.events[2].first == 100);
+    CHECK(trace.events[2].second.number == 2);
+    CHECK(trace.events[3].first == 300);
+    CHECK(trace.events[3].second.number == 5);
+
+    // Consumed: the next block has a single sub-block and no events
+    const auto empty = run(scheduler, 64);
+    CHECK(empty.blocks == std::vector<std::pair<int, int>>{ { 0, 64 } });
+    CHECK(empty.events.empty());
+}
+
+TEST_CASE("EventScheduler clamps events to the block", "[core][events]")
+{
+    EventScheduler scheduler;
+    scheduler.prepare(8);
+
+    scheduler.addParameterChange(-20, 1, 1.0f);
+    scheduler.addParameterChange(1000, 2, 1.0f);
+
+    const auto trace = run(scheduler, 256);
+
+    CHECK(trace.blocks == std::vector<std::pair<int, int>>{ { 0, 255 }, { 255, 1 } });
+    REQUIRE(trace.events.size() == 2);
+    CHECK(trace.events[0].second.sampleOffset == 0);
+    CHECK(trace.events[1].second.sampleOffset == 255);
+
+    // A zero-length block still delivers its events
+    scheduler.addParameterChange(10, 3, 1.0f);
+    const auto zero = run(scheduler, 0);
+    CHECK(zero.blocks.empty());
+    CHECK(zero.events.size() == 1);
+}
+
+TEST_CASE("EventScheduler drops events beyond its capacity", "[core][events]")
+{
+    EventScheduler scheduler;
+    scheduler.prepare(3);
+
+    int accepted = 0;
+    for (int i = 0; i < 5; ++i)
+        accepted += scheduler.addParameterChange(i, i, 0.0f) ? 1 : 0;
+
+    CHECK(accepted == 3);
+    CHECK(scheduler.getNumEvents() == 3);
+    CHECK(scheduler.getNumDroppedEvents() == 2);
+
+    scheduler.clear();
+    CHECK(scheduler.getNumEvents() == 0);
+    CHECK(scheduler.getCapacity() == 3);
+}
+
+TEST_CASE("EventScheduler decodes channel voice messages", "[core][events]")
+{
+    juce::MidiBuffer midi;
+    midi.addEvent(juce::MidiMessage::noteOn(1, 60, static_cast<juce::uint8>(127)), 10);
+    midi.addEvent(juce::MidiMessage::noteOn(1, 62, static_cast<juce::uint8>(0)), 20);
+    midi.addEvent(juce::MidiMessage::noteOff(1, 60, static_cast<juce::uint8>(64)), 30);
+    midi.addEvent(juce::MidiMessage::controllerEvent(1, 74, 127), 40);
+    midi.addEvent(juce::MidiMessage::allNotesOff(1), 50);
+    midi.addEvent(juce::MidiMessage::programChange(1, 3), 60);
+    midi.addEvent(juce::MidiMessage::noteOn(2, 64, static_cast<juce::uint8>(100)), 70);
+
+    SECTION("omni")
+    {
+        EventScheduler scheduler;
+        scheduler.prepare(16);
+        scheduler.addMidiBuffer(midi);
+
+        const auto trace = run(scheduler, 128);
+        REQUIRE(trace.events.size() == 6);
+
+        CHECK(trace.events[0].second.type == Event::Type::NoteOn);
+        CHECK(trace.events[0].second.number == 60);
+        CHECK(trace.events[0].second.value == 1.0f);
+
+        // Note on with zero velocity is a note off
+        CHECK(trace.events[1].second.type == Event::Type::NoteOff);
+        CHECK(trace.events[2].second.type == Event::Type::NoteOff);
+        CHECK(trace.events[3].second.type == Event::Type::Controller);
+        CHECK(trace.events[3].second.number == 74);
+        CHECK(trace.events[4].second.type == Event::Type::AllNotesOff);
+
+        // Program change is ignored; the channel 2 note follows
+        CHECK(trace.events[5].second.channel == 2);
+        CHECK(trace.events[5].first == 70);
+    }
+
+    SECTION("single channel")
+    {
+        EventScheduler scheduler;
+        scheduler.prepare(16);
+        scheduler.addMidiBuffer(midi, 2);
+
+        const auto trace = run(scheduler, 128);
+        REQUIRE(trace.events.size() == 1);
+        CHECK(trace.events[0].second.number == 64);
+    }
+}
@@ -0,0 +1,308 @@
+/*
+  ==============================================================================
+    test_granular_engine.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Grain timing, windowing, pool limits, clouds and sources of the
+    granular engine
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "synthesis/granular_engine.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace vital::audio_engine::synthesis;
+using Grain = GranularEngine::GrainParams;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kPi = 3.141592653589793;
+
+std::shared_ptr<const GrainSource> constantSource(int length)
+{
+    return GrainSource::fromSamples(std::vector<float>(static_cast<size_t>(length), 1.0f), kSampleRate);
+}
+
+/** Each sample holds its own index */
+std::shared_ptr<const GrainSource> rampSource(int length, double sampleRate)
+{
+    std::vector<float> samples(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i)
+        samples[static_cast<size_t>(i)] = static_cast<float>(i);
+    return GrainSource::fromSamples(std::move(samples), sampleRate);
+}
+
+Grain makeGrain(double durationSamples, float pan = 0.0f)
+{
+    Grain grain;
+    grain.durationSeconds = static_cast<float>(durationSamples / kSampleRate);
+    grain.pan = pan;
+    return grain;
+}
+
+struct Stereo
+{
+    std::vector<float> left, right;
+};
+
+Stereo render(GranularEngine& engine, int numSamples, int blockSize)
+{
+    Stereo out{ std::vector<float>(static_cast<size_t>(numSamples), 0.0f),
+                std::vector<float>(static_cast<size_t>(numSamples), 0.0f) };
+    for (int start = 0; start < numSamples; start += blockSize)
+        engine.process(out.left.data() + start, out.right.data() + start, std::min(blockSize, numSamples - start));
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("GranularEngine starts a grain at its sample and windows it", "[synthesis][granular]")
+{
+    GranularEngine engine;
+    engine.prepare(kSampleRate);
+    engine.setSource(0, constantSource(4096));
+
+    REQUIRE(engine.schedule(makeGrain(100.0), 37));
+    const auto out = render(engine, 512, 512);
+
+    const double centre = std::cos(0.25 * kPi);
+    for (int i = 0; i < 512; ++i) {
+        INFO("sample " << i);
+        const int t = i - 37;
+        const double window = t >= 0 && t < 100 ? 0.5 - 0.5 * std::cos(2.0 * kPi * t / 100.0) : 0.0;
+        CHECK(out.left[static_cast<size_t>(i)] == Catch::Approx(centre * window).margin(1.0e-5));
+        CHECK(out.right[static_cast<size_t>(i)] == Catch::Approx(centre * window).margin(1.0e-5));
+    }
+
+    CHECK(engine.getNumActiveGrains() == 0);
+    CHECK(engine.getSampleClock() == 512);
+}
+
+TEST_CASE("GranularEngine output does not depend on the block size", "[synthesis][granular]")
+{
+    const auto run = [](int blockSize) {
+        GranularEngine engine;
+        engine.prepare(kSampleRate);
+        engine.setSource(0, rampSource(20000, kSampleRate));
+
+        // Overlapping grains across several internal chunks, one starting in the past
+        for (int i = 0; i < 6; ++i) {
+            auto grain = makeGrain(300.0 + 77.0 * i, -0.8f + 0.3f * static_cast<float>(i));
+            grain.position = 1000.0 * i;
+            grain.pitch = 0.5f + 0.25f * static_cast<float>(i);
+            grain.window = static_cast<GranularEngine::Window>(i % GranularEngine::kNumWindows);
+            engine.schedule(grain, 150 * i - 20);
+        }
+        return render(engine, 1500, blockSize);
+    };
+
+    const auto whole = run(1500);
+    for (int blockSize : { 64, 100, 333 }) {
+        INFO("block size " << blockSize);
+        const auto split = run(blockSize);
+        for (size_t i = 0; i < whole.left.size(); ++i) {
+            REQUIRE(split.left[i] == Catch::Approx(whole.left[i]).epsilon(1.0e-4).margin(1.0e-4));
+            REQUIRE(split.right[i] == Catch::Approx(whole.right[i]).epsilon(1.0e-4).margin(1.0e-4));
+        }
+    }
+}
+
+TEST_CASE("GranularEngine reads its source at the grain's pitch", "[synthesis][granular]")
+{
+    GranularEngine engine;
+    engine.prepare(kSampleRate);
+
+    // Half-rate source: pitch 2 still reads one source sample per output sample
+    engine.setSource(1, rampSource(4096, kSampleRate / 2.0));
+
+    auto grain = makeGrain(400.0, 1.0f);
+    grain.source = 1;
+    grain.position = 100.0;
+    grain.pitch = 2.0f;
+    grain.window = GranularEngine::Window::Tukey;
+    engine.schedule(grain, 0);
+
+    const auto out = render(engine, 400, 400);
+
+    // Hard right; the flat top of the Tukey window passes the ramp unchanged
+    for (int i = 100; i < 300; ++i) {
+        INFO("sample " << i);
+        CHECK(out.left[static_cast<size_t>(i)] == Catch::Approx(0.0f).margin(1.0e-4));
+        CHECK(out.right[static_cast<size_t>(i)] == Catch::Approx(100.0f + static_cast<float>(i)).margin(1.0e-2));
+    }
+
+    // Mono folds both sides so a centred grain keeps its amplitude
+    engine.setSource(0, constantSource(4096));
+    auto centred = makeGrain(200.0);
+    centred.window = GranularEngine::Window::Tukey;
+    engine.schedule(centred, engine.getSampleClock());
+
+    std::vector<float> mono(200, 0.0f);
+    engine.process(mono.data(), nullptr, 200);
+    CHECK(mono[100] == Catch::Approx(1.0f).margin(1.0e-5));
+}
+
+TEST_CASE("GranularEngine drops grains beyond its pool and stops on request", "[synthesis][granular]")
+{
+    GranularEngine engine;
+    engine.prepare(kSampleRate);
+    engine.setSource(0, constantSource(48000));
+
+    std::vector<float> left(16), right(16);
+    const auto scheduleMany = [&engine](int count) {
+        for (int i = 0; i < count; ++i)
+            REQUIRE(engine.schedule(makeGrain(kSampleRate), 0));
+    };
+
+    scheduleMany(1000);
+    engine.process(left.data(), right.data(), 16);
+    scheduleMany(1000);
+    engine.process(left.data(), right.data(), 16);
+    scheduleMany(100);
+    engine.process(left.data(), right.data(), 16);
+
+    CHECK(engine.getNumActiveGrains() == GranularEngine::kMaxGrains);
+    CHECK(engine.getNumDroppedGrains() == 2100 - GranularEngine::kMaxGrains);
+
+    // A grain for an empty source slot is dropped too
+    Grain orphan = makeGrain(100.0);
+    orphan.source = 5;
+    engine.stopAll();
+    engine.schedule(orphan, 0);
+    engine.schedule(makeGrain(100.0), engine.getSampleClock() + 1000);
+    engine.process(left.data(), right.data(), 16);
+
+    CHECK(engine.getNumActiveGrains() == 0);
+    CHECK(engine.getNumDroppedGrains() == 2100 - GranularEngine::kMaxGrains + 1);
+
+    // stopAll also forgets grains still waiting for their time
+    engine.stopAll();
+    const auto out = render(engine, 2048, 256);
+    CHECK(engine.getNumActiveGrains() == 0);
+    for (float value : out.left)
+        REQUIRE(value == 0.0f);
+
+    // Without a consumer the queue eventually fills and refuses commands
+    bool refused = false;
+    for (int i = 0; i < 4096 && !refused; ++i)
+        refused = !engine.schedule(makeGrain(100.0), 0);
+    CHECK(refused);
+}
+
+TEST_CASE("GranularEngine clouds spawn grains at their density", "[synthesis][granular]")
+{
+    GranularEngine engine;
+    engine.prepare(kSampleRate);
+    engine.setSource(0, constantSource(48000));
+
+    // 100 grains a second, 5 ms each: every grain is a separate burst
+    GranularEngine::CloudSettings cloud;
+    cloud.enabled = true;
+    cloud.density = 100.0f;
+    cloud.durationSeconds = 0.005f;
+    cloud.position = 0.5f;
+    cloud.positionJitter = 0.2f;
+    cloud.amplitude = 1.0f;
+    REQUIRE(engine.setCloud(cloud));
+
+    const auto countBursts = [](const std::vector<float>& signal) {
+        int bursts = 0;
+        bool sounding = false;
+        for (float value : signal) {
+            const bool now = value != 0.0f;
+            bursts += now && !sounding ? 1 : 0;
+            sounding = now;
+        }
+        return bursts;
+    };
+
+    const auto periodic = render(engine, 48000, 512);
+    CHECK(countBursts(periodic.left) == 100);
+
+    cloud.randomTiming = 1.0f;
+    cloud.durationSeconds = 0.0005f;
+    engine.setCloud(cloud);
+    const auto random = render(engine, 480000, 512);
+    CHECK(countBursts(random.left) == Catch::Approx(1000).margin(100));
+
+    cloud.enabled = false;
+    engine.setCloud(cloud);
+    render(engine, 4800, 512);
+    const auto silent = render(engine, 4800, 512);
+    CHECK(countBursts(silent.left) == 0);
+}
+
+TEST_CASE("GranularEngine takes grains from another thread while rendering", "[synthesis][granular]")
+{
+    GranularEngine engine;
+    engine.prepare(kSampleRate);
+    engine.setSource(0, constantSource(48000));
+
+    // A full queue refuses and counts the grain as dropped, so the producer retries
+    std::atomic<bool> done{ false };
+    int refused = 0;
+    std::thread producer([&] {
+        for (int i = 0; i < 2000; ++i) {
+            const auto grain = makeGrain(64.0);
+            while (!engine.schedule(grain, engine.getSampleClock() + 32)) {
+                ++refused;
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::vector<float> left(128), right(128);
+    double energy = 0.0;
+    while (!done.load(std::memory_order_acquire)) {
+        engine.process(left.data(), right.data(), 128);
+        for (float value : left)
+            energy += value * value;
+        std::fill(left.begin(), left.end(), 0.0f);
+    }
+    producer.join();
+
+    for (int block = 0; block < 4; ++block)
+        engine.process(left.data(), right.data(), 128);
+
+    CHECK(energy > 0.0);
+    CHECK(engine.getNumDroppedGrains() == refused);
+    CHECK(engine.getNumActiveGrains() == 0);
+}
+
+TEST_CASE("GrainSource owns or maps its samples", "[synthesis][granular]")
+{
+    CHECK(GrainSource::fromSamples({ 1.0f }, kSampleRate) == nullptr);
+    CHECK(GrainSource::fromSamples({ 1.0f, 2.0f }, 0.0) == nullptr);
+
+    std::vector<float> samples{ 0.0f, 0.25f, 0.5f, 0.75f, 1.0f, -1.0f };
+    const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("vital_grain_source_test.raw");
+
+    // An eight-byte header before the samples
+    std::vector<float> contents{ 123.0f, 456.0f };
+    contents.insert(contents.end(), samples.begin(), samples.end());
+    REQUIRE(file.replaceWithData(contents.data(), contents.size() * sizeof(float)));
+
+    const auto mapped = GrainSource::mapFile(file, 22050.0, 2 * sizeof(float));
+    REQUIRE(mapped != nullptr);
+    CHECK(mapped->getLength() == static_cast<int64_t>(samples.size()));
+    CHECK(mapped->getSampleRate() == 22050.0);
+    for (size_t i = 0; i < samples.size(); ++i)
+        CHECK(mapped->getData()[i] == samples[i]);
+    mapped->prefetch();
+
+    CHECK(GrainSource::mapFile(file, 22050.0, 3) == nullptr);
+    CHECK(GrainSource::mapFile(file, 22050.0, 7 * sizeof(float)) == nullptr);
+    CHECK(GrainSource::mapFile(file.getChildFile("missing"), 22050.0) == nullptr);
+
+    file.deleteFile();
+}
@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+    test_main.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Entry point for the core test suite
+  ==============================================================================
+*/
+
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char* argv[])
+{
+    return Catch::Session().run(argc, argv);
+}
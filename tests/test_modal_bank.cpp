@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+    test_modal_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Impulse response, sample-accurate excitation, culling and material
+    layouts of the modal resonator bank
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "synthesis/modal_bank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace vital::audio_engine::synthesis;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kTwoPi = 6.283185307179586;
+
+ModalBank::Mode makeMode(float frequency, float amplitude, float decaySeconds, float phase = 0.0f)
+{
+    ModalBank::Mode mode;
+    mode.frequency = frequency;
+    mode.amplitude = amplitude;
+    mode.decaySeconds = decaySeconds;
+    mode.phase = phase;
+    return mode;
+}
+
+/** Render numSamples in blocks of blockSize */
+std::vector<float> render(ModalBank& bank, int numSamples, int blockSize, const float* excitation = nullptr)
+{
+    std::vector<float> output(static_cast<size_t>(numSamples), 0.0f);
+    for (int start = 0; start < numSamples; start += blockSize)
+        bank.process(output.data() + start, std::min(blockSize, numSamples - start),
+                     excitation != nullptr ? excitation + start : nullptr);
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("ModalBank rings a struck mode as a decaying sine", "[synthesis][modal]")
+{
+    ModalBank bank;
+    bank.prepare(8, kSampleRate);
+    bank.setNumModes(1);
+    bank.setMode(0, makeMode(1000.0f, 0.5f, 0.5f, 0.3f));
+
+    bank.strike(10, 1.0f);
+    const auto output = render(bank, 2000, 2000);
+
+    for (int i = 0; i < 10; ++i)
+        CHECK(output[static_cast<size_t>(i)] == 0.0f);
+
+    // T60 of half a second, starting one rotation after the strike
+    const double radius = std::pow(1.0e-3, 1.0 / (0.5 * kSampleRate));
+    const double omega = kTwoPi * 1000.0 / kSampleRate;
+    for (int k = 0; k < 1990; ++k) {
+        INFO("sample " << k);
+        const double expected = 0.5 * std::pow(radius, k + 1) * std::sin(omega * (k + 1) + 0.3);
+        CHECK(output[static_cast<size_t>(10 + k)] == Catch::Approx(expected).margin(1.0e-4));
+    }
+}
+
+TEST_CASE("ModalBank applies strikes and excitation at their sample", "[synthesis][modal]")
+{
+    const auto makeBank = [](ModalBank& bank) {
+        bank.prepare(24, kSampleRate);
+        bank.setNumModes(20);
+        for (int i = 0; i < 20; ++i)
+            bank.setMode(i, makeMode(200.0f * static_cast<float>(i + 1), 0.05f, 0.2f, 0.1f * static_cast<float>(i)));
+    };
+
+    SECTION("strikes in one block match strikes in separate blocks")
+    {
+        ModalBank whole, split;
+        makeBank(whole);
+        makeBank(split);
+
+        // Added out of order, and the second lands past the first internal chunk
+        whole.strike(300, 0.5f);
+        whole.strike(40, 1.0f);
+        const auto expected = render(whole, 512, 512);
+
+        std::vector<float> actual(512, 0.0f);
+        split.process(actual.data(), 40);
+        split.strike(0, 1.0f);
+        split.process(actual.data() + 40, 260);
+        split.strike(0, 0.5f);
+        split.process(actual.data() + 300, 212);
+
+        for (size_t i = 0; i < actual.size(); ++i)
+            CHECK(actual[i] == Catch::Approx(expected[i]).margin(1.0e-6));
+    }
+
+    SECTION("a strike past the block lands on its last sample")
+    {
+        ModalBank bank;
+        makeBank(bank);
+        bank.strike(5000, 1.0f);
+
+        const auto output = render(bank, 64, 64);
+        for (int i = 0; i < 63; ++i)
+            CHECK(output[static_cast<size_t>(i)] == 0.0f);
+        CHECK(output[63] != 0.0f);
+    }
+
+    SECTION("an excitation impulse rings like a strike one sample later")
+    {
+        ModalBank driven, struck;
+        makeBank(driven);
+        makeBank(struck);
+
+        std::vector<float> excitation(600, 0.0f);
+        excitation[100] = 0.7f;
+        const auto drivenOutput = render(driven, 600, 128, excitation.data());
+
+        struck.strike(101, 0.7f);
+        const auto struckOutput = render(struck, 600, 600);
+
+        for (int i = 0; i < 100; ++i)
+            CHECK(drivenOutput[static_cast<size_t>(i)] == 0.0f);
+        for (int i = 101; i < 600; ++i)
+            CHECK(drivenOutput[static_cast<size_t>(i)] == Catch::Approx(struckOutput[static_cast<size_t>(i)]).margin(1.0e-6));
+    }
+}
+
+TEST_CASE("ModalBank skips groups that cannot ring or have died away", "[synthesis][modal]")
+{
+    ModalBank bank;
+    bank.prepare(32, kSampleRate);
+    bank.setNumModes(32);
+
+    // Group 0 rings briefly, group 1 is above Nyquist, group 2 silent, group 3 too short to hear
+    for (int i = 0; i < 8; ++i) {
+        bank.setMode(i, makeMode(300.0f + 50.0f * static_cast<float>(i), 0.1f, 0.05f));
+        bank.setMode(8 + i, makeMode(30000.0f, 0.1f, 1.0f));
+        bank.setMode(16 + i, makeMode(500.0f, 0.0f, 1.0f));
+        bank.setMode(24 + i, makeMode(500.0f, 0.1f, 0.001f));
+    }
+
+    std::vector<float> block(256, 0.0f);
+    bank.process(block.data(), 256);
+    CHECK(bank.getNumActiveGroups() == 0);
+
+    bank.strike(0, 1.0f);
+    bank.process(block.data(), 256);
+    CHECK(bank.getNumActiveGroups() == 1);
+    CHECK(bank.getNumActiveModes() == ModalBank::kLaneWidth);
+
+    // A 50 ms T60 is far below -100 dB after half a second
+    render(bank, 24000, 256);
+    std::fill(block.begin(), block.end(), 0.0f);
+    bank.process(block.data(), 256);
+    CHECK(bank.getNumActiveGroups() == 0);
+    CHECK(std::all_of(block.begin(), block.end(), [](float value) { return value == 0.0f; }));
+
+    // Dropping the mode count silences everything immediately
+    bank.strike(0, 1.0f);
+    bank.setNumModes(0);
+    bank.process(block.data(), 256);
+    CHECK(bank.getNumActiveGroups() == 0);
+}
+
+TEST_CASE("ModalBank materials lay out normalised ascending modes", "[synthesis][modal]")
+{
+    using Material = ModalBank::Material;
+
+    ModalBank bank;
+    bank.prepare(ModalBank::kMaxModes, kSampleRate);
+
+    SECTION("harmonic layout")
+    {
+        ModalBank::MaterialPreset preset;
+        preset.layout = ModalBank::ModeLayout::Harmonic;
+        bank.setMaterial(preset, 110.0f, 6);
+
+        REQUIRE(bank.getNumModes() == 6);
+        for (int i = 0; i < 6; ++i)
+            CHECK(bank.getMode(i).frequency == Catch::Approx(110.0f * static_cast<float>(i + 1)));
+    }
+
+    for (const auto material : { Material::Wood, Material::Metal, Material::Glass,
+                                 Material::Bell, Material::Plate, Material::Membrane }) {
+        const auto preset = ModalBank::getPreset(material);
+        bank.setMaterial(material, 100.0f, 64);
+        INFO("layout " << static_cast<int>(preset.layout));
+
+        float amplitudeSum = 0.0f;
+        for (int i = 0; i < 64; ++i) {
+            const auto& mode = bank.getMode(i);
+            amplitudeSum += mode.amplitude;
+            if (i > 0) {
+                CHECK(mode.frequency >= bank.getMode(i - 1).frequency);
+                CHECK(mode.decaySeconds <= bank.getMode(i - 1).decaySeconds);
+            }
+        }
+        CHECK(amplitudeSum == Catch::Approx(1.0f).epsilon(1.0e-4));
+
+        // A unit strike never peaks above one
+        bank.reset();
+        bank.strike(0, 1.0f);
+        const auto output = render(bank, 8192, 512);
+        float peak = 0.0f;
+        for (float value : output)
+            peak = std::max(peak, std::abs(value));
+        CHECK(peak <= 1.0f);
+        CHECK(peak > 0.01f);
+    }
+}
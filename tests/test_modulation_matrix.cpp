@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+    test_modulation_matrix.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Route evaluation and program handoff of the compiled modulation matrix
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "modulation/modulation_matrix.h"
+
+using namespace vital::audio_engine::modulation;
+
+namespace {
+
+constexpr int kBlockSize = 64;
+
+ModulationMatrix::Config smallConfig(int numVoices = 1)
+{
+    ModulationMatrix::Config config;
+    config.numSources = 8;
+    config.numDestinations = 16;
+    config.numVoices = numVoices;
+    config.maxBlockSize = kBlockSize;
+    config.maxRoutes = 8;
+    return config;
+}
+
+/** One block with every source at its given value; the adopted program takes over after it */
+void runBlock(ModulationMatrix& matrix, float sourceValue)
+{
+    for (int source = 0; source < matrix.getConfig().numSources; ++source)
+        matrix.setSourceValue(source, sourceValue);
+    matrix.process(kBlockSize);
+}
+
+} // namespace
+
+TEST_CASE("Curves shape each route and rows sum their routes", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig());
+
+    matrix.addRoute(0, 3, 0.5f);
+    matrix.addRoute(1, 3, 0.25f, ModulationMatrix::Curve::Cubic);
+    matrix.addRoute(2, 4, -1.0f, ModulationMatrix::Curve::Quadratic);
+    matrix.compile();
+    runBlock(matrix, 0.0f);
+
+    matrix.setSourceValue(0, 0.8f);
+    matrix.setSourceValue(1, -0.5f);
+    matrix.setSourceValue(2, -0.5f);
+    matrix.process(kBlockSize);
+
+    CHECK(matrix.getModulation(3) == Catch::Approx(0.5f * 0.8f + 0.25f * -0.125f));
+    CHECK(matrix.getModulation(4) == Catch::Approx(-1.0f * -0.5f * 0.5f));
+    CHECK(matrix.getModulation(5) == 0.0f);
+    CHECK(matrix.isModulated(3));
+    CHECK_FALSE(matrix.isModulated(5));
+}
+
+TEST_CASE("Recompiling keeps a steady route's output", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig());
+
+    matrix.addRoute(0, 5, 0.5f);
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+
+    for (int edit = 0; edit < 4; ++edit) {
+        matrix.addRoute(1, 6 + edit, 0.1f);
+        matrix.compile();
+
+        for (int block = 0; block < 3; ++block) {
+            runBlock(matrix, 1.0f);
+            INFO("edit " << edit << ", block " << block);
+            CHECK(matrix.getModulation(5) == Catch::Approx(0.5f));
+        }
+    }
+}
+
+TEST_CASE("Per-voice outputs survive a recompile", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig(6));
+
+    matrix.addRoute(0, 2, 1.0f);
+    matrix.compile();
+    runBlock(matrix, 0.0f);
+
+    for (int voice = 0; voice < 6; ++voice)
+        matrix.setSourceValue(0, voice, 0.1f * static_cast<float>(voice));
+    matrix.addRoute(1, 3, 1.0f);
+    matrix.compile();
+    matrix.process(kBlockSize);
+
+    for (int voice = 0; voice < 6; ++voice)
+        CHECK(matrix.getModulation(2, voice) == Catch::Approx(0.1f * static_cast<float>(voice)));
+}
+
+TEST_CASE("Removing a route returns its destination to zero", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig());
+
+    const int route = matrix.addRoute(0, 7, 0.5f);
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+    runBlock(matrix, 1.0f);
+    REQUIRE(matrix.getModulation(7) == Catch::Approx(0.5f));
+
+    matrix.removeRoute(route);
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+
+    CHECK(matrix.getModulation(7) == 0.0f);
+    CHECK_FALSE(matrix.isModulated(7));
+}
+
+TEST_CASE("A removed route's id is not reused while the live program reads it", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig());
+
+    const int first = matrix.addRoute(0, 1, 0.5f);
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+
+    matrix.removeRoute(first);
+    const int second = matrix.addRoute(0, 2, 0.9f);
+    CHECK(second != first);
+
+    // Still the old program: the removed route keeps its own depth
+    runBlock(matrix, 1.0f);
+    CHECK(matrix.getModulation(1) == Catch::Approx(0.5f));
+
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+    runBlock(matrix, 1.0f);
+    CHECK(matrix.getModulation(1) == 0.0f);
+    CHECK(matrix.getModulation(2) == Catch::Approx(0.9f));
+
+    // Once a program without it is live the id is handed out again
+    matrix.compile();
+    runBlock(matrix, 1.0f);
+    matrix.compile();
+    bool reused = false;
+    for (int i = 0; i < 7 && !reused; ++i)
+        reused = matrix.addRoute(3, 4, 0.1f) == first;
+    CHECK(reused);
+}
+
+TEST_CASE("Audio-rate destinations follow their sources and survive a recompile", "[modulation]")
+{
+    ModulationMatrix matrix;
+    matrix.prepare(smallConfig());
+
+    REQUIRE(matrix.setSourceRate(0, ModulationMatrix::Rate::Audio));
+    REQUIRE(matrix.setDestinationRate(9, ModulationMatrix::Rate::Audio));
+    matrix.addRoute(0, 9, 2.0f);
+    matrix.compile();
+    matrix.process(kBlockSize);
+
+    auto fillRamp = [&matrix] {
+        float* source = matrix.getSourceBuffer(0);
+        REQUIRE(source != nullptr);
+        for (int i = 0; i < kBlockSize; ++i)
+            source[i] = static_cast<float>(i) / kBlockSize;
+    };
+
+    fillRamp();
+    matrix.process(kBlockSize);
+
+    // An unrelated destination turns audio rate, so the slots are rearranged
+    REQUIRE(matrix.setDestinationRate(3, ModulationMatrix::Rate::Audio));
+    matrix.addRoute(1, 3, 1.0f);
+    matrix.compile();
+
+    fillRamp();
+    matrix.process(kBlockSize);
+
+    const float* output = matrix.getModulationBuffer(9);
+    REQUIRE(output != nullptr);
+    for (int i = 0; i < kBlockSize; ++i)
+        CHECK(output[i] == Catch::Approx(2.0f * static_cast<float>(i) / kBlockSize));
+}
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+    test_new_oscillators.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Block kernels and static dispatch of the new oscillator types
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "oscillators/new_oscillators.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace vital::audio_engine::oscillators;
+
+namespace {
+
+constexpr int kBlock = 512;
+
+/** Every type whose output does not depend on a random seed */
+const std::vector<NewOscillatorType> kDeterministicTypes{
+    NewOscillatorType::Lorenz, NewOscillatorType::Rossler, NewOscillatorType::Henon,
+    NewOscillatorType::Perlin, NewOscillatorType::AdaptiveFM, NewOscillatorType::Wavetable
+};
+
+void configure(Oscillator& oscillator)
+{
+    oscillator.setSampleRate(48000.0f);
+    oscillator.setFrequency(220.0f);
+    oscillator.setAmplitude(0.8f);
+    oscillator.reset();
+}
+
+std::vector<float> renderPieces(Oscillator& oscillator, const std::vector<int>& pieces)
+{
+    std::vector<float> output(kBlock, 0.0f);
+    int offset = 0;
+    for (size_t piece = 0; offset < kBlock; ++piece) {
+        const int count = std::min(pieces[piece % pieces.size()], kBlock - offset);
+        oscillator.process(output.data() + offset, count);
+        offset += count;
+    }
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("Oscillator block kernels do not depend on the block split", "[oscillators][kernels]")
+{
+    for (const auto type : kDeterministicTypes) {
+        INFO(NewOscillatorFactory::getOscillatorName(type));
+
+        auto whole = NewOscillatorFactory::createOscillator(type, "whole");
+        auto split = NewOscillatorFactory::createOscillator(type, "split");
+        REQUIRE(whole != nullptr);
+        configure(*whole);
+        configure(*split);
+
+        const auto reference = renderPieces(*whole, { kBlock });
+        const auto pieces = renderPieces(*split, { 1, 100, 37, 256 });
+
+        float worst = 0.0f;
+        for (int i = 0; i < kBlock; ++i)
+            worst = std::max(worst, std::abs(pieces[static_cast<size_t>(i)] - reference[static_cast<size_t>(i)]));
+        CHECK(worst < 1.0e-5f);
+
+        CHECK(split->getPhase() == Catch::Approx(whole->getPhase()).margin(1.0e-4));
+    }
+}
+
+TEST_CASE("OscillatorHandle renders the same samples as the virtual interface", "[oscillators][kernels]")
+{
+    for (const auto type : kDeterministicTypes) {
+        INFO(NewOscillatorFactory::getOscillatorName(type));
+
+        auto oscillator = NewOscillatorFactory::createOscillator(type, "virtual");
+        auto handle = NewOscillatorFactory::createHandle(type, "handle");
+        REQUIRE(handle);
+        configure(*oscillator);
+        configure(*handle.get());
+
+        std::vector<float> expected(kBlock), actual(kBlock);
+        for (int block = 0; block < 3; ++block) {
+            oscillator->process(expected.data(), kBlock);
+            handle.process(actual.data(), kBlock);
+            CHECK(actual == expected);
+        }
+
+        std::vector<float> left(kBlock), right(kBlock);
+        handle.processStereo(left.data(), right.data(), kBlock);
+        for (int i = 0; i < kBlock; ++i)
+            CHECK(std::isfinite(left[static_cast<size_t>(i)]));
+    }
+
+    auto henon = NewOscillatorFactory::createHandle(NewOscillatorType::Henon, "henon");
+    CHECK(henon.getAs<HenonOscillator>() != nullptr);
+    CHECK(henon.getAs<LorenzOscillator>() == nullptr);
+
+    // Types without an implementation give an empty handle that renders nothing
+    auto missing = NewOscillatorFactory::createHandle(NewOscillatorType::Worley, "worley");
+    CHECK_FALSE(missing);
+    CHECK(NewOscillatorFactory::createOscillator(NewOscillatorType::Worley, "worley") == nullptr);
+
+    std::vector<float> untouched(16, 0.5f);
+    missing.process(untouched.data(), 16);
+    CHECK(untouched == std::vector<float>(16, 0.5f));
+}
+
+TEST_CASE("HenonOscillator iterates the map and soft clips it", "[oscillators][kernels]")
+{
+    HenonOscillator oscillator("henon");
+    configure(oscillator);
+
+    std::vector<float> output(kBlock);
+    oscillator.process(output.data(), kBlock);
+
+    float x = 0.1f, y = 0.3f;
+    for (int i = 0; i < kBlock; ++i) {
+        const float newX = 1.0f - 1.4f * x * x + y;
+        y = 0.3f * x;
+        x = newX;
+        INFO("sample " << i);
+        CHECK(output[static_cast<size_t>(i)] == Catch::Approx(std::tanh(0.3f * x) * 0.8f).margin(2.0e-4));
+    }
+}
+
+TEST_CASE("QuantumSineOscillator without uncertainty is a plain sine", "[oscillators][kernels]")
+{
+    QuantumSineOscillator oscillator("quantum");
+    configure(oscillator);
+    oscillator.setQuantumUncertainty(0.0f);
+    oscillator.setCollapseProbability(0.0f);
+
+    // Longer than one random chunk
+    std::vector<float> output(200);
+    oscillator.process(output.data(), 200);
+
+    const double increment = 220.0 / 48000.0;
+    for (int i = 0; i < 200; ++i) {
+        INFO("sample " << i);
+        CHECK(output[static_cast<size_t>(i)]
+              == Catch::Approx(0.8 * std::sin(6.283185307179586 * increment * i)).margin(1.0e-3));
+    }
+
+    // With full uncertainty and frequent collapses the output stays bounded
+    oscillator.setQuantumUncertainty(1.0f);
+    oscillator.setCollapseProbability(0.1f);
+    oscillator.process(output.data(), 200);
+    for (float value : output)
+        CHECK(std::abs(value) <= 0.8f + 1.0e-5f);
+}
@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+    test_noise_field.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Batched Perlin and simplex kernels against scalar reference noise, their
+    range, and seed compatibility of the shared noise tables
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "oscillators/noise_field.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace vital::audio_engine::oscillators;
+
+namespace {
+
+constexpr int kBatch = NoiseField::kBatch;
+
+/**
+ * The Perlin oscillator's noise before NoiseField: its mt19937 Fisher-Yates
+ * shuffle, branchy gradient selection and scalar 3D Perlin, plus textbook
+ * scalar simplex noise on the same permutation.
+ */
+class ReferenceNoise
+{
+public:
+    explicit ReferenceNoise(int seed)
+    {
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(seed));
+        for (int i = 0; i < 256; ++i)
+            perm_[static_cast<size_t>(i)] = i;
+
+        for (int i = 255; i > 0; --i) {
+            std::uniform_int_distribution<> swapIndex(0, i);
+            std::swap(perm_[static_cast<size_t>(i)], perm_[static_cast<size_t>(swapIndex(gen))]);
+        }
+
+        for (int i = 0; i < 256; ++i)
+            perm_[static_cast<size_t>(i) + 256] = perm_[static_cast<size_t>(i)];
+    }
+
+    float perlin(float x, float y, float z) const
+    {
+        const int X = static_cast<int>(std::floor(x)) & 255;
+        const int Y = static_cast<int>(std::floor(y)) & 255;
+        const int Z = static_cast<int>(std::floor(z)) & 255;
+
+        x -= std::floor(x);
+        y -= std::floor(y);
+        z -= std::floor(z);
+
+        const float u = NoiseField::fade(x), v = NoiseField::fade(y), w = NoiseField::fade(z);
+
+        const int A = p(X) + Y, AA = p(A) + Z, AB = p(A + 1) + Z;
+        const int B = p(X + 1) + Y, BA = p(B) + Z, BB = p(B + 1) + Z;
+
+        return lerp(w, lerp(v, lerp(u, grad(p(AA), x, y, z), grad(p(BA), x - 1.0f, y, z)),
+                               lerp(u, grad(p(AB), x, y - 1.0f, z), grad(p(BB), x - 1.0f, y - 1.0f, z))),
+                       lerp(v, lerp(u, grad(p(AA + 1), x, y, z - 1.0f), grad(p(BA + 1), x - 1.0f, y, z - 1.0f)),
+                               lerp(u, grad(p(AB + 1), x, y - 1.0f, z - 1.0f),
+                                       grad(p(BB + 1), x - 1.0f, y - 1.0f, z - 1.0f))));
+    }
+
+    float simplex(float x, float y, float z) const
+    {
+        static constexpr float kGradients[12][3] = {
+            { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+            { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+            { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 }
+        };
+        constexpr float F3 = 1.0f / 3.0f;
+        constexpr float G3 = 1.0f / 6.0f;
+
+        const float s = (x + y + z) * F3;
+        const int i = static_cast<int>(std::floor(x + s));
+        const int j = static_cast<int>(std::floor(y + s));
+        const int k = static_cast<int>(std::floor(z + s));
+        const float t = static_cast<float>(i + j + k) * G3;
+        const float x0 = x - (static_cast<float>(i) - t);
+        const float y0 = y - (static_cast<float>(j) - t);
+        const float z0 = z - (static_cast<float>(k) - t);
+
+        int i1, j1, k1, i2, j2, k2;
+        if (x0 >= y0) {
+            if (y0 >= z0)      { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+            else if (x0 >= z0) { i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+            else               { i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+        } else {
+            if (y0 < z0)       { i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+            else if (x0 < z0)  { i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+            else               { i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+        }
+
+        const float offsets[4][3] = {
+            { x0, y0, z0 },
+            { x0 - i1 + G3, y0 - j1 + G3, z0 - k1 + G3 },
+            { x0 - i2 + 2.0f * G3, y0 - j2 + 2.0f * G3, z0 - k2 + 2.0f * G3 },
+            { x0 - 1.0f + 3.0f * G3, y0 - 1.0f + 3.0f * G3, z0 - 1.0f + 3.0f * G3 }
+        };
+        const int ii = i & 255, jj = j & 255, kk = k & 255;
+        const int corners[4][3] = { { 0, 0, 0 }, { i1, j1, k1 }, { i2, j2, k2 }, { 1, 1, 1 } };
+
+        float sum = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            const float* d = offsets[c];
+            const float falloff = 0.6f - d[0] * d[0] - d[1] * d[1] - d[2] * d[2];
+            if (falloff < 0.0f) continue;
+
+            const int gi = p(ii + corners[c][0] + p(jj + corners[c][1] + p(kk + corners[c][2]))) % 12;
+            const float* g = kGradients[gi];
+            sum += falloff * falloff * falloff * falloff * (g[0] * d[0] + g[1] * d[1] + g[2] * d[2]);
+        }
+        return 32.0f * sum;
+    }
+
+private:
+    int p(int index) const { return perm_[static_cast<size_t>(index)]; }
+
+    static float lerp(float t, float a, float b) { return a + t * (b - a); }
+
+    static float grad(int hash, float x, float y, float z)
+    {
+        const int h = hash & 15;
+        const float u = h < 8 ? x : y;
+        const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    std::array<int, 512> perm_{};
+};
+
+struct Points
+{
+    std::vector<float> x, y, z;
+};
+
+/** Random points in [-300, 300), which wraps the 256-cell lattice both ways, plus exact and near cell boundaries */
+Points makePoints(int count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coordinate(-300.0f, 300.0f);
+
+    Points points;
+    for (int i = 0; i < count; ++i) {
+        points.x.push_back(coordinate(rng));
+        points.y.push_back(coordinate(rng));
+        points.z.push_back(coordinate(rng));
+    }
+
+    const float boundaries[] = { 0.0f, -0.0f, 1.0f, -1.0f, 255.0f, 256.0f, -256.0f,
+                                 std::nextafter(1.0f, 0.0f), std::nextafter(-1.0f, 0.0f),
+                                 std::nextafter(256.0f, 512.0f), -17.5f, 3.25f };
+    for (float bx : boundaries) {
+        for (float by : boundaries) {
+            points.x.push_back(bx);
+            points.y.push_back(by);
+            points.z.push_back(-bx);
+        }
+    }
+
+    // Whole batches only
+    while (points.x.size() % kBatch != 0) {
+        points.x.push_back(0.5f);
+        points.y.push_back(-0.5f);
+        points.z.push_back(0.25f);
+    }
+    return points;
+}
+
+template <typename Batched>
+std::vector<float> evaluate(const Points& points, Batched&& batched)
+{
+    std::vector<float> output(points.x.size());
+    for (size_t start = 0; start < output.size(); start += kBatch)
+        batched(points.x.data() + start, points.y.data() + start, points.z.data() + start, output.data() + start);
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("NoiseField batched Perlin matches the scalar noise", "[oscillators][noise]")
+{
+    const auto points = makePoints(4096, 1);
+
+    for (const int seed : { 0, 12345, -7 }) {
+        INFO("seed " << seed);
+        const auto field = NoiseField::get(seed);
+        const ReferenceNoise reference(seed);
+
+        const auto batched = evaluate(points, [&](const float* x, const float* y, const float* z, float* out) {
+            field->perlin(x, y, z, out);
+        });
+
+        for (size_t i = 0; i < batched.size(); ++i) {
+            INFO("at (" << points.x[i] << ", " << points.y[i] << ", " << points.z[i] << ")");
+            REQUIRE(batched[i] == field->perlin(points.x[i], points.y[i], points.z[i]));
+            REQUIRE(batched[i] == Catch::Approx(reference.perlin(points.x[i], points.y[i], points.z[i])).margin(1.0e-6));
+        }
+    }
+}
+
+TEST_CASE("NoiseField batched simplex matches the scalar noise", "[oscillators][noise]")
+{
+    const auto points = makePoints(4096, 2);
+
+    for (const int seed : { 0, 12345, -7 }) {
+        INFO("seed " << seed);
+        const auto field = NoiseField::get(seed);
+        const ReferenceNoise reference(seed);
+
+        const auto batched = evaluate(points, [&](const float* x, const float* y, const float* z, float* out) {
+            field->simplex(x, y, z, out);
+        });
+
+        for (size_t i = 0; i < batched.size(); ++i) {
+            INFO("at (" << points.x[i] << ", " << points.y[i] << ", " << points.z[i] << ")");
+            REQUIRE(batched[i] == field->simplex(points.x[i], points.y[i], points.z[i]));
+            REQUIRE(batched[i] == Catch::Approx(reference.simplex(points.x[i], points.y[i], points.z[i])).margin(1.0e-5));
+        }
+    }
+}
+
+TEST_CASE("NoiseField outputs stay within [-1, 1]", "[oscillators][noise]")
+{
+    const auto field = NoiseField::get(12345);
+    const auto points = makePoints(1 << 16, 3);
+
+    const auto perlin = evaluate(points, [&](const float* x, const float* y, const float* z, float* out) {
+        field->perlin(x, y, z, out);
+    });
+    const auto simplex = evaluate(points, [&](const float* x, const float* y, const float* z, float* out) {
+        field->simplex(x, y, z, out);
+    });
+
+    const auto [perlinMin, perlinMax] = std::minmax_element(perlin.begin(), perlin.end());
+    const auto [simplexMin, simplexMax] = std::minmax_element(simplex.begin(), simplex.end());
+    CHECK(*perlinMin >= -1.0f);
+    CHECK(*perlinMax <= 1.0f);
+    CHECK(*simplexMin >= -1.0f);
+    CHECK(*simplexMax <= 1.0f);
+
+    // Not trivially small either
+    CHECK(*perlinMax - *perlinMin > 1.0f);
+    CHECK(*simplexMax - *simplexMin > 1.0f);
+}
+
+TEST_CASE("NoiseField seeds keep the oscillator's permutation", "[oscillators][noise]")
+{
+    SECTION("fields are shared per seed")
+    {
+        const auto first = NoiseField::get(42);
+        CHECK(NoiseField::get(42) == first);
+        CHECK(NoiseField::get(43) != first);
+        CHECK(first->getSeed() == 42);
+    }
+
+    SECTION("the line kernel is Perlin noise on y = z = 0")
+    {
+        const auto field = NoiseField::get(42);
+        const ReferenceNoise reference(42);
+
+        for (float x = -600.0f; x < 600.0f; x += 0.37f) {
+            INFO("x " << x);
+            REQUIRE(field->perlinLine(x) == Catch::Approx(reference.perlin(x, 0.0f, 0.0f)).margin(1.0e-6));
+        }
+    }
+
+    SECTION("different seeds give different noise")
+    {
+        const auto a = NoiseField::get(1);
+        const auto b = NoiseField::get(2);
+
+        int differing = 0;
+        for (int i = 0; i < 64; ++i) {
+            const float x = 0.3f + 1.7f * static_cast<float>(i);
+            differing += a->perlin(x, 0.5f, 0.5f) != b->perlin(x, 0.5f, 0.5f) ? 1 : 0;
+        }
+        CHECK(differing > 48);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+    test_offline_renderer.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Job validation and batch result ordering of the offline renderer
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "offline_renderer.h"
+
+#include <vector>
+
+using namespace vital::audio_engine;
+
+namespace {
+
+juce::File testDirectory()
+{
+    auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("vital_offline_renderer_test");
+    directory.createDirectory();
+    return directory;
+}
+
+/** A one-note type 1 MIDI file */
+juce::File writeMidiFile(const juce::String& name)
+{
+    juce::MidiMessageSequence track;
+    track.addEvent(juce::MidiMessage::noteOn(1, 60, static_cast<juce::uint8>(100)), 0.0);
+    track.addEvent(juce::MidiMessage::noteOff(1, 60), 480.0);
+    track.updateMatchedPairs();
+
+    juce::MidiFile midi;
+    midi.setTicksPerQuarterNote(480);
+    midi.addTrack(track);
+
+    auto file = testDirectory().getChildFile(name);
+    file.deleteFile();
+    juce::FileOutputStream stream(file);
+    REQUIRE(stream.openedOk());
+    REQUIRE(midi.writeTo(stream));
+    return file;
+}
+
+OfflineRenderer::Settings makeSettings()
+{
+    OfflineRenderer::Settings settings;
+    settings.midiFile = writeMidiFile("one_note.mid");
+    settings.outputFile = testDirectory().getChildFile("out.wav");
+    settings.tailSeconds = 0.1;
+    return settings;
+}
+
+} // namespace
+
+TEST_CASE("OfflineRenderer rejects invalid jobs before rendering", "[offline][render]")
+{
+    SECTION("settings")
+    {
+        auto settings = makeSettings();
+        settings.blockSize = 0;
+        const auto result = OfflineRenderer::render(settings);
+        CHECK_FALSE(result.success);
+        CHECK(result.errorMessage.isNotEmpty());
+    }
+
+    SECTION("missing preset")
+    {
+        auto settings = makeSettings();
+        settings.presetFile = testDirectory().getChildFile("missing.vital");
+        const auto result = OfflineRenderer::render(settings);
+        CHECK_FALSE(result.success);
+        CHECK(result.errorMessage.contains("Preset file not found"));
+    }
+
+    SECTION("missing MIDI")
+    {
+        auto settings = makeSettings();
+        settings.midiFile = testDirectory().getChildFile("missing.mid");
+        const auto result = OfflineRenderer::render(settings);
+        CHECK_FALSE(result.success);
+        CHECK(result.errorMessage.contains("MIDI"));
+    }
+
+    SECTION("output format")
+    {
+        auto settings = makeSettings();
+        settings.outputFile = testDirectory().getChildFile("out.mp3");
+        const auto result = OfflineRenderer::render(settings);
+        CHECK_FALSE(result.success);
+        CHECK(result.errorMessage.contains("Unsupported output format"));
+        CHECK_FALSE(settings.outputFile.exists());
+    }
+}
+
+TEST_CASE("OfflineRenderer batch results follow job order", "[offline][render]")
+{
+    std::vector<OfflineRenderer::Settings> jobs;
+    for (int i = 0; i < 6; ++i) {
+        auto job = makeSettings();
+        job.midiFile = testDirectory().getChildFile("missing_" + juce::String(i) + ".mid");
+        jobs.push_back(job);
+    }
+
+    const auto results = OfflineRenderer::renderBatch(jobs, 3);
+
+    REQUIRE(results.size() == jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        INFO("job " << i);
+        CHECK_FALSE(results[i].success);
+        CHECK(results[i].errorMessage.contains(jobs[i].midiFile.getFileName()));
+    }
+}
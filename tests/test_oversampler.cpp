@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+    test_oversampler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Round trips, reported latency, image rejection and block splitting of
+    the half-band oversampler
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "utility/oversampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace vital::audio_engine::utility;
+using Phase = Oversampler::Phase;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kTwoPi = 6.283185307179586;
+constexpr int kLength = 8192;
+
+std::vector<float> makeSine(double frequency, int length)
+{
+    std::vector<float> signal(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i)
+        signal[static_cast<size_t>(i)] = static_cast<float>(0.5 * std::sin(kTwoPi * frequency * i / kSampleRate));
+    return signal;
+}
+
+Oversampler::Config makeConfig(int factor, Phase phase, int maxBlockSize = 512)
+{
+    Oversampler::Config config;
+    config.factor = factor;
+    config.phase = phase;
+    config.numChannels = 1;
+    config.maxBlockSize = maxBlockSize;
+    return config;
+}
+
+/** Amplitude of the component at normalised frequency in signal[start, end) */
+double amplitudeAt(const float* signal, int start, int end, double cyclesPerSample)
+{
+    double inPhase = 0.0, quadrature = 0.0;
+    for (int i = start; i < end; ++i) {
+        inPhase += signal[i] * std::sin(kTwoPi * cyclesPerSample * i);
+        quadrature += signal[i] * std::cos(kTwoPi * cyclesPerSample * i);
+    }
+    return 2.0 * std::hypot(inPhase, quadrature) / (end - start);
+}
+
+} // namespace
+
+TEST_CASE("Oversampler round trips a sine with its reported latency", "[utility][oversampler]")
+{
+    SECTION("linear phase returns the sine delayed by the latency")
+    {
+        for (const int factor : { 2, 4, 8 }) {
+            INFO("factor " << factor);
+
+            Oversampler oversampler;
+            oversampler.prepare(makeConfig(factor, Phase::Linear));
+            const float latency = oversampler.getLatency();
+            CHECK(latency > 0.0f);
+
+            auto signal = makeSine(1000.0, kLength);
+            float* channels[] = { signal.data() };
+            oversampler.process(channels, 1, kLength, [](float* const*, int) {});
+
+            double worst = 0.0;
+            for (int i = 1024; i < kLength; ++i) {
+                const double expected = 0.5 * std::sin(kTwoPi * 1000.0 * (i - latency) / kSampleRate);
+                worst = std::max(worst, std::abs(signal[static_cast<size_t>(i)] - expected));
+            }
+            CHECK(worst < 1.0e-3);
+        }
+    }
+
+    SECTION("minimum phase keeps the passband level with less delay")
+    {
+        for (const int factor : { 2, 4, 8 }) {
+            INFO("factor " << factor);
+
+            Oversampler oversampler;
+            oversampler.prepare(makeConfig(factor, Phase::Minimum));
+            CHECK(oversampler.getLatency() > 0.0f);
+            CHECK(oversampler.getLatency() < HalfBandCascade::get(factor, Phase::Linear)->getLatency());
+
+            for (const double frequency : { 1000.0, 15000.0 }) {
+                auto signal = makeSine(frequency, kLength);
+                float* channels[] = { signal.data() };
+                oversampler.reset();
+                oversampler.process(channels, 1, kLength, [](float* const*, int) {});
+                CHECK(amplitudeAt(signal.data(), 1024, kLength, frequency / kSampleRate)
+                      == Catch::Approx(0.5).margin(5.0e-3));
+            }
+        }
+    }
+}
+
+TEST_CASE("Oversampler rejects images above the base Nyquist", "[utility][oversampler]")
+{
+    for (const auto phase : { Phase::Minimum, Phase::Linear }) {
+        for (const int factor : { 2, 4, 8 }) {
+            INFO("factor " << factor << (phase == Phase::Linear ? ", linear" : ", minimum"));
+
+            Oversampler oversampler;
+            oversampler.prepare(makeConfig(factor, phase, kLength));
+
+            const auto signal = makeSine(5000.0, kLength);
+            const float* input[] = { signal.data() };
+            const float* up = oversampler.processUp(input, 1, kLength)[0];
+            const int numUp = kLength * factor;
+
+            // The tone survives and its first image, mirrored about the base rate, is gone
+            const double rate = kSampleRate * factor;
+            CHECK(amplitudeAt(up, numUp / 4, numUp, 5000.0 / rate) == Catch::Approx(0.5).margin(5.0e-3));
+            CHECK(amplitudeAt(up, numUp / 4, numUp, (kSampleRate - 5000.0) / rate) < 1.0e-4);
+        }
+    }
+}
+
+TEST_CASE("Oversampler output does not depend on the block split", "[utility][oversampler]")
+{
+    const auto input = makeSine(3000.0, 3000);
+
+    for (const auto phase : { Phase::Minimum, Phase::Linear }) {
+        INFO((phase == Phase::Linear ? "linear" : "minimum"));
+
+        // A nonlinearity at the higher rate, applied per piece
+        const auto run = [&](int maxBlockSize) {
+            Oversampler oversampler;
+            oversampler.prepare(makeConfig(4, phase, maxBlockSize));
+            auto signal = input;
+            float* channels[] = { signal.data() };
+            oversampler.process(channels, 1, static_cast<int>(signal.size()), [](float* const* up, int numSamples) {
+                for (int i = 0; i < numSamples; ++i)
+                    up[0][i] = std::tanh(4.0f * up[0][i]);
+            });
+            return signal;
+        };
+
+        const auto whole = run(3000);
+        for (const int maxBlockSize : { 1, 64, 700 }) {
+            INFO("block " << maxBlockSize);
+            const auto split = run(maxBlockSize);
+            for (size_t i = 0; i < whole.size(); ++i)
+                REQUIRE(split[i] == Catch::Approx(whole[i]).margin(1.0e-6));
+        }
+    }
+}
+
+TEST_CASE("Oversampler at factor one passes audio straight through", "[utility][oversampler]")
+{
+    Oversampler oversampler;
+    oversampler.prepare(makeConfig(1, Phase::Linear));
+    CHECK(oversampler.getLatency() == 0.0f);
+
+    const auto input = makeSine(1000.0, 1000);
+    auto signal = input;
+    float* channels[] = { signal.data() };
+    int seen = 0;
+    oversampler.process(channels, 1, 1000, [&seen](float* const*, int numSamples) { seen += numSamples; });
+
+    CHECK(seen == 1000);
+    CHECK(signal == input);
+}
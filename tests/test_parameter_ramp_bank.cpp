@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+    test_parameter_ramp_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Ramp endpoints, change reporting and subscription handoff of the
+    parameter ramp bank
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "utility/parameter_ramp_bank.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace vital::audio_engine::utility;
+
+namespace {
+
+ParameterRampBank::Config makeConfig()
+{
+    ParameterRampBank::Config config;
+    config.numParameters = 200;
+    config.maxBlockSize = 64;
+    config.maxActiveRamps = 4;
+    config.sampleRate = 44100.0;
+    config.defaultSmoothingMs = 10.0f;
+    return config;
+}
+
+std::vector<int> changedIds(const ParameterRampBank& bank, int subscriber)
+{
+    std::vector<int> ids;
+    bank.forEachChanged(subscriber, [&](int paramId, float, const float*) { ids.push_back(paramId); });
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("ParameterRampBank ramps land exactly on their target", "[utility][parameters]")
+{
+    ParameterRampBank bank;
+    bank.prepare(makeConfig());
+
+    // 441 samples: the increment is inexact and the ramp ends mid-block
+    for (float target : { 0.1f, 0.7f, -3.3f, 1234.567f, 0.001f }) {
+        bank.setTarget(7, target);
+
+        float previous = bank.getValue(7);
+        bool ramped = false;
+        for (int block = 0; block < 10; ++block) {
+            bank.process(64);
+            if (const float* ramp = bank.getRamp(7)) {
+                ramped = true;
+                for (int i = 0; i < 64; ++i) {
+                    // Monotonic towards the target
+                    REQUIRE((target - ramp[i]) * (target - previous) >= 0.0f);
+                    previous = ramp[i];
+                }
+            }
+        }
+
+        INFO("target " << target);
+        CHECK(ramped);
+        CHECK(bank.getValue(7) == target);
+        CHECK_FALSE(bank.isRamping(7));
+    }
+}
+
+TEST_CASE("ParameterRampBank reports a parameter only while it moves", "[utility][parameters]")
+{
+    ParameterRampBank bank;
+    bank.prepare(makeConfig());
+    const int subscriber = bank.addSubscriber();
+    bank.subscribeAll(subscriber);
+
+    bank.process(64);
+    CHECK(bank.getNumChanged() == 0);
+
+    // Targets posted between blocks coalesce into one ramp to the last
+    bank.setTarget(3, 0.5f);
+    bank.setTarget(3, 1.0f);
+    bank.setSmoothingTime(4, 0.0f);
+    bank.setTarget(4, 2.0f);
+    bank.process(64);
+
+    CHECK(changedIds(bank, subscriber) == std::vector<int>{ 3, 4 });
+    CHECK(bank.getRamp(3) != nullptr);
+    CHECK(bank.getRamp(4) == nullptr);
+    CHECK(bank.getValue(4) == 2.0f);
+
+    int blocks = 1;
+    while (bank.isRamping(3)) {
+        bank.process(64);
+        ++blocks;
+        REQUIRE(blocks < 20);
+    }
+    CHECK(bank.getValue(3) == 1.0f);
+    CHECK(blocks == 7);
+
+    bank.process(64);
+    CHECK(bank.getNumChanged() == 0);
+}
+
+TEST_CASE("ParameterRampBank steps when the ramp pool is full", "[utility][parameters]")
+{
+    ParameterRampBank bank;
+    bank.prepare(makeConfig());
+
+    for (int paramId = 0; paramId < 6; ++paramId)
+        bank.setTarget(paramId, 1.0f);
+    bank.process(64);
+
+    int ramping = 0;
+    for (int paramId = 0; paramId < 6; ++paramId)
+        ramping += bank.isRamping(paramId) ? 1 : 0;
+
+    CHECK(ramping == 4);
+    CHECK(bank.getNumDroppedRamps() == 2);
+}
+
+TEST_CASE("ParameterRampBank subscriptions apply from the next block", "[utility][parameters]")
+{
+    ParameterRampBank bank;
+    bank.prepare(makeConfig());
+    const int subscriber = bank.addSubscriber();
+
+    const std::vector<int> ids{ 1, 65, 130 };
+    bank.setSubscription(subscriber, ids.data(), static_cast<int>(ids.size()));
+    CHECK_FALSE(bank.isSubscribed(subscriber, 65));
+
+    bank.setSmoothingTime(1, 0.0f);
+    bank.setSmoothingTime(2, 0.0f);
+    bank.setTarget(1, 1.0f);
+    bank.setTarget(2, 1.0f);
+    bank.process(64);
+
+    CHECK(bank.isSubscribed(subscriber, 65));
+    CHECK_FALSE(bank.isSubscribed(subscriber, 2));
+    CHECK(changedIds(bank, subscriber) == std::vector<int>{ 1 });
+
+    bank.unsubscribeAll(subscriber);
+    bank.process(64);
+    CHECK_FALSE(bank.isSubscribed(subscriber, 1));
+}
+
+TEST_CASE("ParameterRampBank never exposes a half-written subscription", "[utility][parameters]")
+{
+    ParameterRampBank bank;
+    bank.prepare(makeConfig());
+    const int subscriber = bank.addSubscriber();
+
+    // Two disjoint sets spanning every mask word; the audio side must always see exactly one
+    std::vector<int> even, odd;
+    for (int paramId = 0; paramId < 200; ++paramId)
+        (paramId % 2 == 0 ? even : odd).push_back(paramId);
+
+    bank.setSubscription(subscriber, even.data(), static_cast<int>(even.size()));
+    bank.process(64);
+
+    std::atomic<bool> done{ false };
+    std::thread writer([&] {
+        for (int i = 0; i < 20000; ++i) {
+            const auto& ids = (i % 2 == 0) ? odd : even;
+            bank.setSubscription(subscriber, ids.data(), static_cast<int>(ids.size()));
+        }
+        done.store(true);
+    });
+
+    bool consistent = true;
+    while (!done.load() && consistent) {
+        bank.process(64);
+
+        const bool first = bank.isSubscribed(subscriber, 0);
+        for (int paramId = 0; paramId < 200; ++paramId)
+            consistent = consistent && bank.isSubscribed(subscriber, paramId) == (first == (paramId % 2 == 0));
+    }
+    writer.join();
+
+    CHECK(consistent);
+
+    // The last published set wins
+    bank.process(64);
+    CHECK(bank.isSubscribed(subscriber, 0));
+    CHECK_FALSE(bank.isSubscribed(subscriber, 1));
+}
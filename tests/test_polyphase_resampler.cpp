@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+    test_polyphase_resampler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Accuracy, timing, streaming modes and alias rejection of the polyphase
+    resampler
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "utility/polyphase_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace vital::audio_engine::utility;
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+PolyphaseResampler::Config makeConfig(double inputRate, double outputRate, bool timeAligned = true)
+{
+    PolyphaseResampler::Config config;
+    config.inputRate = inputRate;
+    config.outputRate = outputRate;
+    config.numChannels = 1;
+    config.timeAligned = timeAligned;
+    return config;
+}
+
+std::vector<float> makeSine(double frequency, double sampleRate, int length, double amplitude = 0.5)
+{
+    std::vector<float> signal(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i)
+        signal[static_cast<size_t>(i)] = static_cast<float>(amplitude * std::sin(kTwoPi * frequency * i / sampleRate));
+    return signal;
+}
+
+/** Push mode: feed blocks of blockSize into room for outputRoom outputs at a time, then flush */
+std::vector<float> resample(PolyphaseResampler& resampler, const std::vector<float>& input,
+                            int blockSize, int outputRoom = 0)
+{
+    std::vector<float> output;
+    std::vector<float> scratch;
+
+    for (int start = 0; start < static_cast<int>(input.size());) {
+        const int count = std::min(blockSize, static_cast<int>(input.size()) - start);
+        const int room = outputRoom > 0 ? outputRoom : resampler.getMaxOutput(count);
+        scratch.assign(static_cast<size_t>(std::max(room, 1)), 0.0f);
+
+        const float* in[] = { input.data() + start };
+        float* out[] = { scratch.data() };
+        const auto result = resampler.process(in, 1, count, out, room);
+        output.insert(output.end(), scratch.begin(), scratch.begin() + result.produced);
+        start += result.consumed;
+    }
+
+    // The tail is half a kernel, which downsampling widens by up to the inverse ratio
+    scratch.assign(static_cast<size_t>(resampler.getMaxOutput(resampler.getConfig().numTaps * 16)), 0.0f);
+    float* out[] = { scratch.data() };
+    const int flushed = resampler.flush(out, 1, static_cast<int>(scratch.size()));
+    output.insert(output.end(), scratch.begin(), scratch.begin() + flushed);
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("PolyphaseResampler keeps a sine's frequency, amplitude and timing", "[utility][resampler]")
+{
+    // Every exact pair family, a downsample by more than four, and a ratio that needs blended rows
+    const std::vector<std::pair<double, double>> rates{
+        { 44100.0, 48000.0 }, { 48000.0, 44100.0 }, { 48000.0, 96000.0 },
+        { 192000.0, 44100.0 }, { 44100.0, 48000.5 }
+    };
+
+    for (const auto& [inputRate, outputRate] : rates) {
+        INFO(inputRate << " Hz to " << outputRate << " Hz");
+
+        PolyphaseResampler resampler;
+        resampler.prepare(makeConfig(inputRate, outputRate));
+        CHECK(resampler.isExact() == (outputRate != 48000.5));
+        CHECK(resampler.getLatency() == 0.0f);
+
+        const int length = static_cast<int>(inputRate / 10.0);
+        const auto output = resample(resampler, makeSine(1000.0, inputRate, length), 512);
+
+        // An offline render yields exactly ceil(K * ratio) samples
+        REQUIRE(static_cast<int>(output.size()) == static_cast<int>(std::ceil(length * resampler.getRatio())));
+
+        // Output n lands on input time n / ratio; the edges see the signal switch on and off
+        const int edge = static_cast<int>(outputRate / 200.0);
+        double worst = 0.0;
+        for (int n = edge; n < static_cast<int>(output.size()) - edge; ++n) {
+            const double expected = 0.5 * std::sin(kTwoPi * 1000.0 * n / outputRate);
+            worst = std::max(worst, std::abs(output[static_cast<size_t>(n)] - expected));
+        }
+        CHECK(worst < 1.0e-4);
+    }
+}
+
+TEST_CASE("PolyphaseResampler without time alignment trails by half a kernel", "[utility][resampler]")
+{
+    PolyphaseResampler resampler;
+    resampler.prepare(makeConfig(44100.0, 48000.0, false));
+
+    const float latency = resampler.getLatency();
+    CHECK(latency == static_cast<float>(resampler.getConfig().numTaps / 2));
+
+    // Output starts straight away, so it is longer by the latency
+    const auto output = resample(resampler, makeSine(1000.0, 44100.0, 4410), 512);
+    CHECK(static_cast<int>(output.size()) > static_cast<int>(std::ceil(4410 * resampler.getRatio())));
+    CHECK(output[0] == 0.0f);
+
+    const int edge = 240 + static_cast<int>(latency * resampler.getRatio());
+    double worst = 0.0;
+    for (int n = edge; n < 4800 - 240; ++n) {
+        const double inputTime = n / resampler.getRatio() - latency;
+        const double expected = 0.5 * std::sin(kTwoPi * 1000.0 * inputTime / 44100.0);
+        worst = std::max(worst, std::abs(output[static_cast<size_t>(n)] - expected));
+    }
+    CHECK(worst < 1.0e-4);
+}
+
+TEST_CASE("PolyphaseResampler output does not depend on the block size", "[utility][resampler]")
+{
+    const auto input = makeSine(3000.0, 44100.0, 9000, 0.9);
+
+    for (const double outputRate : { 48000.0, 48000.5 }) {
+        INFO("output rate " << outputRate);
+
+        PolyphaseResampler whole;
+        whole.prepare(makeConfig(44100.0, outputRate));
+        const auto expected = resample(whole, input, 9000);
+
+        // Single samples, odd blocks, and too little room so input is offered again
+        for (const auto& [blockSize, room] : { std::pair{ 1, 0 }, std::pair{ 37, 0 }, std::pair{ 4096, 0 },
+                                              std::pair{ 700, 13 } }) {
+            INFO("block " << blockSize << ", room " << room);
+            PolyphaseResampler split;
+            split.prepare(makeConfig(44100.0, outputRate));
+            CHECK(resample(split, input, blockSize, room) == expected);
+        }
+    }
+}
+
+TEST_CASE("PolyphaseResampler pull mode produces exactly the outputs asked for", "[utility][resampler]")
+{
+    const auto input = makeSine(500.0, 48000.0, 20000);
+
+    PolyphaseResampler pushed;
+    pushed.prepare(makeConfig(48000.0, 44100.0));
+    const auto expected = resample(pushed, input, 20000);
+
+    PolyphaseResampler pulled;
+    pulled.prepare(makeConfig(48000.0, 44100.0));
+
+    std::vector<float> output;
+    std::vector<float> block;
+    int read = 0;
+    for (int size : { 1, 64, 333, 512, 1000, 512, 7 }) {
+        const int needed = pulled.getRequiredInput(size);
+        REQUIRE(read + needed <= static_cast<int>(input.size()));
+
+        block.assign(static_cast<size_t>(size), 0.0f);
+        const float* in[] = { input.data() + read };
+        float* out[] = { block.data() };
+        const auto result = pulled.process(in, 1, needed, out, size);
+
+        CHECK(result.consumed == needed);
+        CHECK(result.produced == size);
+        CHECK(pulled.getRequiredInput(0) == 0);
+        read += needed;
+        output.insert(output.end(), block.begin(), block.end());
+    }
+
+    for (size_t i = 0; i < output.size(); ++i)
+        REQUIRE(output[i] == expected[i]);
+}
+
+TEST_CASE("PolyphaseResampler passes DC and rejects images and aliases", "[utility][resampler]")
+{
+    SECTION("sinc rows have unity gain at every phase")
+    {
+        PolyphaseSincTable::Design design;
+        design.numPhases = 160;
+        design.numTaps = 64;
+        const auto table = PolyphaseSincTable::get(design);
+
+        for (int phase = 0; phase <= table->getNumPhases(); ++phase) {
+            double sum = 0.0;
+            for (int k = 0; k < table->getNumTaps(); ++k)
+                sum += table->getRow(phase)[k];
+            CHECK(sum == Catch::Approx(1.0).margin(1.0e-5));
+        }
+    }
+
+    SECTION("a 24.5 kHz tone from 48 kHz vanishes at 44.1 kHz")
+    {
+        PolyphaseResampler resampler;
+        resampler.prepare(makeConfig(48000.0, 44100.0));
+        const auto output = resample(resampler, makeSine(24500.0, 48000.0, 48000, 1.0), 1024);
+
+        double peak = 0.0;
+        for (size_t n = 2000; n < output.size() - 2000; ++n)
+            peak = std::max(peak, static_cast<double>(std::abs(output[n])));
+        CHECK(peak < 1.0e-4);
+    }
+
+    SECTION("a constant stays constant through blended rows")
+    {
+        PolyphaseResampler resampler;
+        resampler.prepare(makeConfig(44100.0, 48000.5));
+        const auto output = resample(resampler, std::vector<float>(8000, 0.25f), 256);
+
+        for (size_t n = 200; n < output.size() - 200; ++n)
+            REQUIRE(output[n] == Catch::Approx(0.25f).margin(1.0e-5));
+    }
+
+    SECTION("reset restarts the stream")
+    {
+        PolyphaseResampler resampler;
+        resampler.prepare(makeConfig(44100.0, 48000.0));
+        const auto input = makeSine(1000.0, 44100.0, 2000);
+        const auto first = resample(resampler, input, 300);
+        resampler.reset();
+        CHECK(resample(resampler, input, 300) == first);
+    }
+}
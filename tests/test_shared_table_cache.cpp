@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+    test_shared_table_cache.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Sharing, expiry and concurrent builds of the shared table cache and the
+    tables handed out through it
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "utility/shared_table_cache.h"
+#include "utility/oversampler.h"
+#include "utility/polyphase_resampler.h"
+#include "oscillators/noise_field.h"
+#include "oscillators/wavetable.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace vital::audio_engine;
+
+namespace {
+
+struct CountedTable
+{
+    explicit CountedTable(int v) : value(v) {}
+    int value;
+};
+
+} // namespace
+
+TEST_CASE("SharedTableCache hands out one table per key while it is held", "[utility][tables]")
+{
+    utility::SharedTableCache<int, CountedTable> cache;
+    int builds = 0;
+    auto build = [&](int key) {
+        return [&builds, key] {
+            ++builds;
+            return std::make_shared<const CountedTable>(key);
+        };
+    };
+
+    auto first = cache.get(1, build(1));
+    auto again = cache.get(1, build(1));
+    auto other = cache.get(2, build(2));
+
+    CHECK(first == again);
+    CHECK(first != other);
+    CHECK(other->value == 2);
+    CHECK(builds == 2);
+
+    // Released tables are rebuilt on the next request
+    first.reset();
+    again.reset();
+    auto rebuilt = cache.get(1, build(1));
+    CHECK(rebuilt->value == 1);
+    CHECK(builds == 3);
+}
+
+TEST_CASE("SharedTableCache prunes expired entries on insert", "[utility][tables]")
+{
+    utility::SharedTableCache<int, CountedTable> cache;
+
+    for (int key = 0; key < 100; ++key)
+        cache.get(key, [key] { return std::make_shared<const CountedTable>(key); });
+
+    // Each table died straight away, so every insert dropped the ones before it
+    CHECK(cache.size() <= 1);
+
+    auto held = cache.get(1000, [] { return std::make_shared<const CountedTable>(1000); });
+    cache.get(1001, [] { return std::make_shared<const CountedTable>(1001); });
+    CHECK(cache.size() == 2);
+}
+
+TEST_CASE("SharedTableCache gives concurrent callers the same table", "[utility][tables]")
+{
+    utility::SharedTableCache<int, CountedTable> cache;
+
+    constexpr int kThreads = 8;
+    std::vector<std::shared_ptr<const CountedTable>> results(kThreads);
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            while (!start.load()) std::this_thread::yield();
+            results[static_cast<size_t>(t)] = cache.get(7, [] { return std::make_shared<const CountedTable>(7); });
+        });
+    }
+    start.store(true);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& result : results)
+        CHECK(result == results.front());
+}
+
+TEST_CASE("Shared DSP tables are reused per key", "[utility][tables]")
+{
+    using utility::HalfBandCascade;
+
+    auto cascade = HalfBandCascade::get(4, HalfBandCascade::Phase::Minimum);
+    CHECK(HalfBandCascade::get(5, HalfBandCascade::Phase::Minimum) == cascade);
+    CHECK(HalfBandCascade::get(4, HalfBandCascade::Phase::Linear) != cascade);
+
+    CHECK(oscillators::NoiseField::get(42) == oscillators::NoiseField::get(42));
+    CHECK(oscillators::NoiseField::get(42) != oscillators::NoiseField::get(43));
+
+    const std::vector<std::vector<float>> frames{ std::vector<float>(2048, 0.25f) };
+    CHECK(oscillators::Wavetable::create(frames) == oscillators::Wavetable::create(frames));
+
+    utility::PolyphaseSincTable::Design design;
+    CHECK(utility::PolyphaseSincTable::get(design) == utility::PolyphaseSincTable::get(design));
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+    test_unison.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Stereo layout and loudness of unison stacks
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "oscillators/unison.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace vital::audio_engine::oscillators;
+
+namespace {
+
+struct StereoLevels
+{
+    double left = 0.0;
+    double right = 0.0;
+};
+
+StereoLevels renderStack(int numVoices, float stereoSpread)
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kNumSamples = 48000;
+
+    UnisonStack stack;
+    stack.prepare(1, kSampleRate);
+
+    UnisonStack::Settings settings;
+    settings.numVoices = numVoices;
+    settings.stereoSpread = stereoSpread;
+    settings.detuneCents = 50.0f;
+    settings.phaseRandomization = 1.0f;
+    stack.setSettings(settings);
+    stack.noteOn(0, 220.0f);
+
+    std::vector<float> left(kNumSamples, 0.0f);
+    std::vector<float> right(kNumSamples, 0.0f);
+    stack.render(0, *Wavetable::getShape(Wavetable::Shape::Saw), 0.0f, 1.0f,
+                 left.data(), right.data(), kNumSamples);
+
+    StereoLevels levels;
+    for (int i = 0; i < kNumSamples; ++i) {
+        levels.left += static_cast<double>(left[static_cast<size_t>(i)]) * left[static_cast<size_t>(i)];
+        levels.right += static_cast<double>(right[static_cast<size_t>(i)]) * right[static_cast<size_t>(i)];
+    }
+    levels.left = std::sqrt(levels.left / kNumSamples);
+    levels.right = std::sqrt(levels.right / kNumSamples);
+    return levels;
+}
+
+} // namespace
+
+TEST_CASE("Unison stacks are balanced between left and right", "[unison]")
+{
+    for (const int numVoices : { 2, 3, 4, 16 }) {
+        INFO("voices: " << numVoices);
+        const StereoLevels levels = renderStack(numVoices, 1.0f);
+
+        REQUIRE(levels.left > 0.1);
+        REQUIRE(levels.right > 0.1);
+        CHECK(levels.left / levels.right == Catch::Approx(1.0).margin(0.05));
+    }
+}
+
+TEST_CASE("Unison stack loudness does not depend on the voice count", "[unison]")
+{
+    const StereoLevels single = renderStack(1, 1.0f);
+    const double reference = std::hypot(single.left, single.right);
+
+    for (const int numVoices : { 2, 3, 4, 16 }) {
+        INFO("voices: " << numVoices);
+        const StereoLevels levels = renderStack(numVoices, 1.0f);
+        CHECK(std::hypot(levels.left, levels.right) == Catch::Approx(reference).epsilon(0.25));
+    }
+}
+
+TEST_CASE("Zero stereo spread centres every copy", "[unison]")
+{
+    const StereoLevels levels = renderStack(7, 0.0f);
+    CHECK(levels.left == Catch::Approx(levels.right).epsilon(1.0e-4));
+}
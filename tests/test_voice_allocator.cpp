@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+    test_voice_allocator.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Free list, steal policies and voice groups of the voice allocator
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/voice_allocator.h"
+
+#include <set>
+
+using namespace vital::audio_engine::core;
+using Stage = VoiceAllocator::VoiceStage;
+
+namespace {
+
+VoiceAllocator::Config makeConfig(int maxVoices, VoiceAllocator::StealPolicy policy)
+{
+    VoiceAllocator::Config config;
+    config.maxVoices = maxVoices;
+    config.stealPolicy = policy;
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("VoiceAllocator hands out each free voice once", "[core][voices]")
+{
+    VoiceAllocator allocator;
+    allocator.prepare(makeConfig(8, VoiceAllocator::StealPolicy::Oldest));
+
+    std::set<int> ids;
+    for (int note = 60; note < 68; ++note) {
+        const auto allocation = allocator.noteOn(note, 1, 1.0f);
+        CHECK(allocation.stolenVoiceId == -1);
+        ids.insert(allocation.voiceId);
+    }
+    CHECK(ids.size() == 8);
+    CHECK(allocator.getNumSoundingVoices() == 8);
+
+    // Note off releases, free() returns the voice; doing either twice is a no-op
+    const int voice = allocator.noteOff(63, 1);
+    REQUIRE(voice != -1);
+    CHECK(allocator.getStage(voice) == Stage::Released);
+    CHECK(allocator.getNumHeldVoices() == 7);
+    CHECK_FALSE(allocator.release(voice));
+
+    CHECK(allocator.free(voice));
+    CHECK_FALSE(allocator.free(voice));
+    CHECK(allocator.getStage(voice) == Stage::Free);
+
+    const auto reused = allocator.noteOn(70, 1, 1.0f);
+    CHECK(reused.voiceId == voice);
+    CHECK(reused.stolenVoiceId == -1);
+
+    // Only one free voice ever existed, so the next note must steal
+    CHECK(allocator.noteOn(71, 1, 1.0f).stolenVoiceId != -1);
+}
+
+TEST_CASE("VoiceAllocator steals according to its policy", "[core][voices]")
+{
+    using Policy = VoiceAllocator::StealPolicy;
+
+    SECTION("oldest")
+    {
+        VoiceAllocator allocator;
+        allocator.prepare(makeConfig(4, Policy::Oldest));
+        const int first = allocator.noteOn(60, 1, 1.0f).voiceId;
+        for (int note = 61; note < 64; ++note) allocator.noteOn(note, 1, 1.0f);
+
+        const auto allocation = allocator.noteOn(70, 1, 1.0f);
+        CHECK(allocation.stolenVoiceId == first);
+        CHECK(allocation.voiceId == first);
+        CHECK(allocator.getNote(first) == 70);
+    }
+
+    SECTION("quietest")
+    {
+        VoiceAllocator allocator;
+        allocator.prepare(makeConfig(4, Policy::Quietest));
+        int quiet = -1;
+        for (int note = 60; note < 64; ++note) {
+            const int id = allocator.noteOn(note, 1, 1.0f).voiceId;
+            allocator.setVoiceLevel(id, note == 62 ? 0.01f : 0.5f);
+            if (note == 62) quiet = id;
+        }
+
+        CHECK(allocator.peekStealCandidate() == quiet);
+        CHECK(allocator.noteOn(70, 1, 1.0f).stolenVoiceId == quiet);
+    }
+
+    SECTION("release stage first")
+    {
+        VoiceAllocator allocator;
+        allocator.prepare(makeConfig(4, Policy::ReleaseStageFirst));
+        for (int note = 60; note < 64; ++note) allocator.noteOn(note, 1, 1.0f);
+
+        // The newest voice is in its release tail, so it goes before older held ones
+        const int released = allocator.noteOff(63, 1);
+        CHECK(allocator.noteOn(70, 1, 1.0f).stolenVoiceId == released);
+    }
+
+    SECTION("same note retrigger")
+    {
+        VoiceAllocator allocator;
+        allocator.prepare(makeConfig(4, Policy::SameNoteRetrigger));
+        const int voice = allocator.noteOn(60, 1, 0.5f).voiceId;
+        allocator.noteOff(60, 1);
+
+        const auto allocation = allocator.noteOn(60, 1, 1.0f);
+        CHECK(allocation.retriggered);
+        CHECK(allocation.voiceId == voice);
+        CHECK(allocator.getStage(voice) == Stage::Held);
+        CHECK(allocator.getNumSoundingVoices() == 1);
+    }
+
+    SECTION("priority outranks the policy")
+    {
+        VoiceAllocator allocator;
+        allocator.prepare(makeConfig(2, Policy::Oldest));
+        const int old = allocator.noteOn(60, 1, 1.0f).voiceId;
+        const int young = allocator.noteOn(61, 1, 1.0f).voiceId;
+        allocator.setVoicePriority(old, 1);
+
+        CHECK(allocator.noteOn(62, 1, 1.0f).stolenVoiceId == young);
+    }
+}
+
+TEST_CASE("VoiceAllocator without stealing refuses when full", "[core][voices]")
+{
+    auto config = makeConfig(2, VoiceAllocator::StealPolicy::Oldest);
+    config.enableStealing = false;
+
+    VoiceAllocator allocator;
+    allocator.prepare(config);
+    allocator.noteOn(60, 1, 1.0f);
+    allocator.noteOn(61, 1, 1.0f);
+
+    const auto allocation = allocator.noteOn(62, 1, 1.0f);
+    CHECK(allocation.voiceId == -1);
+    CHECK(allocator.getNumSoundingVoices() == 2);
+}
+
+TEST_CASE("VoiceAllocator limits MPE member channels to their own voices", "[core][voices]")
+{
+    auto config = makeConfig(16, VoiceAllocator::StealPolicy::Oldest);
+    config.groupMode = VoiceAllocator::GroupMode::MPE;
+    config.mpeMasterChannel = 1;
+    config.mpeVoicesPerMemberChannel = 1;
+
+    VoiceAllocator allocator;
+    allocator.prepare(config);
+
+    const int channelTwo = allocator.noteOn(60, 2, 1.0f).voiceId;
+    const int channelThree = allocator.noteOn(64, 3, 1.0f).voiceId;
+
+    // A second note on channel 2 takes that channel's voice and leaves channel 3 alone
+    const auto allocation = allocator.noteOn(62, 2, 1.0f);
+    CHECK(allocation.stolenVoiceId == channelTwo);
+    CHECK(allocator.getNote(channelThree) == 64);
+    CHECK(allocator.getChannel(channelThree) == 3);
+
+    CHECK(allocator.getGroupVoiceLimit(allocator.getGroupForChannel(2)) == 1);
+    CHECK(allocator.getGroupVoiceLimit(allocator.getGroupForChannel(1)) == 16);
+
+    int soundingOnTwo = 0;
+    allocator.forEachSoundingVoice(2, [&](int) { ++soundingOnTwo; });
+    CHECK(soundingOnTwo == 1);
+}
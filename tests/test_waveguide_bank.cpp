@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+    test_waveguide_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Tuning and level of waveguide strings across the keyboard
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "synthesis/waveguide_bank.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace vital::audio_engine::synthesis;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kSettle = 2400;
+constexpr int kWindow = 16384;
+
+std::vector<float> pluckAndRender(float frequency, float dispersion, int numSamples)
+{
+    WaveguideBank bank;
+    bank.prepare(8, 27.5f, kSampleRate);
+
+    WaveguideBank::StringSettings settings;
+    settings.decaySeconds = 4.0f;
+    settings.dispersion = dispersion;
+    bank.pluck(0, frequency, 1.0f, settings);
+
+    // Odd block sizes so bursts and chunks straddle process() calls
+    std::vector<float> output(static_cast<size_t>(numSamples), 0.0f);
+    for (int start = 0; start < numSamples; start += 37)
+        bank.process(output.data() + start, std::min(37, numSamples - start));
+    return output;
+}
+
+/** Hann-windowed DTFT magnitude at frequency over the analysis window */
+double magnitudeAt(const std::vector<float>& signal, double frequency)
+{
+    double real = 0.0, imaginary = 0.0;
+    for (int i = 0; i < kWindow; ++i) {
+        const double window = 0.5 - 0.5 * std::cos(2.0 * M_PI * i / (kWindow - 1));
+        const double phase = 2.0 * M_PI * frequency * i / kSampleRate;
+        const double x = window * signal[static_cast<size_t>(kSettle + i)];
+        real += x * std::cos(phase);
+        imaginary -= x * std::sin(phase);
+    }
+    return std::hypot(real, imaginary);
+}
+
+/** Strongest frequency within a semitone of nominal, in cents from nominal */
+double measuredCents(const std::vector<float>& signal, double nominal)
+{
+    double bestCents = 0.0, bestMagnitude = -1.0;
+    for (double cents = -100.0; cents <= 100.0; cents += 0.5) {
+        const double magnitude = magnitudeAt(signal, nominal * std::exp2(cents / 1200.0));
+        if (magnitude > bestMagnitude) {
+            bestMagnitude = magnitude;
+            bestCents = cents;
+        }
+    }
+    return bestCents;
+}
+
+double rms(const std::vector<float>& signal, int start, int length)
+{
+    double sum = 0.0;
+    for (int i = start; i < start + length; ++i)
+        sum += static_cast<double>(signal[static_cast<size_t>(i)]) * signal[static_cast<size_t>(i)];
+    return std::sqrt(sum / length);
+}
+
+} // namespace
+
+TEST_CASE("Waveguide strings are in tune from 55 Hz to C8", "[waveguide]")
+{
+    for (const float dispersion : { 0.0f, 0.5f, 1.0f }) {
+        for (const float frequency : { 55.0f, 220.0f, 880.0f, 2093.0f, 4186.0f }) {
+            INFO("frequency " << frequency << ", dispersion " << dispersion);
+            const auto output = pluckAndRender(frequency, dispersion, kSettle + kWindow);
+            CHECK(std::abs(measuredCents(output, frequency)) <= 3.0);
+        }
+    }
+}
+
+TEST_CASE("Waveguide strings sound at the top of their range", "[waveguide]")
+{
+    for (const float dispersion : { 0.0f, 0.5f, 1.0f }) {
+        for (const float frequency : { 4186.0f, 8000.0f, 10000.0f, 12000.0f }) {
+            INFO("frequency " << frequency << ", dispersion " << dispersion);
+            const auto output = pluckAndRender(frequency, dispersion, kSettle + kWindow);
+
+            // A full-velocity pluck stays well above the silence threshold for its first 50 ms
+            CHECK(rms(output, 0, 2400) > 0.05);
+            CHECK(std::abs(measuredCents(output, frequency)) <= 5.0);
+        }
+    }
+}
+
+TEST_CASE("Released waveguide voices decay and are culled", "[waveguide]")
+{
+    WaveguideBank bank;
+    bank.prepare(8, 27.5f, kSampleRate);
+    bank.pluck(3, 330.0f, 0.8f);
+    REQUIRE(bank.isActive(3));
+
+    std::vector<float> output(4800, 0.0f);
+    bank.process(output.data(), 4800);
+    bank.release(3);
+
+    for (int block = 0; block < 100 && bank.isActive(3); ++block) {
+        std::fill(output.begin(), output.end(), 0.0f);
+        bank.process(output.data(), 4800);
+    }
+
+    CHECK_FALSE(bank.isActive(3));
+    CHECK(bank.getNumActiveVoices() == 0);
+}
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+    test_wavetable.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Mip level band limits, table sharing and lane rendering of the
+    wavetable engine
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "oscillators/wavetable.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace vital::audio_engine::oscillators;
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+constexpr int kSize = Wavetable::kFrameSize;
+
+/** Amplitude of one harmonic of a row */
+double harmonicAmplitude(const float* row, int harmonic)
+{
+    std::complex<double> sum = 0.0;
+    for (int n = 0; n < kSize; ++n)
+        sum += static_cast<double>(row[n]) * std::polar(1.0, -kTwoPi * static_cast<double>((harmonic * n) % kSize) / kSize);
+    return 2.0 * std::abs(sum) / kSize;
+}
+
+std::vector<float> sineCycle(int length, float amplitude)
+{
+    std::vector<float> cycle(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i)
+        cycle[static_cast<size_t>(i)] = amplitude * static_cast<float>(std::sin(kTwoPi * i / length));
+    return cycle;
+}
+
+} // namespace
+
+TEST_CASE("Wavetable levels stay below Nyquist for their increment", "[oscillators][wavetable]")
+{
+    for (float increment = 1.0e-4f; increment < 0.5f; increment *= 1.07f) {
+        const int level = Wavetable::levelForIncrement(increment);
+        INFO("increment " << increment << " level " << level);
+
+        const int topHarmonic = (kSize / 2) >> level;
+        CHECK(static_cast<float>(topHarmonic) * increment < 0.5f);
+
+        // The next finer level would alias, unless the level is clamped
+        if (level > 0 && level < Wavetable::kNumLevels - 1)
+            CHECK(static_cast<float>(topHarmonic * 2) * increment >= 0.5f);
+    }
+
+    CHECK(Wavetable::levelForIncrement(0.0f) == 0);
+    CHECK(Wavetable::levelForIncrement(-0.1f) == Wavetable::levelForIncrement(0.1f));
+}
+
+TEST_CASE("Wavetable levels drop every harmonic above their limit", "[oscillators][wavetable]")
+{
+    // A naive saw: full of harmonics up to the frame's Nyquist
+    std::vector<float> naiveSaw(static_cast<size_t>(kSize));
+    for (int i = 0; i < kSize; ++i)
+        naiveSaw[static_cast<size_t>(i)] = 2.0f * static_cast<float>(i) / kSize - 1.0f;
+
+    const auto table = Wavetable::create({ naiveSaw });
+
+    for (int level : { 2, 5, 8 }) {
+        INFO("level " << level);
+        const float* row = table->getRow(level, 0);
+        const int topHarmonic = (kSize / 2) >> level;
+
+        CHECK(harmonicAmplitude(row, topHarmonic) > 1.0e-3);
+        CHECK(harmonicAmplitude(row, topHarmonic + 1) < 1.0e-4);
+        CHECK(harmonicAmplitude(row, 2 * topHarmonic + 3) < 1.0e-4);
+
+        // Guard samples continue the cycle in both directions
+        CHECK(row[-1] == row[kSize - 1]);
+        CHECK(row[kSize] == row[0]);
+        CHECK(row[kSize + 2] == row[2]);
+    }
+
+    // The basic saw holds 1 / k harmonics scaled to a unit peak-to-peak ramp
+    const float* saw = Wavetable::getShape(Wavetable::Shape::Saw)->getRow(0, 0);
+    CHECK(harmonicAmplitude(saw, 1) == Catch::Approx(2.0 / 3.141592653589793).epsilon(1.0e-3));
+    CHECK(harmonicAmplitude(saw, 10) == Catch::Approx(0.2 / 3.141592653589793).epsilon(1.0e-3));
+}
+
+TEST_CASE("Wavetables are shared between identical requests", "[oscillators][wavetable]")
+{
+    CHECK(Wavetable::getShape(Wavetable::Shape::Square) == Wavetable::getShape(Wavetable::Shape::Square));
+    CHECK(Wavetable::getShape(Wavetable::Shape::Square) != Wavetable::getShape(Wavetable::Shape::Triangle));
+
+    const std::vector<std::vector<float>> frames{ sineCycle(600, 1.0f), sineCycle(600, 0.5f) };
+    const auto first = Wavetable::create(frames);
+    const auto again = Wavetable::create(frames);
+    const auto other = Wavetable::create({ sineCycle(600, 0.25f) });
+
+    CHECK(first == again);
+    CHECK(first != other);
+    CHECK(first->getNumFrames() == 2);
+
+    // Any cycle length is resampled to the frame size
+    CHECK(harmonicAmplitude(first->getRow(0, 1), 1) == Catch::Approx(0.5).epsilon(1.0e-3));
+}
+
+TEST_CASE("WavetableRenderer sums its lanes", "[oscillators][wavetable]")
+{
+    const auto table = Wavetable::getShape(Wavetable::Shape::Sine);
+    constexpr int kLanes = 5;
+    constexpr int kSamples = 300;
+
+    const int padded = WavetableRenderer::paddedLanes(kLanes);
+    REQUIRE(padded == 8);
+
+    std::vector<float> phases(static_cast<size_t>(padded), 0.0f);
+    std::vector<float> increments(static_cast<size_t>(padded), 0.0f);
+    std::vector<float> gainsLeft(static_cast<size_t>(padded), 0.0f);
+    std::vector<float> gainsRight(static_cast<size_t>(padded), 0.0f);
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const auto i = static_cast<size_t>(lane);
+        phases[i] = 0.13f * static_cast<float>(lane);
+        increments[i] = 0.003f * static_cast<float>(lane + 1) * (lane == 3 ? -1.0f : 1.0f);
+        gainsLeft[i] = 0.1f * static_cast<float>(lane + 1);
+        gainsRight[i] = lane == 2 ? 1.0f : 0.0f;
+    }
+
+    auto expectedPhases = phases;
+    std::vector<float> expectedLeft(kSamples, 0.0f), expectedRight(kSamples, 0.0f);
+    for (int lane = 0; lane < kLanes; ++lane) {
+        auto& phase = expectedPhases[static_cast<size_t>(lane)];
+        for (int sample = 0; sample < kSamples; ++sample) {
+            phase -= std::floor(phase);
+            const float value = static_cast<float>(std::sin(kTwoPi * phase));
+            expectedLeft[static_cast<size_t>(sample)] += value * gainsLeft[static_cast<size_t>(lane)];
+            expectedRight[static_cast<size_t>(sample)] += value * gainsRight[static_cast<size_t>(lane)];
+            phase += increments[static_cast<size_t>(lane)];
+        }
+        phase -= std::floor(phase);
+    }
+
+    WavetableRenderer::Lanes lanes;
+    lanes.phases = phases.data();
+    lanes.increments = increments.data();
+    lanes.gainsLeft = gainsLeft.data();
+    lanes.gainsRight = gainsRight.data();
+    lanes.numLanes = kLanes;
+
+    // Output is added to what is already in the buffers
+    std::vector<float> left(kSamples, 1.0f), right(kSamples, 0.0f);
+    WavetableRenderer::render(*table, 0.0f, lanes, left.data(), right.data(), kSamples);
+
+    for (int sample = 0; sample < kSamples; ++sample) {
+        INFO("sample " << sample);
+        CHECK(left[static_cast<size_t>(sample)] - 1.0f == Catch::Approx(expectedLeft[static_cast<size_t>(sample)]).margin(1.0e-4));
+        CHECK(right[static_cast<size_t>(sample)] == Catch::Approx(expectedRight[static_cast<size_t>(sample)]).margin(1.0e-4));
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const auto i = static_cast<size_t>(lane);
+        CHECK(phases[i] >= 0.0f);
+        CHECK(phases[i] < 1.0f);
+        CHECK(phases[i] == Catch::Approx(expectedPhases[i]).margin(1.0e-5));
+    }
+}
+
+TEST_CASE("WavetableRenderer morphs between neighbouring frames", "[oscillators][wavetable]")
+{
+    const auto table = Wavetable::create({ sineCycle(kSize, 1.0f), sineCycle(kSize, -1.0f), sineCycle(kSize, 0.5f) });
+
+    const auto renderAt = [&table](float framePosition) {
+        float phase[4] = { 0.1f, 0.0f, 0.0f, 0.0f };
+        const float increment[4] = { 0.01f, 0.0f, 0.0f, 0.0f };
+        const float gain[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+
+        WavetableRenderer::Lanes lanes;
+        lanes.phases = phase;
+        lanes.increments = increment;
+        lanes.gainsLeft = gain;
+        lanes.gainsRight = gain;
+        lanes.numLanes = 1;
+
+        std::vector<float> out(64, 0.0f);
+        WavetableRenderer::render(*table, framePosition, lanes, out.data(), nullptr, 64);
+        return out;
+    };
+
+    const auto first = renderAt(0.0f);
+    const auto between = renderAt(0.25f);
+    const auto last = renderAt(1.0f);
+
+    for (size_t i = 0; i < first.size(); ++i) {
+        CHECK(between[i] == Catch::Approx(0.0f).margin(1.0e-4));
+        CHECK(last[i] == Catch::Approx(0.5f * first[i]).margin(1.0e-4));
+    }
+}
+
+TEST_CASE("Wavetable fastSin follows std::sin", "[oscillators][wavetable]")
+{
+    for (float phase = -2.0f; phase < 2.0f; phase += 0.0137f)
+        CHECK(Wavetable::fastSin(phase) == Catch::Approx(std::sin(kTwoPi * phase)).margin(2.0e-6));
+}
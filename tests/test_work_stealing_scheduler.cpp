@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+    test_work_stealing_scheduler.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Task completion, parallel_for coverage and external deque claims of the
+    work-stealing scheduler
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "performance/multithreading.h"
+
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include <vector>
+
+using namespace vital::performance::threading;
+
+namespace {
+
+class CountingTask : public WorkStealingTask
+{
+public:
+    explicit CountingTask(std::atomic<int>& counter) : counter_(counter) {}
+    void execute() override { counter_.fetch_add(1); }
+
+private:
+    std::atomic<int>& counter_;
+};
+
+/** Submit one task from the calling thread; true if it was queued rather than run inline */
+bool submitAndCheckQueued(WorkStealingScheduler& scheduler, std::atomic<int>& counter)
+{
+    const int before = counter.load();
+    scheduler.submit(std::make_unique<CountingTask>(counter));
+    return counter.load() == before;
+}
+
+} // namespace
+
+TEST_CASE("WorkStealingScheduler runs every submitted task", "[performance][scheduler]")
+{
+    WorkStealingScheduler scheduler(4);
+    std::atomic<int> counter{ 0 };
+
+    for (int i = 0; i < 5000; ++i)
+        scheduler.submit(std::make_unique<CountingTask>(counter));
+    scheduler.execute_until_empty();
+
+    CHECK(counter.load() == 5000);
+}
+
+TEST_CASE("WorkStealingScheduler parallel_for covers the range once", "[performance][scheduler]")
+{
+    WorkStealingScheduler scheduler(3);
+
+    for (size_t size : { size_t(0), size_t(1), size_t(63), size_t(10000) }) {
+        std::vector<std::atomic<int>> hits(size);
+        scheduler.parallel_for(0, size, 16, [&](size_t i) { hits[i].fetch_add(1); });
+
+        bool once = true;
+        for (auto& hit : hits)
+            once = once && hit.load() == 1;
+        INFO("size " << size);
+        CHECK(once);
+    }
+}
+
+TEST_CASE("WorkStealingScheduler hands external deques back when threads exit", "[performance][scheduler]")
+{
+    // No workers: a queued task waits for execute_until_empty, an unqueued one runs inline
+    WorkStealingScheduler scheduler(0);
+    std::atomic<int> counter{ 0 };
+
+    constexpr int kThreads = static_cast<int>(WorkStealingScheduler::max_external_threads) + 4;
+
+    // All alive at once: only max_external_threads of them get a deque
+    std::atomic<int> queued{ 0 };
+    std::barrier sync(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            sync.arrive_and_wait();
+            if (submitAndCheckQueued(scheduler, counter)) queued.fetch_add(1);
+            sync.arrive_and_wait();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    threads.clear();
+
+    CHECK(queued.load() == static_cast<int>(WorkStealingScheduler::max_external_threads));
+
+    // Those threads have exited, so a new batch finds every deque free again
+    for (int round = 0; round < 3; ++round) {
+        queued.store(0);
+        for (int t = 0; t < static_cast<int>(WorkStealingScheduler::max_external_threads); ++t) {
+            threads.emplace_back([&] {
+                if (submitAndCheckQueued(scheduler, counter)) queued.fetch_add(1);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        threads.clear();
+
+        INFO("round " << round);
+        CHECK(queued.load() == static_cast<int>(WorkStealingScheduler::max_external_threads));
+    }
+
+    scheduler.execute_until_empty();
+    CHECK(counter.load() == kThreads + 3 * static_cast<int>(WorkStealingScheduler::max_external_threads));
+}
+
+TEST_CASE("WorkStealingScheduler keeps one deque per scheduler for each thread", "[performance][scheduler]")
+{
+    WorkStealingScheduler first(0), second(0);
+    std::atomic<int> counter{ 0 };
+
+    // Alternating keeps both claims instead of re-claiming, so neither scheduler runs the task inline
+    bool allQueued = true;
+    for (int i = 0; i < 100; ++i) {
+        allQueued = submitAndCheckQueued(first, counter) && allQueued;
+        allQueued = submitAndCheckQueued(second, counter) && allQueued;
+    }
+    CHECK(allQueued);
+
+    // The other external deques of each scheduler are still free for other threads
+    std::atomic<int> queued{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < static_cast<int>(WorkStealingScheduler::max_external_threads) - 1; ++t) {
+        threads.emplace_back([&] {
+            if (submitAndCheckQueued(first, counter)) queued.fetch_add(1);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(queued.load() == static_cast<int>(WorkStealingScheduler::max_external_threads) - 1);
+
+    first.execute_until_empty();
+    second.execute_until_empty();
+    CHECK(counter.load() == 200 + static_cast<int>(WorkStealingScheduler::max_external_threads) - 1);
+}
+
+TEST_CASE("WorkStealingScheduler workers can feed another scheduler", "[performance][scheduler]")
+{
+    WorkStealingScheduler outer(2), inner(2);
+    std::atomic<int> counter{ 0 };
+
+    // Each outer chunk runs an inner parallel_for from a worker thread
+    outer.parallel_for(0, 64, 1, [&](size_t) {
+        inner.parallel_for(0, 32, 4, [&](size_t) { counter.fetch_add(1); });
+    });
+
+    CHECK(counter.load() == 64 * 32);
+
+    const auto stats = outer.get_statistics();
+    CHECK(stats.total_tasks_completed > 0);
+}
@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+    test_zdf_filter_bank.cpp
+    Copyright (c) 2025 Vital Audio Engine Team
+
+    Magnitude response, resonance stability, bypass and cutoff glides of
+    the ZDF filter bank
+  ==============================================================================
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "filtering/zdf_filter_bank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace vital::audio_engine::filtering;
+using Model = ZdfFilterBank::Model;
+using Mode = ZdfFilterBank::Mode;
+
+namespace {
+
+constexpr double kSampleRate = 96000.0;
+constexpr int kVoices = 3;
+constexpr int kBlock = 1024;
+
+std::vector<std::vector<float>> makeNoise(int length)
+{
+    std::vector<std::vector<float>> channels(kVoices, std::vector<float>(static_cast<size_t>(length)));
+    uint32_t seed = 4321;
+    for (auto& channel : channels) {
+        for (auto& value : channel) {
+            seed = seed * 1664525u + 1013904223u;
+            value = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        }
+    }
+    return channels;
+}
+
+/** Lowpass voices that glide up four octaves in the first block and back down in the second */
+std::vector<std::vector<float>> renderGlides(const std::vector<int>& pieces)
+{
+    ZdfFilterBank bank;
+    bank.prepare(kVoices, kSampleRate);
+    for (int voice = 0; voice < kVoices; ++voice) {
+        bank.setEnabled(voice, true);
+        bank.setModel(voice, voice == 1 ? ZdfFilterBank::Model::Ladder : ZdfFilterBank::Model::Svf);
+        bank.setMode(voice, ZdfFilterBank::Mode::LowPass);
+        bank.setResonance(voice, 0.5f);
+        bank.setStages(voice, 2);
+        bank.snapCutoff(voice, 300.0f);
+    }
+
+    auto channels = makeNoise(2 * kBlock);
+
+    for (int block = 0; block < 2; ++block) {
+        for (int voice = 0; voice < kVoices; ++voice)
+            bank.setCutoff(voice, block == 0 ? 4800.0f : 300.0f);
+
+        int offset = 0;
+        for (size_t piece = 0; offset < kBlock; ++piece) {
+            const int count = std::min(pieces[piece % pieces.size()], kBlock - offset);
+
+            float* pointers[kVoices];
+            for (int voice = 0; voice < kVoices; ++voice)
+                pointers[voice] = channels[static_cast<size_t>(voice)].data() + block * kBlock + offset;
+
+            bank.process(pointers, kVoices, count, nullptr, offset, kBlock);
+            offset += count;
+        }
+    }
+
+    return channels;
+}
+
+/** Steady-state gain of one voice at frequency, measured by correlating a second of a sine against its quadrature pair */
+double measureGain(Model model, Mode mode, int stages, float cutoff, float frequency,
+                   const float* modulation = nullptr)
+{
+    constexpr double kRate = 48000.0;
+    constexpr int kLength = 48000;
+    constexpr float kLevel = 0.1f;
+
+    ZdfFilterBank bank;
+    bank.prepare(1, kRate);
+    bank.setModel(0, model);
+    bank.setMode(0, mode);
+    bank.setResonance(0, 0.0f);
+    bank.setStages(0, stages);
+    bank.snapCutoff(0, cutoff);
+
+    const double omega = 2.0 * 3.141592653589793 * frequency / kRate;
+    std::vector<float> signal(kLength);
+    for (int i = 0; i < kLength; ++i)
+        signal[static_cast<size_t>(i)] = kLevel * static_cast<float>(std::sin(omega * i));
+
+    for (int start = 0; start < kLength; start += kBlock) {
+        float* channel[] = { signal.data() + start };
+        const float* offsets[] = { modulation };
+        bank.process(channel, 1, std::min(kBlock, kLength - start), modulation != nullptr ? offsets : nullptr);
+    }
+
+    // The second half holds a whole number of periods for every frequency used here
+    double inPhase = 0.0, quadrature = 0.0;
+    for (int i = kLength / 2; i < kLength; ++i) {
+        inPhase += signal[static_cast<size_t>(i)] * std::sin(omega * i);
+        quadrature += signal[static_cast<size_t>(i)] * std::cos(omega * i);
+    }
+    return std::hypot(inPhase, quadrature) * 4.0 / kLength / kLevel;
+}
+
+} // namespace
+
+TEST_CASE("ZdfFilterBank SVF responses match the analogue prototype", "[filtering][zdf]")
+{
+    // Zero resonance is Q 0.5: each pole pair is 6 dB down at the cutoff
+    CHECK(measureGain(Model::Svf, Mode::LowPass, 1, 1000.0f, 1000.0f) == Catch::Approx(0.5).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::HighPass, 1, 1000.0f, 1000.0f) == Catch::Approx(0.5).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::BandPass, 1, 1000.0f, 1000.0f) == Catch::Approx(1.0).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::Notch, 1, 1000.0f, 1000.0f) < 0.01);
+    CHECK(measureGain(Model::Svf, Mode::AllPass, 1, 1000.0f, 3000.0f) == Catch::Approx(1.0).epsilon(0.01));
+
+    // Passbands stay flat and stopbands fall at 12 dB per octave
+    CHECK(measureGain(Model::Svf, Mode::LowPass, 1, 4000.0f, 250.0f) == Catch::Approx(1.0).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::HighPass, 1, 250.0f, 4000.0f) == Catch::Approx(1.0).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::LowPass, 1, 500.0f, 4000.0f) < 0.02);
+
+    // Stages cascade
+    CHECK(measureGain(Model::Svf, Mode::LowPass, 2, 1000.0f, 1000.0f) == Catch::Approx(0.25).epsilon(0.01));
+    CHECK(measureGain(Model::Svf, Mode::LowPass, 4, 1000.0f, 1000.0f) == Catch::Approx(0.0625).epsilon(0.02));
+}
+
+TEST_CASE("ZdfFilterBank ladder responses match four one-pole stages", "[filtering][zdf]")
+{
+    // Without feedback each one-pole is 3 dB down at the cutoff
+    CHECK(measureGain(Model::Ladder, Mode::LowPass, 1, 1000.0f, 1000.0f) == Catch::Approx(0.25).epsilon(0.01));
+    CHECK(measureGain(Model::Ladder, Mode::HighPass, 1, 1000.0f, 1000.0f) == Catch::Approx(0.25).epsilon(0.01));
+    CHECK(measureGain(Model::Ladder, Mode::LowPass, 2, 1000.0f, 1000.0f) == Catch::Approx(0.0625).epsilon(0.02));
+    CHECK(measureGain(Model::Ladder, Mode::LowPass, 1, 4000.0f, 250.0f) == Catch::Approx(1.0).epsilon(0.01));
+    CHECK(measureGain(Model::Ladder, Mode::HighPass, 1, 250.0f, 4000.0f) == Catch::Approx(1.0).epsilon(0.01));
+
+    // Modes the ladder lacks fall back to lowpass
+    CHECK(measureGain(Model::Ladder, Mode::Bell, 1, 1000.0f, 1000.0f) == Catch::Approx(0.25).epsilon(0.01));
+}
+
+TEST_CASE("ZdfFilterBank modulation moves the cutoff in octaves", "[filtering][zdf]")
+{
+    const std::vector<float> octaveUp(static_cast<size_t>(kBlock), 1.0f);
+    for (const auto model : { Model::Svf, Model::Ladder }) {
+        INFO((model == Model::Svf ? "SVF" : "ladder"));
+        CHECK(measureGain(model, Mode::LowPass, 1, 500.0f, 1000.0f, octaveUp.data())
+              == Catch::Approx(measureGain(model, Mode::LowPass, 1, 1000.0f, 1000.0f)).epsilon(1.0e-3));
+    }
+}
+
+TEST_CASE("ZdfFilterBank stays bounded at full resonance near Nyquist", "[filtering][zdf]")
+{
+    ZdfFilterBank bank;
+    bank.prepare(kVoices, kSampleRate);
+    for (int voice = 0; voice < kVoices; ++voice) {
+        bank.setModel(voice, voice == 0 ? Model::Svf : Model::Ladder);
+        bank.setResonance(voice, 1.0f);
+        bank.setStages(voice, ZdfFilterBank::kMaxStages);
+        bank.snapCutoff(voice, 0.48f * static_cast<float>(kSampleRate));
+    }
+    bank.setMode(2, Mode::BandPass);
+
+    // Full-scale noise under a fast sweep that runs into the top of the range, then silence at a
+    // quarter of the sample rate, where a Q 50 pole decays by 1% a sample
+    auto channels = makeNoise(16 * kBlock);
+    for (auto& channel : channels)
+        std::fill(channel.begin() + 8 * kBlock, channel.end(), 0.0f);
+
+    for (int block = 0; block < 16; ++block) {
+        for (int voice = 0; voice < kVoices; ++voice)
+            bank.setCutoff(voice, block >= 8 ? 24000.0f : block % 2 == 1 ? 60000.0f : 50.0f);
+
+        float* pointers[kVoices];
+        for (int voice = 0; voice < kVoices; ++voice)
+            pointers[voice] = channels[static_cast<size_t>(voice)].data() + block * kBlock;
+        bank.process(pointers, kVoices, kBlock);
+    }
+
+    for (int voice = 0; voice < kVoices; ++voice) {
+        INFO("voice " << voice);
+        const auto& channel = channels[static_cast<size_t>(voice)];
+        for (float value : channel)
+            REQUIRE(std::isfinite(value));
+
+        float tail = 0.0f;
+        for (size_t i = channel.size() - kBlock; i < channel.size(); ++i)
+            tail = std::max(tail, std::abs(channel[i]));
+
+        // Four Q 50 stages ring loud but die away; the ladder's clipped loop stays bounded
+        if (voice == 0)
+            CHECK(tail < 1.0e-3f);
+        else
+            CHECK(tail < 16.0f);
+    }
+}
+
+TEST_CASE("ZdfFilterBank ladder self-oscillates and settles at full resonance", "[filtering][zdf]")
+{
+    ZdfFilterBank bank;
+    bank.prepare(1, kSampleRate);
+    bank.setModel(0, Model::Ladder);
+    bank.setResonance(0, 1.0f);
+    bank.snapCutoff(0, 2000.0f);
+
+    std::vector<float> signal(static_cast<size_t>(16 * kBlock), 0.0f);
+    signal[0] = 1.0f;
+    for (int block = 0; block < 16; ++block) {
+        float* channel[] = { signal.data() + block * kBlock };
+        bank.process(channel, 1, kBlock);
+    }
+
+    // The impulse has long gone but the loop keeps ringing, held by the soft clipper
+    float tailPeak = 0.0f;
+    for (size_t i = signal.size() - kBlock; i < signal.size(); ++i)
+        tailPeak = std::max(tailPeak, std::abs(signal[i]));
+    CHECK(tailPeak > 0.1f);
+    CHECK(tailPeak < 4.0f);
+}
+
+TEST_CASE("ZdfFilterBank passes disabled and unprocessed voices through", "[filtering][zdf]")
+{
+    ZdfFilterBank bank;
+    bank.prepare(ZdfFilterBank::kLaneWidth + 2, kSampleRate);
+    for (int voice = 0; voice < ZdfFilterBank::kLaneWidth + 2; ++voice)
+        bank.snapCutoff(voice, 200.0f);
+    bank.setEnabled(1, false);
+    bank.setEnabled(ZdfFilterBank::kLaneWidth, false);
+    CHECK_FALSE(bank.isEnabled(1));
+
+    const auto dry = makeNoise(kBlock);
+    std::vector<std::vector<float>> channels(ZdfFilterBank::kLaneWidth + 2, dry[0]);
+    std::vector<float*> pointers;
+    for (auto& channel : channels)
+        pointers.push_back(channel.data());
+
+    // Only the first kLaneWidth + 1 voices are handed to the bank
+    bank.process(pointers.data(), ZdfFilterBank::kLaneWidth + 1, kBlock);
+
+    CHECK(channels[1] == dry[0]);
+    CHECK(channels[ZdfFilterBank::kLaneWidth] == dry[0]);
+    CHECK(channels[ZdfFilterBank::kLaneWidth + 1] == dry[0]);
+    CHECK(channels[0] != dry[0]);
+    CHECK(channels[2] == channels[0]);
+
+    // Null channels are skipped while the rest of their group is filtered
+    const auto filtered = channels[0];
+    const auto before = channels[2];
+    pointers[0] = nullptr;
+    bank.process(pointers.data(), 3, kBlock);
+    CHECK(channels[0] == filtered);
+    CHECK(channels[2] != before);
+}
+
+TEST_CASE("ZdfFilterBank snaps cutoffs and keeps them across sample rates", "[filtering][zdf]")
+{
+    ZdfFilterBank bank;
+    bank.prepare(2, 48000.0);
+
+    // Voice 0 glides up from the default 1 kHz, voice 1 starts at its target
+    bank.setCutoff(0, 8000.0f);
+    bank.snapCutoff(1, 8000.0f);
+    CHECK(bank.getCutoff(0) == Catch::Approx(8000.0f).epsilon(1.0e-4));
+    CHECK(bank.getCutoff(1) == Catch::Approx(8000.0f).epsilon(1.0e-4));
+
+    auto channels = makeNoise(kBlock);
+    channels[1] = channels[0];
+    const auto dry = channels[0];
+    float* pointers[] = { channels[0].data(), channels[1].data() };
+    bank.process(pointers, 2, kBlock);
+
+    // Over the first few samples the gliding voice has far more high-frequency loss
+    const auto roughness = [](const std::vector<float>& signal) {
+        double sum = 0.0;
+        for (size_t i = 1; i < 64; ++i)
+            sum += std::abs(signal[i] - signal[i - 1]);
+        return sum;
+    };
+    CHECK(roughness(channels[0]) < 0.5 * roughness(channels[1]));
+    CHECK(roughness(channels[1]) < roughness(dry));
+
+    bank.setSampleRate(96000.0);
+    CHECK(bank.getSampleRate() == 96000.0);
+    CHECK(bank.getCutoff(0) == Catch::Approx(8000.0f).epsilon(1.0e-4));
+    CHECK(bank.getCutoff(1) == Catch::Approx(8000.0f).epsilon(1.0e-4));
+}
+
+TEST_CASE("ZdfFilterBank glides across a block split into pieces", "[filtering][zdf]")
+{
+    const auto whole = renderGlides({ kBlock });
+
+    for (const auto& pieces : { std::vector<int>{ 256 }, std::vector<int>{ 100, 37, 300 } }) {
+        const auto split = renderGlides(pieces);
+
+        float worst = 0.0f;
+        for (int voice = 0; voice < kVoices; ++voice)
+            for (int i = 0; i < 2 * kBlock; ++i)
+                worst = std::max(worst, std::abs(split[static_cast<size_t>(voice)][static_cast<size_t>(i)]
+                                                 - whole[static_cast<size_t>(voice)][static_cast<size_t>(i)]));
+
+        INFO("first piece " << pieces.front());
+        CHECK(worst < 1.0e-4f);
+    }
+}